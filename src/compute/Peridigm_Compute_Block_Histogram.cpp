@@ -0,0 +1,189 @@
+/*! \file Peridigm_Compute_Block_Histogram.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <vector>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+
+#include "Peridigm_Compute_Block_Histogram.hpp"
+#include "Peridigm_Field.hpp"
+
+using namespace std;
+
+//! Standard constructor.
+PeridigmNS::Compute_Block_Histogram::Compute_Block_Histogram(Teuchos::RCP<const Teuchos::ParameterList> params,
+                                                             Teuchos::RCP<const Epetra_Comm> epetraComm_,
+                                                             Teuchos::RCP<const Teuchos::ParameterList> computeClassGlobalData_)
+  : Compute(params, epetraComm_, computeClassGlobalData_), m_variableLength(1), m_component(0), m_variableIsStated(false),
+    m_blockId(-1), m_uniformBins(false), m_normalize(false), m_variableFieldId(-1), m_underflowFieldId(-1), m_overflowFieldId(-1)
+{
+  m_blockName = params->get<string>("Block", "All");
+  m_variable = params->get<string>("Variable");
+  m_outputLabel = params->get<string>("Output Label");
+  m_component = params->get<int>("Component", 0);
+  m_normalize = params->get<bool>("Normalize", false);
+
+  FieldManager& fieldManager = FieldManager::self();
+  m_variableFieldId = fieldManager.getFieldId(m_variable);
+  m_fieldIds.push_back(m_variableFieldId);
+
+  FieldSpec spec = fieldManager.getFieldSpec(m_variableFieldId);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(spec.getRelation() != PeridigmField::NODE && spec.getRelation() != PeridigmField::ELEMENT,
+                              "**** Error:  Block_Histogram compute class can be called only for NODE or ELEMENT data.\n");
+  m_variableLength = PeridigmField::variableDimension(spec.getLength());
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(m_component < 0 || m_component >= m_variableLength,
+                              "**** Error:  invalid \"Component\" in Block_Histogram compute class.\n");
+  m_variableIsStated = (spec.getTemporal() == PeridigmField::TWO_STEP);
+
+  // Bins are given either as a space-separated list of edges or as a number of equal bins between a minimum and a maximum
+  if(params->isParameter("Bin Edges")){
+    istringstream binEdges(params->get<string>("Bin Edges"));
+    copy(istream_iterator<double>(binEdges), istream_iterator<double>(), back_inserter< vector<double> >(m_binEdges));
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(m_binEdges.size() < 2, "**** Error:  Block_Histogram compute class requires at least two bin edges.\n");
+    for(unsigned int i=1 ; i<m_binEdges.size() ; ++i)
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(m_binEdges[i] <= m_binEdges[i-1], "**** Error:  Block_Histogram compute class bin edges must be in ascending order.\n");
+  }
+  else{
+    double minimum = params->get<double>("Minimum");
+    double maximum = params->get<double>("Maximum");
+    int numBins = params->get<int>("Number Of Bins");
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(numBins < 1 || maximum <= minimum,
+                                "**** Error:  Block_Histogram compute class requires at least one bin and Maximum greater than Minimum.\n");
+    for(int i=0 ; i<=numBins ; ++i)
+      m_binEdges.push_back(minimum + i*(maximum - minimum)/numBins);
+    m_uniformBins = true;
+  }
+
+  int numBins = m_binEdges.size() - 1;
+  for(int i=0 ; i<numBins ; ++i){
+    ostringstream label;
+    label << m_outputLabel << "_Bin_" << i+1;
+    m_binFieldIds.push_back(fieldManager.getFieldId(PeridigmField::GLOBAL, PeridigmField::SCALAR, PeridigmField::CONSTANT, label.str()));
+    m_fieldIds.push_back(m_binFieldIds.back());
+  }
+  m_underflowFieldId = fieldManager.getFieldId(PeridigmField::GLOBAL, PeridigmField::SCALAR, PeridigmField::CONSTANT, m_outputLabel + "_Underflow");
+  m_overflowFieldId = fieldManager.getFieldId(PeridigmField::GLOBAL, PeridigmField::SCALAR, PeridigmField::CONSTANT, m_outputLabel + "_Overflow");
+  m_fieldIds.push_back(m_underflowFieldId);
+  m_fieldIds.push_back(m_overflowFieldId);
+}
+
+void PeridigmNS::Compute_Block_Histogram::initialize( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks ) {
+
+  m_blockId = -1;
+  if(m_blockName == "All")
+    return;
+
+  for(std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+    if(blockIt->getName() == m_blockName)
+      m_blockId = blockIt->getID();
+  }
+
+  if(m_blockId == -1){
+    string msg = "**** Error:  Block_Histogram compute class failed to find block: " + m_blockName + "\n";
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(true, msg);
+  }
+}
+
+int PeridigmNS::Compute_Block_Histogram::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks ) const {
+
+  PeridigmField::Step step = PeridigmField::STEP_NONE;
+  if(m_variableIsStated)
+    step = PeridigmField::STEP_NP1;
+
+  // Counts for each bin, followed by the underflow and overflow counts
+  int numBins = m_binEdges.size() - 1;
+  double minimum = m_binEdges.front();
+  double maximum = m_binEdges.back();
+  double binWidth = (maximum - minimum)/numBins;
+  vector<double> localCounts(numBins + 2, 0.0), globalCounts(numBins + 2);
+
+  for(std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+    if(m_blockId != -1 && blockIt->getID() != m_blockId)
+      continue;
+    if(!blockIt->hasData(m_variableFieldId, step))
+      continue;
+    double *data;
+    blockIt->getData(m_variableFieldId, step)->ExtractView(&data);
+    int numOwnedPoints = blockIt->getNeighborhoodData()->NumOwnedPoints();
+    for(int i=0 ; i<numOwnedPoints ; ++i){
+      double value = data[m_variableLength*i + m_component];
+      int bin;
+      if(value < minimum)
+        bin = numBins;
+      else if(value > maximum)
+        bin = numBins + 1;
+      else if(value == maximum)
+        bin = numBins - 1;
+      else if(m_uniformBins)
+        bin = std::min(static_cast<int>((value - minimum)/binWidth), numBins - 1);
+      else
+        bin = static_cast<int>(std::upper_bound(m_binEdges.begin(), m_binEdges.end(), value) - m_binEdges.begin()) - 1;
+      localCounts[bin] += 1.0;
+    }
+  }
+
+  epetraComm()->SumAll(&localCounts[0], &globalCounts[0], numBins + 2);
+
+  if(m_normalize){
+    double numPoints = 0.0;
+    for(int i=0 ; i<numBins+2 ; ++i)
+      numPoints += globalCounts[i];
+    if(numPoints > 0.0){
+      for(int i=0 ; i<numBins+2 ; ++i)
+        globalCounts[i] /= numPoints;
+    }
+  }
+
+  Block& firstBlock = *blocks->begin();
+  for(int i=0 ; i<numBins ; ++i)
+    (*firstBlock.getData(m_binFieldIds[i], PeridigmField::STEP_NONE))[0] = globalCounts[i];
+  (*firstBlock.getData(m_underflowFieldId, PeridigmField::STEP_NONE))[0] = globalCounts[numBins];
+  (*firstBlock.getData(m_overflowFieldId, PeridigmField::STEP_NONE))[0] = globalCounts[numBins+1];
+
+  return 0;
+}
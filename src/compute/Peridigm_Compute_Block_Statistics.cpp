@@ -0,0 +1,227 @@
+/*! \file Peridigm_Compute_Block_Statistics.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <vector>
+#include <sstream>
+#include <iterator>
+#include <cfloat>
+
+#include "Peridigm_Compute_Block_Statistics.hpp"
+#include "Peridigm_Field.hpp"
+
+using namespace std;
+
+//! Standard constructor.
+PeridigmNS::Compute_Block_Statistics::Compute_Block_Statistics(Teuchos::RCP<const Teuchos::ParameterList> params,
+                                                               Teuchos::RCP<const Epetra_Comm> epetraComm_,
+                                                               Teuchos::RCP<const Teuchos::ParameterList> computeClassGlobalData_)
+  : Compute(params, epetraComm_, computeClassGlobalData_), m_variableLength(1), m_component(0), m_variableIsStated(false),
+    m_blockId(-1), m_numPercentileBins(1000), m_hasThreshold(false), m_threshold(0.0), m_variableFieldId(-1),
+    m_minimumFieldId(-1), m_maximumFieldId(-1), m_meanFieldId(-1), m_countAboveThresholdFieldId(-1)
+{
+  m_blockName = params->get<string>("Block", "All");
+  m_variable = params->get<string>("Variable");
+  m_outputLabel = params->get<string>("Output Label");
+  m_component = params->get<int>("Component", 0);
+
+  FieldManager& fieldManager = FieldManager::self();
+  m_variableFieldId = fieldManager.getFieldId(m_variable);
+  m_fieldIds.push_back(m_variableFieldId);
+
+  FieldSpec spec = fieldManager.getFieldSpec(m_variableFieldId);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(spec.getRelation() != PeridigmField::NODE && spec.getRelation() != PeridigmField::ELEMENT,
+                              "**** Error:  Block_Statistics compute class can be called only for NODE or ELEMENT data.\n");
+  m_variableLength = PeridigmField::variableDimension(spec.getLength());
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(m_component < 0 || m_component >= m_variableLength,
+                              "**** Error:  invalid \"Component\" in Block_Statistics compute class.\n");
+  m_variableIsStated = (spec.getTemporal() == PeridigmField::TWO_STEP);
+
+  m_minimumFieldId = fieldManager.getFieldId(PeridigmField::GLOBAL, PeridigmField::SCALAR, PeridigmField::CONSTANT, m_outputLabel + "_Minimum");
+  m_maximumFieldId = fieldManager.getFieldId(PeridigmField::GLOBAL, PeridigmField::SCALAR, PeridigmField::CONSTANT, m_outputLabel + "_Maximum");
+  m_meanFieldId = fieldManager.getFieldId(PeridigmField::GLOBAL, PeridigmField::SCALAR, PeridigmField::CONSTANT, m_outputLabel + "_Mean");
+  m_fieldIds.push_back(m_minimumFieldId);
+  m_fieldIds.push_back(m_maximumFieldId);
+  m_fieldIds.push_back(m_meanFieldId);
+
+  // Percentiles are given as a space-separated list, e.g., "50 90 99"
+  istringstream percentiles(params->get<string>("Percentiles", ""));
+  copy(istream_iterator<double>(percentiles), istream_iterator<double>(), back_inserter< vector<double> >(m_percentiles));
+  for(unsigned int i=0 ; i<m_percentiles.size() ; ++i){
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(m_percentiles[i] < 0.0 || m_percentiles[i] > 100.0,
+                                "**** Error:  Block_Statistics compute class percentiles must be between 0 and 100.\n");
+    ostringstream label;
+    label << m_outputLabel << "_P" << m_percentiles[i];
+    m_percentileFieldIds.push_back(fieldManager.getFieldId(PeridigmField::GLOBAL, PeridigmField::SCALAR, PeridigmField::CONSTANT, label.str()));
+    m_fieldIds.push_back(m_percentileFieldIds.back());
+  }
+  m_numPercentileBins = params->get<int>("Percentile Bins", 1000);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(m_numPercentileBins < 1, "**** Error:  Block_Statistics compute class requires at least one percentile bin.\n");
+
+  m_hasThreshold = params->isParameter("Threshold");
+  if(m_hasThreshold){
+    m_threshold = params->get<double>("Threshold");
+    m_countAboveThresholdFieldId = fieldManager.getFieldId(PeridigmField::GLOBAL, PeridigmField::SCALAR, PeridigmField::CONSTANT, m_outputLabel + "_Count_Above");
+    m_fieldIds.push_back(m_countAboveThresholdFieldId);
+  }
+}
+
+void PeridigmNS::Compute_Block_Statistics::initialize( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks ) {
+
+  m_blockId = -1;
+  if(m_blockName == "All")
+    return;
+
+  for(std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+    if(blockIt->getName() == m_blockName)
+      m_blockId = blockIt->getID();
+  }
+
+  if(m_blockId == -1){
+    string msg = "**** Error:  Block_Statistics compute class failed to find block: " + m_blockName + "\n";
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(true, msg);
+  }
+}
+
+int PeridigmNS::Compute_Block_Statistics::compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks ) const {
+
+  PeridigmField::Step step = PeridigmField::STEP_NONE;
+  if(m_variableIsStated)
+    step = PeridigmField::STEP_NP1;
+
+  // Minimum and negated maximum, reduced together with MinAll
+  double localExtrema[2] = {DBL_MAX, DBL_MAX};
+  // Sum, number of points, and number of points above the threshold
+  double localSums[3] = {0.0, 0.0, 0.0};
+
+  for(std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+    if(m_blockId != -1 && blockIt->getID() != m_blockId)
+      continue;
+    if(!blockIt->hasData(m_variableFieldId, step))
+      continue;
+    double *data;
+    blockIt->getData(m_variableFieldId, step)->ExtractView(&data);
+    int numOwnedPoints = blockIt->getNeighborhoodData()->NumOwnedPoints();
+    for(int i=0 ; i<numOwnedPoints ; ++i){
+      double value = data[m_variableLength*i + m_component];
+      if(value < localExtrema[0])
+        localExtrema[0] = value;
+      if(-value < localExtrema[1])
+        localExtrema[1] = -value;
+      localSums[0] += value;
+      if(m_hasThreshold && value > m_threshold)
+        localSums[2] += 1.0;
+    }
+    localSums[1] += numOwnedPoints;
+  }
+
+  double globalExtrema[2], globalSums[3];
+  epetraComm()->MinAll(localExtrema, globalExtrema, 2);
+  epetraComm()->SumAll(localSums, globalSums, 3);
+
+  double minimum(0.0), maximum(0.0), mean(0.0);
+  double numPoints = globalSums[1];
+  if(numPoints > 0.0){
+    minimum = globalExtrema[0];
+    maximum = -globalExtrema[1];
+    mean = globalSums[0]/numPoints;
+  }
+
+  Block& firstBlock = *blocks->begin();
+  (*firstBlock.getData(m_minimumFieldId, PeridigmField::STEP_NONE))[0] = minimum;
+  (*firstBlock.getData(m_maximumFieldId, PeridigmField::STEP_NONE))[0] = maximum;
+  (*firstBlock.getData(m_meanFieldId, PeridigmField::STEP_NONE))[0] = mean;
+  if(m_hasThreshold)
+    (*firstBlock.getData(m_countAboveThresholdFieldId, PeridigmField::STEP_NONE))[0] = globalSums[2];
+
+  if(m_percentiles.size() == 0)
+    return 0;
+
+  // Histogram over [minimum, maximum]
+  double binWidth = (maximum - minimum)/m_numPercentileBins;
+  vector<double> localCounts(m_numPercentileBins, 0.0), globalCounts(m_numPercentileBins);
+  if(binWidth > 0.0){
+    for(std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+      if(m_blockId != -1 && blockIt->getID() != m_blockId)
+        continue;
+      if(!blockIt->hasData(m_variableFieldId, step))
+        continue;
+      double *data;
+      blockIt->getData(m_variableFieldId, step)->ExtractView(&data);
+      int numOwnedPoints = blockIt->getNeighborhoodData()->NumOwnedPoints();
+      for(int i=0 ; i<numOwnedPoints ; ++i){
+        int bin = static_cast<int>((data[m_variableLength*i + m_component] - minimum)/binWidth);
+        if(bin >= m_numPercentileBins)
+          bin = m_numPercentileBins - 1;
+        else if(bin < 0)
+          bin = 0;
+        localCounts[bin] += 1.0;
+      }
+    }
+    epetraComm()->SumAll(&localCounts[0], &globalCounts[0], m_numPercentileBins);
+  }
+
+  // Interpolate linearly within the bin that contains each percentile
+  for(unsigned int p=0 ; p<m_percentiles.size() ; ++p){
+    double value = minimum;
+    if(binWidth > 0.0){
+      double target = 0.01*m_percentiles[p]*numPoints;
+      double cumulativeCount = 0.0;
+      int bin = 0;
+      while(bin < m_numPercentileBins - 1 && cumulativeCount + globalCounts[bin] < target){
+        cumulativeCount += globalCounts[bin];
+        bin += 1;
+      }
+      double fraction = globalCounts[bin] > 0.0 ? (target - cumulativeCount)/globalCounts[bin] : 0.0;
+      if(fraction > 1.0)
+        fraction = 1.0;
+      value = minimum + (bin + fraction)*binWidth;
+    }
+    (*firstBlock.getData(m_percentileFieldIds[p], PeridigmField::STEP_NONE))[0] = value;
+  }
+
+  return 0;
+}
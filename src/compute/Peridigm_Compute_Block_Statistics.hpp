@@ -0,0 +1,127 @@
+/*! \file Peridigm_Compute_Block_Statistics.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifdef COMPUTE_CLASS
+
+ComputeClass(Block_Statistics,Compute_Block_Statistics)
+
+#else
+
+#ifndef PERIDIGM_COMPUTE_BLOCK_STATISTICS_HPP
+#define PERIDIGM_COMPUTE_BLOCK_STATISTICS_HPP
+
+#include "Peridigm_Compute.hpp"
+
+namespace PeridigmNS {
+
+  /*! \brief Class for reducing a point variable over a block to global summary statistics.
+   *
+   *  Computes the minimum, maximum, and mean of one component of the variable, optionally a set of percentiles and the
+   *  number of points above a threshold.  The results are stored in global scalar variables named after the output
+   *  label (e.g., Label_Minimum, Label_P90, Label_Count_Above).  Percentiles are interpolated from a histogram spanning
+   *  the global minimum and maximum, so each evaluation costs a fixed number of reductions regardless of problem size;
+   *  the error is bounded by the width of one histogram bin.
+   */
+  class Compute_Block_Statistics : public PeridigmNS::Compute {
+
+  public:
+
+    //! Standard constructor.
+    Compute_Block_Statistics( Teuchos::RCP<const Teuchos::ParameterList> params,
+                              Teuchos::RCP<const Epetra_Comm> epetraComm_,
+                              Teuchos::RCP<const Teuchos::ParameterList> computeClassGlobalData_);
+
+    //! Destructor.
+    ~Compute_Block_Statistics() {}
+
+    //! Returns a vector of field IDs corresponding to the variables associated with the compute class.
+    virtual std::vector<int> FieldIds() const { return m_fieldIds; }
+
+    //! Initialize the compute class
+    virtual void initialize( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks );
+
+    //! Perform computation
+    virtual int compute( Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks ) const;
+
+  private:
+
+    //! Name of variable to be reduced
+    std::string m_variable;
+    int m_variableLength;
+    int m_component;
+    bool m_variableIsStated;
+
+    //! Name and id of the block, the id is -1 if the statistics are taken over all blocks
+    std::string m_blockName;
+    int m_blockId;
+
+    //! Requested percentiles, between 0 and 100
+    std::vector<double> m_percentiles;
+
+    //! Number of histogram bins used to estimate the percentiles
+    int m_numPercentileBins;
+
+    //! Points with a value greater than the threshold are counted
+    bool m_hasThreshold;
+    double m_threshold;
+
+    //! Label for output variables
+    std::string m_outputLabel;
+
+    //! Field ids for all relevant data
+    std::vector<int> m_fieldIds;
+    int m_variableFieldId;
+    int m_minimumFieldId;
+    int m_maximumFieldId;
+    int m_meanFieldId;
+    int m_countAboveThresholdFieldId;
+    std::vector<int> m_percentileFieldIds;
+  };
+}
+
+#endif // PERIDIGM_COMPUTE_BLOCK_STATISTICS_HPP
+#endif // COMPUTE_CLASS
@@ -113,7 +113,8 @@ void PeridigmNS::Compute_Bond_Visualization::initialize( Teuchos::RCP< vector<Pe
   for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
     Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
     const int numOwnedPoints = neighborhoodData->NumOwnedPoints();
-    const int* neighborhoodList = neighborhoodData->NeighborhoodList();
+    vector<int> neighborhoodListBuffer;
+    const int* neighborhoodList = neighborhoodData->NeighborhoodList(neighborhoodListBuffer);
     Teuchos::RCP<const Epetra_BlockMap> map = blockIt->getOverlapVectorPointMap();
 
     int iID, iNID, localNeighborId, globalId, globalNeighborId, numNeighbors(0), neighborhoodListIndex(0);
@@ -46,6 +46,7 @@
 //@HEADER
 
 #include <vector>
+#include <algorithm>
 
 #include "Peridigm_Compute_Deformation_Gradient.hpp"
 #include "Peridigm_Field.hpp"
@@ -89,7 +90,7 @@ int PeridigmNS::Compute_Deformation_Gradient::compute( Teuchos::RCP< std::vector
 
     Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
     int numOwnedPoints = neighborhoodData->NumOwnedPoints();
-    int* const neighborhoodList = neighborhoodData->NeighborhoodList();
+    const int* bondOffsets = neighborhoodData->BondOffsets();
     Teuchos::RCP<PeridigmNS::DataManager> dataManager = blockIt->getDataManager();
     
     double *volume, *horizon, *modelCoordinates, *coordinates, *shapeTensorInverse, *deformationGradient;
@@ -100,14 +101,21 @@ int PeridigmNS::Compute_Deformation_Gradient::compute( Teuchos::RCP< std::vector
     dataManager->getData(m_shapeTensorInverseFId, PeridigmField::STEP_NONE)->ExtractView(&shapeTensorInverse);
     dataManager->getData(m_deformationGradientFId, PeridigmField::STEP_NONE)->ExtractView(&deformationGradient);
 
-    retval = retval || CORRESPONDENCE::computeShapeTensorInverseAndApproximateDeformationGradient(volume,
-                                                                                                  horizon,
-                                                                                                  modelCoordinates,
-                                                                                                  coordinates,
-                                                                                                  shapeTensorInverse,
-                                                                                                  deformationGradient,
-                                                                                                  neighborhoodList,
-                                                                                                  numOwnedPoints);
+    std::vector<int> neighborIndicesBuffer;
+    for(int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()){
+      int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+      const int* neighborIndices = neighborhoodData->NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+      retval = CORRESPONDENCE::computeShapeTensorInverseAndApproximateDeformationGradientCSR(volume,
+                                                                                             horizon,
+                                                                                             modelCoordinates,
+                                                                                             coordinates,
+                                                                                             shapeTensorInverse,
+                                                                                             deformationGradient,
+                                                                                             firstPoint,
+                                                                                             lastPoint,
+                                                                                             bondOffsets,
+                                                                                             neighborIndices) || retval;
+    }
   }
 
   // Warn if retval not zero
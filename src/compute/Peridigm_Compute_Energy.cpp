@@ -46,6 +46,7 @@
 //@HEADER
 
 #include <vector>
+#include <algorithm>
 
 #include "Peridigm_Compute_Energy.hpp"
 #include "Peridigm_Field.hpp"
@@ -99,7 +100,7 @@ int PeridigmNS::Compute_Energy::compute( Teuchos::RCP< std::vector<PeridigmNS::B
     Teuchos::RCP<NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
     const int numOwnedPoints = neighborhoodData->NumOwnedPoints();
     const int* ownedIDs = neighborhoodData->OwnedIDs();
-    const int* neighborhoodList = neighborhoodData->NeighborhoodList();
+    const int* bondOffsets = neighborhoodData->BondOffsets();
     volume                = blockIt->getData(m_volumeFieldId, PeridigmField::STEP_NONE);
     ref                   = blockIt->getData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE);
     coord                 = blockIt->getData(m_coordinatesFieldId, PeridigmField::STEP_NP1);
@@ -148,54 +149,59 @@ int PeridigmNS::Compute_Energy::compute( Teuchos::RCP< std::vector<PeridigmNS::B
     // Initialize local strain energy density
     double We;
 
-    int neighborhoodListIndex = 0;
-    for (int i=0;i<numElements;i++) 
-      {
-        int numNeighbors = neighborhoodList[neighborhoodListIndex++];
-        int ID = ownedIDs[i];
-        We = 0.0;
-        vol = volume_values[ID];
-        w_vol = w_volume_values[ID];
-        double v1 = velocity_values[3*ID];
-        double v2 = velocity_values[3*ID+1];
-        double v3 = velocity_values[3*ID+2];
-        for (int j=0; j<numNeighbors; j++)
-          {
-            int neighborID = neighborhoodList[neighborhoodListIndex++];
-            TEUCHOS_TEST_FOR_EXCEPT_MSG(neighborID < 0, "Invalid neighbor list\n");
-            int Ne = neighborID;
-            vol2 = volume_values[Ne];
-            double psi1 = (ref_values[3*Ne] - ref_values[3*i]);
-            double psi2 = (ref_values[3*Ne+1] - ref_values[3*i+1]);
-            double psi3 = (ref_values[3*Ne+2] - ref_values[3*i+2]);
-            double eta1 = (coord_values[3*Ne] - coord_values[3*i]);
-            double eta2 = (coord_values[3*Ne+1] - coord_values[3*i+1]);
-            double eta3 = (coord_values[3*Ne+2] - coord_values[3*i+2]);
+    std::vector<int> neighborIndicesBuffer;
+    for (int firstPoint=0;firstPoint<numElements;firstPoint+=NeighborhoodData::PointBlockSize())
+    {
+      int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numElements);
+      const int* neighborIndices = neighborhoodData->NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+      const int firstBond = bondOffsets[firstPoint];
+      for (int i=firstPoint;i<lastPoint;i++) 
+        {
+          int ID = ownedIDs[i];
+          We = 0.0;
+          vol = volume_values[ID];
+          w_vol = w_volume_values[ID];
+          double v1 = velocity_values[3*ID];
+          double v2 = velocity_values[3*ID+1];
+          double v3 = velocity_values[3*ID+2];
+          for (int bondIndex=bondOffsets[i]; bondIndex<bondOffsets[i+1]; bondIndex++)
+            {
+              int neighborID = neighborIndices[bondIndex-firstBond];
+              TEUCHOS_TEST_FOR_EXCEPT_MSG(neighborID < 0, "Invalid neighbor list\n");
+              int Ne = neighborID;
+              vol2 = volume_values[Ne];
+              double psi1 = (ref_values[3*Ne] - ref_values[3*i]);
+              double psi2 = (ref_values[3*Ne+1] - ref_values[3*i+1]);
+              double psi3 = (ref_values[3*Ne+2] - ref_values[3*i+2]);
+              double eta1 = (coord_values[3*Ne] - coord_values[3*i]);
+              double eta2 = (coord_values[3*Ne+1] - coord_values[3*i+1]);
+              double eta3 = (coord_values[3*Ne+2] - coord_values[3*i+2]);
             
-            // Compute the reference position
-            double x = sqrt(psi1*psi1 + psi2*psi2 + psi3*psi3);
+              // Compute the reference position
+              double x = sqrt(psi1*psi1 + psi2*psi2 + psi3*psi3);
             
-            // Compute the deformed position
-            double y = sqrt(eta1*eta1 + eta2*eta2 + eta3*eta3);
+              // Compute the deformed position
+              double y = sqrt(eta1*eta1 + eta2*eta2 + eta3*eta3);
             
-            // Compute the extension
-            double e = y-x;
-            // \todo Generalize for different influence functions
-            // Update the local strain energy density
-            We = We + (1.0)*(e - dilatation_values[ID]*x/3)*vol2;
-          }
-        // Update the strain energy density                
-        W = W + 0.5*BM*dilatation_values[ID]*dilatation_values[ID] + 0.5*(15.0*SM/w_vol)*We;		
-        strain_energy_density_values[i] = 0.5*BM*dilatation_values[ID]*dilatation_values[ID] + 0.5*(15.0*SM/w_vol)*We;		
+              // Compute the extension
+              double e = y-x;
+              // \todo Generalize for different influence functions
+              // Update the local strain energy density
+              We = We + (1.0)*(e - dilatation_values[ID]*x/3)*vol2;
+            }
+          // Update the strain energy density                
+          W = W + 0.5*BM*dilatation_values[ID]*dilatation_values[ID] + 0.5*(15.0*SM/w_vol)*We;		
+          strain_energy_density_values[i] = 0.5*BM*dilatation_values[ID]*dilatation_values[ID] + 0.5*(15.0*SM/w_vol)*We;		
 		
-        // Update the strain energy
-        strain_energy_values[i] = vol*strain_energy_density_values[i];
-        SE = SE + strain_energy_values[i];
-        // Update the global kinetic energy
-        KE = KE + 0.5*vol*density*(v1*v1 + v2*v2 + v3*v3);
-        kinetic_energy_values[i] = 0.5*vol*density*(v1*v1 + v2*v2 + v3*v3);	
-      }
-    
+          // Update the strain energy
+          strain_energy_values[i] = vol*strain_energy_density_values[i];
+          SE = SE + strain_energy_values[i];
+          // Update the global kinetic energy
+          KE = KE + 0.5*vol*density*(v1*v1 + v2*v2 + v3*v3);
+          kinetic_energy_values[i] = 0.5*vol*density*(v1*v1 + v2*v2 + v3*v3);	
+        }
+    }
+
     // Update info across processors
     double localKE, localSE, globalBlockKE, globalBlockSE;
     localKE = KE;
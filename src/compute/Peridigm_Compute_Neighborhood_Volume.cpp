@@ -46,6 +46,7 @@
 //@HEADER
 
 #include <vector>
+#include <algorithm>
 
 #include "Peridigm_Compute_Neighborhood_Volume.hpp"
 #include "Peridigm_Field.hpp"
@@ -71,7 +72,6 @@ void PeridigmNS::Compute_Neighborhood_Volume::initialize( Teuchos::RCP< std::vec
   for(std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
     Teuchos::RCP<NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
     const int numOwnedPoints = neighborhoodData->NumOwnedPoints();
-    const int* neighborhoodList = neighborhoodData->NeighborhoodList();
     double *volume, *neighborhoodVolume;
     blockIt->getData(m_volumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&volume);
     blockIt->getData(m_neighborhoodVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&neighborhoodVolume);
@@ -85,23 +85,26 @@ void PeridigmNS::Compute_Neighborhood_Volume::initialize( Teuchos::RCP< std::vec
       }
     }
 
-    int neighborhoodListIndex = 0;
-    int bondIndex = 0;
-    for(int iID=0 ; iID<numOwnedPoints ; ++iID){
+    const int* bondOffsets = neighborhoodData->BondOffsets();
+    std::vector<int> neighborIndicesBuffer;
+    for(int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()){
+      int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+      const int* neighborIndices = neighborhoodData->NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+      const int firstBond = bondOffsets[firstPoint];
+      for(int iID=firstPoint ; iID<lastPoint ; ++iID){
 
-      // Assume that the cell's own volume is within its neighborhood
-      neighborhoodVolume[iID] = volume[iID];
+        // Assume that the cell's own volume is within its neighborhood
+        neighborhoodVolume[iID] = volume[iID];
 
-      // Sum in the contributions for the neighbors
-      int numNeighbors = neighborhoodList[neighborhoodListIndex++];
-      for(int iNID=0 ; iNID<numNeighbors ; ++iNID){
-        int neighborID = neighborhoodList[neighborhoodListIndex++];
-        double vol(0.0);
-        if(neighborVolume == 0)
-          vol = volume[neighborID];
-        else
-          vol = neighborVolume[bondIndex++];
-        neighborhoodVolume[iID] += vol;
+        // Sum in the contributions for the neighbors
+        for(int bondIndex=bondOffsets[iID] ; bondIndex<bondOffsets[iID+1] ; ++bondIndex){
+          double vol(0.0);
+          if(neighborVolume == 0)
+            vol = volume[neighborIndices[bondIndex-firstBond]];
+          else
+            vol = neighborVolume[bondIndex];
+          neighborhoodVolume[iID] += vol;
+        }
       }
     }
   }
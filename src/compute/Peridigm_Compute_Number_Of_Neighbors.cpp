@@ -68,16 +68,12 @@ void PeridigmNS::Compute_Number_Of_Neighbors::initialize( Teuchos::RCP< std::vec
   for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
     Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
     const int numOwnedPoints = neighborhoodData->NumOwnedPoints();
-    const int* neighborhoodList = neighborhoodData->NeighborhoodList();
     double *numberOfNeighbors;
     blockIt->getData(m_numberOfNeighborsFieldId, PeridigmField::STEP_NONE)->ExtractView(&numberOfNeighbors);
 
-    int neighborhoodListIndex = 0;
-    for(int iID=0 ; iID<numOwnedPoints ; ++iID){
-      int numNeighbors = neighborhoodList[neighborhoodListIndex++];
-      numberOfNeighbors[iID] = numNeighbors;
-      neighborhoodListIndex += numNeighbors;
-    }
+    const int* bondOffsets = neighborhoodData->BondOffsets();
+    for(int iID=0 ; iID<numOwnedPoints ; ++iID)
+      numberOfNeighbors[iID] = bondOffsets[iID+1] - bondOffsets[iID];
   }
 }
 
@@ -83,7 +83,8 @@ int PeridigmNS::Compute_Stored_Elastic_Energy::compute( Teuchos::RCP< std::vecto
     dataManager = blockIt->getDataManager();
     int numOwnedPoints = neighborhoodData->NumOwnedPoints();
     int* const ownedIDs = neighborhoodData->OwnedIDs();
-    int* const neighborhoodList = neighborhoodData->NeighborhoodList();
+    std::vector<int> neighborhoodListBuffer;
+    const int* neighborhoodList = neighborhoodData->NeighborhoodList(neighborhoodListBuffer);
 
     // The stored elastic energy density is computed by the material model
     materialModel->computeStoredElasticEnergyDensity(0.0, numOwnedPoints, ownedIDs, neighborhoodList, *dataManager);
@@ -0,0 +1,260 @@
+/*! \file utPeridigm_Compute_Block_Statistics.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Peridigm_Discretization.hpp>
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include <fstream>
+#include <vector>
+#include "Peridigm.hpp"
+#include "Peridigm_Field.hpp"
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+
+//! Five points along the x axis; the first four are in block_1 and the last one is in block_2.
+Teuchos::RCP<Peridigm> createTwoBlockModel(Teuchos::RCP<Epetra_Comm> comm) {
+
+  // write the discretization on processor 0
+  std::string meshFileName("utPeridigm_Compute_Block_Statistics.txt");
+  if(comm->MyPID() == 0){
+    std::ofstream meshFile(meshFileName.c_str());
+    meshFile << "# x y z block_id volume" << std::endl;
+    for(int i=0 ; i<5 ; ++i)
+      meshFile << i << " 0.0 0.0 " << (i < 4 ? 1 : 2) << " 1.0" << std::endl;
+  }
+  comm->Barrier();
+
+  Teuchos::RCP<Teuchos::ParameterList> peridigmParams = rcp(new Teuchos::ParameterList());
+
+  // material parameters
+  Teuchos::ParameterList& materialParams = peridigmParams->sublist("Materials");
+  Teuchos::ParameterList& linearElasticMaterialParams = materialParams.sublist("My Elastic Material");
+  linearElasticMaterialParams.set("Material Model", "Elastic");
+  linearElasticMaterialParams.set("Density", 7800.0);
+  linearElasticMaterialParams.set("Bulk Modulus", 130.0e9);
+  linearElasticMaterialParams.set("Shear Modulus", 78.0e9);
+
+  // blocks
+  Teuchos::ParameterList& blockParams = peridigmParams->sublist("Blocks");
+  Teuchos::ParameterList& blockOneParams = blockParams.sublist("My First Block");
+  blockOneParams.set("Block Names", "block_1");
+  blockOneParams.set("Material", "My Elastic Material");
+  blockOneParams.set("Horizon", 1.1);
+  Teuchos::ParameterList& blockTwoParams = blockParams.sublist("My Second Block");
+  blockTwoParams.set("Block Names", "block_2");
+  blockTwoParams.set("Material", "My Elastic Material");
+  blockTwoParams.set("Horizon", 1.1);
+
+  // discretization
+  Teuchos::ParameterList& discretizationParams = peridigmParams->sublist("Discretization");
+  discretizationParams.set("Type", "Text File");
+  discretizationParams.set("Input Mesh File", meshFileName);
+
+  // compute classes
+  Teuchos::ParameterList& computeParams = peridigmParams->sublist("Compute Class Parameters");
+
+  Teuchos::ParameterList& allStatisticsParams = computeParams.sublist("All Statistics");
+  allStatisticsParams.set("Compute Class", "Block_Statistics");
+  allStatisticsParams.set("Variable", "Velocity");
+  allStatisticsParams.set("Component", 0);
+  allStatisticsParams.set("Output Label", "All_Velocity_X");
+  allStatisticsParams.set("Percentiles", "50 100");
+  allStatisticsParams.set("Percentile Bins", 4);
+  allStatisticsParams.set("Threshold", 2.5);
+
+  Teuchos::ParameterList& blockOneStatisticsParams = computeParams.sublist("Block One Statistics");
+  blockOneStatisticsParams.set("Compute Class", "Block_Statistics");
+  blockOneStatisticsParams.set("Block", "block_1");
+  blockOneStatisticsParams.set("Variable", "Velocity");
+  blockOneStatisticsParams.set("Output Label", "Block_1_Velocity_X");
+
+  Teuchos::ParameterList& blockTwoStatisticsParams = computeParams.sublist("Block Two Statistics");
+  blockTwoStatisticsParams.set("Compute Class", "Block_Statistics");
+  blockTwoStatisticsParams.set("Block", "block_2");
+  blockTwoStatisticsParams.set("Variable", "Velocity");
+  blockTwoStatisticsParams.set("Output Label", "Block_2_Velocity_X");
+  blockTwoStatisticsParams.set("Percentiles", "50");
+  blockTwoStatisticsParams.set("Threshold", 2.5);
+
+  Teuchos::ParameterList& allHistogramParams = computeParams.sublist("All Histogram");
+  allHistogramParams.set("Compute Class", "Block_Histogram");
+  allHistogramParams.set("Variable", "Velocity");
+  allHistogramParams.set("Output Label", "All_Velocity_X_Histogram");
+  allHistogramParams.set("Bin Edges", "0.5 1.5 3.5");
+
+  Teuchos::ParameterList& uniformHistogramParams = computeParams.sublist("Uniform Histogram");
+  uniformHistogramParams.set("Compute Class", "Block_Histogram");
+  uniformHistogramParams.set("Variable", "Velocity");
+  uniformHistogramParams.set("Output Label", "Uniform_Velocity_X_Histogram");
+  uniformHistogramParams.set("Minimum", 0.0);
+  uniformHistogramParams.set("Maximum", 4.0);
+  uniformHistogramParams.set("Number Of Bins", 2);
+
+  Teuchos::ParameterList& blockTwoHistogramParams = computeParams.sublist("Block Two Histogram");
+  blockTwoHistogramParams.set("Compute Class", "Block_Histogram");
+  blockTwoHistogramParams.set("Block", "block_2");
+  blockTwoHistogramParams.set("Variable", "Velocity");
+  blockTwoHistogramParams.set("Output Label", "Block_2_Velocity_X_Histogram");
+  blockTwoHistogramParams.set("Bin Edges", "0.0 2.0 4.0");
+  blockTwoHistogramParams.set("Normalize", true);
+
+  Teuchos::RCP<Discretization> nullDiscretization;
+  Teuchos::RCP<Peridigm> peridigm = Teuchos::rcp(new Peridigm(MPI_COMM_WORLD, peridigmParams, nullDiscretization));
+
+  return peridigm;
+}
+
+//! Returns the value of a global field, which the compute classes store in the first block.
+double globalValue(Teuchos::RCP< std::vector<Block> > blocks, std::string name) {
+  FieldManager& fieldManager = FieldManager::self();
+  return (*blocks->begin()->getData(fieldManager.getFieldId(name), PeridigmField::STEP_NONE))[0];
+}
+
+TEUCHOS_UNIT_TEST(Compute_Block_Statistics, TwoBlockTest)
+{
+  Teuchos::RCP<Epetra_Comm> comm;
+  #ifdef HAVE_MPI
+    comm = Teuchos::rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  #else
+    comm = Teuchos::rcp(new Epetra_SerialComm);
+  #endif
+
+  int numProcs = comm->NumProc();
+
+  TEST_COMPARE(numProcs, <=, 4);
+  if(numProcs > 4){
+    std::cerr << "Unit test runtime ERROR: utPeridigm_Compute_Block_Statistics only makes sense on 1 to 4 processors." << std::endl;
+    return;
+  }
+
+  Teuchos::RCP<Peridigm> peridigm = createTwoBlockModel(comm);
+  Teuchos::RCP< std::vector<Block> > blocks = peridigm->getBlocks();
+  TEST_EQUALITY((int)blocks->size(), 2);
+
+  // Manufacture velocity data, the x component is the global id
+  // With more than one processor, block_2 has no points on all but one of them
+  FieldManager& fieldManager = FieldManager::self();
+  int velocityFieldId = fieldManager.getFieldId("Velocity");
+  int numOwnedBlockTwoPoints = 0;
+  for(std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+    Teuchos::RCP<Epetra_Vector> velocity = blockIt->getData(velocityFieldId, PeridigmField::STEP_NP1);
+    double* velocityValues = velocity->Values();
+    int* myGIDs = velocity->Map().MyGlobalElements();
+    for(int i=0 ; i<velocity->Map().NumMyElements() ; ++i){
+      velocityValues[3*i] = myGIDs[i];
+      velocityValues[3*i+1] = -1.0;
+      velocityValues[3*i+2] = -1.0;
+    }
+    if(blockIt->getName() == "block_2")
+      numOwnedBlockTwoPoints = blockIt->getNeighborhoodData()->NumOwnedPoints();
+  }
+  int numGlobalBlockTwoPoints;
+  comm->SumAll(&numOwnedBlockTwoPoints, &numGlobalBlockTwoPoints, 1);
+  TEST_EQUALITY(numGlobalBlockTwoPoints, 1);
+
+  peridigm->getComputeManager()->compute(blocks);
+
+  // Values 0, 1, 2, 3, 4 over all blocks
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_Minimum"), 0.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_Maximum"), 4.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_Mean"), 2.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_Count_Above"), 2.0, 1.0e-15);
+  // Four bins of unit width hold 1, 1, 1, and 2 points; the percentiles interpolate within a bin
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_P50"), 2.5, 1.0e-14);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_P100"), 4.0, 1.0e-14);
+
+  // Values 0, 1, 2, 3 in block_1
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "Block_1_Velocity_X_Minimum"), 0.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "Block_1_Velocity_X_Maximum"), 3.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "Block_1_Velocity_X_Mean"), 1.5, 1.0e-15);
+
+  // The single value 4 in block_2
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "Block_2_Velocity_X_Minimum"), 4.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "Block_2_Velocity_X_Maximum"), 4.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "Block_2_Velocity_X_Mean"), 4.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "Block_2_Velocity_X_P50"), 4.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "Block_2_Velocity_X_Count_Above"), 1.0, 1.0e-15);
+
+  // Bin edges 0.5, 1.5, 3.5
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_Histogram_Bin_1"), 1.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_Histogram_Bin_2"), 2.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_Histogram_Underflow"), 1.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_Histogram_Overflow"), 1.0, 1.0e-15);
+
+  // Two uniform bins on [0, 4], the maximum value is counted in the last bin
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "Uniform_Velocity_X_Histogram_Bin_1"), 2.0, 1.0e-15);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "Uniform_Velocity_X_Histogram_Bin_2"), 3.0, 1.0e-15);
+  TEST_EQUALITY(globalValue(blocks, "Uniform_Velocity_X_Histogram_Underflow"), 0.0);
+  TEST_EQUALITY(globalValue(blocks, "Uniform_Velocity_X_Histogram_Overflow"), 0.0);
+
+  // Normalized histogram of block_2
+  TEST_EQUALITY(globalValue(blocks, "Block_2_Velocity_X_Histogram_Bin_1"), 0.0);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "Block_2_Velocity_X_Histogram_Bin_2"), 1.0, 1.0e-15);
+  TEST_EQUALITY(globalValue(blocks, "Block_2_Velocity_X_Histogram_Underflow"), 0.0);
+  TEST_EQUALITY(globalValue(blocks, "Block_2_Velocity_X_Histogram_Overflow"), 0.0);
+
+  // All values below the histogram range
+  for(std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+    Teuchos::RCP<Epetra_Vector> velocity = blockIt->getData(velocityFieldId, PeridigmField::STEP_NP1);
+    velocity->PutScalar(-10.0);
+  }
+  peridigm->getComputeManager()->compute(blocks);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_Minimum"), -10.0, 1.0e-15);
+  TEST_EQUALITY(globalValue(blocks, "All_Velocity_X_Count_Above"), 0.0);
+  TEST_FLOATING_EQUALITY(globalValue(blocks, "All_Velocity_X_Histogram_Underflow"), 5.0, 1.0e-15);
+  TEST_EQUALITY(globalValue(blocks, "All_Velocity_X_Histogram_Bin_1"), 0.0);
+  TEST_EQUALITY(globalValue(blocks, "All_Velocity_X_Histogram_Bin_2"), 0.0);
+}
+
+int main (int argc, char* argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
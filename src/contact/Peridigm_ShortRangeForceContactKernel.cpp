@@ -0,0 +1,222 @@
+//! \file Peridigm_ShortRangeForceContactKernel.cpp
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_ShortRangeForceContactKernel.hpp"
+#include <Teuchos_Assert.hpp>
+#include <vector>
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+  //! Number of pairs processed together; the per-batch scratch arrays are sized by this value.
+  const int pairBatchSize = 64;
+
+}
+
+void PeridigmNS::computeShortRangeContactForce(const double springCoefficient,
+                                               const double contactRadius,
+                                               const double horizon,
+                                               const double frictionCoefficient,
+                                               const int numOwnedPoints,
+                                               const int* ownedIDs,
+                                               const int* contactNeighborhoodList,
+                                               const int numPoints,
+                                               const double* cellVolume,
+                                               const double* y,
+                                               const double* velocity,
+                                               double* contactForce)
+{
+  const double contactRadiusSquared = contactRadius*contactRadius;
+  const double forceScale = springCoefficient/horizon;
+
+  // Flatten the neighbor list into a list of pairs
+  int numPairs(0), neighborhoodListIndex(0);
+  for(int iID=0 ; iID<numOwnedPoints ; ++iID){
+    int numNeighbors = contactNeighborhoodList[neighborhoodListIndex];
+    numPairs += numNeighbors;
+    neighborhoodListIndex += numNeighbors + 1;
+  }
+  if(numPairs == 0)
+    return;
+  std::vector<int> pairNode(numPairs), pairNeighbor(numPairs);
+  int pairIndex(0);
+  neighborhoodListIndex = 0;
+  for(int iID=0 ; iID<numOwnedPoints ; ++iID){
+    int numNeighbors = contactNeighborhoodList[neighborhoodListIndex++];
+    for(int iNID=0 ; iNID<numNeighbors ; ++iNID){
+      int neighborID = contactNeighborhoodList[neighborhoodListIndex++];
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(neighborID < 0, "Invalid neighbor list\n");
+      pairNode[pairIndex] = ownedIDs[iID];
+      pairNeighbor[pairIndex] = neighborID;
+      pairIndex++;
+    }
+  }
+
+  // Structure-of-arrays copies of the positions, and of the velocities if they are needed for friction
+  const bool friction = (frictionCoefficient != 0.0);
+  std::vector<double> yX(numPoints), yY(numPoints), yZ(numPoints);
+  std::vector<double> vX, vY, vZ;
+  for(int i=0 ; i<numPoints ; ++i){
+    yX[i] = y[3*i];
+    yY[i] = y[3*i+1];
+    yZ[i] = y[3*i+2];
+  }
+  if(friction){
+    vX.resize(numPoints);
+    vY.resize(numPoints);
+    vZ.resize(numPoints);
+    for(int i=0 ; i<numPoints ; ++i){
+      vX[i] = velocity[3*i];
+      vY[i] = velocity[3*i+1];
+      vZ[i] = velocity[3*i+2];
+    }
+  }
+
+  int numThreads(1);
+#ifdef _OPENMP
+  numThreads = omp_get_max_threads();
+#endif
+  // Thread 0 accumulates directly into contactForce, the other threads into their own arrays
+  std::vector<double> threadForce(numThreads > 1 ? static_cast<size_t>(numThreads-1)*3*numPoints : 0, 0.0);
+  const int numBatches = (numPairs + pairBatchSize - 1)/pairBatchSize;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(numThreads)
+#endif
+  {
+    int thread(0);
+#ifdef _OPENMP
+    thread = omp_get_thread_num();
+#endif
+    double* force = (thread == 0) ? contactForce : &threadForce[static_cast<size_t>(thread-1)*3*numPoints];
+
+    double dX[pairBatchSize], dY[pairBatchSize], dZ[pairBatchSize], magnitude[pairBatchSize];
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for(int batch=0 ; batch<numBatches ; ++batch){
+      const int first = batch*pairBatchSize;
+      const int numBatchPairs = (first + pairBatchSize <= numPairs) ? pairBatchSize : numPairs - first;
+      const int* node = &pairNode[first];
+      const int* neighbor = &pairNeighbor[first];
+
+      // Relative positions and force magnitude per unit volume and unit distance; zero for pairs outside the contact radius
+      for(int k=0 ; k<numBatchPairs ; ++k){
+        dX[k] = yX[neighbor[k]] - yX[node[k]];
+        dY[k] = yY[neighbor[k]] - yY[node[k]];
+        dZ[k] = yZ[neighbor[k]] - yZ[node[k]];
+      }
+      for(int k=0 ; k<numBatchPairs ; ++k){
+        double distanceSquared = dX[k]*dX[k] + dY[k]*dY[k] + dZ[k]*dZ[k];
+        double distance = std::sqrt(distanceSquared);
+        magnitude[k] = (distanceSquared < contactRadiusSquared) ? forceScale*(contactRadius - distance)/distance : 0.0;
+      }
+
+      if(!friction){
+        for(int k=0 ; k<numBatchPairs ; ++k){
+          if(magnitude[k] == 0.0)
+            continue;
+          const int i = node[k];
+          const int j = neighbor[k];
+          const double nodeScale = magnitude[k]*cellVolume[j];
+          const double neighborScale = magnitude[k]*cellVolume[i];
+          force[3*i]   -= nodeScale*dX[k];
+          force[3*i+1] -= nodeScale*dY[k];
+          force[3*i+2] -= nodeScale*dZ[k];
+          force[3*j]   += neighborScale*dX[k];
+          force[3*j+1] += neighborScale*dY[k];
+          force[3*j+2] += neighborScale*dZ[k];
+        }
+      }
+      else{
+        for(int k=0 ; k<numBatchPairs ; ++k){
+          if(magnitude[k] == 0.0)
+            continue;
+          const int i = node[k];
+          const int j = neighbor[k];
+          const double distance = std::sqrt(dX[k]*dX[k] + dY[k]*dY[k] + dZ[k]*dZ[k]);
+          const double normal[3] = {dX[k]/distance, dY[k]/distance, dZ[k]/distance};
+
+          // Relative tangential velocity of the node with respect to the pair's center of mass; the neighbor's is its negative
+          const double nodeDotNormal = vX[i]*normal[0] + vY[i]*normal[1] + vZ[i]*normal[2];
+          const double neighborDotNormal = vX[j]*normal[0] + vY[j]*normal[1] + vZ[j]*normal[2];
+          const double vRel[3] = {0.5*((vX[i] - nodeDotNormal*normal[0]) - (vX[j] - neighborDotNormal*normal[0])),
+                                  0.5*((vY[i] - nodeDotNormal*normal[1]) - (vY[j] - neighborDotNormal*normal[1])),
+                                  0.5*((vZ[i] - nodeDotNormal*normal[2]) - (vZ[j] - neighborDotNormal*normal[2]))};
+          const double normVRel = std::sqrt(vRel[0]*vRel[0] + vRel[1]*vRel[1] + vRel[2]*vRel[2]);
+
+          // Normal force magnitudes, and the friction forces that oppose the relative tangential velocities
+          const double nodeNormalForce = magnitude[k]*cellVolume[j]*distance;
+          const double neighborNormalForce = magnitude[k]*cellVolume[i]*distance;
+          const double nodeFrictionScale = (normVRel != 0.0) ? frictionCoefficient*nodeNormalForce/normVRel : 0.0;
+          const double neighborFrictionScale = (normVRel != 0.0) ? frictionCoefficient*neighborNormalForce/normVRel : 0.0;
+
+          for(int dof=0 ; dof<3 ; ++dof){
+            force[3*i+dof] += -nodeNormalForce*normal[dof] - nodeFrictionScale*vRel[dof];
+            force[3*j+dof] +=  neighborNormalForce*normal[dof] + neighborFrictionScale*vRel[dof];
+          }
+        }
+      }
+    }
+  }
+
+  // Sum the per-thread contributions
+  if(numThreads > 1){
+    const int length = 3*numPoints;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(numThreads)
+#endif
+    for(int i=0 ; i<length ; ++i){
+      for(int thread=1 ; thread<numThreads ; ++thread)
+        contactForce[i] += threadForce[static_cast<size_t>(thread-1)*length + i];
+    }
+  }
+}
@@ -64,6 +64,8 @@
 #include "Peridigm_InfluenceFunction.hpp"
 #include "Peridigm_DiscretizationFactory.hpp"
 #include "Peridigm_OutputManager_ExodusII.hpp"
+#include "Peridigm_OutputManager_Probe.hpp"
+#include "Peridigm_OutputManager_BondFamily.hpp"
 #include "Peridigm_ComputeManager.hpp"
 #include "Peridigm_ContactModelFactory.hpp"
 #include "Peridigm_BoundaryAndInitialConditionManager.hpp"
@@ -78,6 +80,7 @@
 #include "Peridigm.hpp"
 #include "correspondence.h" // For Invert3by3Matrix
 #include "Peridigm_DataManager.hpp" //For readBlocktoDisk & writeBlocktoDisk
+#include "Peridigm_BinaryRestart.hpp"
 #ifdef PERIDIGM_PV
   #include "Peridigm_PartialVolumeCalculator.hpp"
 #endif
@@ -97,6 +100,10 @@
 #include "EpetraExt_VectorIn.h"
 #include "EpetraExt_VectorOut.h"
 #include <sys/stat.h>
+#include <climits>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 
@@ -176,6 +183,17 @@ PeridigmNS::Peridigm::Peridigm(const MPI_Comm& comm,
     numMultiphysDoFs = 0;
  }
 
+  // Number of OpenMP threads used by the threaded kernels on each processor
+  // Defaults to one so that runs with one MPI rank per core do not oversubscribe
+  int numThreads = peridigmParams->get<int>("Number of Threads", 1);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(numThreads < 1, "\n**** Error, \"Number of Threads\" must be greater than zero.\n");
+#ifdef _OPENMP
+  omp_set_num_threads(numThreads);
+#else
+  if(numThreads > 1 && peridigmComm->MyPID() == 0)
+    cout << "\n**** Warning:  \"Number of Threads\" is ignored, Peridigm was built without OpenMP (USE_OPENMP).\n" << endl;
+#endif
+
   // Initialize the influence function
   string influenceFunctionString = peridigmParams->sublist("Discretization").get<string>("Influence Function", "One");
   PeridigmNS::InfluenceFunction::self().setInfluenceFunction( influenceFunctionString );
@@ -295,6 +313,15 @@ PeridigmNS::Peridigm::Peridigm(const MPI_Comm& comm,
   // Create field ids that may be required for output
   fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Proc_Num");
 
+  // Create the field id for tracking bonds that are compacted out of the neighborhood lists
+  // The damage models query for this field to include compacted (fully broken) bonds in the damage calculation
+  for(unsigned int i=0 ; i<solverParameters.size() ; ++i){
+    if(solverParameters[i]->isSublist("Verlet") && solverParameters[i]->sublist("Verlet").isParameter("Bond Compaction Threshold")){
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(peridigmParams->isParameter("Restart"), "\n**** Error, \"Bond Compaction Threshold\" is not compatible with restart.\n");
+      fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Number_Of_Compacted_Bonds");
+    }
+  }
+
   // Instantiate the contact manager
   Teuchos::ParameterList contactParams;
   if(peridigmParams->isSublist("Contact")){
@@ -481,6 +508,37 @@ PeridigmNS::Peridigm::Peridigm(const MPI_Comm& comm,
                         blockIDs,
                         globalNeighborhoodData);
 
+  // Optionally store the block neighbor lists in compressed form
+  bool compressNeighborLists = discParams->get<bool>("Compress Neighbor Lists", false);
+  if(compressNeighborLists){
+    // Heap checkpoints before and after compression give the memory comparison in the Memstat report
+    memstat->addStat("Neighbor Lists Plain");
+    double localMemory[3] = {0.0, 0.0, 0.0};
+    for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+      Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
+      localMemory[0] += neighborhoodData->memorySize();
+      blockIt->compressNeighborhoodData();
+      localMemory[1] += neighborhoodData->memorySize();
+      localMemory[2] += neighborhoodData->neighborIndicesMemorySize();
+    }
+    double globalMemory[3];
+    peridigmComm->SumAll(localMemory, globalMemory, 3);
+    // Bond counts are summed as doubles, the global count can exceed the range of an int
+    double localNumBonds(0.0), globalNumBonds(0.0);
+    for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
+      localNumBonds += static_cast<double>(blockIt->getNeighborhoodData()->NumBonds());
+    peridigmComm->SumAll(&localNumBonds, &globalNumBonds, 1);
+    if(peridigmComm->MyPID() == 0){
+      cout << "Neighbor list compression:" << endl;
+      cout << "  Neighborhood data, plain (MB)       " << globalMemory[0] << endl;
+      cout << "  Neighborhood data, compressed (MB)  " << globalMemory[1] << endl;
+      if(globalNumBonds > 0)
+        cout << "  Bytes per neighbor index            " << globalMemory[2]*1048576.0/globalNumBonds << "\n" << endl;
+    }
+    const std::string statTag = "Neighbor Lists Compressed";
+    memstat->addStat(statTag);
+  }
+
   // Create a temporary vector for storing the global element ids
   Epetra_Vector elementIds(*(peridigmDiscretization->getCellVolume()));
   for(int i=0 ; i<elementIds.MyLength() ; ++i)
@@ -727,7 +785,12 @@ PeridigmNS::Peridigm::Peridigm(const MPI_Comm& comm,
       jacobianType = PeridigmNS::Material::BLOCK_DIAGONAL;
   }
   //Initialize restart if requested in the input file
+  binaryRestart = false;
   if(peridigmParams->isParameter("Restart")){
+    string restartFormat = peridigmParams->get<string>("Restart Format", "MatrixMarket");
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(restartFormat != "MatrixMarket" && restartFormat != "Binary",
+                                "\n**** Error, \"Restart Format\" must be \"MatrixMarket\" or \"Binary\".\n");
+    binaryRestart = (restartFormat == "Binary");
 	 InitializeRestart();
   }
 }
@@ -1014,6 +1077,10 @@ restartFiles["deltaU"] = pathname;
 //scratch restart file
 sprintf(pathname,"%s/scratch.mat",restart_directory_namePtr);
 restartFiles["scratch"] = pathname;
+
+//binary restart file, one per processor
+sprintf(pathname,"%s/restart.%d.%d.bin",restart_directory_namePtr,peridigmComm->NumProc(),peridigmComm->MyPID());
+restartFiles["binary"] = pathname;
 }
 void PeridigmNS::Peridigm::instantiateComputeManager(Teuchos::RCP<Discretization> peridigmDiscretization) {
 
@@ -1188,11 +1255,15 @@ void PeridigmNS::Peridigm::initializeOutputManager() {
       outputParams->set("MyPID", (int)(peridigmComm->MyPID()));
       // Make the default format "ExodusII"
       string outputFormat = outputParams->get("Output File Type", "ExodusII");
-      TEUCHOS_TEST_FOR_EXCEPTION( outputFormat != "ExodusII",
+      TEUCHOS_TEST_FOR_EXCEPTION( outputFormat != "ExodusII" && outputFormat != "Probe" && outputFormat != "Bond Family",
                                   std::invalid_argument,
-                                  "PeridigmNS::Peridigm: \"Output File Type\" must be \"ExodusII\".");
+                                  "PeridigmNS::Peridigm: \"Output File Type\" must be \"ExodusII\", \"Probe\", or \"Bond Family\".");
       if (outputFormat == "ExodusII")
         outputManager->add( Teuchos::rcp(new PeridigmNS::OutputManager_ExodusII( outputParams, this, blocks ) ) );
+      else if (outputFormat == "Probe")
+        outputManager->add( Teuchos::rcp(new PeridigmNS::OutputManager_Probe( outputParams, this, blocks ) ) );
+      else if (outputFormat == "Bond Family")
+        outputManager->add( Teuchos::rcp(new PeridigmNS::OutputManager_BondFamily( outputParams, this, blocks ) ) );
     }
   }
 }
@@ -1221,6 +1292,7 @@ void PeridigmNS::Peridigm::execute(Teuchos::RCP<Teuchos::ParameterList> solverPa
 void PeridigmNS::Peridigm::executeSolvers() {
   for(unsigned int i=0 ; i<solverParameters.size() ; ++i){
     execute(solverParameters[i]);
+    outputManager->flush();
     if(peridigmParams->isParameter("Restart")){
     	writeRestart(solverParameters[i]);
     }
@@ -1253,22 +1325,24 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
     safetyFactor = verletParams->get<double>("Safety Factor");
     dt *= safetyFactor;
   }
+  // Compaction of fully broken bonds out of the neighborhood lists, if requested
+  // Compacted bonds no longer appear in any per-bond quantity, so Number_Of_Neighbors, Neighborhood_Volume, and bond family
+  // output reflect only the remaining bonds; the damage models account for them through Number_Of_Compacted_Bonds
+  bool compactBrokenBonds = verletParams->isParameter("Bond Compaction Threshold");
+  double bondCompactionThreshold = 1.0;
+  int bondCompactionFrequency = 100;
+  if(compactBrokenBonds){
+    bondCompactionThreshold = verletParams->get<double>("Bond Compaction Threshold");
+    if(verletParams->isParameter("Bond Compaction Frequency"))
+      bondCompactionFrequency = verletParams->get<int>("Bond Compaction Frequency");
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(bondCompactionFrequency < 1, "\n**** Error, \"Bond Compaction Frequency\" must be greater than zero.\n");
+  }
   double timeInitial = solverParams->get("Initial Time", 0.0);
   double timeFinal   = solverParams->get("Final Time", 1.0);
   double timeCurrent = timeInitial;
   workset->timeStep = dt;
   double dt2 = dt/2.0;
-  int nsteps = static_cast<int>( floor((timeFinal-timeInitial)/dt) );
-
-  // Check to make sure the number of time steps is sane
-  if(floor((timeFinal-timeInitial)/dt) > static_cast<double>(INT_MAX)){
-    if(peridigmComm->MyPID() == 0){
-      cout << "WARNING:  The number of time steps exceed the maximum allowable value for an integer." << endl;
-      cout << "          The number of steps will be reduced to " << INT_MAX << "." << endl;
-      cout << "          Any chance you botched the units in your input deck?\n" << endl;
-    }
-    nsteps = INT_MAX;
-  }
+  long long nsteps = static_cast<long long>( floor((timeFinal-timeInitial)/dt) );
 
   // Write time step information to stdout
   if(peridigmComm->MyPID() == 0){
@@ -1352,7 +1426,7 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
   outputManager->write(blocks, timeCurrent);
   PeridigmNS::Timer::self().stopTimer("Output");
 
-  int displayTrigger = nsteps/100;
+  long long displayTrigger = nsteps/100;
   if(displayTrigger == 0)
     displayTrigger = 1;
 
@@ -1364,7 +1438,17 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
   double currentValue = 0.0;
   double previousValue = 0.0;
 
-  for(int step=1; step<=nsteps; step++){
+  // Damage is passed to the contact manager only if it is used to select the points that are searched for contact
+  Teuchos::RCP<Epetra_Vector> contactDamage;
+  int damageFieldId = -1;
+  if(analysisHasContact && contactManager->requiresDamage()){
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(!PeridigmNS::FieldManager::self().hasField("Damage"),
+                                "\n**** Error:  Contact parameter \"Surface Damage Threshold\" requires a damage model.\n");
+    damageFieldId = PeridigmNS::FieldManager::self().getFieldId("Damage");
+    contactDamage = Teuchos::rcp(new Epetra_Vector(*oneDimensionalMap));
+  }
+
+  for(long long step=1; step<=nsteps; step++){
 
     double timePrevious = timeCurrent;
     timeCurrent = timeInitial + (step*dt);
@@ -1388,8 +1472,24 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
     // rebalance, if requested
     PeridigmNS::Timer::self().startTimer("Rebalance");
     // \todo Should we load updated information first?  If so, only do this if we're really going to rebalance.
-    if(analysisHasContact)
+    if(analysisHasContact){
+      if(!contactDamage.is_null()){
+        // Only the owned values are current, and each point is owned by one block, so they are inserted directly;
+        // an export would also bring in the ghosted copies
+        contactDamage->PutScalar(0.0);
+        for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+          if(!blockIt->hasData(damageFieldId, PeridigmField::STEP_N))
+            continue;
+          double* blockDamage;
+          blockIt->getData(damageFieldId, PeridigmField::STEP_N)->ExtractView(&blockDamage);
+          Teuchos::RCP<const Epetra_BlockMap> ownedMap = blockIt->getOwnedScalarPointMap();
+          for(int i=0 ; i<ownedMap->NumMyElements() ; ++i)
+            (*contactDamage)[oneDimensionalMap->LID(ownedMap->GID(i))] = blockDamage[i];
+        }
+        contactManager->importDamage(contactDamage);
+      }
       contactManager->rebalance(step);
+    }
     PeridigmNS::Timer::self().stopTimer("Rebalance");
 
     // Do one step of velocity-Verlet
@@ -1492,6 +1592,14 @@ void PeridigmNS::Peridigm::executeExplicit(Teuchos::RCP<Teuchos::ParameterList>
     // swap state N and state NP1
     for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
       blockIt->updateState();
+
+    // remove fully broken bonds from the neighborhood lists, if requested
+    if(compactBrokenBonds && step%bondCompactionFrequency == 0){
+      PeridigmNS::Timer::self().startTimer("Bond Compaction");
+      for(blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
+        blockIt->compactBrokenBonds(bondCompactionThreshold);
+      PeridigmNS::Timer::self().stopTimer("Bond Compaction");
+    }
   }
   displayProgress("Explicit time integration", 100.0);
   *out << "\n\n";
@@ -3549,6 +3657,8 @@ void PeridigmNS::Peridigm::allocateJacobian(const int numDoFs) {
 
   // Construct map for global tangent matrix
   // Note that this must be an Epetra_Map, not an Epetra_BlockMap, so we can't use threeDimensionalMap directly
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(static_cast<long long>(numDoFs) * oneDimensionalMap->NumGlobalElements() > INT_MAX,
+                              "**** PeridigmNS::Peridigm::allocateJacobian(), the number of global degrees of freedom exceeds the range of the 32-bit global ordinals used by the tangent matrix.\n");
   int numGlobalElements = numDoFs * oneDimensionalMap->NumGlobalElements();
   int numMyElements = numDoFs * oneDimensionalMap->NumMyElements();
   vector<int> myGlobalElements(numMyElements);
@@ -3573,7 +3683,7 @@ void PeridigmNS::Peridigm::allocateJacobian(const int numDoFs) {
 
   // Loop over the neighborhood for each locally-owned point and record non-zero entries in the matrix.
   // Entries will exist for any two points that are bonded, and any two points that are bonded to a common third point.
-  int* neighborhoodList = globalNeighborhoodData->NeighborhoodList();
+  int* neighborhoodList = globalNeighborhoodData->InterleavedNeighborhoodList();
   int neighborhoodListIndex = 0;
   vector<int> globalIndices;
   int numOwnedPoints = globalNeighborhoodData->NumOwnedPoints();
@@ -3654,6 +3764,8 @@ void PeridigmNS::Peridigm::allocateBlockDiagonalJacobian() {
 
   // Construct map for global tangent matrix
   // Note that this must be an Epetra_Map, not an Epetra_BlockMap, so we can't use threeDimensionalMap directly
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(3LL * oneDimensionalMap->NumGlobalElements() > INT_MAX,
+                              "**** PeridigmNS::Peridigm::allocateBlockDiagonalJacobian(), the number of global degrees of freedom exceeds the range of the 32-bit global ordinals used by the tangent matrix.\n");
   int numGlobalElements = 3*oneDimensionalMap->NumGlobalElements();
   int numMyElements = 3*oneDimensionalMap->NumMyElements();
   vector<int> myGlobalElements(numMyElements);
@@ -3957,11 +4069,13 @@ void PeridigmNS::Peridigm::writeRestart(Teuchos::RCP<Teuchos::ParameterList> sol
   char  path[100];
   int IterationNumber;
 
-  if(peridigmComm->MyPID() == 0){
+  // The folder name is set on all processors, which each write their own file in the binary format
   IterationNumber = atoi(firstNumbersSring( restartFiles["path"]  ).c_str())+1;
   sprintf(path,"restart-%06d",IterationNumber);
-  cout << "The restart folder is " << path  <<"." << endl;
   setRestartNames(path);
+
+  if(peridigmComm->MyPID() == 0){
+  cout << "The restart folder is " << path  <<"." << endl;
   sprintf(createDirectory,"mkdir %s",path);
   system(createDirectory);
   cout << "Writing restart files. \n" << endl;
@@ -3981,6 +4095,12 @@ void PeridigmNS::Peridigm::writeRestart(Teuchos::RCP<Teuchos::ParameterList> sol
   outputFile << "Current time is " << "\n" << currentTime  << "\n";
   outputFile.close();
   }
+  if(binaryRestart && !analysisHasMultiphysics){
+    // Wait for the folder to be created
+    peridigmComm->Barrier();
+    writeBinaryRestart();
+    return;
+  }
   if(analysisHasMultiphysics){
 	 cout << "Restart for Multiphysics is not implemented yet." << endl;
 	 exit (0);
@@ -4061,6 +4181,14 @@ void PeridigmNS::Peridigm::readRestart(){
   	cout <<"Reading restart. \n"<< endl;
   	cout.flush();
   }
+  // Read the binary files if every processor has one, otherwise read the MatrixMarket files
+  int localHasBinaryRestart = BinaryRestartReader::exists(restartFiles["binary"]) ? 1 : 0;
+  int hasBinaryRestart;
+  peridigmComm->MinAll(&localHasBinaryRestart, &hasBinaryRestart, 1);
+  if(hasBinaryRestart && !analysisHasMultiphysics){
+    readBinaryRestart();
+    return;
+  }
   if(analysisHasMultiphysics){
 	  if(peridigmComm->MyPID() == 0){
 		  TEUCHOS_TEST_FOR_EXCEPT_MSG(true,"Error: Restart for Multiphysics is not implemented yet.\n");
@@ -4153,4 +4281,61 @@ void PeridigmNS::Peridigm::readRestart(){
 	     	  std::string blockName = blockIt->getName();
 			  blockIt->readBlockfromDisk(blockName,restartFiles["path"].c_str());
 	  	  }
+
+	  // Convert a MatrixMarket restart to the binary format, so that later restarts from this folder read the binary files
+	  if(binaryRestart){
+	    writeBinaryRestart();
+	    if(peridigmComm->MyPID() == 0)
+	      cout << "Converted the restart files in " << restartFiles["path"] << " to the binary format.\n" << endl;
+	  }
+}
+
+void PeridigmNS::Peridigm::writeBinaryRestart(){
+  BinaryRestartWriter writer(restartFiles["binary"], peridigmComm->NumProc(), peridigmComm->MyPID());
+  // The decomposition is stored so that it can be verified on restart
+  writer.write("oneDimensionalMap", *oneDimensionalMap);
+  writer.write("blockIDs", *blockIDs);
+  writer.write("horizon", *horizon);
+  writer.write("volume", *volume);
+  writer.write("density", *density);
+  writer.write("deltaTemperature", *deltaTemperature);
+  writer.write("x", *x);
+  writer.write("u", *u);
+  writer.write("y", *y);
+  writer.write("v", *v);
+  writer.write("a", *a);
+  writer.write("force", *force);
+  writer.write("contactForce", *contactForce);
+  writer.write("externalForce", *externalForce);
+  writer.write("deltaU", *deltaU);
+  writer.write("scratch", *scratch);
+  for(std::vector<PeridigmNS::Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
+    blockIt->writeBlocktoDisk(blockIt->getName(), writer);
+}
+
+void PeridigmNS::Peridigm::readBinaryRestart(){
+  BinaryRestartReader reader(restartFiles["binary"], peridigmComm->NumProc(), peridigmComm->MyPID());
+  // Every processor must agree before any of them throws, otherwise the others would hang in the next collective call
+  int localMapMatches = reader.matchesMap("oneDimensionalMap", *oneDimensionalMap) ? 1 : 0;
+  int mapMatches;
+  peridigmComm->MinAll(&localMapMatches, &mapMatches, 1);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(mapMatches == 0,
+                              "**** Error reading binary restart files, the stored decomposition does not match the current decomposition.\n");
+  reader.read("blockIDs", *blockIDs);
+  reader.read("horizon", *horizon);
+  reader.read("volume", *volume);
+  reader.read("density", *density);
+  reader.read("deltaTemperature", *deltaTemperature);
+  reader.read("x", *x);
+  reader.read("u", *u);
+  reader.read("y", *y);
+  reader.read("v", *v);
+  reader.read("a", *a);
+  reader.read("force", *force);
+  reader.read("contactForce", *contactForce);
+  reader.read("externalForce", *externalForce);
+  reader.read("deltaU", *deltaU);
+  reader.read("scratch", *scratch);
+  for(std::vector<PeridigmNS::Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++)
+    blockIt->readBlockfromDisk(blockIt->getName(), reader);
 }
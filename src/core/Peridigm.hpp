@@ -627,6 +627,15 @@ namespace PeridigmNS {
 
     //Read the restart files
     void readRestart();
+
+    // Flag indicating that restart files are written in the binary per-processor format rather than MatrixMarket
+    bool binaryRestart;
+
+    // Write the binary restart file for this processor
+    void writeBinaryRestart();
+
+    // Read the binary restart file for this processor
+    void readBinaryRestart();
   };
 }
 
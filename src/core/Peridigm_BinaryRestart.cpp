@@ -0,0 +1,266 @@
+/*! \file Peridigm_BinaryRestart.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_BinaryRestart.hpp"
+#include <Teuchos_Assert.hpp>
+#include <cstring>
+#include <cstddef>
+
+using namespace std;
+
+namespace {
+
+  //! File signature.
+  const char restartMagic[8] = {'P','D','R','E','S','T','R','T'};
+
+  //! Version of the binary restart format.
+  const int32_t restartVersion = 1;
+
+  //! Length of the fixed-size record names.
+  const int recordNameLength = 64;
+
+  //! Record data types.
+  enum { DOUBLE_RECORD = 0, INT_RECORD = 1 };
+
+  //! Adler-32 checksum, continued from the given value.
+  uint32_t adler32(const char* data, size_t length, uint32_t adler = 1) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    uint32_t a = adler & 0xffff;
+    uint32_t b = adler >> 16;
+    while(length > 0){
+      // 5552 is the largest block for which b cannot overflow before the modulus is taken
+      size_t blockLength = length < 5552 ? length : 5552;
+      length -= blockLength;
+      while(blockLength-- > 0){
+        a += *bytes++;
+        b += a;
+      }
+      a %= 65521;
+      b %= 65521;
+    }
+    return (b << 16) | a;
+  }
+
+  //! Fixed-size file header.
+  struct FileHeader {
+    char magic[8];
+    int32_t version;
+    int32_t numProc;
+    int32_t myPID;
+    uint32_t checksum;
+  };
+
+  //! Fixed-size record header.
+  struct RecordHeader {
+    char name[recordNameLength];
+    int32_t type;
+    int32_t numVectors;
+    int64_t length;
+    uint32_t dataChecksum;
+    uint32_t headerChecksum;
+  };
+
+  uint32_t headerChecksum(const FileHeader& header) {
+    return adler32(reinterpret_cast<const char*>(&header), offsetof(FileHeader, checksum));
+  }
+
+  uint32_t headerChecksum(const RecordHeader& header) {
+    return adler32(reinterpret_cast<const char*>(&header), offsetof(RecordHeader, headerChecksum));
+  }
+}
+
+PeridigmNS::BinaryRestartWriter::BinaryRestartWriter(const string& filename_, int numProc, int myPID)
+  : filename(filename_)
+{
+  file.open(filename.c_str(), ios::out | ios::binary | ios::trunc);
+  TEUCHOS_TEST_FOR_EXCEPTION(!file.is_open(), std::runtime_error,
+                             "**** Error in BinaryRestartWriter, unable to open " << filename << "\n");
+
+  FileHeader header;
+  memset(&header, 0, sizeof(FileHeader));
+  memcpy(header.magic, restartMagic, 8);
+  header.version = restartVersion;
+  header.numProc = numProc;
+  header.myPID = myPID;
+  header.checksum = headerChecksum(header);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+}
+
+PeridigmNS::BinaryRestartWriter::~BinaryRestartWriter()
+{
+  if(file.is_open())
+    file.close();
+}
+
+void PeridigmNS::BinaryRestartWriter::write(const string& name, const Epetra_BlockMap& map)
+{
+  vector<const char*> vectors(1, reinterpret_cast<const char*>(map.MyGlobalElements()));
+  writeRecord(name, INT_RECORD, 1, map.NumMyElements(), vectors, map.NumMyElements()*sizeof(int));
+}
+
+void PeridigmNS::BinaryRestartWriter::write(const string& name, const Epetra_MultiVector& data)
+{
+  vector<const char*> vectors(data.NumVectors());
+  for(int i=0 ; i<data.NumVectors() ; ++i)
+    vectors[i] = reinterpret_cast<const char*>(data[i]);
+  writeRecord(name, DOUBLE_RECORD, data.NumVectors(), data.MyLength(), vectors, data.MyLength()*sizeof(double));
+}
+
+void PeridigmNS::BinaryRestartWriter::writeRecord(const string& name, int32_t type, int32_t numVectors, int64_t length, const vector<const char*>& vectors, int64_t vectorSize)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(static_cast<int>(name.size()) >= recordNameLength, std::invalid_argument,
+                             "**** Error in BinaryRestartWriter, record name " << name << " is too long.\n");
+
+  RecordHeader header;
+  memset(&header, 0, sizeof(RecordHeader));
+  strncpy(header.name, name.c_str(), recordNameLength-1);
+  header.type = type;
+  header.numVectors = numVectors;
+  header.length = length;
+  header.dataChecksum = 1;
+  for(unsigned int i=0 ; i<vectors.size() ; ++i)
+    header.dataChecksum = adler32(vectors[i], vectorSize, header.dataChecksum);
+  header.headerChecksum = headerChecksum(header);
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(RecordHeader));
+  for(unsigned int i=0 ; i<vectors.size() ; ++i)
+    file.write(vectors[i], vectorSize);
+  TEUCHOS_TEST_FOR_EXCEPTION(!file.good(), std::runtime_error,
+                             "**** Error in BinaryRestartWriter, failed to write " << name << " to " << filename << "\n");
+}
+
+PeridigmNS::BinaryRestartReader::BinaryRestartReader(const string& filename_, int numProc, int myPID)
+  : filename(filename_)
+{
+  file.open(filename.c_str(), ios::in | ios::binary);
+  TEUCHOS_TEST_FOR_EXCEPTION(!file.is_open(), std::runtime_error,
+                             "**** Error in BinaryRestartReader, unable to open " << filename << "\n");
+
+  FileHeader header;
+  file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+  TEUCHOS_TEST_FOR_EXCEPTION(!file.good() || memcmp(header.magic, restartMagic, 8) != 0, std::runtime_error,
+                             "**** Error in BinaryRestartReader, " << filename << " is not a Peridigm binary restart file.\n");
+  TEUCHOS_TEST_FOR_EXCEPTION(header.checksum != headerChecksum(header), std::runtime_error,
+                             "**** Error in BinaryRestartReader, corrupt file header in " << filename << "\n");
+  TEUCHOS_TEST_FOR_EXCEPTION(header.version != restartVersion, std::runtime_error,
+                             "**** Error in BinaryRestartReader, " << filename << " has format version " << header.version
+                             << ", expected version " << restartVersion << ".\n");
+  TEUCHOS_TEST_FOR_EXCEPTION(header.numProc != numProc || header.myPID != myPID, std::runtime_error,
+                             "**** Error in BinaryRestartReader, " << filename << " was written by processor " << header.myPID
+                             << " of " << header.numProc << ", binary restarts must be read with the same number of processors.\n");
+
+  // Index the records so that they can be read in any order
+  RecordHeader recordHeader;
+  while(file.read(reinterpret_cast<char*>(&recordHeader), sizeof(RecordHeader))){
+    TEUCHOS_TEST_FOR_EXCEPTION(recordHeader.headerChecksum != headerChecksum(recordHeader), std::runtime_error,
+                               "**** Error in BinaryRestartReader, corrupt record header in " << filename << "\n");
+    recordHeader.name[recordNameLength-1] = '\0';
+    Record record;
+    record.offset = file.tellg();
+    record.type = recordHeader.type;
+    record.numVectors = recordHeader.numVectors;
+    record.length = recordHeader.length;
+    record.checksum = recordHeader.dataChecksum;
+    records[string(recordHeader.name)] = record;
+    int64_t entrySize = (record.type == INT_RECORD) ? sizeof(int) : sizeof(double);
+    file.seekg(record.numVectors*record.length*entrySize, ios::cur);
+  }
+  file.clear();
+}
+
+bool PeridigmNS::BinaryRestartReader::exists(const string& filename)
+{
+  ifstream file(filename.c_str(), ios::in | ios::binary);
+  return file.is_open();
+}
+
+bool PeridigmNS::BinaryRestartReader::matchesMap(const string& name, const Epetra_BlockMap& map)
+{
+  std::map<string, Record>::const_iterator it = records.find(name);
+  TEUCHOS_TEST_FOR_EXCEPTION(it == records.end(), std::runtime_error,
+                             "**** Error in BinaryRestartReader, record " << name << " not found in " << filename << "\n");
+  if(it->second.type != INT_RECORD || it->second.length != map.NumMyElements())
+    return false;
+  vector<int> globalIds(map.NumMyElements());
+  vector<char*> vectors(1, reinterpret_cast<char*>(globalIds.empty() ? 0 : &globalIds[0]));
+  readRecord(name, vectors, globalIds.size()*sizeof(int));
+  const int* myGlobalIds = map.MyGlobalElements();
+  for(int i=0 ; i<map.NumMyElements() ; ++i){
+    if(globalIds[i] != myGlobalIds[i])
+      return false;
+  }
+  return true;
+}
+
+void PeridigmNS::BinaryRestartReader::read(const string& name, Epetra_MultiVector& data)
+{
+  std::map<string, Record>::const_iterator it = records.find(name);
+  TEUCHOS_TEST_FOR_EXCEPTION(it == records.end(), std::runtime_error,
+                             "**** Error in BinaryRestartReader, record " << name << " not found in " << filename << "\n");
+  TEUCHOS_TEST_FOR_EXCEPTION(it->second.type != DOUBLE_RECORD || it->second.numVectors != data.NumVectors() || it->second.length != data.MyLength(), std::runtime_error,
+                             "**** Error in BinaryRestartReader, record " << name << " in " << filename << " does not match the size of the current data.\n");
+  vector<char*> vectors(data.NumVectors());
+  for(int i=0 ; i<data.NumVectors() ; ++i)
+    vectors[i] = reinterpret_cast<char*>(data[i]);
+  readRecord(name, vectors, data.MyLength()*sizeof(double));
+}
+
+void PeridigmNS::BinaryRestartReader::readRecord(const string& name, const vector<char*>& vectors, int64_t vectorSize)
+{
+  const Record& record = records[name];
+  file.seekg(record.offset);
+  uint32_t checksum = 1;
+  for(unsigned int i=0 ; i<vectors.size() ; ++i){
+    if(vectorSize > 0)
+      file.read(vectors[i], vectorSize);
+    checksum = adler32(vectors[i], vectorSize, checksum);
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION(!file.good(), std::runtime_error,
+                             "**** Error in BinaryRestartReader, failed to read " << name << " from " << filename << "\n");
+  TEUCHOS_TEST_FOR_EXCEPTION(checksum != record.checksum, std::runtime_error,
+                             "**** Error in BinaryRestartReader, checksum mismatch for " << name << " in " << filename << "\n");
+}
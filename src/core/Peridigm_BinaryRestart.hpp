@@ -0,0 +1,151 @@
+/*! \file Peridigm_BinaryRestart.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef PERIDIGM_BINARYRESTART_HPP
+#define PERIDIGM_BINARYRESTART_HPP
+
+#include <Epetra_BlockMap.h>
+#include <Epetra_MultiVector.h>
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace PeridigmNS {
+
+/*! \brief Writer for the binary restart format.
+ *
+ *  Each processor writes its locally-owned data to its own file, with no communication.  The file begins with a
+ *  header ("PDRESTRT", the format version, the number of processors, and the processor id, followed by a checksum of
+ *  these fields) and contains a sequence of named records.  Each record header holds the name, the data type, the
+ *  number of vectors, the length of each vector, a checksum of the data, and a checksum of the record header itself;
+ *  the data follow as raw arrays, one vector after another.  A restart must be read with the same number of
+ *  processors and the same decomposition, which is verified by storing the global ids of the maps.
+ */
+class BinaryRestartWriter {
+
+public:
+
+  //! Constructor; creates the file and writes the file header.
+  BinaryRestartWriter(const std::string& filename, int numProc, int myPID);
+
+  //! Destructor.
+  ~BinaryRestartWriter();
+
+  //! Write the locally-owned global ids of the given map.
+  void write(const std::string& name, const Epetra_BlockMap& map);
+
+  //! Write the locally-owned entries of each vector in the given multivector.
+  void write(const std::string& name, const Epetra_MultiVector& data);
+
+private:
+
+  //! Copy constructor.
+  BinaryRestartWriter(const BinaryRestartWriter& writer);
+
+  //! Assignment operator.
+  BinaryRestartWriter& operator=(const BinaryRestartWriter& writer);
+
+  //! Write a record header followed by the given data.
+  void writeRecord(const std::string& name, int32_t type, int32_t numVectors, int64_t length, const std::vector<const char*>& vectors, int64_t vectorSize);
+
+  std::string filename;
+  std::ofstream file;
+};
+
+//! Reader for the binary restart format written by BinaryRestartWriter.
+class BinaryRestartReader {
+
+public:
+
+  //! Constructor; opens the file, verifies the file header, and indexes the records.
+  BinaryRestartReader(const std::string& filename, int numProc, int myPID);
+
+  //! Destructor.
+  ~BinaryRestartReader(){}
+
+  //! Returns true if the file contains a record with the given name.
+  bool hasRecord(const std::string& name) const { return records.find(name) != records.end(); }
+
+  //! Returns true if the locally-owned global ids of the given map match those stored in the named record.
+  bool matchesMap(const std::string& name, const Epetra_BlockMap& map);
+
+  //! Read the named record into the given multivector, which must have the stored number of vectors and local length.
+  void read(const std::string& name, Epetra_MultiVector& data);
+
+  //! Returns true if a binary restart file exists for the given file name.
+  static bool exists(const std::string& filename);
+
+private:
+
+  //! Copy constructor.
+  BinaryRestartReader(const BinaryRestartReader& reader);
+
+  //! Assignment operator.
+  BinaryRestartReader& operator=(const BinaryRestartReader& reader);
+
+  //! Location and layout of a record.
+  struct Record {
+    std::streamoff offset;
+    int32_t type;
+    int32_t numVectors;
+    int64_t length;
+    uint32_t checksum;
+  };
+
+  //! Find the named record and read its data into the given vectors, verifying the checksum.
+  void readRecord(const std::string& name, const std::vector<char*>& vectors, int64_t vectorSize);
+
+  std::string filename;
+  std::ifstream file;
+  std::map<std::string, Record> records;
+};
+
+}
+
+#endif // PERIDIGM_BINARYRESTART_HPP
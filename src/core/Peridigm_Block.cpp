@@ -69,6 +69,9 @@ void PeridigmNS::Block::initialize(Teuchos::RCP<const Epetra_BlockMap> globalOwn
                         globalBlockIds,
                         globalNeighborhoodData);
 
+  // The material and damage kernels operate on the CSR form of the neighborhood list
+  neighborhoodData->UpdateCSR();
+
   TEUCHOS_TEST_FOR_EXCEPT_MSG(materialModel.is_null(),
                               "\n**** Material model must be set via Block::setMaterialModel() prior to calling Block::initialize()\n");
   
@@ -97,10 +100,11 @@ void PeridigmNS::Block::initializeMaterialModel(double timeStep)
   TEUCHOS_TEST_FOR_EXCEPT_MSG(dataManager.is_null(),
                       "\n**** DataManager must be initialized via Block::initializeDataManager() prior to calling Block::initializeMaterialModel()\n");
 
+  vector<int> neighborhoodListBuffer;
   materialModel->initialize(timeStep,
                             neighborhoodData->NumOwnedPoints(),
                             neighborhoodData->OwnedIDs(),
-                            neighborhoodData->NeighborhoodList(),
+                            neighborhoodData->NeighborhoodList(neighborhoodListBuffer),
                             *dataManager);
 }
 
@@ -114,9 +118,10 @@ void PeridigmNS::Block::initializeDamageModel(double timeStep)
   TEUCHOS_TEST_FOR_EXCEPT_MSG(dataManager.is_null(),
                       "\n**** DataManager must be initialized via Block::initializeDataManager() prior to calling Block::initializeDamageModel()\n");
 
+  vector<int> neighborhoodListBuffer;
   damageModel->initialize(timeStep,
                           neighborhoodData->NumOwnedPoints(),
                           neighborhoodData->OwnedIDs(),
-                          neighborhoodData->NeighborhoodList(),
+                          neighborhoodData->NeighborhoodList(neighborhoodListBuffer),
                           *dataManager);
 }
@@ -49,6 +49,7 @@
 #include "Peridigm_Field.hpp"
 #include <vector>
 #include <set>
+#include <algorithm>
 
 using namespace std;
 
@@ -182,11 +183,24 @@ void PeridigmNS::BlockBase::createMapsFromGlobalMaps(Teuchos::RCP<const Epetra_B
   ownedScalarBondMap =
     Teuchos::rcp(new Epetra_BlockMap(numGlobalElements, numMyElements, myGlobalElements, elementSizeList, indexBase, globalOwnedScalarPointMap->Comm()));
 
+  createOverlapMapsFromGlobalMaps(globalOverlapScalarPointMap, globalBlockIds, globalNeighborhoodData);
+}
+
+void PeridigmNS::BlockBase::createOverlapMapsFromGlobalMaps(Teuchos::RCP<const Epetra_BlockMap> globalOverlapScalarPointMap,
+                                                            Teuchos::RCP<const Epetra_Vector>   globalBlockIds,
+                                                            Teuchos::RCP<const PeridigmNS::NeighborhoodData> globalNeighborhoodData)
+{
+  double* globalBlockIdsPtr;
+  globalBlockIds->ExtractView(&globalBlockIdsPtr);
+
+  // The owned global IDs
+  vector<int> IDs(ownedScalarPointMap->MyGlobalElements(), ownedScalarPointMap->MyGlobalElements() + ownedScalarPointMap->NumMyElements());
+
   // Create a list of nodes that need to be ghosted (both across material boundaries and across processor boundaries)
   set<int> ghosts;
 
   // Check the neighborhood list for things that need to be ghosted
-  int* const globalNeighborhoodList = globalNeighborhoodData->NeighborhoodList();
+  int* const globalNeighborhoodList = globalNeighborhoodData->InterleavedNeighborhoodList();
   int globalNeighborhoodListIndex = 0;
   for(int iLID=0 ; iLID<globalNeighborhoodData->NumOwnedPoints() ; ++iLID){
     int numNeighbors = globalNeighborhoodList[globalNeighborhoodListIndex++];
@@ -203,9 +217,6 @@ void PeridigmNS::BlockBase::createMapsFromGlobalMaps(Teuchos::RCP<const Epetra_B
   for(unsigned int i=0 ; i<IDs.size() ; ++i)
     ghosts.erase(IDs[i]);
 
-  // Copy IDs, this is the owned global ID list
-  vector<int> ownedIDs(IDs.begin(), IDs.end());
-
   // Append ghosts to IDs
   // This creates the overlap global ID list
   for(set<int>::iterator it=ghosts.begin() ; it!=ghosts.end() ; ++it)
@@ -213,17 +224,19 @@ void PeridigmNS::BlockBase::createMapsFromGlobalMaps(Teuchos::RCP<const Epetra_B
 
   // Create the overlap scalar point map and the overlap vector point map
 
-  numMyElements = IDs.size();
-  myGlobalElements = 0;
+  int numGlobalElements = -1;
+  int numMyElements = IDs.size();
+  int* myGlobalElements = 0;
   if(numMyElements > 0)
     myGlobalElements = &IDs.at(0);
-  elementSize = 1;
+  int elementSize = 1;
+  int indexBase = 0;
   overlapScalarPointMap =
-    Teuchos::rcp(new Epetra_BlockMap(numGlobalElements, numMyElements, myGlobalElements, elementSize, indexBase, globalOwnedScalarPointMap->Comm()));
+    Teuchos::rcp(new Epetra_BlockMap(numGlobalElements, numMyElements, myGlobalElements, elementSize, indexBase, ownedScalarPointMap->Comm()));
 
   elementSize = 3;
   overlapVectorPointMap =
-    Teuchos::rcp(new Epetra_BlockMap(numGlobalElements, numMyElements, myGlobalElements, elementSize, indexBase, globalOwnedScalarPointMap->Comm()));
+    Teuchos::rcp(new Epetra_BlockMap(numGlobalElements, numMyElements, myGlobalElements, elementSize, indexBase, ownedScalarPointMap->Comm()));
 
   // Invalidate the importers
   oneDimensionalImporter = Teuchos::RCP<Epetra_Import>();
@@ -240,7 +253,7 @@ Teuchos::RCP<PeridigmNS::NeighborhoodData> PeridigmNS::BlockBase::createNeighbor
   vector<int> neighborhoodList;
   vector<int> neighborhoodPtr(numOwnedPoints);
 
-  int* const globalNeighborhoodList = globalNeighborhoodData->NeighborhoodList();
+  int* const globalNeighborhoodList = globalNeighborhoodData->InterleavedNeighborhoodList();
   int* const globalNeighborhoodPtr = globalNeighborhoodData->NeighborhoodPtr();
 
   // Create the neighborhoodList and neighborhoodPtr for this block.
@@ -276,7 +289,7 @@ Teuchos::RCP<PeridigmNS::NeighborhoodData> PeridigmNS::BlockBase::createNeighbor
   }
   blockNeighborhoodData->SetNeighborhoodListSize(neighborhoodList.size());
   if(neighborhoodList.size() > 0){
-    memcpy(blockNeighborhoodData->NeighborhoodList(),
+    memcpy(blockNeighborhoodData->InterleavedNeighborhoodList(),
            &neighborhoodList.at(0),
            neighborhoodList.size()*sizeof(int));
   }
@@ -284,6 +297,125 @@ Teuchos::RCP<PeridigmNS::NeighborhoodData> PeridigmNS::BlockBase::createNeighbor
   return blockNeighborhoodData;
 }
 
+bool PeridigmNS::BlockBase::compactBrokenBonds(double brokenBondFractionThreshold)
+{
+  PeridigmNS::FieldManager& fieldManager = PeridigmNS::FieldManager::self();
+  if(!fieldManager.hasField("Bond_Damage") || !fieldManager.hasField("Number_Of_Compacted_Bonds"))
+    return false;
+  int bondDamageFieldId = fieldManager.getFieldId("Bond_Damage");
+  int numberOfCompactedBondsFieldId = fieldManager.getFieldId("Number_Of_Compacted_Bonds");
+
+  // The presence of these fields is the same on all processors, so either all or none of the processors return here
+  if(!dataManager->hasData(bondDamageFieldId, PeridigmField::STEP_N) || !dataManager->hasData(numberOfCompactedBondsFieldId, PeridigmField::STEP_NONE))
+    return false;
+
+  double *bondDamage, *numberOfCompactedBonds;
+  dataManager->getData(bondDamageFieldId, PeridigmField::STEP_N)->ExtractView(&bondDamage);
+  dataManager->getData(numberOfCompactedBondsFieldId, PeridigmField::STEP_NONE)->ExtractView(&numberOfCompactedBonds);
+
+  // Determine the global fraction of bonds in this block that are fully broken
+  int numBonds = ownedScalarBondMap->NumMyPoints();
+  int numBrokenBonds = 0;
+  for(int i=0 ; i<numBonds ; ++i){
+    if(bondDamage[i] >= 1.0)
+      numBrokenBonds += 1;
+  }
+  double localCounts[2], globalCounts[2];
+  localCounts[0] = static_cast<double>(numBrokenBonds);
+  localCounts[1] = static_cast<double>(numBonds);
+  ownedScalarBondMap->Comm().SumAll(localCounts, globalCounts, 2);
+  if(globalCounts[0] == 0.0 || globalCounts[0] < brokenBondFractionThreshold*globalCounts[1])
+    return false;
+
+  // Create the compacted neighborhood list, recording the original index of each retained bond
+  int numOwnedPoints = neighborhoodData->NumOwnedPoints();
+  const int* ownedIDs = neighborhoodData->OwnedIDs();
+  const int* bondOffsets = neighborhoodData->BondOffsets();
+
+  vector<int> compactedNeighborhoodList;
+  compactedNeighborhoodList.reserve(numOwnedPoints + numBonds - numBrokenBonds);
+  vector<int> compactedNeighborhoodPtr(numOwnedPoints);
+  vector<int> retainedBondIndices;
+  retainedBondIndices.reserve(numBonds - numBrokenBonds);
+  vector<int> bondIDs;
+  vector<int> bondElementSize;
+
+  vector<int> neighborIndicesBuffer;
+  for(int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()){
+    int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+    const int* neighborIndices = neighborhoodData->NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+    const int firstBond = bondOffsets[firstPoint];
+    for(int iID=firstPoint ; iID<lastPoint ; ++iID){
+      compactedNeighborhoodPtr[iID] = (int)(compactedNeighborhoodList.size());
+      int numNeighbors = bondOffsets[iID+1] - bondOffsets[iID];
+      int numNeighborsIndex = (int)(compactedNeighborhoodList.size());
+      compactedNeighborhoodList.push_back(0);
+      int numRetainedNeighbors = 0;
+      for(int bondIndex=bondOffsets[iID] ; bondIndex<bondOffsets[iID+1] ; ++bondIndex){
+        if(bondDamage[bondIndex] < 1.0){
+          compactedNeighborhoodList.push_back(neighborIndices[bondIndex-firstBond]);
+          retainedBondIndices.push_back(bondIndex);
+          numRetainedNeighbors += 1;
+        }
+      }
+      compactedNeighborhoodList[numNeighborsIndex] = numRetainedNeighbors;
+      numberOfCompactedBonds[ownedIDs[iID]] += numNeighbors - numRetainedNeighbors;
+      // Elements with no bonds have no entry in the bond map
+      if(numRetainedNeighbors > 0){
+        bondIDs.push_back(ownedScalarPointMap->GID(iID));
+        bondElementSize.push_back(numRetainedNeighbors);
+      }
+    }
+  }
+
+  // Create the compacted bond map and move the bond data onto it
+  int numGlobalElements = -1;
+  int numMyElements = bondElementSize.size();
+  int* myGlobalElements = 0;
+  int* elementSizeList = 0;
+  if(numMyElements > 0){
+    myGlobalElements = &bondIDs.at(0);
+    elementSizeList = &bondElementSize.at(0);
+  }
+  int indexBase = 0;
+  ownedScalarBondMap =
+    Teuchos::rcp(new Epetra_BlockMap(numGlobalElements, numMyElements, myGlobalElements, elementSizeList, indexBase, ownedScalarPointMap->Comm()));
+
+  dataManager->compactBondData(ownedScalarBondMap, retainedBondIndices);
+
+  // Load the compacted neighborhood list; the owned IDs are unchanged
+  bool compressed = neighborhoodData->IsCompressed();
+  neighborhoodData->SetNeighborhoodListSize(compactedNeighborhoodList.size());
+  if(compactedNeighborhoodList.size() > 0){
+    memcpy(neighborhoodData->InterleavedNeighborhoodList(),
+           &compactedNeighborhoodList.at(0),
+           compactedNeighborhoodList.size()*sizeof(int));
+  }
+  if(compactedNeighborhoodPtr.size() > 0){
+    memcpy(neighborhoodData->NeighborhoodPtr(),
+           &compactedNeighborhoodPtr.at(0),
+           compactedNeighborhoodPtr.size()*sizeof(int));
+  }
+  neighborhoodData->UpdateCSR();
+  if(compressed)
+    neighborhoodData->Compress();
+
+  return true;
+}
+
+void PeridigmNS::BlockBase::compressNeighborhoodData()
+{
+  // Sorted neighbor lists compress to short deltas; the bond data is permuted in place on the unchanged bond map
+  vector<int> bondPermutation;
+  neighborhoodData->SortNeighbors(bondPermutation);
+  bool sorted = true;
+  for(unsigned int i=0 ; i<bondPermutation.size() && sorted ; ++i)
+    sorted = (bondPermutation[i] == static_cast<int>(i));
+  if(!sorted && !dataManager.is_null())
+    dataManager->compactBondData(ownedScalarBondMap, bondPermutation);
+  neighborhoodData->Compress();
+}
+
 void PeridigmNS::BlockBase::initializeDataManager(vector<int> fieldIds)
 {
   // The material model must be set prior to initializing the data manager.
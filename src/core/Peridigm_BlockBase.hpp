@@ -166,6 +166,23 @@ namespace PeridigmNS {
      */
     void exportData(Epetra_Vector& target, int fieldId, PeridigmField::Step step, Epetra_CombineMode combineMode);
 
+    /*! \brief Removes fully broken bonds from the neighborhood list and the bond data.
+     *
+     *  Bonds with a Bond_Damage value of 1.0 at STATE_N are removed if the global fraction of such bonds in
+     *  the block is at least the given threshold.  The number of bonds removed from each point is accumulated
+     *  in the Number_Of_Compacted_Bonds field so that damage models can continue to report the fraction of the
+     *  original bonds that are broken.  This function must be called on all processors.  Returns true if the
+     *  bonds were compacted.
+     */
+    bool compactBrokenBonds(double brokenBondFractionThreshold);
+
+    /*! \brief Sorts the neighbors of each point, reorders the bond data to match, and compresses the neighborhood list.
+     *
+     *  The bond data are permuted along with the neighbors.  Restart files store the bond data in neighbor order,
+     *  so a restart must use the same "Compress Neighbor Lists" setting as the run that wrote it.
+     */
+    void compressNeighborhoodData();
+
     //! Swaps STATE_N and STATE_NP1.
     void updateState(){ dataManager->updateState(); };
 
@@ -175,6 +192,12 @@ namespace PeridigmNS {
     //! Read block data
     void readBlockfromDisk(std::string blockName, char const * path){ dataManager->readBlockfromDisk(blockName, path); }
 
+    //! Write block data to a binary restart file
+    void writeBlocktoDisk(std::string blockName, BinaryRestartWriter& writer){ dataManager->writeBlocktoDisk(blockName, writer); }
+
+    //! Read block data from a binary restart file
+    void readBlockfromDisk(std::string blockName, BinaryRestartReader& reader){ dataManager->readBlockfromDisk(blockName, reader); }
+
   protected:
     
     /*! \brief Creates the set of block-specific maps.
@@ -191,6 +214,11 @@ namespace PeridigmNS {
                                   Teuchos::RCP<const Epetra_Vector>   globalBlockIds,
                                   Teuchos::RCP<const PeridigmNS::NeighborhoodData> globalNeighborhoodData);
 
+    //! Create the block-specific overlap maps, which hold the owned points followed by the ghosts, from the block's owned point map.
+    void createOverlapMapsFromGlobalMaps(Teuchos::RCP<const Epetra_BlockMap> globalOverlapScalarPointMap,
+                                         Teuchos::RCP<const Epetra_Vector>   globalBlockIds,
+                                         Teuchos::RCP<const PeridigmNS::NeighborhoodData> globalNeighborhoodData);
+
     //! Create the block-specific neighborhood data.
     Teuchos::RCP<PeridigmNS::NeighborhoodData> createNeighborhoodDataFromGlobalNeighborhoodData(Teuchos::RCP<const Epetra_BlockMap> globalOverlapScalarPointMap,
                                                                                                 Teuchos::RCP<const PeridigmNS::NeighborhoodData> globalNeighborhoodData);
@@ -110,3 +110,18 @@ void PeridigmNS::ContactBlock::rebalance(Teuchos::RCP<const Epetra_BlockMap> reb
                          overlapVectorPointMap,
                          ownedScalarBondMap);
 }
+
+void PeridigmNS::ContactBlock::updateOverlap(Teuchos::RCP<const Epetra_BlockMap> globalOverlapScalarPointMap,
+                                             Teuchos::RCP<const Epetra_Vector> globalBlockIds,
+                                             Teuchos::RCP<const PeridigmNS::NeighborhoodData> globalNeighborhoodData)
+{
+  createOverlapMapsFromGlobalMaps(globalOverlapScalarPointMap,
+                                  globalBlockIds,
+                                  globalNeighborhoodData);
+
+  neighborhoodData = createNeighborhoodDataFromGlobalNeighborhoodData(globalOverlapScalarPointMap,
+                                                                      globalNeighborhoodData);
+
+  dataManager->updateOverlapMaps(overlapScalarPointMap,
+                                 overlapVectorPointMap);
+}
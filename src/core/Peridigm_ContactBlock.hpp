@@ -97,6 +97,14 @@ class ContactBlock : public BlockBase {
                    Teuchos::RCP<const Epetra_Vector> rebalancedGlobalBlockIds,
                    Teuchos::RCP<const PeridigmNS::NeighborhoodData> rebalancedGlobalNeighborhoodData);
 
+    /*! \brief Rebuild the overlap maps and neighborhood information for a new contact neighbor list when the owned points are unchanged.
+     *
+     *  The owned maps, the bond map, and the owned data are retained, so no data is moved between processors.
+     */
+    void updateOverlap(Teuchos::RCP<const Epetra_BlockMap> globalOverlapScalarPointMap,
+                       Teuchos::RCP<const Epetra_Vector> globalBlockIds,
+                       Teuchos::RCP<const PeridigmNS::NeighborhoodData> globalNeighborhoodData);
+
   protected:
 
     //! The contact model
@@ -54,6 +54,10 @@
 
 #include "PdZoltan.h"
 #include "NeighborhoodList.h"
+#include <cmath>
+#include <fstream>
+#include <cfloat>
+#include <algorithm>
 
 using namespace std;
 
@@ -62,7 +66,13 @@ using namespace std;
 PeridigmNS::ContactManager::ContactManager(const Teuchos::ParameterList& contactParams,
                                            Teuchos::RCP<Discretization> disc,
                                            Teuchos::RCP<Teuchos::ParameterList> peridigmParams)
-  : verbose(false), myPID(-1), params(contactParams), contactRebalanceFrequency(0), contactSearchRadius(0.0),
+  : verbose(false), myPID(-1), params(contactParams), contactRebalanceFrequency(0), contactSearchRadius(0.0), contactVerletSkin(0.0),
+    contactRepartitionImbalanceThreshold(0.0), contactWorkImbalance(1.0), contactSearchRadiusExtension(0.0),
+    contactSurfaceNeighborFraction(0.0), contactSurfaceDamageThreshold(0.0), contactBlockPairBroadPhase(false),
+    contactStatisticsPending(false), contactStatisticsHeaderWritten(false), contactStatisticsStep(0), contactStatisticsRepartitioned(false),
+    contactStatisticsCandidatePairs(0.0), contactStatisticsGhostPoints(0.0), contactStatisticsBytesMigrated(0.0),
+    contactStatisticsDecompositionTime(0.0), contactStatisticsSearchTime(0.0), contactStatisticsMapTime(0.0),
+    contactStatisticsForceTime(0.0),
     blockIdFieldId(-1), volumeFieldId(-1), coordinatesFieldId(-1), velocityFieldId(-1), contactForceDensityFieldId(-1)
 {
   if(contactParams.isParameter("Verbose"))
@@ -79,9 +89,33 @@ PeridigmNS::ContactManager::ContactManager(const Teuchos::ParameterList& contact
   if(!contactParams.isParameter("Search Radius"))
     TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter, "Contact parameter \"Search Radius\" not specified.");
   contactSearchRadius = contactParams.get<double>("Search Radius");
-  if(!contactParams.isParameter("Search Frequency"))
+  if(contactParams.isParameter("Verlet Skin")){
+    contactVerletSkin = contactParams.get<double>("Verlet Skin");
+    TEUCHOS_TEST_FOR_EXCEPTION(contactVerletSkin <= 0.0, Teuchos::Exceptions::InvalidParameter, "Contact parameter \"Verlet Skin\" must be greater than zero.");
+  }
+  if(!contactParams.isParameter("Search Frequency") && contactVerletSkin == 0.0)
     TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter, "Contact parameter \"Search Frequency\" not specified.");
-  contactRebalanceFrequency = contactParams.get<int>("Search Frequency");
+  if(contactParams.isParameter("Search Frequency")){
+    contactRebalanceFrequency = contactParams.get<int>("Search Frequency");
+    TEUCHOS_TEST_FOR_EXCEPTION(contactRebalanceFrequency < 1, Teuchos::Exceptions::InvalidParameter, "Contact parameter \"Search Frequency\" must be greater than zero.");
+  }
+  if(contactParams.isParameter("Repartition Imbalance Threshold")){
+    contactRepartitionImbalanceThreshold = contactParams.get<double>("Repartition Imbalance Threshold");
+    TEUCHOS_TEST_FOR_EXCEPTION(contactRepartitionImbalanceThreshold < 1.0, Teuchos::Exceptions::InvalidParameter, "Contact parameter \"Repartition Imbalance Threshold\" must be at least 1.0.");
+  }
+  if(contactParams.isParameter("Surface Neighbor Fraction")){
+    contactSurfaceNeighborFraction = contactParams.get<double>("Surface Neighbor Fraction");
+    TEUCHOS_TEST_FOR_EXCEPTION(contactSurfaceNeighborFraction <= 0.0 || contactSurfaceNeighborFraction > 1.0, Teuchos::Exceptions::InvalidParameter, "Contact parameter \"Surface Neighbor Fraction\" must be greater than zero and no greater than 1.0.");
+  }
+  if(contactParams.isParameter("Surface Damage Threshold")){
+    contactSurfaceDamageThreshold = contactParams.get<double>("Surface Damage Threshold");
+    TEUCHOS_TEST_FOR_EXCEPTION(contactSurfaceDamageThreshold <= 0.0 || contactSurfaceDamageThreshold > 1.0, Teuchos::Exceptions::InvalidParameter, "Contact parameter \"Surface Damage Threshold\" must be greater than zero and no greater than 1.0.");
+  }
+
+  if(contactParams.isParameter("Statistics File"))
+    contactStatisticsFileName = contactParams.get<string>("Statistics File");
+  if(contactParams.isParameter("Block Pair Broad Phase"))
+    contactBlockPairBroadPhase = contactParams.get<bool>("Block Pair Broad Phase");
 
   createContactInteractionsList(contactParams, disc);
 
@@ -252,6 +286,7 @@ void PeridigmNS::ContactManager::initialize(Teuchos::RCP<const Epetra_BlockMap>
     contactParams.set("Horizon", blockHorizon);
     if(!contactParams.isParameter("Friction Coefficient"))
       contactParams.set("Friction Coefficient", 0.0);
+    contactStatisticsContactRadii.push_back(contactParams.isParameter("Contact Radius") ? contactParams.get<double>("Contact Radius") : 0.0);
     Teuchos::RCP<const PeridigmNS::ContactModel> contactModel = contactModelFactory.create(contactParams);
     contactBlockIt->setContactModel(contactModel);
   }
@@ -316,7 +351,7 @@ void PeridigmNS::ContactManager::initialize(Teuchos::RCP<const Epetra_BlockMap>
   vector<int> contactBondMapElementSizeList;
   contactBondMapElementSizeList.reserve(bondMap_->NumMyElements());
 
-  int* neighborhoodList = neighborhoodData->NeighborhoodList();
+  int* neighborhoodList = neighborhoodData->InterleavedNeighborhoodList();
   int neighborhoodListIndex = 0;
   int* neighborhoodListOwnedIds = neighborhoodData->OwnedIDs();
   for(int i=0 ; i<neighborhoodData->NumOwnedPoints() ; ++i){
@@ -350,9 +385,10 @@ void PeridigmNS::ContactManager::initialize(Teuchos::RCP<const Epetra_BlockMap>
   threeDimensionalMothershipToContactMothershipImporter = Teuchos::rcp(new Epetra_Import(*threeDimensionalContactMap, *threeDimensionalMap));
 
   // Create the contact mothership multivectors
-  oneDimensionalContactMothership = Teuchos::rcp(new Epetra_MultiVector(*oneDimensionalContactMap, 2));
+  oneDimensionalContactMothership = Teuchos::rcp(new Epetra_MultiVector(*oneDimensionalContactMap, 3));
   contactBlockIDs = Teuchos::rcp((*oneDimensionalContactMothership)(0), false);         // block ID
   contactVolume = Teuchos::rcp((*oneDimensionalContactMothership)(1), false);           // cell volume
+  contactDamage = Teuchos::rcp((*oneDimensionalContactMothership)(2), false);           // damage, used only for selecting surface candidates
 
   threeDimensionalContactMothership = Teuchos::rcp(new Epetra_MultiVector(*threeDimensionalContactMap, 4));
   contactY = Teuchos::rcp((*threeDimensionalContactMothership)(0), false);             // current positions
@@ -383,7 +419,7 @@ void PeridigmNS::ContactManager::loadNeighborhoodData(Teuchos::RCP<PeridigmNS::N
   int peridigmNumOwned = globalNeighborhoodData->NumOwnedPoints();
   int* peridigmOwnedIds = globalNeighborhoodData->OwnedIDs();
   int peridigmNeighborhoodListSize = globalNeighborhoodData->NeighborhoodListSize();
-  int* peridigmNeighborhoodList = globalNeighborhoodData->NeighborhoodList();
+  int* peridigmNeighborhoodList = globalNeighborhoodData->InterleavedNeighborhoodList();
 
   vector<int> ownedIds;
   vector<int> neighborhoodList;
@@ -428,7 +464,7 @@ void PeridigmNS::ContactManager::loadNeighborhoodData(Teuchos::RCP<PeridigmNS::N
  		 &neighborhoodPtr[0],
  		 neighborhoodPtr.size()*sizeof(int));
   neighborhoodData->SetNeighborhoodListSize(neighborhoodList.size());
-  memcpy(neighborhoodData->NeighborhoodList(),
+  memcpy(neighborhoodData->InterleavedNeighborhoodList(),
  		 &neighborhoodList[0],
  		 neighborhoodList.size()*sizeof(int));
 
@@ -486,28 +522,131 @@ void PeridigmNS::ContactManager::exportData(Teuchos::RCP<Epetra_Vector> contactF
   contactForce->Export(*contactContactForce, *threeDimensionalMothershipToContactMothershipImporter, Insert);
 }
 
-void PeridigmNS::ContactManager::rebalance(int step)
+void PeridigmNS::ContactManager::importDamage(Teuchos::RCP<Epetra_Vector> damage)
+{
+  contactDamage->Import(*damage, *oneDimensionalMothershipToContactMothershipImporter, Insert);
+}
+
+void PeridigmNS::ContactManager::flagSurfaceCandidates(Epetra_Vector& surfaceCandidates) const
 {
-  if( step%contactRebalanceFrequency != 0)
+  // The bulk number of bonds for each block is taken to be the largest number of bonds of any point in the block
+  map<int, int> blockIndex;
+  for(vector<PeridigmNS::ContactBlock>::iterator it = contactBlocks->begin() ; it != contactBlocks->end() ; it++){
+    int index = static_cast<int>(blockIndex.size());
+    blockIndex.insert(std::make_pair(it->getID(), index));
+  }
+  vector<int> localMaxBonds(blockIndex.size(), 0), globalMaxBonds(blockIndex.size(), 0);
+  vector<int> numBonds(oneDimensionalContactMap->NumMyElements(), 0);
+  for(int i=0 ; i<oneDimensionalContactMap->NumMyElements() ; ++i){
+    int bondMapLocalID = bondContactMap->LID(oneDimensionalContactMap->GID(i));
+    if(bondMapLocalID != -1)
+      numBonds[i] = bondContactMap->ElementSize(bondMapLocalID);
+    map<int, int>::const_iterator it = blockIndex.find(static_cast<int>((*contactBlockIDs)[i]));
+    if(it != blockIndex.end() && numBonds[i] > localMaxBonds[it->second])
+      localMaxBonds[it->second] = numBonds[i];
+  }
+  if(!localMaxBonds.empty())
+    oneDimensionalContactMap->Comm().MaxAll(&localMaxBonds[0], &globalMaxBonds[0], static_cast<int>(localMaxBonds.size()));
+
+  // A point is a candidate if it has a deficit of bonds relative to the bulk, or if it is sufficiently damaged
+  surfaceCandidates.PutScalar(0.0);
+  for(int i=0 ; i<oneDimensionalContactMap->NumMyElements() ; ++i){
+    map<int, int>::const_iterator it = blockIndex.find(static_cast<int>((*contactBlockIDs)[i]));
+    int bulkNumBonds = (it != blockIndex.end()) ? globalMaxBonds[it->second] : 0;
+    if(numBonds[i] < contactSurfaceNeighborFraction*bulkNumBonds)
+      surfaceCandidates[i] = 1.0;
+    else if(contactSurfaceDamageThreshold > 0.0 && (*contactDamage)[i] >= contactSurfaceDamageThreshold)
+      surfaceCandidates[i] = 1.0;
+  }
+}
+
+double PeridigmNS::ContactManager::maxDisplacementSince(const Epetra_Vector& referencePositions) const
+{
+  double localMaxDisplacementSquared = 0.0;
+  for(int i=0 ; i<contactY->MyLength() ; i+=3){
+    double dx = (*contactY)[i]   - referencePositions[i];
+    double dy = (*contactY)[i+1] - referencePositions[i+1];
+    double dz = (*contactY)[i+2] - referencePositions[i+2];
+    double displacementSquared = dx*dx + dy*dy + dz*dz;
+    if(displacementSquared > localMaxDisplacementSquared)
+      localMaxDisplacementSquared = displacementSquared;
+  }
+  double globalMaxDisplacementSquared;
+  contactY->Map().Comm().MaxAll(&localMaxDisplacementSquared, &globalMaxDisplacementSquared, 1);
+  return sqrt(globalMaxDisplacementSquared);
+}
+
+void PeridigmNS::ContactManager::rebalance(long long step)
+{
+  // A search is always performed the first time through.  After that, a search is performed at the
+  // requested frequency and, with a Verlet skin, whenever a point may have moved into the search radius
+  // of a point that was not in its list at the last search.
+  bool searchRequired = contactYAtLastSearch.is_null();
+  if(contactRebalanceFrequency > 0 && step%contactRebalanceFrequency == 0)
+    searchRequired = true;
+  if(!searchRequired && contactVerletSkin > 0.0)
+    searchRequired = maxDisplacementSince(*contactYAtLastSearch) > 0.5*contactVerletSkin;
+  if(!searchRequired)
     return;
 
   const Epetra_Comm& comm = oneDimensionalMap->Comm();
 
-  // \todo Handle serial case.  We don't need to rebalance, but we still want to update the contact search.
-  QUICKGRID::Data rebalancedDecomp = currentConfigurationDecomp();
+  // Repartition unless the contact work is still acceptably balanced in the current partitioning.
+  // Points owned by a processor may have moved outside the region assigned to that processor at the
+  // last repartitioning, so the search radius is extended by the largest such motion.  This ensures
+  // that every pair within the search radius is still found.
+  bool repartition = true;
+  if(contactRepartitionImbalanceThreshold > 0.0 && contactZoltanPtr)
+    repartition = contactWorkImbalance > contactRepartitionImbalanceThreshold;
+  contactSearchRadiusExtension = 0.0;
+  if(!repartition)
+    contactSearchRadiusExtension = maxDisplacementSince(*contactYAtLastRepartition);
+
+  PeridigmNS::Timer& timer = PeridigmNS::Timer::self();
+  double decompositionTime = timer.elapsedTime("Contact Decomposition");
+  double searchTime = timer.elapsedTime("Contact Search");
+  double mapTime = timer.elapsedTime("Contact Maps");
+
+  timer.startTimer("Contact Decomposition");
+  QUICKGRID::Data rebalancedDecomp = repartition ? currentConfigurationDecomp() : currentConfigurationDecompWithoutRepartition();
+  if(repartition)
+    contactZoltanPtr = rebalancedDecomp.zoltanPtr;
+  timer.stopTimer("Contact Decomposition");
+
+  timer.startTimer("Contact Maps");
 
   Teuchos::RCP<Epetra_BlockMap> rebalancedOneDimensionalMap = Teuchos::rcp(new Epetra_BlockMap(PdQuickGridDiscretization::getOwnedMap(comm, rebalancedDecomp, 1)));
-  Teuchos::RCP<const Epetra_Import> oneDimensionalMapImporter = Teuchos::rcp(new Epetra_Import(*rebalancedOneDimensionalMap, *oneDimensionalContactMap));
 
-  Teuchos::RCP<Epetra_BlockMap> rebalancedThreeDimensionalMap = Teuchos::rcp(new Epetra_BlockMap(PdQuickGridDiscretization::getOwnedMap(comm, rebalancedDecomp, 3)));
-  Teuchos::RCP<const Epetra_Import> threeDimensionalMapImporter = Teuchos::rcp(new Epetra_Import(*rebalancedThreeDimensionalMap, *threeDimensionalContactMap));
+  // If each processor owns the same points as before, which is typical when searching without repartitioning, the owned maps,
+  // the rebalanced neighbor list, the contact mothership vectors, and the importers to and from the mothership vectors are all
+  // still valid and are reused; only the overlap maps and the data that depend on them are rebuilt
+  bool ownedPointsUnchanged = !rebalancedNeighborGlobalIDList.is_null() && rebalancedOneDimensionalMap->SameAs(*oneDimensionalContactMap);
+
+  Teuchos::RCP<Epetra_BlockMap> rebalancedThreeDimensionalMap;
+  Teuchos::RCP<Epetra_BlockMap> rebalancedBondMap;
+  Teuchos::RCP<const Epetra_Import> oneDimensionalMapImporter;
+  Teuchos::RCP<const Epetra_Import> threeDimensionalMapImporter;
+  Teuchos::RCP<Epetra_Vector> rebalancedNeighborGlobalIDs;
+  if(ownedPointsUnchanged){
+    rebalancedOneDimensionalMap = Teuchos::rcp_const_cast<Epetra_BlockMap>(oneDimensionalContactMap);
+    rebalancedThreeDimensionalMap = Teuchos::rcp_const_cast<Epetra_BlockMap>(threeDimensionalContactMap);
+    rebalancedBondMap = Teuchos::rcp_const_cast<Epetra_BlockMap>(bondContactMap);
+    rebalancedNeighborGlobalIDs = rebalancedNeighborGlobalIDList;
+  }
+  else{
+    oneDimensionalMapImporter = Teuchos::rcp(new Epetra_Import(*rebalancedOneDimensionalMap, *oneDimensionalContactMap));
 
-  Teuchos::RCP<Epetra_BlockMap> rebalancedBondMap = createRebalancedBondMap(rebalancedOneDimensionalMap, oneDimensionalMapImporter);
-  Teuchos::RCP<const Epetra_Import> bondMapImporter = Teuchos::rcp(new Epetra_Import(*rebalancedBondMap, *bondContactMap));
+    rebalancedThreeDimensionalMap = Teuchos::rcp(new Epetra_BlockMap(PdQuickGridDiscretization::getOwnedMap(comm, rebalancedDecomp, 3)));
+    threeDimensionalMapImporter = Teuchos::rcp(new Epetra_Import(*rebalancedThreeDimensionalMap, *threeDimensionalContactMap));
 
-  // create a list of neighbors in the rebalanced configuration
-  // this list has the global ID for each neighbor of each on-processor point (that is, on processor in the rebalanced configuration)
-  Teuchos::RCP<Epetra_Vector> rebalancedNeighborGlobalIDs = createRebalancedNeighborGlobalIDList(rebalancedBondMap, bondMapImporter);
+    rebalancedBondMap = createRebalancedBondMap(rebalancedOneDimensionalMap, oneDimensionalMapImporter);
+    Teuchos::RCP<const Epetra_Import> bondMapImporter = Teuchos::rcp(new Epetra_Import(*rebalancedBondMap, *bondContactMap));
+
+    // create a list of neighbors in the rebalanced configuration
+    // this list has the global ID for each neighbor of each on-processor point (that is, on processor in the rebalanced configuration)
+    rebalancedNeighborGlobalIDs = createRebalancedNeighborGlobalIDList(rebalancedBondMap, bondMapImporter);
+    rebalancedNeighborGlobalIDList = rebalancedNeighborGlobalIDs;
+  }
 
   // create a list of all the off-processor IDs that will need to be ghosted
   set<int> offProcessorIDs;
@@ -523,11 +662,36 @@ void PeridigmNS::ContactManager::rebalance(int step)
   // 3) keeps track of the additional off-processor IDs that need to be ghosted as a result of the contact search (offProcessorContactIDs)
   Teuchos::RCP< map<int, vector<int> > > contactNeighborGlobalIDs = Teuchos::rcp(new map<int, vector<int> >());
   Teuchos::RCP< set<int> > offProcessorContactIDs = Teuchos::rcp(new set<int>());
-  contactSearch(rebalancedOneDimensionalMap, rebalancedBondMap, rebalancedNeighborGlobalIDs, rebalancedDecomp, contactNeighborGlobalIDs, offProcessorContactIDs);
+  Teuchos::RCP<Epetra_Vector> rebalancedSurfaceCandidates;
+  if(contactSurfaceNeighborFraction > 0.0 || contactSurfaceDamageThreshold > 0.0){
+    Epetra_Vector surfaceCandidates(*oneDimensionalContactMap);
+    flagSurfaceCandidates(surfaceCandidates);
+    rebalancedSurfaceCandidates = Teuchos::rcp(new Epetra_Vector(*rebalancedOneDimensionalMap));
+    if(ownedPointsUnchanged)
+      *rebalancedSurfaceCandidates = surfaceCandidates;
+    else
+      rebalancedSurfaceCandidates->Import(surfaceCandidates, *oneDimensionalMapImporter, Insert);
+  }
+  Teuchos::RCP<Epetra_Vector> rebalancedBlockIDs;
+  if(contactBlockPairBroadPhase){
+    rebalancedBlockIDs = Teuchos::rcp(new Epetra_Vector(*rebalancedOneDimensionalMap));
+    if(ownedPointsUnchanged)
+      *rebalancedBlockIDs = *contactBlockIDs;
+    else
+      rebalancedBlockIDs->Import(*contactBlockIDs, *oneDimensionalMapImporter, Insert);
+  }
+  timer.stopTimer("Contact Maps");
+  timer.startTimer("Contact Search");
+  contactSearch(rebalancedOneDimensionalMap, rebalancedBondMap, rebalancedNeighborGlobalIDs, rebalancedSurfaceCandidates, rebalancedBlockIDs,
+                rebalancedDecomp, contactNeighborGlobalIDs, offProcessorContactIDs);
+  timer.stopTimer("Contact Search");
+  timer.startTimer("Contact Maps");
 
   // add the off-processor IDs required for contact to the list of points that will be ghosted
+  int numContactGhostPoints = 0;
   for(set<int>::const_iterator it=offProcessorContactIDs->begin() ; it!=offProcessorContactIDs->end() ; it++){
-    offProcessorIDs.insert(*it);
+    if(offProcessorIDs.insert(*it).second)
+      numContactGhostPoints++;
   }
 
   // construct the rebalanced overlap maps
@@ -559,30 +723,54 @@ void PeridigmNS::ContactManager::rebalance(int step)
                                                                     rebalancedOneDimensionalMap,
                                                                     rebalancedOneDimensionalOverlapMap);
   
-  // rebalance the mothership (global) contact vectors
-  Teuchos::RCP<Epetra_MultiVector> rebalancedOneDimensionalMothership = Teuchos::rcp(new Epetra_MultiVector(*rebalancedOneDimensionalMap, oneDimensionalContactMothership->NumVectors()));
-  rebalancedOneDimensionalMothership->Import(*oneDimensionalContactMothership, *oneDimensionalMapImporter, Insert);
-  oneDimensionalContactMothership = rebalancedOneDimensionalMothership;
-  contactBlockIDs = Teuchos::rcp((*oneDimensionalContactMothership)(0), false);         // block ID
-  contactVolume = Teuchos::rcp((*oneDimensionalContactMothership)(1), false);           // cell volume
+  // record the amount of data moved to this processor by the rebalance
+  double bytesMigrated = 0.0;
+  if(!ownedPointsUnchanged){
+    int bytesPerPoint = sizeof(double)*(oneDimensionalContactMothership->NumVectors() + 3*threeDimensionalContactMothership->NumVectors());
+    for(int i=0 ; i<rebalancedOneDimensionalMap->NumMyElements() ; ++i){
+      int globalID = rebalancedOneDimensionalMap->GID(i);
+      if(!oneDimensionalContactMap->MyGID(globalID)){
+        bytesMigrated += bytesPerPoint;
+        int bondMapLocalID = rebalancedBondMap->LID(globalID);
+        if(bondMapLocalID != -1)
+          bytesMigrated += sizeof(double)*rebalancedBondMap->ElementSize(bondMapLocalID);
+      }
+    }
+  }
 
-  Teuchos::RCP<Epetra_MultiVector> rebalancedThreeDimensionalMothership = Teuchos::rcp(new Epetra_MultiVector(*rebalancedThreeDimensionalMap, threeDimensionalContactMothership->NumVectors()));
-  rebalancedThreeDimensionalMothership->Import(*threeDimensionalContactMothership, *threeDimensionalMapImporter, Insert);
-  threeDimensionalContactMothership = rebalancedThreeDimensionalMothership;
-  contactY = Teuchos::rcp((*threeDimensionalContactMothership)(0), false);             // current positions
-  contactV = Teuchos::rcp((*threeDimensionalContactMothership)(1), false);             // velocities
-  contactContactForce = Teuchos::rcp((*threeDimensionalContactMothership)(2), false);  // contact force
-  contactScratch = Teuchos::rcp((*threeDimensionalContactMothership)(3), false);       // scratch
+  // rebalance the mothership (global) contact vectors
+  if(!ownedPointsUnchanged){
+    Teuchos::RCP<Epetra_MultiVector> rebalancedOneDimensionalMothership = Teuchos::rcp(new Epetra_MultiVector(*rebalancedOneDimensionalMap, oneDimensionalContactMothership->NumVectors()));
+    rebalancedOneDimensionalMothership->Import(*oneDimensionalContactMothership, *oneDimensionalMapImporter, Insert);
+    oneDimensionalContactMothership = rebalancedOneDimensionalMothership;
+    contactBlockIDs = Teuchos::rcp((*oneDimensionalContactMothership)(0), false);         // block ID
+    contactVolume = Teuchos::rcp((*oneDimensionalContactMothership)(1), false);           // cell volume
+    contactDamage = Teuchos::rcp((*oneDimensionalContactMothership)(2), false);           // damage
+
+    Teuchos::RCP<Epetra_MultiVector> rebalancedThreeDimensionalMothership = Teuchos::rcp(new Epetra_MultiVector(*rebalancedThreeDimensionalMap, threeDimensionalContactMothership->NumVectors()));
+    rebalancedThreeDimensionalMothership->Import(*threeDimensionalContactMothership, *threeDimensionalMapImporter, Insert);
+    threeDimensionalContactMothership = rebalancedThreeDimensionalMothership;
+    contactY = Teuchos::rcp((*threeDimensionalContactMothership)(0), false);             // current positions
+    contactV = Teuchos::rcp((*threeDimensionalContactMothership)(1), false);             // velocities
+    contactContactForce = Teuchos::rcp((*threeDimensionalContactMothership)(2), false);  // contact force
+    contactScratch = Teuchos::rcp((*threeDimensionalContactMothership)(3), false);       // scratch
+  }
 
-  // rebalance the contact blocks
-  for(contactBlockIt = contactBlocks->begin() ; contactBlockIt != contactBlocks->end() ; contactBlockIt++)
-    contactBlockIt->rebalance(rebalancedOneDimensionalMap,
-                              rebalancedOneDimensionalOverlapMap,
-                              rebalancedThreeDimensionalMap,
-                              rebalancedThreeDimensionalOverlapMap,
-                              rebalancedBondMap,
-                              contactBlockIDs,
-                              contactNeighborhoodData);
+  // rebalance the contact blocks; if the owned points are unchanged, only their overlap maps and ghosts are rebuilt
+  for(contactBlockIt = contactBlocks->begin() ; contactBlockIt != contactBlocks->end() ; contactBlockIt++){
+    if(ownedPointsUnchanged)
+      contactBlockIt->updateOverlap(rebalancedOneDimensionalOverlapMap,
+                                    contactBlockIDs,
+                                    contactNeighborhoodData);
+    else
+      contactBlockIt->rebalance(rebalancedOneDimensionalMap,
+                                rebalancedOneDimensionalOverlapMap,
+                                rebalancedThreeDimensionalMap,
+                                rebalancedThreeDimensionalOverlapMap,
+                                rebalancedBondMap,
+                                contactBlockIDs,
+                                contactNeighborhoodData);
+  }
 
   // Reload data from the contact manager's mothership vectors into the contact blocks
   // \todo Cut back on loading data, it's probably correct already depending on how rebalance is handled above.
@@ -601,8 +789,31 @@ void PeridigmNS::ContactManager::rebalance(int step)
   bondContactMap = rebalancedBondMap;
 
   // Reset the importers for passing data between the mothership and contact mothership vectors
-  oneDimensionalMothershipToContactMothershipImporter = Teuchos::rcp(new Epetra_Import(*oneDimensionalContactMap, *oneDimensionalMap));
-  threeDimensionalMothershipToContactMothershipImporter = Teuchos::rcp(new Epetra_Import(*threeDimensionalContactMap, *threeDimensionalMap));
+  if(!ownedPointsUnchanged){
+    oneDimensionalMothershipToContactMothershipImporter = Teuchos::rcp(new Epetra_Import(*oneDimensionalContactMap, *oneDimensionalMap));
+    threeDimensionalMothershipToContactMothershipImporter = Teuchos::rcp(new Epetra_Import(*threeDimensionalContactMap, *threeDimensionalMap));
+  }
+
+  // Record the positions used for this search; without a skin, only the fact that a search was performed is needed
+  if(contactVerletSkin > 0.0)
+    contactYAtLastSearch = Teuchos::rcp(new Epetra_Vector(*contactY));
+  else
+    contactYAtLastSearch = contactY;
+  if(repartition && contactRepartitionImbalanceThreshold > 0.0)
+    contactYAtLastRepartition = Teuchos::rcp(new Epetra_Vector(*contactY));
+  timer.stopTimer("Contact Maps");
+
+  // Store the statistics for this search; they are written at the next force evaluation, once the pairs within the contact radius are known
+  if(!contactStatisticsFileName.empty()){
+    contactStatisticsPending = true;
+    contactStatisticsStep = step;
+    contactStatisticsRepartitioned = repartition;
+    contactStatisticsGhostPoints = numContactGhostPoints;
+    contactStatisticsBytesMigrated = bytesMigrated;
+    contactStatisticsDecompositionTime = timer.elapsedTime("Contact Decomposition") - decompositionTime;
+    contactStatisticsSearchTime = timer.elapsedTime("Contact Search") - searchTime;
+    contactStatisticsMapTime = timer.elapsedTime("Contact Maps") - mapTime;
+  }
 }
 
 QUICKGRID::Data PeridigmNS::ContactManager::currentConfigurationDecomp() {
@@ -644,6 +855,37 @@ QUICKGRID::Data PeridigmNS::ContactManager::currentConfigurationDecomp() {
   return decomp;
 }
 
+QUICKGRID::Data PeridigmNS::ContactManager::currentConfigurationDecompWithoutRepartition() {
+
+  // Same as currentConfigurationDecomp(), but the points remain on their current processors and
+  // the Zoltan object from the last repartitioning is used to determine the off-processor points
+  int myNumElements = oneDimensionalContactMap->NumMyElements();
+  int dimension = 3;
+  QUICKGRID::Data decomp = QUICKGRID::allocatePdGridData(myNumElements, dimension);
+
+  decomp.globalNumPoints = oneDimensionalContactMap->NumGlobalElements();
+
+  UTILITIES::Array<int> myGlobalIDs(myNumElements);
+  memcpy(myGlobalIDs.get(), oneDimensionalContactMap->MyGlobalElements(), myNumElements*sizeof(int));
+  decomp.myGlobalIDs = myGlobalIDs.get_shared_ptr();
+
+  UTILITIES::Array<double> myX(myNumElements*dimension);
+  double* yPtr;
+  contactY->ExtractView(&yPtr);
+  memcpy(myX.get(), yPtr, myNumElements*dimension*sizeof(double));
+  decomp.myX = myX.get_shared_ptr();
+
+  UTILITIES::Array<double> cellVolume(myNumElements);
+  double* volumePtr;
+  contactVolume->ExtractView(&volumePtr);
+  memcpy(cellVolume.get(), volumePtr, myNumElements*sizeof(double));
+  decomp.cellVolume = cellVolume.get_shared_ptr();
+
+  decomp.zoltanPtr = contactZoltanPtr;
+
+  return decomp;
+}
+
 Teuchos::RCP<Epetra_BlockMap> PeridigmNS::ContactManager::createRebalancedBondMap(Teuchos::RCP<Epetra_BlockMap> rebalancedOneDimensionalMap,
                                                                                   Teuchos::RCP<const Epetra_Import> oneDimensionalMapToRebalancedOneDimensionalMapImporter) {
 
@@ -696,9 +938,59 @@ struct NonDeleter{
 	void operator()(T* d) {}
 };
 
+set< pair<int, int> > PeridigmNS::ContactManager::findActiveBlockPairs(const Epetra_Vector& blockIDs,
+                                                                      const vector<char>& searched,
+                                                                      const double* x,
+                                                                      double searchRadius) const
+{
+  // Compute the bounding box of the searched points in each block that is part of a contact interaction
+  map<int, int> blockIndex;
+  for(vector< boost::tuple<int, int, string> >::const_iterator it=contactInteractions.begin() ; it!=contactInteractions.end() ; it++){
+    int index = static_cast<int>(blockIndex.size());
+    blockIndex.insert(make_pair(it->get<0>(), index));
+    index = static_cast<int>(blockIndex.size());
+    blockIndex.insert(make_pair(it->get<1>(), index));
+  }
+  int numBlocks = static_cast<int>(blockIndex.size());
+  vector<double> localMin(3*numBlocks, DBL_MAX), localMax(3*numBlocks, -DBL_MAX);
+  for(size_t iPt=0 ; iPt<searched.size() ; ++iPt){
+    if(!searched[iPt])
+      continue;
+    map<int, int>::const_iterator it = blockIndex.find(static_cast<int>(blockIDs[iPt]));
+    if(it == blockIndex.end())
+      continue;
+    for(int dof=0 ; dof<3 ; ++dof){
+      localMin[3*it->second+dof] = min(localMin[3*it->second+dof], x[3*iPt+dof]);
+      localMax[3*it->second+dof] = max(localMax[3*it->second+dof], x[3*iPt+dof]);
+    }
+  }
+  vector<double> globalMin(3*numBlocks), globalMax(3*numBlocks);
+  if(numBlocks > 0){
+    blockIDs.Comm().MinAll(&localMin[0], &globalMin[0], 3*numBlocks);
+    blockIDs.Comm().MaxAll(&localMax[0], &globalMax[0], 3*numBlocks);
+  }
+
+  // A block pair is active if neither block is empty and the boxes are no further apart than the search radius
+  set< pair<int, int> > activeBlockPairs;
+  for(vector< boost::tuple<int, int, string> >::const_iterator it=contactInteractions.begin() ; it!=contactInteractions.end() ; it++){
+    int first = blockIndex[it->get<0>()];
+    int second = blockIndex[it->get<1>()];
+    bool active = globalMin[3*first] <= globalMax[3*first] && globalMin[3*second] <= globalMax[3*second];
+    for(int dof=0 ; dof<3 && active ; ++dof){
+      if(globalMin[3*second+dof] - globalMax[3*first+dof] > searchRadius || globalMin[3*first+dof] - globalMax[3*second+dof] > searchRadius)
+        active = false;
+    }
+    if(active)
+      activeBlockPairs.insert(make_pair(min(it->get<0>(), it->get<1>()), max(it->get<0>(), it->get<1>())));
+  }
+  return activeBlockPairs;
+}
+
 void PeridigmNS::ContactManager::contactSearch(Teuchos::RCP<const Epetra_BlockMap> rebalancedOneDimensionalMap, 
                                                Teuchos::RCP<const Epetra_BlockMap> rebalancedBondMap,
                                                Teuchos::RCP<const Epetra_Vector> rebalancedNeighborGlobalIDs,
+                                               Teuchos::RCP<const Epetra_Vector> rebalancedSurfaceCandidates,
+                                               Teuchos::RCP<const Epetra_Vector> rebalancedBlockIDs,
                                                QUICKGRID::Data& rebalancedDecomp,
                                                Teuchos::RCP< map<int, vector<int> > > contactNeighborGlobalIDs,
                                                Teuchos::RCP< set<int> > offProcessorContactIDs)
@@ -708,17 +1000,93 @@ void PeridigmNS::ContactManager::contactSearch(Teuchos::RCP<const Epetra_BlockMa
   std::tr1::shared_ptr<const Epetra_Comm> comm_shared_ptr(&comm,NonDeleter<const Epetra_Comm>());
   QUICKGRID::Data d = rebalancedDecomp;
 
+  // Every locally-owned point has an entry in the contact neighbor list, even if it is not searched
+  for(size_t iPt=0 ; iPt<d.numPoints ; ++iPt)
+    (*contactNeighborGlobalIDs)[d.myGlobalIDs.get()[iPt]];
+
+  double searchRadius = contactSearchRadius + contactVerletSkin + contactSearchRadiusExtension;
+
+  // If surface candidates were flagged, only the candidates take part in the search
+  vector<char> searched(d.numPoints, 1);
+  if(!rebalancedSurfaceCandidates.is_null()){
+    for(size_t iPt=0 ; iPt<d.numPoints ; ++iPt){
+      if((*rebalancedSurfaceCandidates)[iPt] == 0.0)
+        searched[iPt] = 0;
+    }
+  }
+
+  // Block-pair broad phase:  points in blocks that are not part of any potentially-interacting block pair are not searched,
+  // and if some pairs of the remaining blocks do not interact, the neighbors found by the search are filtered by block pair
+  set< pair<int, int> > activeBlockPairs;
+  bool filterBlockPairs = false;
+  if(!rebalancedBlockIDs.is_null()){
+    activeBlockPairs = findActiveBlockPairs(*rebalancedBlockIDs, searched, d.myX.get(), searchRadius);
+    set<int> activeBlocks;
+    for(set< pair<int, int> >::const_iterator it=activeBlockPairs.begin() ; it!=activeBlockPairs.end() ; ++it){
+      activeBlocks.insert(it->first);
+      activeBlocks.insert(it->second);
+    }
+    for(size_t iPt=0 ; iPt<d.numPoints ; ++iPt){
+      if(activeBlocks.find(static_cast<int>((*rebalancedBlockIDs)[iPt])) == activeBlocks.end())
+        searched[iPt] = 0;
+    }
+    filterBlockPairs = activeBlockPairs.size() != activeBlocks.size()*(activeBlocks.size()+1)/2;
+  }
+
+  size_t numSearched = 0;
+  for(size_t iPt=0 ; iPt<d.numPoints ; ++iPt){
+    if(searched[iPt])
+      numSearched++;
+  }
+  if(numSearched < d.numPoints){
+    UTILITIES::Array<int> searchedGlobalIDs(numSearched);
+    UTILITIES::Array<double> searchedX(3*numSearched);
+    size_t index = 0;
+    for(size_t iPt=0 ; iPt<d.numPoints ; ++iPt){
+      if(searched[iPt]){
+        searchedGlobalIDs.get()[index] = d.myGlobalIDs.get()[iPt];
+        for(int dof=0 ; dof<3 ; ++dof)
+          searchedX.get()[3*index+dof] = d.myX.get()[3*iPt+dof];
+        index++;
+      }
+    }
+    d.numPoints = numSearched;
+    d.myGlobalIDs = searchedGlobalIDs.get_shared_ptr();
+    d.myX = searchedX.get_shared_ptr();
+  }
+
   // TEMPORARY PLACEHOLDER FOR PER-NODE SEARCH RADII
-  Teuchos::RCP<Epetra_Vector> contactSearchRadii = Teuchos::rcp(new Epetra_Vector(*rebalancedOneDimensionalMap));
-  contactSearchRadii->PutScalar(contactSearchRadius);
+  Epetra_BlockMap searchMap(-1, static_cast<int>(d.numPoints), d.myGlobalIDs.get(), 1, 0, comm);
+  Teuchos::RCP<Epetra_Vector> contactSearchRadii = Teuchos::rcp(new Epetra_Vector(searchMap));
+  contactSearchRadii->PutScalar(searchRadius);
 
   PDNEIGH::NeighborhoodList neighList(comm_shared_ptr,d.zoltanPtr.get(),d.numPoints,d.myGlobalIDs,d.myX,contactSearchRadii);
 
   int* searchNeighborhood = neighList.get_neighborhood().get();
 
   int* searchGlobalIDs = neighList.get_owned_gids().get();
+
+  // Obtain the block ids of the neighbors found by the search, which may be off-processor
+  Teuchos::RCP<Epetra_BlockMap> neighborMap;
+  Teuchos::RCP<Epetra_Vector> neighborBlockIDs;
+  if(filterBlockPairs){
+    set<int> neighborGlobalIDSet;
+    int index = 0;
+    for(size_t iPt=0 ; iPt<d.numPoints ; ++iPt){
+      int numNeighbors = searchNeighborhood[index++];
+      for(int iNeighbor=0 ; iNeighbor<numNeighbors ; ++iNeighbor)
+        neighborGlobalIDSet.insert(searchNeighborhood[index++]);
+    }
+    vector<int> neighborGlobalIDs(neighborGlobalIDSet.begin(), neighborGlobalIDSet.end());
+    neighborMap = Teuchos::rcp(new Epetra_BlockMap(-1, static_cast<int>(neighborGlobalIDs.size()), neighborGlobalIDs.empty() ? 0 : &neighborGlobalIDs[0], 1, 0, comm));
+    neighborBlockIDs = Teuchos::rcp(new Epetra_Vector(*neighborMap));
+    Epetra_Import neighborImporter(*neighborMap, *rebalancedOneDimensionalMap);
+    neighborBlockIDs->Import(*rebalancedBlockIDs, neighborImporter, Insert);
+  }
+
   int searchListIndex = 0;
-  for(size_t iPt=0 ; iPt<rebalancedDecomp.numPoints ; ++iPt){
+  contactStatisticsCandidatePairs = 0.0;
+  for(size_t iPt=0 ; iPt<d.numPoints ; ++iPt){
 
     int globalID = searchGlobalIDs[iPt];
     vector<int>& contactNeighborGlobalIDList = (*contactNeighborGlobalIDs)[globalID];
@@ -736,11 +1104,21 @@ void PeridigmNS::ContactManager::contactSearch(Teuchos::RCP<const Epetra_BlockMa
       }
     }
 
+    int blockID = -1;
+    if(filterBlockPairs)
+      blockID = static_cast<int>( (*rebalancedBlockIDs)[rebalancedOneDimensionalMap->LID(globalID)] );
+
     // loop over the neighbors found by the contact search
     // retain only those neighbors that are not bonded
     int searchNumNeighbors = searchNeighborhood[searchListIndex++];
+    contactStatisticsCandidatePairs += searchNumNeighbors;
     for(int iNeighbor=0 ; iNeighbor<searchNumNeighbors ; ++iNeighbor){
       int globalNeighborID = searchNeighborhood[searchListIndex++];
+      if(filterBlockPairs){
+        int neighborBlockID = static_cast<int>( (*neighborBlockIDs)[neighborMap->LID(globalNeighborID)] );
+        if(activeBlockPairs.find(make_pair(min(blockID, neighborBlockID), max(blockID, neighborBlockID))) == activeBlockPairs.end())
+          continue;
+      }
       set<int>::iterator it = bondedNeighbors.find(globalNeighborID);  // \todo Don't consider broken bonds here
       if(it == bondedNeighbors.end()){
         contactNeighborGlobalIDList.push_back(globalNeighborID);
@@ -749,13 +1127,26 @@ void PeridigmNS::ContactManager::contactSearch(Teuchos::RCP<const Epetra_BlockMa
       }
     }
   }
+
+  // Record the contact work imbalance, which is used to decide whether to repartition at the next search
+  if(contactRepartitionImbalanceThreshold > 0.0){
+    double localWork = static_cast<double>(rebalancedDecomp.numPoints);
+    for(map<int, vector<int> >::const_iterator it=contactNeighborGlobalIDs->begin() ; it!=contactNeighborGlobalIDs->end() ; ++it)
+      localWork += it->second.size();
+    double maxWork, totalWork;
+    comm.MaxAll(&localWork, &maxWork, 1);
+    comm.SumAll(&localWork, &totalWork, 1);
+    contactWorkImbalance = 1.0;
+    if(totalWork > 0.0)
+      contactWorkImbalance = maxWork/(totalWork/comm.NumProc());
+  }
 }
 
 Teuchos::RCP<Epetra_Vector> PeridigmNS::ContactManager::createRebalancedNeighborGlobalIDList(Teuchos::RCP<Epetra_BlockMap> rebalancedBondMap,
                                                                                              Teuchos::RCP<const Epetra_Import> bondMapToRebalancedBondMapImporter) {
   // construct a globalID neighbor list in the static global decomposition
   Teuchos::RCP<Epetra_Vector> neighborGlobalIDs = Teuchos::rcp(new Epetra_Vector(*bondContactMap));
-  int* neighborhoodList = neighborhoodData->NeighborhoodList();
+  int* neighborhoodList = neighborhoodData->InterleavedNeighborhoodList();
   int neighborhoodListIndex = 0;
   int neighborGlobalIDIndex = 0;
   for(int i=0 ; i<neighborhoodData->NumOwnedPoints() ; ++i){
@@ -790,7 +1181,7 @@ Teuchos::RCP<PeridigmNS::NeighborhoodData> PeridigmNS::ContactManager::createReb
   }
   rebalancedNeighborhoodData->SetNeighborhoodListSize(rebalancedOneDimensionalMap->NumMyElements() + rebalancedBondMap->NumMyPoints());
   // numNeighbors1, n1LID, n2LID, n3LID, numNeighbors2, n1LID, n2LID, ...
-  int* neighborhoodList = rebalancedNeighborhoodData->NeighborhoodList();
+  int* neighborhoodList = rebalancedNeighborhoodData->InterleavedNeighborhoodList();
   // points into neighborhoodList, gives start of neighborhood information for each locally-owned element
   int* neighborhoodPtr = rebalancedNeighborhoodData->NeighborhoodPtr();
   // gives the offset at which the list of neighbors can be found in the rebalancedNeighborGlobalIDs vector for each locally-owned element
@@ -844,7 +1235,7 @@ Teuchos::RCP<PeridigmNS::NeighborhoodData> PeridigmNS::ContactManager::createReb
 		neighborhoodListSize += it->second.size() + 1;
 	rebalancedContactNeighborhoodData->SetNeighborhoodListSize(neighborhoodListSize);
 	// numNeighbors1, n1LID, n2LID, n3LID, numNeighbors2, n1LID, n2LID, ...
-	int* neighborhoodList = rebalancedContactNeighborhoodData->NeighborhoodList();
+	int* neighborhoodList = rebalancedContactNeighborhoodData->InterleavedNeighborhoodList();
 	// points into neighborhoodList, gives start of neighborhood information for each locally-owned element
 	int* neighborhoodPtr = rebalancedContactNeighborhoodData->NeighborhoodPtr();
 	// loop over locally owned points
@@ -870,12 +1261,13 @@ Teuchos::RCP<PeridigmNS::NeighborhoodData> PeridigmNS::ContactManager::createReb
 
 void PeridigmNS::ContactManager::evaluateContactForce(double dt)
 {
+  PeridigmNS::Timer::self().startTimer("Contact Force");
   for(contactBlockIt = contactBlocks->begin() ; contactBlockIt != contactBlocks->end() ; contactBlockIt++){
 
     Teuchos::RCP<PeridigmNS::NeighborhoodData> nData = contactBlockIt->getNeighborhoodData();
     const int numOwnedPoints = nData->NumOwnedPoints();
     const int* ownedIDs = nData->OwnedIDs();
-    const int* neighborhoodList = nData->NeighborhoodList();
+    const int* neighborhoodList = nData->InterleavedNeighborhoodList();
     Teuchos::RCP<PeridigmNS::DataManager> dataManager = contactBlockIt->getDataManager();
     Teuchos::RCP<const PeridigmNS::ContactModel> contactModel = contactBlockIt->getContactModel();
 
@@ -886,4 +1278,64 @@ void PeridigmNS::ContactManager::evaluateContactForce(double dt)
                                  neighborhoodList,
                                  *dataManager);
   }
+  PeridigmNS::Timer::self().stopTimer("Contact Force");
+
+  if(contactStatisticsPending)
+    writeContactStatistics();
+}
+
+void PeridigmNS::ContactManager::writeContactStatistics()
+{
+  // Count the contact pairs that are within the contact radius of the model of the block that owns the first point
+  double localPairsInContactRadius = 0.0;
+  double maxContactRadius = 0.0;
+  for(contactBlockIt = contactBlocks->begin() ; contactBlockIt != contactBlocks->end() ; contactBlockIt++){
+    double contactRadius = contactStatisticsContactRadii[contactBlockIt - contactBlocks->begin()];
+    double contactRadiusSquared = contactRadius*contactRadius;
+    maxContactRadius = std::max(maxContactRadius, contactRadius);
+    Teuchos::RCP<PeridigmNS::NeighborhoodData> nData = contactBlockIt->getNeighborhoodData();
+    const int* ownedIDs = nData->OwnedIDs();
+    const int* neighborhoodList = nData->InterleavedNeighborhoodList();
+    double* y;
+    contactBlockIt->getDataManager()->getData(coordinatesFieldId, PeridigmField::STEP_NP1)->ExtractView(&y);
+    int neighborhoodListIndex = 0;
+    for(int iID=0 ; iID<nData->NumOwnedPoints() ; ++iID){
+      int nodeID = ownedIDs[iID];
+      int numNeighbors = neighborhoodList[neighborhoodListIndex++];
+      for(int iNID=0 ; iNID<numNeighbors ; ++iNID){
+        int neighborID = neighborhoodList[neighborhoodListIndex++];
+        double dx = y[3*neighborID]   - y[3*nodeID];
+        double dy = y[3*neighborID+1] - y[3*nodeID+1];
+        double dz = y[3*neighborID+2] - y[3*nodeID+2];
+        if(dx*dx + dy*dy + dz*dz < contactRadiusSquared)
+          localPairsInContactRadius += 1.0;
+      }
+    }
+  }
+
+  const Epetra_Comm& comm = oneDimensionalMap->Comm();
+  double forceTime = PeridigmNS::Timer::self().elapsedTime("Contact Force");
+  double localCounts[4] = {contactStatisticsCandidatePairs, localPairsInContactRadius, contactStatisticsGhostPoints, contactStatisticsBytesMigrated};
+  double globalCounts[4];
+  comm.SumAll(localCounts, globalCounts, 4);
+  double localTimes[4] = {contactStatisticsDecompositionTime, contactStatisticsSearchTime, contactStatisticsMapTime, forceTime - contactStatisticsForceTime};
+  double globalTimes[4];
+  comm.MaxAll(localTimes, globalTimes, 4);
+  contactStatisticsForceTime = forceTime;
+  contactStatisticsPending = false;
+
+  if(myPID == 0){
+    ofstream out(contactStatisticsFileName.c_str(), contactStatisticsHeaderWritten ? ios::app : ios::trunc);
+    if(!contactStatisticsHeaderWritten)
+      out << "Step,Repartitioned,Contact Radius,Candidate Pairs,Pairs In Contact Radius,Contact Ghost Points,Bytes Migrated,"
+          << "Decomposition Time,Search Time,Map Time,Force Time" << endl;
+    out << contactStatisticsStep << "," << (contactStatisticsRepartitioned ? 1 : 0) << "," << maxContactRadius;
+    for(int i=0 ; i<4 ; ++i)
+      out << "," << static_cast<long long>(globalCounts[i]);
+    for(int i=0 ; i<4 ; ++i)
+      out << "," << globalTimes[i];
+    out << endl;
+  }
+  contactStatisticsHeaderWritten = true;
+
 }
@@ -50,6 +50,7 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include "boost/tuple/tuple.hpp"
 #include "boost/tuple/tuple_comparison.hpp"
 #include <Teuchos_ParameterList.hpp>
@@ -114,9 +115,42 @@ namespace PeridigmNS {
 
     void exportData(Teuchos::RCP<Epetra_Vector> contactForce);
 
+    //! Returns true if damage is used to select the points that take part in the contact search.
+    bool requiresDamage() const { return contactSurfaceDamageThreshold > 0.0; }
+
+    //! Import the damage at each point; required prior to rebalance() if requiresDamage() is true.
+    void importDamage(Teuchos::RCP<Epetra_Vector> damage);
+
     Teuchos::RCP< std::vector<PeridigmNS::ContactBlock> > getContactBlocks(){ return contactBlocks; };
 
-    void rebalance(int step);
+    /*! \brief Repartitions the contact data and performs a contact search, if required.
+     *
+     *  A search is performed every "Search Frequency" steps.  If a "Verlet Skin" is specified, the search
+     *  radius is extended by the skin and a search is also performed whenever a point has moved more than
+     *  half the skin since the last search; in that case "Search Frequency" is optional.
+     *
+     *  If a "Repartition Imbalance Threshold" is specified, the points are repartitioned only if the contact work
+     *  imbalance found by the previous search (maximum over the mean) exceeds the threshold.  Otherwise the contact
+     *  neighbor list is refreshed in the existing partitioning, with the search radius extended by the distance the
+     *  points have moved since the last repartitioning.
+     *
+     *  If a "Surface Neighbor Fraction" or a "Surface Damage Threshold" is specified, only surface candidates take part
+     *  in the search.  A point is a candidate if it has fewer bonds than the given fraction of the bulk (largest) number
+     *  of bonds in its block, or if its damage is at least the given threshold.  Either criterion can be used alone.
+     *  The candidates are determined anew at each search.
+     *
+     *  If "Block Pair Broad Phase" is true, the bounding box of the contact points in each block is computed prior to
+     *  the search.  Only block pairs listed in the contact interactions whose boxes are within the search radius of each
+     *  other are searched, and contact neighbors are retained only for those block pairs.
+     *
+     *  If a "Statistics File" is specified, a line is appended to that CSV file for each search, at the first force
+     *  evaluation after the search.  It contains the contact radius (the largest over the contact blocks), the global
+     *  number of candidate pairs found by the search, the number of pairs within the contact radius of the model of the
+     *  block that owns the first point of the pair, the number of points ghosted for contact, the number of bytes
+     *  migrated, and the maximum time over the processors spent on decomposition, search, and map construction.  The
+     *  force time is the time spent evaluating contact forces since the previous search.
+     */
+    void rebalance(long long step);
 
     void evaluateContactForce(double dt);
 
@@ -139,6 +173,18 @@ namespace PeridigmNS {
     //! Compute a parallel decomposion based on the current configuration
     QUICKGRID::Data currentConfigurationDecomp();
 
+    //! Append the statistics for the last search to the statistics file; must be called on all processors.
+    void writeContactStatistics();
+
+    //! Set the entries of the given vector (on oneDimensionalContactMap) to 1.0 for surface candidates and 0.0 otherwise.
+    void flagSurfaceCandidates(Epetra_Vector& surfaceCandidates) const;
+
+    //! Maximum distance any point has moved since the given positions were recorded.
+    double maxDisplacementSince(const Epetra_Vector& referencePositions) const;
+
+    //! Create a decomposition object for the current configuration that retains the current partitioning
+    QUICKGRID::Data currentConfigurationDecompWithoutRepartition();
+
     //! Create a rebalanced bond map
     Teuchos::RCP<Epetra_BlockMap> createRebalancedBondMap(Teuchos::RCP<Epetra_BlockMap> rebalancedOneDimensionalMap,
                                                           Teuchos::RCP<const Epetra_Import> oneDimensionalMapToRebalancedOneDimensionalMapImporter);
@@ -157,10 +203,18 @@ namespace PeridigmNS {
     void contactSearch(Teuchos::RCP<const Epetra_BlockMap> rebalancedOneDimensionalMap,
                        Teuchos::RCP<const Epetra_BlockMap> rebalancedBondMap,
                        Teuchos::RCP<const Epetra_Vector> rebalancedNeighborGlobalIDs,
+                       Teuchos::RCP<const Epetra_Vector> rebalancedSurfaceCandidates,
+                       Teuchos::RCP<const Epetra_Vector> rebalancedBlockIDs,
                        QUICKGRID::Data& rebalancedDecomp,
                        Teuchos::RCP< std::map<int, std::vector<int> > > contactNeighborGlobalIDs,
                        Teuchos::RCP< std::set<int> > offProcessorContactIDs);
 
+    //! Find the interacting block pairs, stored as (smaller id, larger id), whose searched points have bounding boxes within the search radius of each other
+    std::set< std::pair<int, int> > findActiveBlockPairs(const Epetra_Vector& blockIDs,
+                                                         const std::vector<char>& searched,
+                                                         const double* x,
+                                                         double searchRadius) const;
+
     //! Create a rebalanced NeighborhoodData object for contact
     Teuchos::RCP<PeridigmNS::NeighborhoodData> createRebalancedContactNeighborhoodData(Teuchos::RCP<std::map<int, std::vector<int> > > contactNeighborGlobalIDs,
                                                                                        Teuchos::RCP<const Epetra_BlockMap> rebalancedOneDimensionalMap,
@@ -192,12 +246,64 @@ namespace PeridigmNS {
     //! List of neighbors for all locally-owned nodes, stored in current configuration
     Teuchos::RCP<PeridigmNS::NeighborhoodData> contactNeighborhoodData;
 
+    //! Global IDs of the bonded neighbors of the locally-owned points, on bondContactMap; reused by rebalance() if the owned points do not change
+    Teuchos::RCP<Epetra_Vector> rebalancedNeighborGlobalIDList;
+
     //! Contact search frequency
     int contactRebalanceFrequency;
 
     //! Contact search radius
     double contactSearchRadius;
 
+    //! Verlet skin distance added to the contact search radius; zero if the skin is not used
+    double contactVerletSkin;
+
+    //! Positions of the points at the last contact search, on threeDimensionalContactMap
+    Teuchos::RCP<Epetra_Vector> contactYAtLastSearch;
+
+    //! Contact work imbalance above which the points are repartitioned; zero if the points are repartitioned at every search
+    double contactRepartitionImbalanceThreshold;
+
+    //! Contact work imbalance (maximum over mean) found by the last contact search
+    double contactWorkImbalance;
+
+    //! Amount by which the search radius is extended to account for motion since the last repartitioning
+    double contactSearchRadiusExtension;
+
+    //! Positions of the points at the last repartitioning, on threeDimensionalContactMap
+    Teuchos::RCP<Epetra_Vector> contactYAtLastRepartition;
+
+    //! Zoltan object holding the partitioning from the last repartitioning, used for ghosting when searching without repartitioning
+    std::tr1::shared_ptr<struct Zoltan_Struct> contactZoltanPtr;
+
+    //! Fraction of the bulk number of bonds below which a point is a surface candidate; zero if all points are searched
+    double contactSurfaceNeighborFraction;
+
+    //! Damage at or above which a point is a surface candidate; zero if damage is not considered
+    double contactSurfaceDamageThreshold;
+
+    //! Flag for restricting the search to interacting block pairs with overlapping bounding boxes
+    bool contactBlockPairBroadPhase;
+
+    //! @name Contact statistics; the counts and times are local to this processor
+    //@{
+    std::string contactStatisticsFileName;
+    bool contactStatisticsPending;
+    bool contactStatisticsHeaderWritten;
+    long long contactStatisticsStep;
+    bool contactStatisticsRepartitioned;
+    double contactStatisticsCandidatePairs;
+    double contactStatisticsGhostPoints;
+    double contactStatisticsBytesMigrated;
+    double contactStatisticsDecompositionTime;
+    double contactStatisticsSearchTime;
+    double contactStatisticsMapTime;
+    //! Value of the "Contact Force" timer when the last statistics were written
+    double contactStatisticsForceTime;
+    //! Contact radius of the model of each contact block, in the order of contactBlocks, used to count the pairs in contact
+    std::vector<double> contactStatisticsContactRadii;
+    //@}
+
     //! Contact models
     std::map< std::string, Teuchos::RCP<const PeridigmNS::ContactModel> > contactModels;
 
@@ -216,6 +322,9 @@ namespace PeridigmNS {
     //! Global contact vector for volume
     Teuchos::RCP<Epetra_Vector> contactVolume;
 
+    //! Global contact vector for damage
+    Teuchos::RCP<Epetra_Vector> contactDamage;
+
     //! Global contact vector for current position
     Teuchos::RCP<Epetra_Vector> contactY;
 
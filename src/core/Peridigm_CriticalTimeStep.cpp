@@ -57,7 +57,8 @@ double PeridigmNS::ComputeCriticalTimeStep(const Epetra_Comm& comm, PeridigmNS::
   Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = block.getNeighborhoodData();
   const int numOwnedPoints = neighborhoodData->NumOwnedPoints();
   const int* ownedIDs = neighborhoodData->OwnedIDs();
-  const int* neighborhoodList = neighborhoodData->NeighborhoodList();
+  std::vector<int> neighborhoodListBuffer;
+  const int* neighborhoodList = neighborhoodData->NeighborhoodList(neighborhoodListBuffer);
   Teuchos::RCP<const PeridigmNS::Material> materialModel = block.getMaterialModel();
 
   double density = materialModel()->Density();
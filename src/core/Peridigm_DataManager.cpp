@@ -45,6 +45,7 @@
 // ************************************************************************
 //@HEADER
 
+#include <cstring>
 #include <Teuchos_Exceptions.hpp>
 #include <Epetra_Import.h>
 #include <Epetra_Comm.h>
@@ -464,6 +465,103 @@ void PeridigmNS::DataManager::rebalance(Teuchos::RCP<const Epetra_BlockMap> reba
   ownedBondMap = rebalancedOwnedBondMap;
 }
 
+void PeridigmNS::DataManager::updateOverlapMaps(Teuchos::RCP<const Epetra_BlockMap> updatedOverlapScalarPointMap,
+                                                Teuchos::RCP<const Epetra_BlockMap> updatedOverlapVectorPointMap)
+{
+  int numOwnedPoints = ownedScalarPointMap->NumMyElements();
+  int numGlobalElements = updatedOverlapScalarPointMap->NumGlobalElements();
+  int numMyElements = updatedOverlapScalarPointMap->NumMyElements();
+  int* myGlobalElements = updatedOverlapScalarPointMap->MyGlobalElements();
+  int indexBase(0);
+
+  map< PeridigmField::Length, vector<int> >::iterator it;
+  Teuchos::RCP<const Epetra_BlockMap> map;
+
+  for(int iState=0 ; iState<3 ; ++iState){
+
+    Teuchos::RCP<State> state;
+    std::map< PeridigmField::Length, vector<int> > *pointFieldIds(NULL);
+    vector<int> *bondFieldIds(NULL);
+    if(iState == 0){
+      state = stateNONE;
+      pointFieldIds = &statelessPointFieldIds;
+      bondFieldIds = &statelessBondFieldIds;
+    }
+    else if(iState == 1){
+      state = stateN;
+      pointFieldIds = &statefulPointFieldIds;
+      bondFieldIds = &statefulBondFieldIds;
+    }
+    else if(iState == 2){
+      state = stateNP1;
+      pointFieldIds = &statefulPointFieldIds;
+      bondFieldIds = &statefulBondFieldIds;
+    }
+
+    if(!state.is_null()){
+
+      Teuchos::RCP<State> updatedState = Teuchos::rcp(new State);
+
+      // Allocate point-wise data on the new overlap maps and copy the owned entries, which are at the front of both maps
+      for(it = pointFieldIds->begin() ; it != pointFieldIds->end() ; ++it){
+        PeridigmField::Length length = it->first;
+        vector<int>& fieldIds = it->second;
+        if(length == PeridigmField::SCALAR)
+          map = updatedOverlapScalarPointMap;
+        else if(length == PeridigmField::VECTOR)
+          map = updatedOverlapVectorPointMap;
+        else
+          map = Teuchos::RCP<Epetra_BlockMap>(new Epetra_BlockMap(numGlobalElements,
+                                                                  numMyElements,
+                                                                  myGlobalElements,
+                                                                  PeridigmField::variableDimension(length),
+                                                                  indexBase,
+                                                                  *getEpetraComm()));
+        updatedState->allocatePointData(length, fieldIds, map);
+        Epetra_MultiVector& source = *state->getPointMultiVector(length);
+        Epetra_MultiVector& target = *updatedState->getPointMultiVector(length);
+        int numOwnedEntries = numOwnedPoints*PeridigmField::variableDimension(length);
+        for(int iVec=0 ; iVec<source.NumVectors() ; ++iVec)
+          memcpy(target[iVec], source[iVec], numOwnedEntries*sizeof(double));
+      }
+
+      // The bond map is unchanged
+      if(bondFieldIds->size() > 0){
+        updatedState->allocateBondData(*bondFieldIds, ownedBondMap);
+        *updatedState->getBondMultiVector() = *state->getBondMultiVector();
+      }
+
+      if(iState == 0)
+        stateNONE = updatedState;
+      else if(iState == 1)
+        stateN = updatedState;
+      else if(iState == 2)
+        stateNP1 = updatedState;
+    }
+  }
+
+  overlapScalarPointMap = updatedOverlapScalarPointMap;
+  overlapVectorPointMap = updatedOverlapVectorPointMap;
+
+  scatterToGhosts();
+}
+
+void PeridigmNS::DataManager::compactBondData(Teuchos::RCP<const Epetra_BlockMap> compactedOwnedBondMap,
+                                              const std::vector<int>& retainedBondIndices)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(compactedOwnedBondMap->NumMyPoints() != static_cast<int>(retainedBondIndices.size()), Teuchos::RangeError,
+                             "Error in PeridigmNS::DataManager::compactBondData(), compacted bond map is inconsistent with list of retained bonds.");
+
+  if(statelessBondFieldIds.size() > 0)
+    stateNONE->compactBondData(compactedOwnedBondMap, retainedBondIndices);
+  if(statefulBondFieldIds.size() > 0){
+    stateN->compactBondData(compactedOwnedBondMap, retainedBondIndices);
+    stateNP1->compactBondData(compactedOwnedBondMap, retainedBondIndices);
+  }
+
+  ownedBondMap = compactedOwnedBondMap;
+}
+
 Teuchos::RCP<const Epetra_Comm> PeridigmNS::DataManager::getEpetraComm()
 {
   Teuchos::RCP<const Epetra_Comm> comm;
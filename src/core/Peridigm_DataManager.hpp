@@ -112,6 +112,22 @@ public:
                  Teuchos::RCP<const Epetra_BlockMap> rebalancedOverlapVectorPointMap,
                  Teuchos::RCP<const Epetra_BlockMap> rebalancedOwnedBondMap);
 
+  /*! \brief Moves the point data onto new overlap maps when the owned points are unchanged and only the ghosts differ.
+   *
+   * The owned points come first in both the old and the new overlap maps, so the owned data are copied in place and
+   * the ghosts are filled by scatterToGhosts().  The bond data are unchanged.
+   */
+  void updateOverlapMaps(Teuchos::RCP<const Epetra_BlockMap> updatedOverlapScalarPointMap,
+                         Teuchos::RCP<const Epetra_BlockMap> updatedOverlapVectorPointMap);
+
+  /*! \brief Discards bond data for bonds that have been removed from the neighborhood list.
+   *
+   * The bond data in each State is reallocated on the given compacted bond map.  The i-th bond
+   * in the compacted bond data is copied from bond retainedBondIndices[i] of the original bond data.
+   */
+  void compactBondData(Teuchos::RCP<const Epetra_BlockMap> compactedOwnedBondMap,
+                       const std::vector<int>& retainedBondIndices);
+
   //! Returns the number of times rebalance has been called.
   int getRebalanceCount(){ return rebalanceCount; }
 
@@ -183,6 +199,14 @@ public:
 	  getStateN()->readStateData(getStateN(),"StateN",blockName,path);
 	  getStateNP1()->readStateData(getStateNP1(),"StateNP1",blockName,path);
   }
+  void writeBlocktoDisk(std::string blockName, BinaryRestartWriter& writer){
+    getStateN()->writeStateData(writer,"StateN",blockName);
+    getStateNP1()->writeStateData(writer,"StateNP1",blockName);
+  }
+  void readBlockfromDisk(std::string blockName, BinaryRestartReader& reader){
+    getStateN()->readStateData(reader,"StateN",blockName);
+    getStateNP1()->readStateData(reader,"StateNP1",blockName);
+  }
 
 protected:
 
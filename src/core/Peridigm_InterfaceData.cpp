@@ -46,6 +46,7 @@
 //@HEADER
 
 #include <Peridigm_InterfaceData.hpp>
+#include <Peridigm_ExodusMutex.hpp>
 #include <exodusII.h>
 #include <Epetra_Import.h>
 
@@ -138,6 +139,7 @@ PeridigmNS::InterfaceData::InitializeExodusOutput(Teuchos::RCP<Epetra_Vector> ex
   int CPU_word_size = 0;
   int IO_word_size = 0;
   /* create EXODUS II file */
+  boost::mutex::scoped_lock exodusLock(exodusMutex());
   const int output_exoid = ex_create (&writable[0],EX_CLOBBER,&CPU_word_size, &IO_word_size);
   exoid = output_exoid;
 
@@ -282,6 +284,7 @@ PeridigmNS::InterfaceData::WriteExodusOutput(int timeStep, const float & timeVal
   std::vector<char> writable(outputFileNameStr.size() + 1);
   std::copy(outputFileNameStr.begin(), outputFileNameStr.end(), writable.begin());
 
+  boost::mutex::scoped_lock exodusLock(exodusMutex());
   exoid = ex_open(&writable[0], EX_WRITE, &CPU_word_size, &IO_word_size, &version);
 
   error_int = ex_put_time(exoid, timeStep, &timeValue);
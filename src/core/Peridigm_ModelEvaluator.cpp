@@ -68,14 +68,9 @@ PeridigmNS::ModelEvaluator::evalModel(Teuchos::RCP<Workset> workset) const
     Teuchos::RCP<const PeridigmNS::DamageModel> damageModel = blockIt->getDamageModel();
     if(!damageModel.is_null()){
       Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
-      const int numOwnedPoints = neighborhoodData->NumOwnedPoints();
-      const int* ownedIDs = neighborhoodData->OwnedIDs();
-      const int* neighborhoodList = neighborhoodData->NeighborhoodList();
       Teuchos::RCP<PeridigmNS::DataManager> dataManager = blockIt->getDataManager();
-      damageModel->computeDamage(dt, 
-                                 numOwnedPoints,
-                                 ownedIDs,
-                                 neighborhoodList,
+      damageModel->computeDamage(dt,
+                                 *neighborhoodData,
                                  *dataManager);
     }
   }
@@ -85,16 +80,11 @@ PeridigmNS::ModelEvaluator::evalModel(Teuchos::RCP<Workset> workset) const
   for(blockIt = workset->blocks->begin() ; blockIt != workset->blocks->end() ; blockIt++){
 
     Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
-    const int numOwnedPoints = neighborhoodData->NumOwnedPoints();
-    const int* ownedIDs = neighborhoodData->OwnedIDs();
-    const int* neighborhoodList = neighborhoodData->NeighborhoodList();
     Teuchos::RCP<PeridigmNS::DataManager> dataManager = blockIt->getDataManager();
     Teuchos::RCP<const PeridigmNS::Material> materialModel = blockIt->getMaterialModel();
 
-    materialModel->computeForce(dt, 
-                                numOwnedPoints,
-                                ownedIDs,
-                                neighborhoodList,
+    materialModel->computeForce(dt,
+                                *neighborhoodData,
                                 *dataManager);
   }
 
@@ -118,7 +108,8 @@ PeridigmNS::ModelEvaluator::evalJacobian(Teuchos::RCP<Workset> workset) const
     Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
     const int numOwnedPoints = neighborhoodData->NumOwnedPoints();
     const int* ownedIDs = neighborhoodData->OwnedIDs();
-    const int* neighborhoodList = neighborhoodData->NeighborhoodList();
+    std::vector<int> neighborhoodListBuffer;
+    const int* neighborhoodList = neighborhoodData->NeighborhoodList(neighborhoodListBuffer);
     Teuchos::RCP<PeridigmNS::DataManager> dataManager = blockIt->getDataManager();
     Teuchos::RCP<const PeridigmNS::Material> materialModel = blockIt->getMaterialModel();
 
@@ -48,23 +48,99 @@
 #ifndef PERIDIGM_NEIGHBORHOODDATA_HPP
 #define PERIDIGM_NEIGHBORHOODDATA_HPP
 
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <Teuchos_Assert.hpp>
+
 namespace PeridigmNS {
 
+/*! \brief Neighborhood lists for the points owned by a processor.
+ *
+ * The neighborhood list is loaded in the interleaved format [n0, ids..., n1, ids..., ...], where
+ * neighborhoodPtr gives the location of the neighbor count for each owned point.  UpdateCSR() converts
+ * the list, in place, to compressed sparse row (CSR) form, given by BondOffsets() and NeighborIndices().
+ * In the CSR form, the neighbors of owned point i are NeighborIndices()[BondOffsets()[i]] through
+ * NeighborIndices()[BondOffsets()[i+1]-1], and the position in NeighborIndices() is the bond index
+ * into bond data.  The CSR form allows any range of points to be processed independently.
+ * InterleavedNeighborhoodList() gives access to the interleaved list while it is being loaded; once
+ * the CSR form has been built, code that requires the interleaved format obtains it through
+ * NeighborhoodList(std::vector<int>&), which rebuilds it in a buffer.
+ *
+ * NeighborhoodData can also be constructed as a view of an interleaved list owned by the caller.  Only
+ * the bond offsets are computed, and NeighborIndices(firstPoint, lastPoint, buffer) gathers the neighbors
+ * of each block of points into the buffer, so the interleaved entry points of the materials and damage
+ * models do not copy the list.
+ *
+ * For memory-bound runs with large horizons, Compress() replaces the CSR neighbor indices with a
+ * delta-encoded, variable-length byte stream.  Each neighbor is stored as the zigzag-encoded difference
+ * from the previous neighbor (the first neighbor is relative to the point itself), which takes a single
+ * byte for nearby points.  Kernels access the neighbor indices for a range of points through
+ * NeighborIndices(firstPoint, lastPoint, buffer), which decodes into the buffer when the data are
+ * compressed.  The order of the neighbors, and thus the bond indexing, is unchanged by compression.
+ * SortNeighbors() orders the neighbors of each point beforehand, which keeps the deltas small; it
+ * returns the bond permutation so that the owner of the bond data can reorder it to match.
+ */
 class NeighborhoodData {
 
 public:
 
   NeighborhoodData() 
-    : numOwnedPoints(0), ownedIDs(0), neighborhoodListSize(0), neighborhoodList(0), neighborhoodPtr(0) {}
+    : numOwnedPoints(0), ownedIDs(0), neighborhoodListSize(0), neighborhoodList(0), neighborhoodPtr(0), numBonds(0), bondOffsets(0), neighborIndices(0), interleavedView(0), compressedNeighborsSize(0), compressedOffsets(0), compressedNeighbors(0) {}
 
   NeighborhoodData(const NeighborhoodData& other)
-    : numOwnedPoints(0), ownedIDs(0), neighborhoodListSize(0), neighborhoodList(0), neighborhoodPtr(0)
+    : numOwnedPoints(0), ownedIDs(0), neighborhoodListSize(0), neighborhoodList(0), neighborhoodPtr(0), numBonds(0), bondOffsets(0), neighborIndices(0), interleavedView(0), compressedNeighborsSize(0), compressedOffsets(0), compressedNeighbors(0)
   {
     SetNumOwned(other.NumOwnedPoints());
-    SetNeighborhoodListSize(other.NeighborhoodListSize());
     memcpy(ownedIDs, other.ownedIDs, numOwnedPoints*sizeof(int));
     memcpy(neighborhoodPtr, other.neighborhoodPtr, numOwnedPoints*sizeof(int));
-    memcpy(neighborhoodList, other.neighborhoodList, neighborhoodListSize*sizeof(int));
+    neighborhoodListSize = other.neighborhoodListSize;
+    numBonds = other.numBonds;
+    interleavedView = other.interleavedView;
+    // Copy the data in whichever representation it is stored
+    if(other.neighborhoodList != 0){
+      neighborhoodList = new int[neighborhoodListSize];
+      memcpy(neighborhoodList, other.neighborhoodList, neighborhoodListSize*sizeof(int));
+    }
+    if(other.bondOffsets != 0){
+      bondOffsets = new int[numOwnedPoints+1];
+      memcpy(bondOffsets, other.bondOffsets, (numOwnedPoints+1)*sizeof(int));
+    }
+    if(other.neighborIndices != 0){
+      neighborIndices = new int[neighborhoodListSize > 0 ? neighborhoodListSize : 1];
+      memcpy(neighborIndices, other.neighborIndices, numBonds*sizeof(int));
+    }
+    if(other.compressedNeighbors != 0){
+      compressedNeighborsSize = other.compressedNeighborsSize;
+      compressedOffsets = new int[numOwnedPoints+1];
+      memcpy(compressedOffsets, other.compressedOffsets, (numOwnedPoints+1)*sizeof(int));
+      compressedNeighbors = new unsigned char[compressedNeighborsSize > 0 ? compressedNeighborsSize : 1];
+      memcpy(compressedNeighbors, other.compressedNeighbors, compressedNeighborsSize);
+    }
+  }
+
+  /*! \brief Creates a view of an interleaved neighborhood list, which must outlive the NeighborhoodData.
+   *
+   *  The owned IDs are copied and the bond offsets are computed, but the list itself is not copied.
+   *  UpdateCSR() and Compress() copy the list before converting it.
+   */
+  NeighborhoodData(int numOwned, const int* ownedIDList, const int* neighborhoodListInterleaved)
+    : numOwnedPoints(0), ownedIDs(0), neighborhoodListSize(0), neighborhoodList(0), neighborhoodPtr(0), numBonds(0), bondOffsets(0), neighborIndices(0), interleavedView(0), compressedNeighborsSize(0), compressedOffsets(0), compressedNeighbors(0)
+  {
+    SetNumOwned(numOwned);
+    bondOffsets = new int[numOwned+1];
+    int listSize = 0;
+    for(int i=0 ; i<numOwned ; ++i){
+      ownedIDs[i] = ownedIDList[i];
+      neighborhoodPtr[i] = listSize;
+      bondOffsets[i] = listSize - i;
+      listSize += neighborhoodListInterleaved[listSize] + 1;
+    }
+    bondOffsets[numOwned] = listSize - numOwned;
+    numBonds = bondOffsets[numOwned];
+    neighborhoodListSize = listSize;
+    interleavedView = neighborhoodListInterleaved;
   }
 
   ~NeighborhoodData(){
@@ -74,6 +150,7 @@ public:
 	  delete[] neighborhoodList;
     if(neighborhoodPtr != 0)
       delete[] neighborhoodPtr;
+    ClearCSR();
   }
 
   void SetNumOwned(int numOwned){
@@ -84,13 +161,151 @@ public:
     if(neighborhoodPtr != 0)
       delete[] neighborhoodPtr;
     neighborhoodPtr = new int[numOwned];
+    ClearCSR();
   }
 
+  //! Allocates the interleaved neighborhood list, discarding the CSR form if it exists.
   void SetNeighborhoodListSize(int neighborhoodSize){
 	neighborhoodListSize = neighborhoodSize;
 	if(neighborhoodList != 0)
 	  delete[] neighborhoodList;
 	neighborhoodList = new int[neighborhoodListSize];
+    ClearCSR();
+  }
+
+  /*! \brief Converts the interleaved neighborhood list to CSR form.
+   *
+   *  The neighbor counts are removed and the neighbor indices are shifted to the front of the list's
+   *  storage, which then becomes the CSR neighbor indices.  Only the bond offsets are allocated.  Has no
+   *  effect if the CSR form has already been built.  A view of an interleaved list is copied first.
+   */
+  void UpdateCSR(){
+    if(interleavedView != 0){
+      neighborhoodList = new int[neighborhoodListSize > 0 ? neighborhoodListSize : 1];
+      memcpy(neighborhoodList, interleavedView, neighborhoodListSize*sizeof(int));
+    }
+    if(neighborhoodList == 0)
+      return;
+    ClearCSR();
+    bondOffsets = new int[numOwnedPoints+1];
+    // Each index moves to a lower position in the list, so the entries are never overwritten before they are read
+    int neighborhoodListIndex = 0;
+    int bondIndex = 0;
+    for(int i=0 ; i<numOwnedPoints ; ++i){
+      bondOffsets[i] = bondIndex;
+      int numNeighbors = neighborhoodList[neighborhoodListIndex++];
+      for(int j=0 ; j<numNeighbors ; ++j)
+        neighborhoodList[bondIndex++] = neighborhoodList[neighborhoodListIndex++];
+    }
+    bondOffsets[numOwnedPoints] = bondIndex;
+    numBonds = bondIndex;
+    neighborIndices = neighborhoodList;
+    neighborhoodList = 0;
+  }
+
+  /*! \brief Sorts the neighbors of each point in ascending order.
+   *
+   *  The CSR form is built first if necessary.  On return, bond bondIndex of the sorted list is bond
+   *  bondPermutation[bondIndex] of the original list; any bond data must be reordered accordingly.
+   *  The data must not be compressed.
+   */
+  void SortNeighbors(std::vector<int>& bondPermutation){
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(IsCompressed(), "\n**** Error:  NeighborhoodData::SortNeighbors(), the neighbor indices are compressed.\n");
+    UpdateCSR();
+    bondPermutation.resize(numBonds);
+    std::vector< std::pair<int,int> > neighbors;
+    for(int i=0 ; i<numOwnedPoints ; ++i){
+      neighbors.clear();
+      for(int bondIndex=bondOffsets[i] ; bondIndex<bondOffsets[i+1] ; ++bondIndex)
+        neighbors.push_back(std::make_pair(neighborIndices[bondIndex], bondIndex));
+      std::sort(neighbors.begin(), neighbors.end());
+      for(unsigned int j=0 ; j<neighbors.size() ; ++j){
+        neighborIndices[bondOffsets[i]+j] = neighbors[j].first;
+        bondPermutation[bondOffsets[i]+j] = neighbors[j].second;
+      }
+    }
+  }
+
+  /*! \brief Replaces the CSR neighbor indices with the compressed representation.
+   *
+   *  The CSR form is built first if necessary.  The bond offsets are retained and the uncompressed
+   *  neighbor indices are freed, so that afterwards the neighbors are only available through
+   *  NeighborIndices(int, int, std::vector<int>&) and NeighborhoodList(std::vector<int>&).  Has no
+   *  effect if the data are already compressed.
+   */
+  void Compress(){
+    if(IsCompressed())
+      return;
+    UpdateCSR();
+    compressedOffsets = new int[numOwnedPoints+1];
+    // Worst case is five bytes per neighbor
+    std::vector<unsigned char> bytes;
+    bytes.reserve(numBonds + numBonds/4);
+    for(int i=0 ; i<numOwnedPoints ; ++i){
+      compressedOffsets[i] = static_cast<int>(bytes.size());
+      int previous = i;
+      for(int bondIndex=bondOffsets[i] ; bondIndex<bondOffsets[i+1] ; ++bondIndex){
+        int delta = neighborIndices[bondIndex] - previous;
+        previous = neighborIndices[bondIndex];
+        unsigned int value = (static_cast<unsigned int>(delta) << 1) ^ static_cast<unsigned int>(delta >> 31);
+        while(value >= 0x80){
+          bytes.push_back(static_cast<unsigned char>(value | 0x80));
+          value >>= 7;
+        }
+        bytes.push_back(static_cast<unsigned char>(value));
+      }
+    }
+    compressedOffsets[numOwnedPoints] = static_cast<int>(bytes.size());
+    compressedNeighborsSize = static_cast<int>(bytes.size());
+    compressedNeighbors = new unsigned char[compressedNeighborsSize > 0 ? compressedNeighborsSize : 1];
+    if(compressedNeighborsSize > 0)
+      memcpy(compressedNeighbors, &bytes[0], compressedNeighborsSize);
+    delete[] neighborIndices;
+    neighborIndices = 0;
+  }
+
+  //! Returns true if the CSR neighbor indices are stored in compressed form.
+  bool IsCompressed() const{
+    return compressedNeighbors != 0;
+  }
+
+  /*! \brief Returns the neighbor indices of the points in the range [firstPoint, lastPoint).
+   *
+   *  The neighbor of bond bondIndex is entry bondIndex - BondOffsets()[firstPoint] of the returned array.  If the data
+   *  are compressed, they are decoded into the given buffer, otherwise a pointer into the CSR neighbor indices is returned.
+   */
+  const int* NeighborIndices(int firstPoint, int lastPoint, std::vector<int>& buffer) const{
+    if(interleavedView != 0){
+      // The neighbors of a single point are contiguous in the interleaved list
+      if(lastPoint == firstPoint + 1)
+        return interleavedView + neighborhoodPtr[firstPoint] + 1;
+      buffer.resize(bondOffsets[lastPoint] - bondOffsets[firstPoint] + 1);
+      int* target = &buffer[0];
+      for(int i=firstPoint ; i<lastPoint ; ++i){
+        const int* neighbors = interleavedView + neighborhoodPtr[i] + 1;
+        target = std::copy(neighbors, neighbors + (bondOffsets[i+1] - bondOffsets[i]), target);
+      }
+      return &buffer[0];
+    }
+    if(!IsCompressed())
+      return neighborIndices + bondOffsets[firstPoint];
+    buffer.resize(bondOffsets[lastPoint] - bondOffsets[firstPoint] + 1);
+    int* target = &buffer[0];
+    for(int i=firstPoint ; i<lastPoint ; ++i)
+      target = DecodeNeighbors(i, target);
+    return &buffer[0];
+  }
+
+  //! Number of points per call to NeighborIndices(int, int, std::vector<int>&) used by kernels that process the points in blocks.
+  static int PointBlockSize(){
+    return 1024;
+  }
+
+  //! Size in megabytes of the CSR neighbor indices, as stored (compressed or not).
+  double neighborIndicesMemorySize() const{
+    if(IsCompressed())
+      return (compressedNeighborsSize*sizeof(unsigned char) + (numOwnedPoints + 1)*sizeof(int))/1048576.0;
+    return (numBonds*sizeof(int))/1048576.0;
   }
 
   int NumOwnedPoints() const{
@@ -109,23 +324,124 @@ public:
 	return neighborhoodListSize;
   }
 
-  int* NeighborhoodList() const{
+  /*! \brief Interleaved neighborhood list, for loading the data and for data that are never converted to CSR form.
+   *
+   *  Throws once the CSR form has been built or if the data are a view; use NeighborhoodList(std::vector<int>&) to
+   *  read the interleaved list in that case.
+   */
+  int* InterleavedNeighborhoodList() const{
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(neighborhoodList == 0 && (bondOffsets != 0 || interleavedView != 0),
+                                "\n**** Error, NeighborhoodData::InterleavedNeighborhoodList() called on data in CSR form, use NeighborhoodList(std::vector<int>&).\n");
 	return neighborhoodList;
   }
 
+  /*! \brief Returns the interleaved neighborhood list, whether or not the CSR form has been built.
+   *
+   *  If the data are stored in CSR form, compressed or not, the interleaved list is rebuilt in the given buffer.
+   *  Intended for code that has not been ported to the CSR form; kernels should use NeighborIndices(int, int, std::vector<int>&).
+   */
+  const int* NeighborhoodList(std::vector<int>& buffer) const{
+    if(neighborhoodList != 0)
+      return neighborhoodList;
+    if(interleavedView != 0)
+      return interleavedView;
+    buffer.resize(numOwnedPoints + numBonds + 1);
+    int* target = &buffer[0];
+    for(int i=0 ; i<numOwnedPoints ; ++i){
+      *target++ = bondOffsets[i+1] - bondOffsets[i];
+      if(IsCompressed())
+        target = DecodeNeighbors(i, target);
+      else
+        for(int bondIndex=bondOffsets[i] ; bondIndex<bondOffsets[i+1] ; ++bondIndex)
+          *target++ = neighborIndices[bondIndex];
+    }
+    return &buffer[0];
+  }
+
+  //! Number of bonds in the CSR form.
+  int NumBonds() const{
+    return numBonds;
+  }
+
+  //! CSR row offsets, length NumOwnedPoints()+1.
+  int* BondOffsets() const{
+    return bondOffsets;
+  }
+
+  //! CSR column indices, length NumBonds(); null if the data are compressed or a view, see NeighborIndices(int, int, std::vector<int>&).
+  int* NeighborIndices() const{
+    return neighborIndices;
+  }
+
   double memorySize() const{
-    int sizeInBytes =
-      (2*numOwnedPoints + neighborhoodListSize + 2)*sizeof(int) + 3*sizeof(int*);
+    size_t sizeInBytes =
+      (2*numOwnedPoints + 2)*sizeof(int) + 3*sizeof(int*);
+    // The CSR neighbor indices occupy the storage of the interleaved list
+    if(neighborhoodList != 0 || neighborIndices != 0)
+      sizeInBytes += neighborhoodListSize*sizeof(int);
+    if(bondOffsets != 0)
+      sizeInBytes += (numOwnedPoints + 1 + 1)*sizeof(int) + 2*sizeof(int*);
+    if(IsCompressed())
+      sizeInBytes += (numOwnedPoints + 1 + 1)*sizeof(int) + compressedNeighborsSize*sizeof(unsigned char) + sizeof(int*) + sizeof(unsigned char*);
     double sizeInMegabytes = sizeInBytes/1048576.0;
     return sizeInMegabytes;
   }
 
 protected:
+
+  void ClearCSR(){
+    interleavedView = 0;
+    if(bondOffsets != 0)
+      delete[] bondOffsets;
+    bondOffsets = 0;
+    if(neighborIndices != 0)
+      delete[] neighborIndices;
+    neighborIndices = 0;
+    numBonds = 0;
+    ClearCompressed();
+  }
+
+  void ClearCompressed(){
+    if(compressedOffsets != 0)
+      delete[] compressedOffsets;
+    compressedOffsets = 0;
+    if(compressedNeighbors != 0)
+      delete[] compressedNeighbors;
+    compressedNeighbors = 0;
+    compressedNeighborsSize = 0;
+  }
+
+  //! Decodes the neighbors of the given point into target, returns a pointer to the entry following the last neighbor.
+  int* DecodeNeighbors(int point, int* target) const{
+    const unsigned char* byte = &compressedNeighbors[compressedOffsets[point]];
+    int previous = point;
+    for(int bondIndex=bondOffsets[point] ; bondIndex<bondOffsets[point+1] ; ++bondIndex){
+      unsigned int value = 0;
+      int shift = 0;
+      while(*byte & 0x80){
+        value |= static_cast<unsigned int>(*byte++ & 0x7f) << shift;
+        shift += 7;
+      }
+      value |= static_cast<unsigned int>(*byte++) << shift;
+      int delta = static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1);
+      previous += delta;
+      *target++ = previous;
+    }
+    return target;
+  }
+
   int numOwnedPoints;
   int* ownedIDs;
   int neighborhoodListSize;
   int* neighborhoodList;
   int* neighborhoodPtr;
+  int numBonds;
+  int* bondOffsets;
+  int* neighborIndices;
+  const int* interleavedView;
+  int compressedNeighborsSize;
+  int* compressedOffsets;
+  unsigned char* compressedNeighbors;
 };
 
 }
@@ -99,6 +99,37 @@ void PeridigmNS::State::allocateBondData(vector<int> fieldIds,
   }
 }
 
+void PeridigmNS::State::compactBondData(Teuchos::RCP<const Epetra_BlockMap> map,
+                                        const vector<int>& retainedBondIndices)
+{
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(bondData.is_null(),
+                              "\n**** Error:  PeridigmNS::State::compactBondData(), bond data has not been allocated!\n");
+
+  Teuchos::RCP<Epetra_MultiVector> compactedBondData = Teuchos::rcp(new Epetra_MultiVector(*map, bondData->NumVectors()));
+  for(int iVec=0 ; iVec<bondData->NumVectors() ; ++iVec){
+    const double* source = (*bondData)[iVec];
+    double* target = (*compactedBondData)[iVec];
+    for(unsigned int i=0 ; i<retainedBondIndices.size() ; ++i)
+      target[i] = source[retainedBondIndices[i]];
+  }
+
+  // Re-point the field ids associated with the bond data at the compacted vectors
+  FieldManager& fieldManager = FieldManager::self();
+  vector<int> bondFieldIds;
+  std::map< int, Teuchos::RCP<Epetra_Vector> >::const_iterator it;
+  for(it = fieldIdToDataMap.begin() ; it != fieldIdToDataMap.end() ; ++it){
+    if(fieldManager.getFieldSpec(it->first).getRelation() == PeridigmField::BOND)
+      bondFieldIds.push_back(it->first);
+  }
+  // allocateBondData() sorts the field ids, so the vectors are in ascending field id order
+  for(unsigned int i=0 ; i<bondFieldIds.size() ; ++i){
+    fieldIdToDataMap[bondFieldIds[i]] = Teuchos::rcp((*compactedBondData)(i), false);
+    fieldIdToDataVector[bondFieldIds[i]] = Teuchos::rcp((*compactedBondData)(i), false);
+  }
+
+  bondData = compactedBondData;
+}
+
 vector<int> PeridigmNS::State::getFieldIds(PeridigmField::Relation relation,
 										   PeridigmField::Length length)
 {
@@ -205,6 +236,36 @@ void PeridigmNS::State::readStateData(Teuchos::RCP<PeridigmNS::State> source,  s
 	  }
 }
 
+void PeridigmNS::State::writeStateData(BinaryRestartWriter& writer, std::string stateName, std::string blockName)
+{
+  char VectorName[100];
+  for(unsigned int i=0 ; i<pointData.size() ; ++i){
+    if(!pointData[i].is_null()){
+      sprintf(VectorName,"%s%s_Element%d",blockName.c_str(),stateName.c_str(),i);
+      writer.write(VectorName, *pointData[i]);
+    }
+  }
+  if(!bondData.is_null()){
+    sprintf(VectorName,"%s%s",blockName.c_str(),stateName.c_str());
+    writer.write(VectorName, *bondData);
+  }
+}
+
+void PeridigmNS::State::readStateData(BinaryRestartReader& reader, std::string stateName, std::string blockName)
+{
+  char VectorName[100];
+  for(unsigned int i=0 ; i<pointData.size() ; ++i){
+    if(!pointData[i].is_null()){
+      sprintf(VectorName,"%s%s_Element%d",blockName.c_str(),stateName.c_str(),i);
+      reader.read(VectorName, *pointData[i]);
+    }
+  }
+  if(!bondData.is_null()){
+    sprintf(VectorName,"%s%s",blockName.c_str(),stateName.c_str());
+    reader.read(VectorName, *bondData);
+  }
+}
+
 void PeridigmNS::State::copyLocallyOwnedMultiVectorData(Epetra_MultiVector& source, Epetra_MultiVector& target)
 {
   TEUCHOS_TEST_FOR_EXCEPTION(source.NumVectors() != target.NumVectors(), std::runtime_error,
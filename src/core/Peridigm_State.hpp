@@ -51,6 +51,7 @@
 #include <Teuchos_RCP.hpp>
 #include <Epetra_Vector.h>
 #include "Peridigm_Field.hpp"
+#include "Peridigm_BinaryRestart.hpp"
 #include <vector>
 
 namespace PeridigmNS {
@@ -91,6 +92,9 @@ public:
   //! Allocates underlying Epetra_Multivector for bond data; only scalar bond data is supported.
   void allocateBondData(std::vector<int> fieldIds, Teuchos::RCP<const Epetra_BlockMap> map);
 
+  //! Replaces the bond data with a subset of the existing bonds; the i-th bond on the new map is copied from bond retainedBondIndices[i].
+  void compactBondData(Teuchos::RCP<const Epetra_BlockMap> map, const std::vector<int>& retainedBondIndices);
+
   //@}
 
   //! Return the maximum allowable element size for point data.
@@ -132,6 +136,12 @@ public:
   //! Read state data
   void readStateData(Teuchos::RCP<PeridigmNS::State> source,  std::string stateName, std::string blockName, char const * path);
 
+  //! Write state data to a binary restart file
+  void writeStateData(BinaryRestartWriter& writer, std::string stateName, std::string blockName);
+
+  //! Read state data from a binary restart file
+  void readStateData(BinaryRestartReader& reader, std::string stateName, std::string blockName);
+
 
 private:
 
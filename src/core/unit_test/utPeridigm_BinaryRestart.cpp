@@ -0,0 +1,205 @@
+/*! \file utPeridigm_BinaryRestart.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include <Epetra_BlockMap.h>
+#include <Epetra_MultiVector.h>
+#include <Epetra_Vector.h>
+#include "Peridigm_BinaryRestart.hpp"
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Teuchos_GlobalMPISession.hpp"
+
+#ifdef HAVE_MPI
+  #include <Epetra_MpiComm.h>
+#else
+  #include <Epetra_SerialComm.h>
+#endif
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+using namespace std;
+
+//! Create a communicator for MPI_COMM_WORLD.
+Teuchos::RCP<Epetra_Comm> createComm()
+{
+  Teuchos::RCP<Epetra_Comm> comm;
+  #ifdef HAVE_MPI
+    comm = rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  #else
+    comm = rcp(new Epetra_SerialComm);
+  #endif
+  return comm;
+}
+
+//! Restart file name for this processor.
+string restartFilename(const Epetra_Comm& comm, const string& base)
+{
+  stringstream ss;
+  ss << base << "." << comm.NumProc() << "." << comm.MyPID() << ".bin";
+  return ss.str();
+}
+
+//! Create a map with five points per processor, numbered contiguously, and the given element size.
+Teuchos::RCP<Epetra_BlockMap> createMap(const Epetra_Comm& comm, int elementSize, bool reversed = false)
+{
+  int numMyElements = 5;
+  vector<int> myGlobalElements(numMyElements);
+  for(int i=0 ; i<numMyElements ; ++i)
+    myGlobalElements[i] = numMyElements*comm.MyPID() + (reversed ? numMyElements - 1 - i : i);
+  return rcp(new Epetra_BlockMap(-1, numMyElements, &myGlobalElements[0], elementSize, 0, comm));
+}
+
+//! Write a restart file containing a map, a two-vector scalar multivector, and a vector with three entries per point.
+void writeRestartFile(const Epetra_Comm& comm, const string& filename)
+{
+  Teuchos::RCP<Epetra_BlockMap> scalarMap = createMap(comm, 1);
+  Teuchos::RCP<Epetra_BlockMap> vectorMap = createMap(comm, 3);
+  Epetra_MultiVector scalarData(*scalarMap, 2);
+  Epetra_Vector vectorData(*vectorMap);
+  for(int i=0 ; i<scalarData.MyLength() ; ++i){
+    scalarData[0][i] = scalarMap->GID(i);
+    scalarData[1][i] = -0.5*scalarMap->GID(i);
+  }
+  for(int i=0 ; i<vectorData.MyLength() ; ++i)
+    vectorData[i] = 1.0e-3*(3*scalarMap->GID(i/3) + i%3);
+
+  BinaryRestartWriter writer(filename, comm.NumProc(), comm.MyPID());
+  writer.write("map", *scalarMap);
+  writer.write("scalar", scalarData);
+  writer.write("vector", vectorData);
+}
+
+TEUCHOS_UNIT_TEST(BinaryRestart, RoundTrip) {
+
+  Teuchos::RCP<Epetra_Comm> comm = createComm();
+  string filename = restartFilename(*comm, "utPeridigm_BinaryRestart_RoundTrip");
+  writeRestartFile(*comm, filename);
+
+  TEST_ASSERT(BinaryRestartReader::exists(filename));
+  BinaryRestartReader reader(filename, comm->NumProc(), comm->MyPID());
+  TEST_ASSERT(reader.hasRecord("map"));
+  TEST_ASSERT(reader.hasRecord("scalar"));
+  TEST_ASSERT(reader.hasRecord("vector"));
+  TEST_ASSERT(!reader.hasRecord("missing"));
+
+  // The stored decomposition matches the original map but not one with the points in a different order
+  Teuchos::RCP<Epetra_BlockMap> scalarMap = createMap(*comm, 1);
+  Teuchos::RCP<Epetra_BlockMap> vectorMap = createMap(*comm, 3);
+  TEST_ASSERT(reader.matchesMap("map", *scalarMap));
+  TEST_ASSERT(!reader.matchesMap("map", *createMap(*comm, 1, true)));
+
+  // Records may be read in any order
+  Epetra_Vector vectorData(*vectorMap);
+  reader.read("vector", vectorData);
+  Epetra_MultiVector scalarData(*scalarMap, 2);
+  reader.read("scalar", scalarData);
+  for(int i=0 ; i<scalarData.MyLength() ; ++i){
+    TEST_EQUALITY(scalarData[0][i], (double)(scalarMap->GID(i)));
+    TEST_EQUALITY(scalarData[1][i], -0.5*scalarMap->GID(i));
+  }
+  for(int i=0 ; i<vectorData.MyLength() ; ++i)
+    TEST_EQUALITY(vectorData[i], 1.0e-3*(3*scalarMap->GID(i/3) + i%3));
+
+  // Records must be read into data of the stored size
+  Epetra_Vector wrongNumVectors(*scalarMap);
+  TEST_THROW(reader.read("scalar", wrongNumVectors), std::runtime_error);
+  TEST_THROW(reader.read("map", scalarData), std::runtime_error);
+  TEST_THROW(reader.read("missing", scalarData), std::runtime_error);
+
+  // A restart written with a different processor layout is rejected
+  TEST_THROW(BinaryRestartReader(filename, comm->NumProc() + 1, comm->MyPID()), std::runtime_error);
+}
+
+TEUCHOS_UNIT_TEST(BinaryRestart, CorruptedChecksum) {
+
+  Teuchos::RCP<Epetra_Comm> comm = createComm();
+  string filename = restartFilename(*comm, "utPeridigm_BinaryRestart_CorruptedChecksum");
+  writeRestartFile(*comm, filename);
+
+  // Flip a bit in the last byte of the file, which is part of the data of the last record
+  {
+    fstream file(filename.c_str(), ios::in | ios::out | ios::binary);
+    file.seekg(-1, ios::end);
+    char byte;
+    file.read(&byte, 1);
+    byte ^= 0x01;
+    file.seekp(-1, ios::end);
+    file.write(&byte, 1);
+  }
+
+  // The other records are intact, the corrupted record fails its Adler-32 checksum
+  BinaryRestartReader reader(filename, comm->NumProc(), comm->MyPID());
+  Teuchos::RCP<Epetra_BlockMap> scalarMap = createMap(*comm, 1);
+  Teuchos::RCP<Epetra_BlockMap> vectorMap = createMap(*comm, 3);
+  TEST_ASSERT(reader.matchesMap("map", *scalarMap));
+  Epetra_MultiVector scalarData(*scalarMap, 2);
+  reader.read("scalar", scalarData);
+  Epetra_Vector vectorData(*vectorMap);
+  TEST_THROW(reader.read("vector", vectorData), std::runtime_error);
+
+  // Flip a bit in the version number, which is covered by the file header checksum
+  {
+    fstream file(filename.c_str(), ios::in | ios::out | ios::binary);
+    file.seekg(8, ios::beg);
+    char byte;
+    file.read(&byte, 1);
+    byte ^= 0x01;
+    file.seekp(8, ios::beg);
+    file.write(&byte, 1);
+  }
+  TEST_THROW(BinaryRestartReader(filename, comm->NumProc(), comm->MyPID()), std::runtime_error);
+}
+
+int main( int argc, char* argv[] ) {
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
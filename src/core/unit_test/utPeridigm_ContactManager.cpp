@@ -0,0 +1,370 @@
+/*! \file utPeridigm_ContactManager.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include <Epetra_MpiComm.h>
+#include "Peridigm_ContactManager.hpp"
+#include "Peridigm_TextFileDiscretization.hpp"
+#include "Peridigm_HorizonManager.hpp"
+#include "Peridigm_Field.hpp"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+using namespace std;
+
+//! A point of the test discretization, listed in the order of the global ids.
+struct ContactTestPoint {
+  double x[3];
+  int blockId;
+  double volume;
+};
+
+/*! \brief Two 4x4x4 cubes with unit spacing, block_1 at 0 <= x <= 3 and block_2 at 5 <= x <= 8, and a 2x2x2 cube, block_3, far away.
+ *
+ *  The horizon is 1.5, so there are no bonds between the blocks.  The test moves block_2 toward block_1 along x.
+ */
+vector<ContactTestPoint> contactTestPoints() {
+  vector<ContactTestPoint> points;
+  const int numPointsPerSide[3] = {4, 4, 2};
+  const double xOrigin[3] = {0.0, 5.0, 50.0};
+  const double volume[3] = {1.0, 0.9, 1.1};
+  for(int block=0 ; block<3 ; ++block){
+    int n = numPointsPerSide[block];
+    for(int k=0 ; k<n ; ++k){
+      for(int j=0 ; j<n ; ++j){
+        for(int i=0 ; i<n ; ++i){
+          ContactTestPoint point;
+          point.x[0] = xOrigin[block] + i;
+          point.x[1] = j;
+          point.x[2] = k;
+          point.blockId = block + 1;
+          point.volume = volume[block];
+          points.push_back(point);
+        }
+      }
+    }
+  }
+  return points;
+}
+
+//! Current position of the given point, with block_2 moved along x by the given shift.
+double currentPosition(const ContactTestPoint& point, double shift, int dof) {
+  return point.x[dof] + (point.blockId == 2 && dof == 0 ? shift : 0.0);
+}
+
+//! Contact test model; the mothership vectors are on the owned maps of the discretization.
+struct ContactTestModel {
+  RCP<Discretization> discretization;
+  RCP<ParameterList> peridigmParams;
+  RCP<Epetra_Vector> blockIds;
+  RCP<Epetra_Vector> volume;
+  RCP<Epetra_Vector> y;
+  RCP<Epetra_Vector> v;
+};
+
+ContactTestModel createContactTestModel(const Epetra_Comm& comm) {
+
+  const string fileName = "utPeridigm_ContactManager.txt";
+  vector<ContactTestPoint> points = contactTestPoints();
+  if(comm.MyPID() == 0){
+    ofstream file(fileName.c_str());
+    file << "# x y z block_id volume" << endl;
+    for(unsigned int i=0 ; i<points.size() ; ++i)
+      file << points[i].x[0] << " " << points[i].x[1] << " " << points[i].x[2] << " " << points[i].blockId << " " << points[i].volume << endl;
+  }
+  comm.Barrier();
+
+  ContactTestModel model;
+  model.peridigmParams = rcp(new ParameterList);
+  ParameterList& blockParams = model.peridigmParams->sublist("Blocks");
+  ParameterList& allBlockParams = blockParams.sublist("My Blocks");
+  allBlockParams.set("Block Names", "block_1 block_2 block_3");
+  allBlockParams.set("Horizon", 1.5);
+  HorizonManager::self().loadHorizonInformationFromBlockParameters(blockParams);
+
+  FieldManager& fieldManager = FieldManager::self();
+  fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Block_Id");
+  fieldManager.getFieldId(PeridigmField::ELEMENT, PeridigmField::SCALAR, PeridigmField::CONSTANT, "Volume");
+  fieldManager.getFieldId(PeridigmField::NODE, PeridigmField::VECTOR, PeridigmField::TWO_STEP, "Coordinates");
+  fieldManager.getFieldId(PeridigmField::NODE, PeridigmField::VECTOR, PeridigmField::TWO_STEP, "Velocity");
+  fieldManager.getFieldId(PeridigmField::NODE, PeridigmField::VECTOR, PeridigmField::TWO_STEP, "Contact_Force_Density");
+
+  RCP<ParameterList> discParams = rcp(new ParameterList);
+  discParams->set("Type", "Text File");
+  discParams->set("Input Mesh File", fileName);
+  model.discretization = rcp(new TextFileDiscretization(rcp(comm.Clone()), discParams));
+
+  model.blockIds = model.discretization->getBlockID();
+  model.volume = model.discretization->getCellVolume();
+  model.y = rcp(new Epetra_Vector(*model.discretization->getInitialX()));
+  model.v = rcp(new Epetra_Vector(model.y->Map()));
+  return model;
+}
+
+//! Moves block_2 along x so that it is the given shift from its reference position.
+void moveBlockTwo(ContactTestModel& model, double shift) {
+  Epetra_Vector& x = *model.discretization->getInitialX();
+  for(int i=0 ; i<model.blockIds->MyLength() ; ++i){
+    (*model.y)[3*i] = x[3*i] + ((*model.blockIds)[i] == 2 ? shift : 0.0);
+    (*model.y)[3*i+1] = x[3*i+1];
+    (*model.y)[3*i+2] = x[3*i+2];
+  }
+}
+
+//! Contact parameters for a short-range force model with a contact radius of 0.9 and a search radius of 1.0 between all blocks.
+ParameterList contactTestParams(const string& statisticsFileName) {
+  ParameterList contactParams;
+  contactParams.set("Search Radius", 1.0);
+  contactParams.set("Statistics File", statisticsFileName);
+  ParameterList& modelParams = contactParams.sublist("Models").sublist("My Contact Model");
+  modelParams.set("Contact Model", "Short Range Force");
+  modelParams.set("Contact Radius", 0.9);
+  modelParams.set("Spring Constant", 1.0e3);
+  contactParams.sublist("Interactions").sublist("General Contact").set("Contact Model", "My Contact Model");
+  return contactParams;
+}
+
+RCP<ContactManager> createContactManager(const ParameterList& contactParams, ContactTestModel& model) {
+  RCP<ContactManager> contactManager = rcp(new ContactManager(contactParams, model.discretization, model.peridigmParams));
+  contactManager->initialize(model.discretization->getGlobalOwnedMap(1),
+                             model.discretization->getGlobalOwnedMap(3),
+                             model.discretization->getGlobalOverlapMap(1),
+                             model.discretization->getGlobalBondMap(),
+                             model.discretization->getNeighborhoodData(),
+                             model.discretization->getBlockID());
+  contactManager->loadAllMothershipData(model.blockIds, model.volume, model.y, model.v);
+  contactManager->initializeContactBlocks();
+  return contactManager;
+}
+
+//! Performs a contact step in the current configuration and returns the contact force on the owned points.
+RCP<Epetra_Vector> contactStep(ContactManager& contactManager, ContactTestModel& model, long long step) {
+  contactManager.importData(model.volume, model.y, model.v);
+  contactManager.rebalance(step);
+  contactManager.evaluateContactForce(1.0e-6);
+  RCP<Epetra_Vector> contactForce = rcp(new Epetra_Vector(model.y->Map()));
+  contactManager.exportData(contactForce);
+  return contactForce;
+}
+
+//! Reads the rows of a contact statistics file, skipping the header.
+vector< vector<double> > readStatistics(const Epetra_Comm& comm, const string& fileName) {
+  comm.Barrier();
+  vector< vector<double> > rows;
+  ifstream file(fileName.c_str());
+  string line;
+  getline(file, line);
+  while(getline(file, line)){
+    vector<double> row;
+    stringstream ss(line);
+    string value;
+    while(getline(ss, value, ','))
+      row.push_back(atof(value.c_str()));
+    rows.push_back(row);
+  }
+  return rows;
+}
+
+//! Column indices in the contact statistics file.
+const int stepColumn = 0;
+const int repartitionedColumn = 1;
+const int candidatePairsColumn = 3;
+const int pairsInContactRadiusColumn = 4;
+
+void checkForcesEqual(const Epetra_Vector& force, const Epetra_Vector& expected, FancyOStream& out, bool& success) {
+  double maxForce;
+  expected.NormInf(&maxForce);
+  TEST_COMPARE(maxForce, >, 0.0);
+  for(int i=0 ; i<expected.MyLength() ; ++i)
+    TEST_COMPARE(std::fabs(force[i] - expected[i]), <=, 1.0e-12*maxForce);
+}
+
+//! Checks the volumes and current positions, including those of the ghosts, imported into each contact block.
+void checkContactBlockData(ContactManager& contactManager, double shift, FancyOStream& out, bool& success) {
+  vector<ContactTestPoint> points = contactTestPoints();
+  FieldManager& fieldManager = FieldManager::self();
+  int volumeFieldId = fieldManager.getFieldId("Volume");
+  int coordinatesFieldId = fieldManager.getFieldId("Coordinates");
+  RCP< vector<ContactBlock> > contactBlocks = contactManager.getContactBlocks();
+  for(vector<ContactBlock>::iterator it = contactBlocks->begin() ; it != contactBlocks->end() ; it++){
+    RCP<DataManager> dataManager = it->getDataManager();
+    Epetra_Vector& volume = *dataManager->getData(volumeFieldId, PeridigmField::STEP_NONE);
+    Epetra_Vector& y = *dataManager->getData(coordinatesFieldId, PeridigmField::STEP_NP1);
+    TEST_EQUALITY(y.MyLength(), 3*volume.MyLength());
+    for(int i=0 ; i<volume.MyLength() ; ++i){
+      int globalId = volume.Map().GID(i);
+      TEST_EQUALITY(y.Map().GID(i), globalId);
+      TEST_EQUALITY(volume[i], points[globalId].volume);
+      for(int dof=0 ; dof<3 ; ++dof)
+        TEST_EQUALITY(y[3*i+dof], currentPosition(points[globalId], shift, dof));
+    }
+  }
+}
+
+TEUCHOS_UNIT_TEST(ContactManager, VerletSkinTrigger) {
+
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+  ContactTestModel model = createContactTestModel(comm);
+
+  // A Verlet skin of 0.4 requires a search once a point has moved more than 0.2 since the last search
+  ParameterList skinParams = contactTestParams("utPeridigm_ContactManager_Skin.csv");
+  skinParams.set("Verlet Skin", 0.4);
+  ParameterList everyStepParams = contactTestParams("utPeridigm_ContactManager_EveryStep.csv");
+  everyStepParams.set("Search Frequency", 1);
+
+  // Block_2 starts at a gap of 0.7, moves 0.19 (no search), then a further 0.02 (search)
+  const double shifts[3] = {-1.3, -1.49, -1.51};
+  moveBlockTwo(model, shifts[0]);
+  RCP<ContactManager> skinContactManager = createContactManager(skinParams, model);
+  RCP<ContactManager> everyStepContactManager = createContactManager(everyStepParams, model);
+  for(int step=0 ; step<3 ; ++step){
+    moveBlockTwo(model, shifts[step]);
+    RCP<Epetra_Vector> skinForce = contactStep(*skinContactManager, model, step);
+    RCP<Epetra_Vector> everyStepForce = contactStep(*everyStepContactManager, model, step);
+    // Pairs that are within the contact radius without a search were within the extended search radius at the last search
+    checkForcesEqual(*skinForce, *everyStepForce, out, success);
+    checkContactBlockData(*skinContactManager, shifts[step], out, success);
+  }
+
+  vector< vector<double> > skinRows = readStatistics(comm, "utPeridigm_ContactManager_Skin.csv");
+  TEST_EQUALITY(static_cast<int>(skinRows.size()), 2);
+  if(skinRows.size() == 2){
+    TEST_EQUALITY(skinRows[0][stepColumn], 0.0);
+    TEST_EQUALITY(skinRows[1][stepColumn], 2.0);
+  }
+  vector< vector<double> > everyStepRows = readStatistics(comm, "utPeridigm_ContactManager_EveryStep.csv");
+  TEST_EQUALITY(static_cast<int>(everyStepRows.size()), 3);
+}
+
+TEUCHOS_UNIT_TEST(ContactManager, ReuseMatchesRebuild) {
+
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+  ContactTestModel model = createContactTestModel(comm);
+
+  // With a very large imbalance threshold the points are never repartitioned after the first search, so the owned
+  // maps are reused and only the overlap maps are rebuilt; otherwise the contact data is rebuilt at every search
+  ParameterList reuseParams = contactTestParams("utPeridigm_ContactManager_Reuse.csv");
+  reuseParams.set("Search Frequency", 1);
+  reuseParams.set("Repartition Imbalance Threshold", 1.0e6);
+  ParameterList rebuildParams = contactTestParams("utPeridigm_ContactManager_Rebuild.csv");
+  rebuildParams.set("Search Frequency", 1);
+
+  const double shifts[4] = {-1.3, -1.4, -1.5, -1.6};
+  moveBlockTwo(model, shifts[0]);
+  RCP<ContactManager> reuseContactManager = createContactManager(reuseParams, model);
+  RCP<ContactManager> rebuildContactManager = createContactManager(rebuildParams, model);
+  for(int step=0 ; step<4 ; ++step){
+    moveBlockTwo(model, shifts[step]);
+    RCP<Epetra_Vector> reuseForce = contactStep(*reuseContactManager, model, step);
+    RCP<Epetra_Vector> rebuildForce = contactStep(*rebuildContactManager, model, step);
+    checkForcesEqual(*reuseForce, *rebuildForce, out, success);
+    checkContactBlockData(*reuseContactManager, shifts[step], out, success);
+    checkContactBlockData(*rebuildContactManager, shifts[step], out, success);
+  }
+
+  vector< vector<double> > reuseRows = readStatistics(comm, "utPeridigm_ContactManager_Reuse.csv");
+  vector< vector<double> > rebuildRows = readStatistics(comm, "utPeridigm_ContactManager_Rebuild.csv");
+  TEST_EQUALITY(static_cast<int>(reuseRows.size()), 4);
+  TEST_EQUALITY(static_cast<int>(rebuildRows.size()), 4);
+  for(unsigned int i=0 ; i<reuseRows.size() && i<rebuildRows.size() ; ++i){
+    TEST_EQUALITY(reuseRows[i][repartitionedColumn], i == 0 ? 1.0 : 0.0);
+    TEST_EQUALITY(rebuildRows[i][repartitionedColumn], 1.0);
+    TEST_EQUALITY(reuseRows[i][pairsInContactRadiusColumn], rebuildRows[i][pairsInContactRadiusColumn]);
+    TEST_COMPARE(reuseRows[i][pairsInContactRadiusColumn], >, 0.0);
+  }
+}
+
+TEUCHOS_UNIT_TEST(ContactManager, FilteringKeepsPairsInContactRadius) {
+
+  Epetra_MpiComm comm(MPI_COMM_WORLD);
+  ContactTestModel model = createContactTestModel(comm);
+
+  // Only points with fewer bonds than the bulk are searched, and block_3 is dropped by the broad phase
+  ParameterList allPointsParams = contactTestParams("utPeridigm_ContactManager_AllPoints.csv");
+  allPointsParams.set("Search Frequency", 1);
+  ParameterList filteredParams = contactTestParams("utPeridigm_ContactManager_Filtered.csv");
+  filteredParams.set("Search Frequency", 1);
+  filteredParams.set("Surface Neighbor Fraction", 1.0);
+  filteredParams.set("Block Pair Broad Phase", true);
+
+  const double shifts[3] = {-1.3, -1.5, -1.7};
+  moveBlockTwo(model, shifts[0]);
+  RCP<ContactManager> allPointsContactManager = createContactManager(allPointsParams, model);
+  RCP<ContactManager> filteredContactManager = createContactManager(filteredParams, model);
+  for(int step=0 ; step<3 ; ++step){
+    moveBlockTwo(model, shifts[step]);
+    RCP<Epetra_Vector> allPointsForce = contactStep(*allPointsContactManager, model, step);
+    RCP<Epetra_Vector> filteredForce = contactStep(*filteredContactManager, model, step);
+    checkForcesEqual(*filteredForce, *allPointsForce, out, success);
+  }
+
+  vector< vector<double> > allPointsRows = readStatistics(comm, "utPeridigm_ContactManager_AllPoints.csv");
+  vector< vector<double> > filteredRows = readStatistics(comm, "utPeridigm_ContactManager_Filtered.csv");
+  TEST_EQUALITY(static_cast<int>(allPointsRows.size()), 3);
+  TEST_EQUALITY(static_cast<int>(filteredRows.size()), 3);
+  for(unsigned int i=0 ; i<allPointsRows.size() && i<filteredRows.size() ; ++i){
+    TEST_COMPARE(filteredRows[i][candidatePairsColumn], <, allPointsRows[i][candidatePairsColumn]);
+    TEST_EQUALITY(filteredRows[i][pairsInContactRadiusColumn], allPointsRows[i][pairsInContactRadiusColumn]);
+    TEST_COMPARE(filteredRows[i][pairsInContactRadiusColumn], >, 0.0);
+  }
+}
+
+int main
+(int argc, char* argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
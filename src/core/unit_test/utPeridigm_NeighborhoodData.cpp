@@ -0,0 +1,317 @@
+/*! \file utPeridigm_NeighborhoodData.cpp */
+
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Peridigm_NeighborhoodData.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+using namespace std;
+
+//! Creates an interleaved neighborhood list with a mix of empty, small, and large neighborhoods.
+vector<int> createInterleavedNeighborhoodList(int numOwnedPoints, int numOverlapPoints)
+{
+  vector<int> neighborhoodList;
+  for(int i=0 ; i<numOwnedPoints ; ++i){
+    int numNeighbors = (i*7) % 23;
+    if(i%11 == 0)
+      numNeighbors = 0;
+    neighborhoodList.push_back(numNeighbors);
+    for(int n=0 ; n<numNeighbors ; ++n)
+      neighborhoodList.push_back( (i + 1 + (n*n*37 + n*5)) % numOverlapPoints );
+  }
+  return neighborhoodList;
+}
+
+//! Loads an interleaved neighborhood list into a NeighborhoodData object the way the discretizations do.
+void loadNeighborhoodData(const vector<int>& neighborhoodList, int numOwnedPoints, NeighborhoodData& neighborhoodData)
+{
+  neighborhoodData.SetNumOwned(numOwnedPoints);
+  neighborhoodData.SetNeighborhoodListSize(neighborhoodList.size());
+  memcpy(neighborhoodData.InterleavedNeighborhoodList(), &neighborhoodList[0], neighborhoodList.size()*sizeof(int));
+  int neighborhoodListIndex = 0;
+  for(int i=0 ; i<numOwnedPoints ; ++i){
+    neighborhoodData.OwnedIDs()[i] = i;
+    neighborhoodData.NeighborhoodPtr()[i] = neighborhoodListIndex;
+    neighborhoodListIndex += neighborhoodList[neighborhoodListIndex] + 1;
+  }
+}
+
+//! Walks the CSR form in blocks of NeighborhoodData::PointBlockSize() and checks each bond against the interleaved traversal.
+void checkBlockTraversal(const NeighborhoodData& neighborhoodData, const vector<int>& neighborhoodList, Teuchos::FancyOStream& out, bool& success)
+{
+  const int numOwnedPoints = neighborhoodData.NumOwnedPoints();
+  const int* bondOffsets = neighborhoodData.BondOffsets();
+  vector<int> neighborIndicesBuffer;
+
+  int neighborhoodListIndex = 0;
+  int bondIndex = 0;
+  for(int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()){
+    int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+    const int* neighborIndices = neighborhoodData.NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+    for(int iID=firstPoint ; iID<lastPoint ; ++iID){
+      int numNeighbors = neighborhoodList[neighborhoodListIndex++];
+      TEST_EQUALITY(bondOffsets[iID], bondIndex);
+      TEST_EQUALITY(bondOffsets[iID+1] - bondOffsets[iID], numNeighbors);
+      for(int n=0 ; n<numNeighbors ; ++n){
+        TEST_EQUALITY(neighborIndices[bondIndex - bondOffsets[firstPoint]], neighborhoodList[neighborhoodListIndex]);
+        neighborhoodListIndex++;
+        bondIndex++;
+      }
+    }
+  }
+  TEST_EQUALITY(neighborhoodListIndex, (int)neighborhoodList.size());
+  TEST_EQUALITY(bondIndex, neighborhoodData.NumBonds());
+}
+
+//! Checks that the interleaved list rebuilt from the CSR form matches the original.
+void checkRebuiltNeighborhoodList(const NeighborhoodData& neighborhoodData, const vector<int>& neighborhoodList, Teuchos::FancyOStream& out, bool& success)
+{
+  TEST_THROW(neighborhoodData.InterleavedNeighborhoodList(), std::logic_error);
+  vector<int> buffer;
+  const int* rebuiltNeighborhoodList = neighborhoodData.NeighborhoodList(buffer);
+  for(unsigned int i=0 ; i<neighborhoodList.size() ; ++i)
+    TEST_EQUALITY(rebuiltNeighborhoodList[i], neighborhoodList[i]);
+}
+
+TEUCHOS_UNIT_TEST(NeighborhoodData, UpdateCSR) {
+
+  const int numOwnedPoints = 2*NeighborhoodData::PointBlockSize() + 137;
+  const int numOverlapPoints = numOwnedPoints + 500;
+  vector<int> neighborhoodList = createInterleavedNeighborhoodList(numOwnedPoints, numOverlapPoints);
+
+  NeighborhoodData neighborhoodData;
+  loadNeighborhoodData(neighborhoodList, numOwnedPoints, neighborhoodData);
+  neighborhoodData.UpdateCSR();
+
+  TEST_ASSERT(!neighborhoodData.IsCompressed());
+  TEST_EQUALITY(neighborhoodData.NumBonds(), (int)neighborhoodList.size() - numOwnedPoints);
+  checkBlockTraversal(neighborhoodData, neighborhoodList, out, success);
+  checkRebuiltNeighborhoodList(neighborhoodData, neighborhoodList, out, success);
+
+  // A second call has no effect
+  neighborhoodData.UpdateCSR();
+  checkBlockTraversal(neighborhoodData, neighborhoodList, out, success);
+
+  // The copy constructor preserves the CSR form
+  NeighborhoodData copy(neighborhoodData);
+  checkBlockTraversal(copy, neighborhoodList, out, success);
+}
+
+TEUCHOS_UNIT_TEST(NeighborhoodData, InterleavedConstructor) {
+
+  const int numOwnedPoints = NeighborhoodData::PointBlockSize() + 1;
+  const int numOverlapPoints = 2*numOwnedPoints;
+  vector<int> neighborhoodList = createInterleavedNeighborhoodList(numOwnedPoints, numOverlapPoints);
+  vector<int> ownedIDs(numOwnedPoints);
+  for(int i=0 ; i<numOwnedPoints ; ++i)
+    ownedIDs[i] = i;
+
+  NeighborhoodData neighborhoodData(numOwnedPoints, &ownedIDs[0], &neighborhoodList[0]);
+
+  TEST_EQUALITY(neighborhoodData.NumOwnedPoints(), numOwnedPoints);
+  checkBlockTraversal(neighborhoodData, neighborhoodList, out, success);
+  checkRebuiltNeighborhoodList(neighborhoodData, neighborhoodList, out, success);
+
+  // The data are a view of the list; the neighbors of a single point are returned in place
+  vector<int> buffer;
+  TEST_ASSERT(neighborhoodData.NeighborIndices() == 0);
+  TEST_ASSERT(neighborhoodData.NeighborIndices(1, 2, buffer) == &neighborhoodList[neighborhoodData.NeighborhoodPtr()[1] + 1]);
+
+  // The copy constructor preserves the view, and UpdateCSR() converts a copy of the list
+  NeighborhoodData copy(neighborhoodData);
+  checkBlockTraversal(copy, neighborhoodList, out, success);
+  neighborhoodData.UpdateCSR();
+  TEST_ASSERT(neighborhoodData.NeighborIndices() != 0);
+  checkBlockTraversal(neighborhoodData, neighborhoodList, out, success);
+  checkRebuiltNeighborhoodList(neighborhoodData, neighborhoodList, out, success);
+}
+
+TEUCHOS_UNIT_TEST(NeighborhoodData, CompressedBlockTraversal) {
+
+  const int numOwnedPoints = 3*NeighborhoodData::PointBlockSize() + 5;
+  const int numOverlapPoints = numOwnedPoints + 50;
+  vector<int> neighborhoodList = createInterleavedNeighborhoodList(numOwnedPoints, numOverlapPoints);
+
+  NeighborhoodData neighborhoodData;
+  loadNeighborhoodData(neighborhoodList, numOwnedPoints, neighborhoodData);
+  neighborhoodData.UpdateCSR();
+  neighborhoodData.Compress();
+
+  TEST_ASSERT(neighborhoodData.IsCompressed());
+  TEST_ASSERT(neighborhoodData.NeighborIndices() == 0);
+  checkBlockTraversal(neighborhoodData, neighborhoodList, out, success);
+  checkRebuiltNeighborhoodList(neighborhoodData, neighborhoodList, out, success);
+
+  // Reloading the interleaved list discards the compressed form
+  loadNeighborhoodData(neighborhoodList, numOwnedPoints, neighborhoodData);
+  TEST_ASSERT(!neighborhoodData.IsCompressed());
+  neighborhoodData.UpdateCSR();
+  checkBlockTraversal(neighborhoodData, neighborhoodList, out, success);
+}
+
+TEUCHOS_UNIT_TEST(NeighborhoodData, CompressRoundTrip) {
+
+  // Empty neighborhoods, neighbors in decreasing order, and gaps up to the full range of the indices
+  const int numOwnedPoints = NeighborhoodData::PointBlockSize() + 300;
+  const int largestIndex = std::numeric_limits<int>::max() - 1;
+  vector<int> neighborhoodList;
+  for(int i=0 ; i<numOwnedPoints ; ++i){
+    if(i%3 == 0){
+      neighborhoodList.push_back(0);
+      continue;
+    }
+    neighborhoodList.push_back(6);
+    neighborhoodList.push_back(largestIndex - i);
+    neighborhoodList.push_back(0);
+    neighborhoodList.push_back(i + 1);
+    neighborhoodList.push_back(largestIndex/2 + i);
+    neighborhoodList.push_back(i > 0 ? i - 1 : 0);
+    neighborhoodList.push_back(largestIndex);
+  }
+
+  // Compress() builds the CSR form itself
+  NeighborhoodData neighborhoodData;
+  loadNeighborhoodData(neighborhoodList, numOwnedPoints, neighborhoodData);
+  neighborhoodData.Compress();
+
+  TEST_ASSERT(neighborhoodData.IsCompressed());
+  TEST_ASSERT(neighborhoodData.NeighborIndices() == 0);
+  checkBlockTraversal(neighborhoodData, neighborhoodList, out, success);
+  checkRebuiltNeighborhoodList(neighborhoodData, neighborhoodList, out, success);
+
+  // A second call has no effect
+  neighborhoodData.Compress();
+  checkBlockTraversal(neighborhoodData, neighborhoodList, out, success);
+
+  // The copy constructor preserves the compressed form
+  NeighborhoodData copy(neighborhoodData);
+  TEST_ASSERT(copy.IsCompressed());
+  checkBlockTraversal(copy, neighborhoodList, out, success);
+}
+
+TEUCHOS_UNIT_TEST(NeighborhoodData, SortNeighbors) {
+
+  // Neighbors in scrambled order, with an empty neighborhood in between
+  const int numOwnedPoints = 3;
+  int list[] = {4, 7, 2, 9, 3,  0,  3, 5, 1, 4};
+  vector<int> neighborhoodList(list, list + sizeof(list)/sizeof(int));
+
+  NeighborhoodData neighborhoodData;
+  loadNeighborhoodData(neighborhoodList, numOwnedPoints, neighborhoodData);
+  neighborhoodData.UpdateCSR();
+
+  // Bond data tagged with the original neighbor of each bond follows the permutation
+  vector<int> bondData(neighborhoodData.NeighborIndices(), neighborhoodData.NeighborIndices() + neighborhoodData.NumBonds());
+  vector<int> bondPermutation;
+  neighborhoodData.SortNeighbors(bondPermutation);
+  TEST_EQUALITY(static_cast<int>(bondPermutation.size()), neighborhoodData.NumBonds());
+
+  int sortedList[] = {4, 2, 3, 7, 9,  0,  3, 1, 4, 5};
+  vector<int> sortedNeighborhoodList(sortedList, sortedList + sizeof(sortedList)/sizeof(int));
+  checkBlockTraversal(neighborhoodData, sortedNeighborhoodList, out, success);
+  const int* neighborIndices = neighborhoodData.NeighborIndices();
+  for(int bondIndex=0 ; bondIndex<neighborhoodData.NumBonds() ; ++bondIndex)
+    TEST_EQUALITY(bondData[bondPermutation[bondIndex]], neighborIndices[bondIndex]);
+
+  // The sorted list compresses and decodes in sorted order
+  neighborhoodData.Compress();
+  checkBlockTraversal(neighborhoodData, sortedNeighborhoodList, out, success);
+  checkRebuiltNeighborhoodList(neighborhoodData, sortedNeighborhoodList, out, success);
+
+  // Compressed indices cannot be sorted
+  TEST_THROW(neighborhoodData.SortNeighbors(bondPermutation), std::logic_error);
+}
+
+TEUCHOS_UNIT_TEST(NeighborhoodData, CompressEmptyNeighborhoods) {
+
+  const int numOwnedPoints = 10;
+  vector<int> neighborhoodList(numOwnedPoints, 0);
+
+  NeighborhoodData neighborhoodData;
+  loadNeighborhoodData(neighborhoodList, numOwnedPoints, neighborhoodData);
+  neighborhoodData.Compress();
+
+  TEST_ASSERT(neighborhoodData.IsCompressed());
+  TEST_EQUALITY(neighborhoodData.NumBonds(), 0);
+  checkBlockTraversal(neighborhoodData, neighborhoodList, out, success);
+  checkRebuiltNeighborhoodList(neighborhoodData, neighborhoodList, out, success);
+}
+
+TEUCHOS_UNIT_TEST(NeighborhoodData, CompressedMemorySize) {
+
+  // Nearby neighbors take a single byte each once compressed
+  const int numOwnedPoints = 2000;
+  vector<int> neighborhoodList;
+  for(int i=0 ; i<numOwnedPoints ; ++i){
+    neighborhoodList.push_back(20);
+    for(int n=1 ; n<=20 ; ++n)
+      neighborhoodList.push_back(i + n);
+  }
+
+  NeighborhoodData neighborhoodData;
+  loadNeighborhoodData(neighborhoodList, numOwnedPoints, neighborhoodData);
+  neighborhoodData.UpdateCSR();
+  double uncompressedMemory = neighborhoodData.memorySize();
+  double uncompressedIndicesMemory = neighborhoodData.neighborIndicesMemorySize();
+  neighborhoodData.Compress();
+
+  TEST_COMPARE(neighborhoodData.memorySize(), <, uncompressedMemory);
+  TEST_COMPARE(neighborhoodData.neighborIndicesMemorySize(), <, 0.5*uncompressedIndicesMemory);
+  checkBlockTraversal(neighborhoodData, neighborhoodList, out, success);
+}
+
+int main
+(int argc, char* argv[])
+{
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
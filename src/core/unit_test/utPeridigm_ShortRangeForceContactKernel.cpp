@@ -0,0 +1,275 @@
+/*! \file utPeridigm_ShortRangeForceContactKernel.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_UnitTestRepository.hpp"
+#include "Peridigm_ShortRangeForceContactKernel.hpp"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+using namespace std;
+
+//! Pair-by-pair evaluation of the short-range contact force, as computed prior to the batched kernel.
+void scalarContactForce(double springCoefficient,
+                        double contactRadius,
+                        double horizon,
+                        double frictionCoefficient,
+                        int numOwnedPoints,
+                        const int* ownedIDs,
+                        const int* contactNeighborhoodList,
+                        const double* cellVolume,
+                        const double* y,
+                        const double* velocity,
+                        double* contactForce)
+{
+  int neighborhoodListIndex = 0;
+  for(int iID=0 ; iID<numOwnedPoints ; ++iID){
+    int numNeighbors = contactNeighborhoodList[neighborhoodListIndex++];
+    int nodeID = ownedIDs[iID];
+    for(int iNID=0 ; iNID<numNeighbors ; ++iNID){
+      int neighborID = contactNeighborhoodList[neighborhoodListIndex++];
+      double delta[3];
+      for(int dof=0 ; dof<3 ; ++dof)
+        delta[dof] = y[3*neighborID+dof] - y[3*nodeID+dof];
+      double distance = sqrt(delta[0]*delta[0] + delta[1]*delta[1] + delta[2]*delta[2]);
+      if(distance >= contactRadius)
+        continue;
+      double temp = springCoefficient*(contactRadius - distance)/horizon;
+      double currentNormalForce[3], neighborNormalForce[3];
+      for(int dof=0 ; dof<3 ; ++dof){
+        currentNormalForce[dof] = -temp*cellVolume[neighborID]*delta[dof]/distance;
+        neighborNormalForce[dof] = temp*cellVolume[nodeID]*delta[dof]/distance;
+      }
+      double currentFrictionForce[3] = {0.0, 0.0, 0.0};
+      double neighborFrictionForce[3] = {0.0, 0.0, 0.0};
+      if(frictionCoefficient != 0.0){
+        double normal[3], currentDotNormal(0.0), neighborDotNormal(0.0);
+        for(int dof=0 ; dof<3 ; ++dof){
+          normal[dof] = delta[dof]/distance;
+          currentDotNormal += velocity[3*nodeID+dof]*normal[dof];
+          neighborDotNormal += velocity[3*neighborID+dof]*normal[dof];
+        }
+        double currentVrel[3], neighborVrel[3];
+        for(int dof=0 ; dof<3 ; ++dof){
+          double currentVperp = velocity[3*nodeID+dof] - currentDotNormal*normal[dof];
+          double neighborVperp = velocity[3*neighborID+dof] - neighborDotNormal*normal[dof];
+          double Vcm = 0.5*(currentVperp + neighborVperp);
+          currentVrel[dof] = currentVperp - Vcm;
+          neighborVrel[dof] = neighborVperp - Vcm;
+        }
+        double normCurrentVrel = sqrt(currentVrel[0]*currentVrel[0] + currentVrel[1]*currentVrel[1] + currentVrel[2]*currentVrel[2]);
+        double normNeighborVrel = sqrt(neighborVrel[0]*neighborVrel[0] + neighborVrel[1]*neighborVrel[1] + neighborVrel[2]*neighborVrel[2]);
+        double normCurrentNormalForce = sqrt(currentNormalForce[0]*currentNormalForce[0] + currentNormalForce[1]*currentNormalForce[1] + currentNormalForce[2]*currentNormalForce[2]);
+        double normNeighborNormalForce = sqrt(neighborNormalForce[0]*neighborNormalForce[0] + neighborNormalForce[1]*neighborNormalForce[1] + neighborNormalForce[2]*neighborNormalForce[2]);
+        for(int dof=0 ; dof<3 ; ++dof){
+          if(normCurrentVrel != 0.0)
+            currentFrictionForce[dof] = -frictionCoefficient*normCurrentNormalForce*currentVrel[dof]/normCurrentVrel;
+          if(normNeighborVrel != 0.0)
+            neighborFrictionForce[dof] = -frictionCoefficient*normNeighborNormalForce*neighborVrel[dof]/normNeighborVrel;
+        }
+      }
+      for(int dof=0 ; dof<3 ; ++dof){
+        contactForce[3*nodeID+dof] += currentNormalForce[dof] + currentFrictionForce[dof];
+        contactForce[3*neighborID+dof] += neighborNormalForce[dof] + neighborFrictionForce[dof];
+      }
+    }
+  }
+}
+
+//! Perturbed lattice of points and a contact neighbor list that spans many pair batches and includes pairs outside the contact radius.
+struct ContactProblem {
+  double contactRadius;
+  int numPoints;
+  int numOwnedPoints;
+  vector<int> ownedIDs;
+  vector<int> neighborhoodList;
+  vector<double> cellVolume;
+  vector<double> y;
+  vector<double> velocity;
+  int numPairs;
+  int numPairsInContactRadius;
+};
+
+//! Deterministic pseudo-random number in [-1, 1).
+double pseudoRandom(unsigned int& state)
+{
+  state = 1664525u*state + 1013904223u;
+  return 2.0*(state/4294967296.0) - 1.0;
+}
+
+ContactProblem createContactProblem()
+{
+  ContactProblem problem;
+  const double contactRadius = 1.2;
+  problem.contactRadius = contactRadius;
+  const int n = 6;
+  problem.numPoints = n*n*n;
+  problem.numOwnedPoints = 150;
+  problem.cellVolume.resize(problem.numPoints);
+  problem.y.resize(3*problem.numPoints);
+  problem.velocity.resize(3*problem.numPoints);
+  unsigned int state = 12345u;
+  for(int i=0 ; i<problem.numPoints ; ++i){
+    int index[3] = {i%n, (i/n)%n, i/(n*n)};
+    for(int dof=0 ; dof<3 ; ++dof){
+      // The first two points are left unperturbed and share a velocity, so that their relative tangential velocity is zero
+      problem.y[3*i+dof] = index[dof] + (i < 2 ? 0.0 : 0.1*pseudoRandom(state));
+      problem.velocity[3*i+dof] = (i < 2 ? 0.5 : pseudoRandom(state));
+    }
+    problem.cellVolume[i] = 1.0 + 0.2*pseudoRandom(state);
+  }
+  // The neighbor lists of the owned points include non-owned points and pairs beyond the contact radius
+  problem.numPairs = 0;
+  problem.numPairsInContactRadius = 0;
+  for(int i=0 ; i<problem.numOwnedPoints ; ++i){
+    problem.ownedIDs.push_back(i);
+    vector<int> neighbors;
+    for(int j=i+1 ; j<problem.numPoints ; ++j){
+      double distanceSquared = 0.0;
+      for(int dof=0 ; dof<3 ; ++dof)
+        distanceSquared += (problem.y[3*j+dof] - problem.y[3*i+dof])*(problem.y[3*j+dof] - problem.y[3*i+dof]);
+      if(distanceSquared < 1.5*1.5*contactRadius*contactRadius){
+        neighbors.push_back(j);
+        if(distanceSquared < contactRadius*contactRadius)
+          problem.numPairsInContactRadius++;
+      }
+    }
+    problem.neighborhoodList.push_back(static_cast<int>(neighbors.size()));
+    problem.neighborhoodList.insert(problem.neighborhoodList.end(), neighbors.begin(), neighbors.end());
+    problem.numPairs += static_cast<int>(neighbors.size());
+  }
+  return problem;
+}
+
+//! Evaluates the kernel and the scalar loop, both accumulating onto the same nonzero initial force, and compares the results.
+void compareWithScalarLoop(const ContactProblem& problem,
+                           double frictionCoefficient,
+                           Teuchos::FancyOStream& out,
+                           bool& success)
+{
+  const double springCoefficient = 2.0;
+  const double contactRadius = problem.contactRadius;
+  const double horizon = 3.0;
+
+  vector<double> expected(3*problem.numPoints), force(3*problem.numPoints);
+  for(int i=0 ; i<3*problem.numPoints ; ++i)
+    expected[i] = force[i] = 0.01*i;
+
+  scalarContactForce(springCoefficient, contactRadius, horizon, frictionCoefficient,
+                     problem.numOwnedPoints, &problem.ownedIDs[0], &problem.neighborhoodList[0],
+                     &problem.cellVolume[0], &problem.y[0], &problem.velocity[0], &expected[0]);
+
+  computeShortRangeContactForce(springCoefficient, contactRadius, horizon, frictionCoefficient,
+                                problem.numOwnedPoints, &problem.ownedIDs[0], &problem.neighborhoodList[0],
+                                problem.numPoints, &problem.cellVolume[0], &problem.y[0], &problem.velocity[0], &force[0]);
+
+  // The pairs are summed in a different order, so the comparison is relative to the largest force
+  double maxForce = 0.0;
+  for(int i=0 ; i<3*problem.numPoints ; ++i)
+    maxForce = max(maxForce, fabs(expected[i]));
+  TEST_COMPARE(maxForce, >, 0.0);
+  for(int i=0 ; i<3*problem.numPoints ; ++i)
+    TEST_COMPARE(fabs(force[i] - expected[i]), <=, 1.0e-12*maxForce);
+}
+
+TEUCHOS_UNIT_TEST(ShortRangeForceContactKernel, ProblemSpansBatches) {
+  ContactProblem problem = createContactProblem();
+  // Many batches of 64 pairs, a partial final batch, and pairs on both sides of the contact radius
+  TEST_COMPARE(problem.numPairs, >, 10*64);
+  TEST_COMPARE(problem.numPairs%64, !=, 0);
+  TEST_COMPARE(problem.numPairsInContactRadius, >, 0);
+  TEST_COMPARE(problem.numPairsInContactRadius, <, problem.numPairs);
+}
+
+TEUCHOS_UNIT_TEST(ShortRangeForceContactKernel, NormalForceMatchesScalarLoop) {
+  ContactProblem problem = createContactProblem();
+  compareWithScalarLoop(problem, 0.0, out, success);
+}
+
+TEUCHOS_UNIT_TEST(ShortRangeForceContactKernel, FrictionForceMatchesScalarLoop) {
+  ContactProblem problem = createContactProblem();
+  compareWithScalarLoop(problem, 0.3, out, success);
+}
+
+TEUCHOS_UNIT_TEST(ShortRangeForceContactKernel, ThreadedMatchesScalarLoop) {
+#ifdef _OPENMP
+  // Each thread accumulates into its own copy of the force array, which is summed at the end
+  ContactProblem problem = createContactProblem();
+  int maxThreads = omp_get_max_threads();
+  for(int numThreads=1 ; numThreads<=4 ; ++numThreads){
+    omp_set_num_threads(numThreads);
+    compareWithScalarLoop(problem, 0.0, out, success);
+    compareWithScalarLoop(problem, 0.3, out, success);
+  }
+  omp_set_num_threads(maxThreads);
+#endif
+}
+
+TEUCHOS_UNIT_TEST(ShortRangeForceContactKernel, NoPairs) {
+  // Owned points without contact neighbors leave the force unchanged
+  int ownedIDs[2] = {0, 1};
+  int neighborhoodList[2] = {0, 0};
+  double cellVolume[2] = {1.0, 1.0};
+  double y[6] = {0.0, 0.0, 0.0, 0.5, 0.0, 0.0};
+  double velocity[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  double force[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+  computeShortRangeContactForce(1.0, 1.0, 1.0, 0.3, 2, ownedIDs, neighborhoodList, 2, cellVolume, y, velocity, force);
+  for(int i=0 ; i<6 ; ++i)
+    TEST_EQUALITY(force[i], i + 1.0);
+}
+
+int main
+(int argc, char* argv[])
+{
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
@@ -541,6 +541,73 @@ TEUCHOS_UNIT_TEST(State, CopyFrom) {
   }
 }
 
+//! Test removal of bonds from the bond data and remapping of the bond field ids.
+
+TEUCHOS_UNIT_TEST(State, CompactBondData) {
+
+  Teuchos::RCP<Epetra_Comm> comm;
+
+  #ifdef HAVE_MPI
+    comm = rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  #else
+    comm = rcp(new Epetra_SerialComm);
+  #endif
+
+  PeridigmNS::State state;
+  Teuchos::RCP<Epetra_BlockMap> overlapScalarPointMap;
+  Teuchos::RCP<Epetra_BlockMap> overlapVectorPointMap;
+  Teuchos::RCP<Epetra_BlockMap> ownedScalarBondMap;
+  vector<int> scalarPointFieldIds;
+  vector<int> vectorPointFieldIds;
+  vector<int> bondFieldIds;
+
+  state = createThreePointProblem(comm, overlapScalarPointMap, overlapVectorPointMap, ownedScalarBondMap, scalarPointFieldIds, vectorPointFieldIds, bondFieldIds);
+
+  FieldManager& fm = FieldManager::self();
+  int bondDamageFieldId = fm.getFieldId("Bond_Damage");
+  int plasticExtensionFieldId = fm.getFieldId("Deviatoric_Plastic_Extension");
+
+  // set distinct values for each bond
+  Epetra_Vector& bondDamage = *(state.getData(bondDamageFieldId));
+  Epetra_Vector& plasticExtension = *(state.getData(plasticExtensionFieldId));
+  for(int i=0 ; i<bondDamage.MyLength() ; ++i){
+    bondDamage[i] = i;
+    plasticExtension[i] = 100.0 + i;
+  }
+
+  // remove the first bond of every point that has more than one bond
+  const Epetra_BlockMap& map = *ownedScalarBondMap;
+  vector<int> retainedBondIndices;
+  vector<int> compactedElementSize(map.NumMyElements());
+  for(int i=0 ; i<map.NumMyElements() ; ++i){
+    int firstPointInElement = map.FirstPointInElement(i);
+    int firstRetained = (map.ElementSize(i) > 1) ? 1 : 0;
+    for(int j=firstRetained ; j<map.ElementSize(i) ; ++j)
+      retainedBondIndices.push_back(firstPointInElement + j);
+    compactedElementSize[i] = map.ElementSize(i) - firstRetained;
+  }
+  Teuchos::RCP<const Epetra_BlockMap> compactedMap =
+    Teuchos::rcp(new Epetra_BlockMap(-1, map.NumMyElements(), map.MyGlobalElements(), &compactedElementSize[0], 0, *comm));
+
+  state.compactBondData(compactedMap, retainedBondIndices);
+
+  TEST_EQUALITY( state.getBondMultiVector()->NumVectors(), (int)bondFieldIds.size() );
+  TEST_EQUALITY( state.getBondMultiVector()->MyLength(), (int)retainedBondIndices.size() );
+  TEST_ASSERT( state.getBondMultiVector()->Map().SameAs( *compactedMap ) );
+
+  // the field ids must refer to the compacted vectors, with each value taken from its retained bond
+  Epetra_Vector& compactedBondDamage = *(state.getData(bondDamageFieldId));
+  Epetra_Vector& compactedPlasticExtension = *(state.getData(plasticExtensionFieldId));
+  TEST_EQUALITY( compactedBondDamage.MyLength(), (int)retainedBondIndices.size() );
+  TEST_ASSERT( compactedBondDamage.Map().SameAs( *compactedMap ) );
+  for(unsigned int i=0 ; i<retainedBondIndices.size() ; ++i){
+    TEST_FLOATING_EQUALITY(compactedBondDamage[i], (double)(retainedBondIndices[i]), 1.0e-14);
+    TEST_FLOATING_EQUALITY(compactedPlasticExtension[i], 100.0 + retainedBondIndices[i], 1.0e-14);
+  }
+  TEST_ASSERT( state.getData(bondDamageFieldId)->Values() == (*state.getBondMultiVector())[0] ||
+               state.getData(bondDamageFieldId)->Values() == (*state.getBondMultiVector())[1] );
+}
+
 
 
 
@@ -89,6 +89,14 @@ namespace PeridigmNS {
                   const int* neighborhoodList,
                   PeridigmNS::DataManager& dataManager) const ;
 
+    using DamageModel::computeDamage;
+
+    //! Evaluate the damage using the CSR view of the neighborhood data, if available.
+    virtual void
+    computeDamage(const double dt,
+                  const PeridigmNS::NeighborhoodData& neighborhoodData,
+                  PeridigmNS::DataManager& dataManager) const ;
+
   protected:
 
 	//! Computes the distance between nodes (a1, a2, a3) and (b1, b2, b3).
@@ -109,6 +117,7 @@ namespace PeridigmNS {
     int m_damageFieldId;
     int m_bondDamageFieldId;
     int m_deltaTemperatureFieldId;
+    int m_numberOfCompactedBondsFieldId;
   };
 
 }
@@ -53,6 +53,7 @@
 #include <Epetra_Vector.h>
 #include <Epetra_Map.h>
 #include "Peridigm_DataManager.hpp"
+#include "Peridigm_NeighborhoodData.hpp"
 
 namespace PeridigmNS {
 
@@ -89,6 +90,15 @@ namespace PeridigmNS {
                   const int* neighborhoodList,
                   PeridigmNS::DataManager& dataManager) const = 0;
 
+	//! Evaluate the damage given the block's neighborhood data, which is in CSR form; the default implementation calls computeDamage() with the rebuilt interleaved neighborhood list.
+	virtual void
+	computeDamage(const double dt,
+                  const PeridigmNS::NeighborhoodData& neighborhoodData,
+                  PeridigmNS::DataManager& dataManager) const {
+      std::vector<int> neighborhoodListBuffer;
+      computeDamage(dt, neighborhoodData.NumOwnedPoints(), neighborhoodData.OwnedIDs(), neighborhoodData.NeighborhoodList(neighborhoodListBuffer), dataManager);
+    }
+
   private:
 	
 	//! Default constructor with no arguments, private to prevent use.
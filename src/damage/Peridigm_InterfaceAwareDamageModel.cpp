@@ -47,11 +47,13 @@
 
 #include "Peridigm_InterfaceAwareDamageModel.hpp"
 #include "Peridigm_Field.hpp"
+#include <algorithm>
+#include <vector>
 
 using namespace std;
 
 PeridigmNS::InterfaceAwareDamageModel::InterfaceAwareDamageModel(const Teuchos::ParameterList& params)
-  : DamageModel(params), m_applyThermalStrains(false), m_modelCoordinatesFieldId(-1), m_coordinatesFieldId(-1), m_damageFieldId(-1), m_bondDamageFieldId(-1), m_criticalStretchFieldId(-1), m_deltaTemperatureFieldId(-1)
+  : DamageModel(params), m_applyThermalStrains(false), m_modelCoordinatesFieldId(-1), m_coordinatesFieldId(-1), m_damageFieldId(-1), m_bondDamageFieldId(-1), m_criticalStretchFieldId(-1), m_deltaTemperatureFieldId(-1), m_numberOfCompactedBondsFieldId(-1)
 {
   m_criticalStretch = params.get<double>("Critical Stretch");
 
@@ -75,6 +77,12 @@ PeridigmNS::InterfaceAwareDamageModel::InterfaceAwareDamageModel(const Teuchos::
   m_fieldIds.push_back(m_bondDamageFieldId);
   if(m_applyThermalStrains)
     m_fieldIds.push_back(m_deltaTemperatureFieldId);
+
+  // Bonds removed from the neighborhood list by compaction are fully broken and count toward the damage
+  if(fieldManager.hasField("Number_Of_Compacted_Bonds")){
+    m_numberOfCompactedBondsFieldId = fieldManager.getFieldId("Number_Of_Compacted_Bonds");
+    m_fieldIds.push_back(m_numberOfCompactedBondsFieldId);
+  }
   m_fieldIds.push_back(m_criticalStretchFieldId);
 
 }
@@ -120,6 +128,20 @@ PeridigmNS::InterfaceAwareDamageModel::computeDamage(const double dt,
                                                       const int* neighborhoodList,
                                                       PeridigmNS::DataManager& dataManager) const
 {
+  // View of the interleaved list; the neighbors are gathered one block of points at a time, without copying the list
+  NeighborhoodData neighborhoodData(numOwnedPoints, ownedIDs, neighborhoodList);
+  computeDamage(dt, neighborhoodData, dataManager);
+}
+
+void
+PeridigmNS::InterfaceAwareDamageModel::computeDamage(const double dt,
+                                                     const PeridigmNS::NeighborhoodData& neighborhoodData,
+                                                     PeridigmNS::DataManager& dataManager) const
+{
+  const int numOwnedPoints = neighborhoodData.NumOwnedPoints();
+  const int* ownedIDs = neighborhoodData.OwnedIDs();
+  const int* bondOffsets = neighborhoodData.BondOffsets();
+
   double *x, *y, *damage, *bondDamage, *deltaTemperature, *criticalStretch;
   dataManager.getData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&x);
   dataManager.getData(m_coordinatesFieldId, PeridigmField::STEP_NP1)->ExtractView(&y);
@@ -130,97 +152,80 @@ PeridigmNS::InterfaceAwareDamageModel::computeDamage(const double dt,
   if(m_applyThermalStrains)
     dataManager.getData(m_deltaTemperatureFieldId, PeridigmField::STEP_NP1)->ExtractView(&deltaTemperature);
 
-  double trialDamage(0.0);
-  int neighborhoodListIndex(0), bondIndex(0);
-  int nodeId, numNeighbors, neighborID, iID, iNID;
-  double nodeInitialX[3], nodeCurrentX[3], initialDistance, currentDistance, relativeExtension, totalDamage;
-
-  // Update the bond damage
-  // Break bonds if the extension is greater than the critical extension
-  for(iID=0 ; iID<numOwnedPoints ; ++iID){
-    nodeId = ownedIDs[iID];
-    nodeInitialX[0] = x[nodeId*3];
-    nodeInitialX[1] = x[nodeId*3+1];
-    nodeInitialX[2] = x[nodeId*3+2];
-    nodeCurrentX[0] = y[nodeId*3];
-    nodeCurrentX[1] = y[nodeId*3+1];
-    nodeCurrentX[2] = y[nodeId*3+2];
-    numNeighbors = neighborhoodList[neighborhoodListIndex++];
-
-    for(iNID=0 ; iNID<numNeighbors ; ++iNID){
-      neighborID = neighborhoodList[neighborhoodListIndex++];
-      const double neighborCriticalStretch = criticalStretch[neighborID];
-      // Skip neighbors that do not allow bond breaking or bonds that are already broken
-      if(bondDamage[bondIndex]!=0.0 || neighborCriticalStretch == 0.0){bondIndex+=1;continue;}
-
-      TEUCHOS_TEST_FOR_EXCEPTION(neighborCriticalStretch==0.0,std::logic_error,"Error: Neighbor critical stretch cannot be zero at this point.");
-      const double minCriticalStretch = (neighborCriticalStretch < m_criticalStretch) ? neighborCriticalStretch : m_criticalStretch;
-
-      initialDistance = 
-          distance(nodeInitialX[0], nodeInitialX[1], nodeInitialX[2],
-            x[neighborID*3], x[neighborID*3+1], x[neighborID*3+2]);
-      currentDistance = 
-          distance(nodeCurrentX[0], nodeCurrentX[1], nodeCurrentX[2],
-            y[neighborID*3], y[neighborID*3+1], y[neighborID*3+2]);
-      if(m_applyThermalStrains)
-        currentDistance -= m_alpha*deltaTemperature[nodeId]*initialDistance;
-      relativeExtension = (currentDistance - initialDistance)/initialDistance;
-      trialDamage = 0.0;
-      if(relativeExtension > minCriticalStretch)
-      {
-        trialDamage = 1.0;
-      }
-      if(trialDamage > bondDamage[bondIndex]){
-        bondDamage[bondIndex] = trialDamage;
-      }
-      bondIndex += 1;
-    }
-  }
-
   TEUCHOS_TEST_FOR_EXCEPTION(m_bcManager==Teuchos::null,std::logic_error,"Error: the bc manager pointer should have been set by here.");
   Teuchos::RCP< std::map< std::string, std::vector<int> > > nodeSetMap = m_bcManager->getNodeSets();
 
-  //  Update the element damage (percent of bonds broken)
-  neighborhoodListIndex = 0;
-  bondIndex = 0;
-  for(iID=0 ; iID<numOwnedPoints ; ++iID){
-	nodeId = ownedIDs[iID];
-	numNeighbors = neighborhoodList[neighborhoodListIndex++];
-    neighborhoodListIndex += numNeighbors;
-	totalDamage = 0.0;
-  for(iNID=0 ; iNID<numNeighbors ; ++iNID){
-    totalDamage += bondDamage[bondIndex++];
-  }
-
-  if(totalDamage >= numNeighbors-2) // This would imply rank deficiency and would lead to problems in CG
-  {
-    const string deficientSetName = "RANK_DEFICIENT_NODES";
-    TEUCHOS_TEST_FOR_EXCEPTION(nodeSetMap->find(deficientSetName)==nodeSetMap->end(),std::logic_error,"Error: The placeholder nodeset for rank deficient nodes is missing.");
-    bool nodeAlreadyRegistered = false;
-    vector<int> * deficientSet = &nodeSetMap->find(deficientSetName)->second;
-    for(unsigned i=0;i<deficientSet->size();++i)
-      if((*deficientSet)[i]==nodeId)
-        nodeAlreadyRegistered = true;
-
-    if(!nodeAlreadyRegistered){
-      cout << "Warning: Potentially rank deficient node detected (Node with 2 or less bonds). " << endl
-           << "Node " << nodeId + 1 << " will be removed from the linear system." << endl;
-      deficientSet->push_back(nodeId);
-
-      // if the node is removed from the linear system break all its bonds
-      bondIndex -= numNeighbors;
-      for(iNID=0 ; iNID<numNeighbors ; ++iNID){
-        bondDamage[bondIndex++] = 1.0;
+  double* numberOfCompactedBonds = NULL;
+  if(m_numberOfCompactedBondsFieldId != -1)
+    dataManager.getData(m_numberOfCompactedBondsFieldId, PeridigmField::STEP_NONE)->ExtractView(&numberOfCompactedBonds);
+
+  // Each point reads and writes only its own bonds, so the bond damage and the element damage
+  // are updated in a single pass; the blocks are processed serially because the rank deficient
+  // node set is shared
+  std::vector<int> neighborIndicesBuffer;
+  for(int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()){
+    int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+    const int* neighborIndices = neighborhoodData.NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+    const int firstBond = bondOffsets[firstPoint];
+    for(int iID=firstPoint ; iID<lastPoint ; ++iID){
+      int nodeId = ownedIDs[iID];
+      const double* nodeInitialX = &x[nodeId*3];
+      const double* nodeCurrentX = &y[nodeId*3];
+      int numNeighbors = bondOffsets[iID+1] - bondOffsets[iID];
+
+      // Update the bond damage
+      // Break bonds if the extension is greater than the critical extension
+      double totalDamage = 0.0;
+      for(int bondIndex=bondOffsets[iID] ; bondIndex<bondOffsets[iID+1] ; ++bondIndex){
+        int neighborID = neighborIndices[bondIndex-firstBond];
+        const double neighborCriticalStretch = criticalStretch[neighborID];
+        // Skip neighbors that do not allow bond breaking or bonds that are already broken
+        if(bondDamage[bondIndex] == 0.0 && neighborCriticalStretch != 0.0){
+          const double minCriticalStretch = (neighborCriticalStretch < m_criticalStretch) ? neighborCriticalStretch : m_criticalStretch;
+          double initialDistance =
+            distance(nodeInitialX[0], nodeInitialX[1], nodeInitialX[2],
+                     x[neighborID*3], x[neighborID*3+1], x[neighborID*3+2]);
+          double currentDistance =
+            distance(nodeCurrentX[0], nodeCurrentX[1], nodeCurrentX[2],
+                     y[neighborID*3], y[neighborID*3+1], y[neighborID*3+2]);
+          if(m_applyThermalStrains)
+            currentDistance -= m_alpha*deltaTemperature[nodeId]*initialDistance;
+          double relativeExtension = (currentDistance - initialDistance)/initialDistance;
+          if(relativeExtension > minCriticalStretch)
+            bondDamage[bondIndex] = 1.0;
+        }
+        totalDamage += bondDamage[bondIndex];
       }
-      totalDamage = numNeighbors;
-    }
-  }
 
+      //  Update the element damage (percent of bonds broken)
+      if(totalDamage >= numNeighbors-2) // This would imply rank deficiency and would lead to problems in CG
+      {
+        const string deficientSetName = "RANK_DEFICIENT_NODES";
+        TEUCHOS_TEST_FOR_EXCEPTION(nodeSetMap->find(deficientSetName)==nodeSetMap->end(),std::logic_error,"Error: The placeholder nodeset for rank deficient nodes is missing.");
+        vector<int> * deficientSet = &nodeSetMap->find(deficientSetName)->second;
+        bool nodeAlreadyRegistered = std::find(deficientSet->begin(), deficientSet->end(), nodeId) != deficientSet->end();
+
+        if(!nodeAlreadyRegistered){
+          cout << "Warning: Potentially rank deficient node detected (Node with 2 or less bonds). " << endl
+               << "Node " << nodeId + 1 << " will be removed from the linear system." << endl;
+          deficientSet->push_back(nodeId);
+
+          // if the node is removed from the linear system break all its bonds
+          for(int bondIndex=bondOffsets[iID] ; bondIndex<bondOffsets[iID+1] ; ++bondIndex)
+            bondDamage[bondIndex] = 1.0;
+          totalDamage = numNeighbors;
+        }
+      }
 
-	if(numNeighbors > 0)
-	  totalDamage /= numNeighbors;
-	else
-	  totalDamage = 0.0;
- 	damage[nodeId] = totalDamage;
+      if(numberOfCompactedBonds != NULL){
+        totalDamage += numberOfCompactedBonds[nodeId];
+        numNeighbors += static_cast<int>(numberOfCompactedBonds[nodeId]);
+      }
+      if(numNeighbors > 0)
+        totalDamage /= numNeighbors;
+      else
+        totalDamage = 0.0;
+      damage[nodeId] = totalDamage;
+    }
   }
 }
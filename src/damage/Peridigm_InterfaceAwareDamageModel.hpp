@@ -92,6 +92,14 @@ namespace PeridigmNS {
                   const int* neighborhoodList,
                   PeridigmNS::DataManager& dataManager) const ;
 
+    using DamageModel::computeDamage;
+
+    //! Evaluate the damage using the CSR form of the neighborhood data.
+    virtual void
+    computeDamage(const double dt,
+                  const PeridigmNS::NeighborhoodData& neighborhoodData,
+                  PeridigmNS::DataManager& dataManager) const;
+
   protected:
 
 	//! Computes the distance between nodes (a1, a2, a3) and (b1, b2, b3).
@@ -113,6 +121,7 @@ namespace PeridigmNS {
     int m_bondDamageFieldId;
     int m_criticalStretchFieldId;
     int m_deltaTemperatureFieldId;
+    int m_numberOfCompactedBondsFieldId;
 
     Teuchos::RCP<PeridigmNS::BoundaryAndInitialConditionManager> m_bcManager;
   };
@@ -47,11 +47,13 @@
 
 #include "Peridigm_UserDefinedTimeDependentCriticalStretchDamageModel.hpp"
 #include "Peridigm_Field.hpp"
+#include <algorithm>
+#include <vector>
 
 using namespace std;
 
 PeridigmNS::UserDefinedTimeDependentCriticalStretchDamageModel::UserDefinedTimeDependentCriticalStretchDamageModel(const Teuchos::ParameterList& params)
-  : DamageModel(params), m_applyThermalStrains(false), m_modelCoordinatesFieldId(-1), m_coordinatesFieldId(-1), m_damageFieldId(-1), m_bondDamageFieldId(-1), m_deltaTemperatureFieldId(-1)
+  : DamageModel(params), m_applyThermalStrains(false), m_modelCoordinatesFieldId(-1), m_coordinatesFieldId(-1), m_damageFieldId(-1), m_bondDamageFieldId(-1), m_deltaTemperatureFieldId(-1), m_numberOfCompactedBondsFieldId(-1)
 {
 
   functiondmg = params.get<string>("Time Dependent Critical Stretch");
@@ -87,6 +89,12 @@ PeridigmNS::UserDefinedTimeDependentCriticalStretchDamageModel::UserDefinedTimeD
   
   if(m_applyThermalStrains)
     m_fieldIds.push_back(m_deltaTemperatureFieldId);
+
+  // Bonds removed from the neighborhood list by compaction are fully broken and count toward the damage
+  if(fieldManager.hasField("Number_Of_Compacted_Bonds")){
+    m_numberOfCompactedBondsFieldId = fieldManager.getFieldId("Number_Of_Compacted_Bonds");
+    m_fieldIds.push_back(m_numberOfCompactedBondsFieldId);
+  }
 }
 
 PeridigmNS::UserDefinedTimeDependentCriticalStretchDamageModel::~UserDefinedTimeDependentCriticalStretchDamageModel()
@@ -166,76 +174,80 @@ PeridigmNS::UserDefinedTimeDependentCriticalStretchDamageModel::computeDamage(co
                                                       const int* neighborhoodList,
                                                       PeridigmNS::DataManager& dataManager) const 
 {
-  double *x, *y, *damage, *bondDamageN, *bondDamageNP1, *deltaTemperature, *step;
+  // View of the interleaved list; the neighbors are gathered one block of points at a time, without copying the list
+  NeighborhoodData neighborhoodData(numOwnedPoints, ownedIDs, neighborhoodList);
+  computeDamage(dt, neighborhoodData, dataManager);
+}
+
+void
+PeridigmNS::UserDefinedTimeDependentCriticalStretchDamageModel::computeDamage(const double dt,
+                                                      const PeridigmNS::NeighborhoodData& neighborhoodData,
+                                                      PeridigmNS::DataManager& dataManager) const
+{
+  const int numOwnedPoints = neighborhoodData.NumOwnedPoints();
+  const int* ownedIDs = neighborhoodData.OwnedIDs();
+  const int* bondOffsets = neighborhoodData.BondOffsets();
+
+  double *x, *y, *damage, *bondDamageNP1, *deltaTemperature;
   dataManager.getData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&x);
   dataManager.getData(m_coordinatesFieldId, PeridigmField::STEP_NP1)->ExtractView(&y);
   dataManager.getData(m_damageFieldId, PeridigmField::STEP_NP1)->ExtractView(&damage);
-  dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_N)->ExtractView(&bondDamageN);
   dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_NP1)->ExtractView(&bondDamageNP1);
-  //dataManager.getData(m_stepFieldId, PeridigmField::STEP_NP1)->ExtractView(&step);
   deltaTemperature = NULL;
   if(m_applyThermalStrains)
     dataManager.getData(m_deltaTemperatureFieldId, PeridigmField::STEP_NP1)->ExtractView(&deltaTemperature);
-    
-
-  double trialDamage(0.0);
-  int neighborhoodListIndex(0), bondIndex(0);
-  int nodeId, numNeighbors, neighborID, iID, iNID;
-  double nodeInitialX[3], nodeCurrentX[3], initialDistance, currentDistance, relativeExtension, totalDamage;
-
-  // Set the bond damage to the previous value
-  dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_NP1) =
-    dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_N);
-
-  // Update the bond damage
-  // Break bonds if the extension is greater than the critical extension
-  
-  for(iID=0 ; iID<numOwnedPoints ; ++iID){
-	nodeId = ownedIDs[iID];
-	nodeInitialX[0] = x[nodeId*3];
-	nodeInitialX[1] = x[nodeId*3+1];
-	nodeInitialX[2] = x[nodeId*3+2];
-	nodeCurrentX[0] = y[nodeId*3];
-	nodeCurrentX[1] = y[nodeId*3+1];
-	nodeCurrentX[2] = y[nodeId*3+2];
-	numNeighbors = neighborhoodList[neighborhoodListIndex++];
-	for(iNID=0 ; iNID<numNeighbors ; ++iNID){
-	  neighborID = neighborhoodList[neighborhoodListIndex++];
-      initialDistance = 
-        distance(nodeInitialX[0], nodeInitialX[1], nodeInitialX[2],
-                 x[neighborID*3], x[neighborID*3+1], x[neighborID*3+2]);
-      currentDistance = 
-        distance(nodeCurrentX[0], nodeCurrentX[1], nodeCurrentX[2],
-                 y[neighborID*3], y[neighborID*3+1], y[neighborID*3+2]);
-      if(m_applyThermalStrains)
-        currentDistance -= m_alpha*deltaTemperature[nodeId]*initialDistance;
-      relativeExtension = (currentDistance - initialDistance)/initialDistance;
-      trialDamage = 0.0;
-      if(relativeExtension > m_criticalStretch)
-        trialDamage = 1.0;
-      if(trialDamage > bondDamageNP1[bondIndex]){
-        bondDamageNP1[bondIndex] = trialDamage;
+  double* numberOfCompactedBonds = NULL;
+  if(m_numberOfCompactedBondsFieldId != -1)
+    dataManager.getData(m_numberOfCompactedBondsFieldId, PeridigmField::STEP_NONE)->ExtractView(&numberOfCompactedBonds);
+
+  // Each point reads and writes only its own bonds, so the bond damage and the element damage
+  // are updated in a single pass, and the blocks of points are independent
+  const int blockSize = NeighborhoodData::PointBlockSize();
+  const int numPointBlocks = (numOwnedPoints + blockSize - 1)/blockSize;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<int> neighborIndicesBuffer;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for(int pointBlock=0 ; pointBlock<numPointBlocks ; ++pointBlock){
+      int firstPoint = pointBlock*blockSize;
+      int lastPoint = std::min(firstPoint + blockSize, numOwnedPoints);
+      const int* neighborIndices = neighborhoodData.NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+      const int firstBond = bondOffsets[firstPoint];
+      for(int iID=firstPoint ; iID<lastPoint ; ++iID){
+        int nodeId = ownedIDs[iID];
+        const double* nodeInitialX = &x[nodeId*3];
+        const double* nodeCurrentX = &y[nodeId*3];
+        int numNeighbors = bondOffsets[iID+1] - bondOffsets[iID];
+        double totalDamage = 0.0;
+        for(int bondIndex=bondOffsets[iID] ; bondIndex<bondOffsets[iID+1] ; ++bondIndex){
+          int neighborID = neighborIndices[bondIndex-firstBond];
+          double initialDistance =
+            distance(nodeInitialX[0], nodeInitialX[1], nodeInitialX[2],
+                     x[neighborID*3], x[neighborID*3+1], x[neighborID*3+2]);
+          double currentDistance =
+            distance(nodeCurrentX[0], nodeCurrentX[1], nodeCurrentX[2],
+                     y[neighborID*3], y[neighborID*3+1], y[neighborID*3+2]);
+          if(m_applyThermalStrains)
+            currentDistance -= m_alpha*deltaTemperature[nodeId]*initialDistance;
+          double relativeExtension = (currentDistance - initialDistance)/initialDistance;
+          if(relativeExtension > m_criticalStretch && bondDamageNP1[bondIndex] < 1.0)
+            bondDamageNP1[bondIndex] = 1.0;
+          totalDamage += bondDamageNP1[bondIndex];
+        }
+        if(numberOfCompactedBonds != NULL){
+          totalDamage += numberOfCompactedBonds[nodeId];
+          numNeighbors += static_cast<int>(numberOfCompactedBonds[nodeId]);
+        }
+        if(numNeighbors > 0)
+          totalDamage /= numNeighbors;
+        else
+          totalDamage = 0.0;
+        damage[nodeId] = totalDamage;
       }
-      bondIndex += 1;
     }
   }
-
-  //  Update the element damage (percent of bonds broken)
-
-  neighborhoodListIndex = 0;
-  bondIndex = 0;
-  for(iID=0 ; iID<numOwnedPoints ; ++iID){
-	nodeId = ownedIDs[iID];
-	numNeighbors = neighborhoodList[neighborhoodListIndex++];
-    neighborhoodListIndex += numNeighbors;
-	totalDamage = 0.0;
-	for(iNID=0 ; iNID<numNeighbors ; ++iNID){
-	  totalDamage += bondDamageNP1[bondIndex++];
-	}
-	if(numNeighbors > 0)
-	  totalDamage /= numNeighbors;
-	else
-	  totalDamage = 0.0;
- 	damage[nodeId] = totalDamage;
-  }
 }
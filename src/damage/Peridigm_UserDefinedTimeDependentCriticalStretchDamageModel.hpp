@@ -107,7 +107,14 @@ namespace PeridigmNS {
                   const int* ownedIDs,
                   const int* neighborhoodList,
                   PeridigmNS::DataManager& dataManager) const;
-              
+
+    using DamageModel::computeDamage;
+
+    //! Evaluate the damage using the CSR view of the neighborhood data, if available.
+    virtual void
+	computeDamage(const double dt,
+                  const PeridigmNS::NeighborhoodData& neighborhoodData,
+                  PeridigmNS::DataManager& dataManager) const;
                   
     //! evaluate Parser
     void evaluateParserDmg(double & currentValue, double & previousValue, const double & timeCurrent=0.0, const double & timePrevious=0.0);          
@@ -138,6 +145,7 @@ namespace PeridigmNS {
     int m_damageFieldId;
     int m_bondDamageFieldId;
     int m_deltaTemperatureFieldId;
+    int m_numberOfCompactedBondsFieldId;
     int m_stepFieldId;
   };
 
@@ -75,6 +75,9 @@ namespace PeridigmNS {
     //! Write data to disk
     virtual void write(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double) = 0;
 
+    //! Complete any writes that have been staged but not yet written to disk
+    virtual void flush(){};
+
   protected:
 
     //! Number of processors and processor ID
@@ -78,6 +78,13 @@ namespace PeridigmNS {
         (*it)->write(blocks, current_time);
     }
 
+    //! Flush all output managers in container
+    void flush() {
+      std::vector< Teuchos::RCP< PeridigmNS::OutputManager > >::iterator it;
+      for ( it=outputManagers.begin() ; it < outputManagers.end(); it++ )
+        (*it)->flush();
+    }
+
   protected:
 
     //! Container for RCPs to individual output managers
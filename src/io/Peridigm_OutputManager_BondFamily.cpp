@@ -0,0 +1,269 @@
+/*! \file Peridigm_OutputManager_BondFamily.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
+#include <Teuchos_Assert.hpp>
+
+#include "Peridigm.hpp"
+#include "Peridigm_OutputManager_BondFamily.hpp"
+#include "Peridigm_Field.hpp"
+
+using namespace std;
+
+PeridigmNS::OutputManager_BondFamily::OutputManager_BondFamily(const Teuchos::RCP<Teuchos::ParameterList>& params,
+                                                               PeridigmNS::Peridigm *peridigm_,
+                                                               Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks)
+  : writeBondStretch(false), filterByDamage(false), minimumBondDamage(0.0), filterByStretch(false), minimumBondStretch(0.0),
+    bondDamageFieldId(-1), modelCoordinatesFieldId(-1), coordinatesFieldId(-1) {
+
+  // No output requested
+  iWrite = true;
+  if (params == Teuchos::null) {
+    iWrite = false;
+    return;
+  }
+
+  numProc = params->get<int>("NumProc");
+  myPID = params->get<int>("MyPID");
+  count = 0;
+  writeNeighborlist = true;
+
+  // Default to no output
+  frequency = params->get<int>("Output Frequency",-1);
+
+  outputFormat = params->get<string>("Output Format","BINARY");
+  TEUCHOS_TEST_FOR_EXCEPTION( outputFormat != "BINARY",  std::invalid_argument,
+                              "PeridigmNS::OutputManager_BondFamily::OutputManager_BondFamily() -- Output format must be BINARY for bond family output.");
+
+  // Output filename base
+  filenameBase = params->get<string>("Output Filename","bonds");
+
+  // User-requested bond fields
+  FieldManager& fieldManager = FieldManager::self();
+  outputVariables = sublist(params, "Output Variables");
+  for (Teuchos::ParameterList::ConstIterator it = outputVariables->begin(); it != outputVariables->end(); ++it) {
+    PeridigmNS::FieldSpec spec = fieldManager.getFieldSpec(it->first);
+    TEUCHOS_TEST_FOR_EXCEPTION( spec.getRelation() != PeridigmField::BOND,  std::invalid_argument,
+                                "PeridigmNS::OutputManager_BondFamily::OutputManager_BondFamily() -- Bond family output is valid only for bond data, " << it->first << " is not a bond variable.");
+    fieldIds.push_back(spec.getId());
+    columnNames.push_back(spec.getLabel());
+  }
+
+  // The bond stretch is computed from the model and current coordinates rather than stored
+  writeBondStretch = params->get<bool>("Bond Stretch",false);
+  if (writeBondStretch)
+    columnNames.push_back("Bond_Stretch");
+  TEUCHOS_TEST_FOR_EXCEPTION( columnNames.size() == 0,  std::invalid_argument,
+                              "PeridigmNS::OutputManager_BondFamily::OutputManager_BondFamily() -- No Output Variables given and Bond Stretch not requested.");
+  columnData.resize(columnNames.size());
+
+  // Default to writing every bond; if either minimum is given, only bonds meeting at least one of them are written
+  filterByDamage = params->isParameter("Minimum Bond Damage");
+  if (filterByDamage)
+    minimumBondDamage = params->get<double>("Minimum Bond Damage");
+  filterByStretch = params->isParameter("Minimum Bond Stretch");
+  if (filterByStretch)
+    minimumBondStretch = params->get<double>("Minimum Bond Stretch");
+
+  // Bonds compacted out of the neighborhood lists are no longer stored, so a damage-filtered output would silently omit
+  // exactly the fully broken bonds it is meant to capture
+  TEUCHOS_TEST_FOR_EXCEPTION( filterByDamage && fieldManager.hasField("Number_Of_Compacted_Bonds"),  std::invalid_argument,
+                              "PeridigmNS::OutputManager_BondFamily::OutputManager_BondFamily() -- Minimum Bond Damage cannot be used with a Bond Compaction Threshold, compacted bonds are not written.");
+
+  if (filterByDamage)
+    bondDamageFieldId = fieldManager.getFieldId("Bond_Damage");
+  if (writeBondStretch || filterByStretch) {
+    modelCoordinatesFieldId = fieldManager.getFieldId("Model_Coordinates");
+    coordinatesFieldId = fieldManager.getFieldId("Coordinates");
+  }
+}
+
+PeridigmNS::OutputManager_BondFamily::~OutputManager_BondFamily() {
+  if (file.is_open())
+    file.close();
+}
+
+void PeridigmNS::OutputManager_BondFamily::openFile() {
+
+  // One file per processor, named following the Exodus convention
+  std::ostringstream filename;
+  filename << filenameBase << ".bonds";
+  if (numProc > 1) {
+    std::ostringstream tmpstr;
+    tmpstr << numProc;
+    int len = tmpstr.str().length();
+    filename << "." << std::setfill('0') << std::setw(len) << numProc;
+    filename << "." << std::setfill('0') << std::setw(len) << myPID;
+  }
+
+  file.open(filename.str().c_str(), ios::out | ios::binary | ios::trunc);
+  TEUCHOS_TEST_FOR_EXCEPTION( !file.is_open(),  std::runtime_error,
+                              "PeridigmNS::OutputManager_BondFamily::openFile() -- Unable to open " << filename.str());
+
+  file.write("PDBONDS1", 8);
+  int32_t numColumns = columnNames.size();
+  file.write(reinterpret_cast<const char*>(&numColumns), sizeof(int32_t));
+  for (unsigned int i=0 ; i<columnNames.size() ; ++i) {
+    char columnName[64];
+    memset(columnName, 0, 64);
+    strncpy(columnName, columnNames[i].c_str(), 63);
+    file.write(columnName, 64);
+  }
+}
+
+void PeridigmNS::OutputManager_BondFamily::write(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double current_time) {
+
+  if (!iWrite) return;
+
+  // increment index count
+  count = count + 1;
+
+  // The first call corresponds to the initial configuration
+  if (frequency<=0 || (count-1)%frequency!=0) return;
+
+  if (!file.is_open())
+    openFile();
+
+  bondGlobalIds.clear();
+  for (unsigned int c=0 ; c<columnData.size() ; ++c)
+    columnData[c].clear();
+
+  bool computeStretch = writeBondStretch || filterByStretch;
+  int numFields = fieldIds.size();
+  vector<double*> fieldValues(numFields);
+
+  for (std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++) {
+
+    Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
+    const int numOwnedPoints = neighborhoodData->NumOwnedPoints();
+    const int* bondOffsets = neighborhoodData->BondOffsets();
+    Teuchos::RCP<const Epetra_BlockMap> overlapMap = blockIt->getOverlapScalarPointMap();
+
+    // Fields that are not present in this block are written as zero
+    for (int f=0 ; f<numFields ; ++f) {
+      fieldValues[f] = 0;
+      if (blockIt->hasData(fieldIds[f], PeridigmField::STEP_NP1))
+        blockIt->getData(fieldIds[f], PeridigmField::STEP_NP1)->ExtractView(&fieldValues[f]);
+      else if (blockIt->hasData(fieldIds[f], PeridigmField::STEP_NONE))
+        blockIt->getData(fieldIds[f], PeridigmField::STEP_NONE)->ExtractView(&fieldValues[f]);
+    }
+    double* bondDamage = 0;
+    if (filterByDamage && blockIt->hasData(bondDamageFieldId, PeridigmField::STEP_NP1))
+      blockIt->getData(bondDamageFieldId, PeridigmField::STEP_NP1)->ExtractView(&bondDamage);
+    double *modelCoordinates = 0, *coordinates = 0;
+    if (computeStretch) {
+      blockIt->getData(modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&modelCoordinates);
+      blockIt->getData(coordinatesFieldId, PeridigmField::STEP_NP1)->ExtractView(&coordinates);
+    }
+
+    vector<int> neighborIndicesBuffer;
+    for (int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()) {
+      int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+      const int* neighborIndices = neighborhoodData->NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+      const int firstBond = bondOffsets[firstPoint];
+      for (int iID=firstPoint ; iID<lastPoint ; ++iID) {
+        int globalId = overlapMap->GID(iID);
+        for (int bondIndex=bondOffsets[iID] ; bondIndex<bondOffsets[iID+1] ; ++bondIndex) {
+          int neighborId = neighborIndices[bondIndex-firstBond];
+
+          double stretch = 0.0;
+          if (computeStretch) {
+            double initialDistance(0.0), currentDistance(0.0);
+            for (int i=0 ; i<3 ; ++i) {
+              double dx = modelCoordinates[3*neighborId+i] - modelCoordinates[3*iID+i];
+              double dy = coordinates[3*neighborId+i] - coordinates[3*iID+i];
+              initialDistance += dx*dx;
+              currentDistance += dy*dy;
+            }
+            initialDistance = std::sqrt(initialDistance);
+            currentDistance = std::sqrt(currentDistance);
+            stretch = (currentDistance - initialDistance)/initialDistance;
+          }
+
+          if (filterByDamage || filterByStretch) {
+            bool selected = false;
+            if (filterByDamage && bondDamage != 0 && bondDamage[bondIndex] >= minimumBondDamage)
+              selected = true;
+            if (filterByStretch && stretch >= minimumBondStretch)
+              selected = true;
+            if (!selected)
+              continue;
+          }
+
+          bondGlobalIds.push_back(globalId + 1);
+          bondGlobalIds.push_back(overlapMap->GID(neighborId) + 1);
+          for (int f=0 ; f<numFields ; ++f)
+            columnData[f].push_back(fieldValues[f] != 0 ? fieldValues[f][bondIndex] : 0.0);
+          if (writeBondStretch)
+            columnData[numFields].push_back(stretch);
+        }
+      }
+    }
+  }
+
+  int64_t numBonds = bondGlobalIds.size()/2;
+  file.write(reinterpret_cast<const char*>(&current_time), sizeof(double));
+  file.write(reinterpret_cast<const char*>(&numBonds), sizeof(int64_t));
+  if (numBonds > 0) {
+    file.write(reinterpret_cast<const char*>(&bondGlobalIds[0]), bondGlobalIds.size()*sizeof(int));
+    for (unsigned int c=0 ; c<columnData.size() ; ++c)
+      file.write(reinterpret_cast<const char*>(&columnData[c][0]), columnData[c].size()*sizeof(double));
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION( !file.good(),  std::runtime_error,
+                              "PeridigmNS::OutputManager_BondFamily::write() -- Error writing bond family output.");
+}
+
+void PeridigmNS::OutputManager_BondFamily::flush() {
+  if (file.is_open())
+    file.flush();
+}
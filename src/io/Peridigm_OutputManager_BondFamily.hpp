@@ -0,0 +1,149 @@
+/*! \file Peridigm_OutputManager_BondFamily.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef PERIDIGM_OUTPUTMANAGER_BONDFAMILY_HPP
+#define PERIDIGM_OUTPUTMANAGER_BONDFAMILY_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+#include <Peridigm_OutputManager.hpp>
+
+#include <Teuchos_ParameterList.hpp>
+
+// Forward declaration
+namespace PeridigmNS {
+  class Peridigm;
+}
+
+namespace PeridigmNS {
+
+  /*! \brief Output manager that writes bond data for the bond families of the locally-owned points.
+   *
+   *  Each processor writes its own binary file with no communication, so the output scales to large parallel runs.
+   *  A bond is identified by the global ids of its two points; because bond data are stored by the owner of each
+   *  family, a bond between two points appears once in each of their families.  The output can be restricted to
+   *  bonds whose damage or stretch exceeds a given value, which keeps the files small for fracture analysis.
+   *  Bonds removed from the neighborhood lists by a "Bond Compaction Threshold" are not written, so the Minimum
+   *  Bond Damage filter is rejected when compaction is enabled.
+   *
+   *  Each file holds a header ("PDBONDS1", the number of columns as a 32-bit integer, and a 64-character name for each
+   *  column) followed by one record per output step: the time as a double, the number of bonds as a 64-bit integer,
+   *  the (i, j) global id pair of each bond as 32-bit integers (one-based, as in the Exodus files), and then the
+   *  values of each column for all the bonds in turn.
+   */
+  class OutputManager_BondFamily: public PeridigmNS::OutputManager {
+
+  public:
+
+    //! Basic constructor.
+    OutputManager_BondFamily(const Teuchos::RCP<Teuchos::ParameterList>& params,
+                             PeridigmNS::Peridigm *peridigm_,
+                             Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks);
+
+    //! Destructor.
+    virtual ~OutputManager_BondFamily();
+
+    //! Write the selected bonds to this processor's file
+    virtual void write(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double);
+
+    //! Flush this processor's file to disk
+    virtual void flush();
+
+  private:
+
+    //! Copy constructor.
+    OutputManager_BondFamily( const OutputManager& OM );
+
+    //! Assignment operator.
+    OutputManager_BondFamily& operator=( const OutputManager& OM );
+
+    //! Open this processor's file and write the header
+    void openFile();
+
+    //! Field ids of the requested bond variables
+    std::vector<int> fieldIds;
+
+    //! Column names
+    std::vector<std::string> columnNames;
+
+    //! Flag indicating that the bond stretch is written as the last column
+    bool writeBondStretch;
+
+    //! @name Bond selection
+    //@{
+    //! Flag indicating that bonds are selected by damage
+    bool filterByDamage;
+    //! Bonds with damage greater than or equal to this value are written
+    double minimumBondDamage;
+    //! Flag indicating that bonds are selected by stretch
+    bool filterByStretch;
+    //! Bonds with stretch greater than or equal to this value are written
+    double minimumBondStretch;
+    //@}
+
+    //! @name Field ids used to select bonds and compute the bond stretch
+    //@{
+    int bondDamageFieldId;
+    int modelCoordinatesFieldId;
+    int coordinatesFieldId;
+    //@}
+
+    //! Global id pairs of the bonds in the current record
+    std::vector<int> bondGlobalIds;
+
+    //! Values of each column for the bonds in the current record
+    std::vector< std::vector<double> > columnData;
+
+    //! Output file for this processor
+    std::ofstream file;
+  };
+
+}
+
+#endif //PERIDIGM_OUTPUTMANAGER_BONDFAMILY_HPP
@@ -50,16 +50,36 @@
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
 
 #include <netcdf.h>
 #include <exodusII.h>
 
 #include <Epetra_Comm.h>
+#ifdef HAVE_MPI
+#include <Epetra_MpiComm.h>
+#endif
+#ifdef PARALLEL_AWARE_EXODUS
+#include <exodusII_par.h>
+#endif
 #include "Teuchos_StandardParameterEntryValidators.hpp"
 #include <Teuchos_Assert.hpp>
+#include <Trilinos_version.h>
+#if TRILINOS_MAJOR_MINOR_VERSION >= 111100
+#include "RTC_FunctionRTC.hh"
+#else
+#include "FunctionRTC.hh"
+#endif
+#include <boost/bind.hpp>
 
 #include "Peridigm.hpp"
 #include "Peridigm_OutputManager_ExodusII.hpp"
+#include "Peridigm_ExodusMutex.hpp"
 #include "Peridigm_Field.hpp"
 
 using namespace std;
@@ -114,9 +134,11 @@ PeridigmNS::OutputManager_ExodusII::OutputManager_ExodusII(const Teuchos::RCP<Te
   outputFormat = params->get<string>("Output Format","BINARY"); 
   TEUCHOS_TEST_FOR_EXCEPTION( outputFormat != "BINARY",  std::invalid_argument, "PeridigmNS::OutputManager_ExodusII:::OutputManager_ExodusII() -- Output format must be BINARY for ExodusII.");
 
-  // Default to not write full neighborlist
+  // Bond families are not written to the Exodus database; the flag is accepted for existing input decks and ignored
   writeNeighborlist = params->get<bool>("Bond Family",false); 
-  TEUCHOS_TEST_FOR_EXCEPTION( (numProc != 1) && (writeNeighborlist),  std::invalid_argument, "PeridigmNS::OutputManager_ExodusII:::OutputManager_ExodusII() -- Parallel write of bond families not currently supported.");
+  if(writeNeighborlist && myPID == 0)
+    std::cout << "\n**** Warning in PeridigmNS::OutputManager_ExodusII, \"Bond Family\" is ignored; bond families are written by a separate Output list with \"Output File Type\" set to \"Bond Family\".\n" << std::endl;
+  writeNeighborlist = false;
 
   // Output filename base
   filenameBase = params->get<string>("Output Filename","dump"); 
@@ -147,6 +169,94 @@ PeridigmNS::OutputManager_ExodusII::OutputManager_ExodusII(const Teuchos::RCP<Te
 
   // Default to storing and writing doubles
   CPU_word_size = IO_word_size = sizeof(double);
+  string outputPrecision = params->get<string>("Output Precision","Double");
+  outputSinglePrecision = (outputPrecision == "Single");
+
+  // Default to no compression; compression level 1-9 selects netCDF-4 deflate, optionally preceded by the shuffle filter
+  compressionLevel = params->get<int>("Compression Level",0);
+  TEUCHOS_TEST_FOR_EXCEPTION( compressionLevel < 0 || compressionLevel > 9,  std::invalid_argument, "PeridigmNS::OutputManager_ExodusII:::OutputManager_ExodusII() -- Compression Level must be between 0 and 9.");
+  compressionShuffle = params->get<bool>("Compression Shuffle",true);
+
+  // Optional lossy quantization of individual fields to a given number of significant decimal digits
+  if (params->isSublist("Significant Digits")) {
+    Teuchos::ParameterList& significantDigits = params->sublist("Significant Digits");
+    for (Teuchos::ParameterList::ConstIterator it = significantDigits.begin(); it != significantDigits.end(); ++it) {
+      int digits = significantDigits.get<int>(it->first);
+      TEUCHOS_TEST_FOR_EXCEPTION( digits < 1 || digits > 15,  std::invalid_argument, "PeridigmNS::OutputManager_ExodusII:::OutputManager_ExodusII() -- Significant Digits must be between 1 and 15.");
+      mantissaBits[it->first] = static_cast<int>(std::ceil(digits*std::log(10.0)/std::log(2.0)));
+    }
+  }
+
+  // Optional restriction of the output to a region, which is the union of the points in the listed blocks, the points
+  // in the listed node sets, and the points at which the region function evaluates to a nonzero value
+  hasRegion = params->isSublist("Region");
+  if (hasRegion) {
+    Teuchos::ParameterList& regionParams = params->sublist("Region");
+    istringstream blockNames(regionParams.get<string>("Block Names",""));
+    copy(istream_iterator<string>(blockNames), istream_iterator<string>(), back_inserter<vector<string> >(regionBlockNames));
+    istringstream nodeSetNames(regionParams.get<string>("Node Set Names",""));
+    copy(istream_iterator<string>(nodeSetNames), istream_iterator<string>(), back_inserter<vector<string> >(regionNodeSetNames));
+    regionFunction = regionParams.get<string>("Function","");
+    TEUCHOS_TEST_FOR_EXCEPTION( regionBlockNames.empty() && regionNodeSetNames.empty() && regionFunction.empty(),  std::invalid_argument,
+                                "PeridigmNS::OutputManager_ExodusII:::OutputManager_ExodusII() -- Region must specify Block Names, Node Set Names, or a Function.");
+  }
+  numOutputNodes = 0;
+  writesDatabase = true;
+
+  // Optional event-triggered output; a frame is written when the number of newly broken bonds, the increase in the
+  // total damage, or the change in the kinetic energy since the last frame reaches the given threshold, but no sooner
+  // than the minimum interval and no later than the maximum interval
+  hasOutputTrigger = params->isSublist("Output Trigger");
+  triggerBrokenBonds = triggerDamageIncrement = triggerKineticEnergyIncrement = 0.0;
+  triggerMinimumInterval = 1;
+  triggerMaximumInterval = std::numeric_limits<int>::max();
+  if (hasOutputTrigger) {
+    Teuchos::ParameterList& triggerParams = params->sublist("Output Trigger");
+    triggerBrokenBonds = triggerParams.get<int>("Broken Bonds",0);
+    triggerDamageIncrement = triggerParams.get<double>("Damage Increment",0.0);
+    triggerKineticEnergyIncrement = triggerParams.get<double>("Kinetic Energy Increment",0.0);
+    triggerMinimumInterval = triggerParams.get<int>("Minimum Interval",1);
+    triggerMaximumInterval = triggerParams.get<int>("Maximum Interval",frequency > 0 ? frequency : std::numeric_limits<int>::max());
+    TEUCHOS_TEST_FOR_EXCEPTION( triggerMinimumInterval < 1 || triggerMaximumInterval < triggerMinimumInterval,  std::invalid_argument,
+                                "PeridigmNS::OutputManager_ExodusII:::OutputManager_ExodusII() -- Output Trigger requires 1 <= Minimum Interval <= Maximum Interval.");
+  }
+  lastTriggeredOutputStep = 0;
+  lastTriggerMetrics[0] = lastTriggerMetrics[1] = lastTriggerMetrics[2] = 0.0;
+  FieldManager& fieldManager = FieldManager::self();
+  damageFieldId = fieldManager.hasField("Damage") ? fieldManager.getFieldId("Damage") : -1;
+  numberOfCompactedBondsFieldId = fieldManager.hasField("Number_Of_Compacted_Bonds") ? fieldManager.getFieldId("Number_Of_Compacted_Bonds") : -1;
+  volumeFieldId = fieldManager.hasField("Volume") ? fieldManager.getFieldId("Volume") : -1;
+  velocityFieldId = fieldManager.hasField("Velocity") ? fieldManager.getFieldId("Velocity") : -1;
+
+  // Default to one database per processor; a shared database is written collectively through parallel netCDF-4
+  sharedFile = params->get<bool>("Shared File",false);
+  if(numProc == 1 || globalDataOnly)
+    sharedFile = false;
+#if !defined(HAVE_MPI) || !defined(PARALLEL_AWARE_EXODUS)
+  TEUCHOS_TEST_FOR_EXCEPTION( sharedFile,  std::invalid_argument, "PeridigmNS::OutputManager_ExodusII:::OutputManager_ExodusII() -- Shared File requires an MPI build and an exodus library with parallel netCDF-4 support.");
+#endif
+  sharedNodeOffset = 0;
+
+  // Default to opening and closing the database at every write; if the database is kept open it is synced with
+  // ex_update every flushInterval writes, so the file on disk is valid up to the last sync
+  keepFileOpen = params->get<bool>("Keep File Open",false);
+  flushInterval = params->get<int>("Flush Interval",1);
+  TEUCHOS_TEST_FOR_EXCEPTION( flushInterval < 1,  std::invalid_argument, "PeridigmNS::OutputManager_ExodusII:::OutputManager_ExodusII() -- Flush Interval must be at least 1.");
+  fileIsOpen = false;
+  writesSinceUpdate = 0;
+
+  // Default to synchronous output; in asynchronous mode the fields are copied into one of a fixed number of
+  // snapshots and written by a background thread while the solver continues
+  asynchronousWrite = params->get<bool>("Asynchronous Write",false);
+  int maxPendingWrites = params->get<int>("Maximum Pending Writes",2);
+  TEUCHOS_TEST_FOR_EXCEPTION( maxPendingWrites < 1,  std::invalid_argument, "PeridigmNS::OutputManager_ExodusII:::OutputManager_ExodusII() -- Maximum Pending Writes must be at least 1.");
+  TEUCHOS_TEST_FOR_EXCEPTION( asynchronousWrite && sharedFile,  std::invalid_argument, "PeridigmNS::OutputManager_ExodusII:::OutputManager_ExodusII() -- Asynchronous Write is not supported for a Shared File.");
+  if(!asynchronousWrite)
+    maxPendingWrites = 1;
+  snapshotPool.resize(maxPendingWrites);
+  for(int i=0 ; i<maxPendingWrites ; ++i)
+    freeSnapshots.push_back(i);
+  asyncShutdown = false;
   
   // Not called yet
   initializeExodusDatabaseCalled = false;
@@ -172,8 +282,27 @@ Teuchos::ParameterList PeridigmNS::OutputManager_ExodusII::getValidParameterList
   setIntParameter("Initial Output Step",1,"Integer number of first output dump.",&validParameterList,intParam);
   setIntParameter("Final Output Step",std::numeric_limits<int>::max()-1,"Integer number of last output dump.",&validParameterList,intParam);
   Teuchos::setStringToIntegralParameter<int>("Output Format","BINARY","ASCII or BINARY",Teuchos::tuple<string>("ASCII","BINARY"),&validParameterList);
+  Teuchos::setStringToIntegralParameter<int>("Output Precision","Double","Double or Single",Teuchos::tuple<string>("Double","Single"),&validParameterList);
+  setIntParameter("Compression Level",0,"netCDF-4 deflate level, 0 for no compression",&validParameterList,intParam);
+  validParameterList.set("Compression Shuffle",true);
   setIntParameter("Output Frequency",-1,"Frequency of Output",&validParameterList,intParam);
   validParameterList.set("Parallel Write",true);
+  validParameterList.set("Shared File",false);
+  validParameterList.set("Bond Family",false);
+  Teuchos::ParameterList& validRegionParameterList = validParameterList.sublist("Region");
+  validRegionParameterList.set("Block Names","");
+  validRegionParameterList.set("Node Set Names","");
+  validRegionParameterList.set("Function","");
+  Teuchos::ParameterList& validTriggerParameterList = validParameterList.sublist("Output Trigger");
+  setIntParameter("Broken Bonds",0,"Number of newly broken bonds that triggers a frame",&validTriggerParameterList,intParam);
+  validTriggerParameterList.set("Damage Increment",0.0);
+  validTriggerParameterList.set("Kinetic Energy Increment",0.0);
+  setIntParameter("Minimum Interval",1,"Minimum number of steps between frames",&validTriggerParameterList,intParam);
+  setIntParameter("Maximum Interval",std::numeric_limits<int>::max(),"Maximum number of steps between frames",&validTriggerParameterList,intParam);
+  validParameterList.set("Keep File Open",false);
+  setIntParameter("Flush Interval",1,"Number of writes between syncs of an open database",&validParameterList,intParam);
+  validParameterList.set("Asynchronous Write",false);
+  setIntParameter("Maximum Pending Writes",2,"Maximum number of output steps staged for the background writer",&validParameterList,intParam);
 
   // Create a vector of valid output variables
   // Do not include bond data, since we can not output it
@@ -201,10 +330,36 @@ Teuchos::ParameterList PeridigmNS::OutputManager_ExodusII::getValidParameterList
   for(unsigned int i=0 ; i<validOutputFieldSpecs.size() ; ++i)
     validOutputVariablesParameterList.set(validOutputFieldSpecs[i].getLabel(), false);
 
+  // Any output variable may be given a number of significant digits
+  Teuchos::ParameterList& validSignificantDigitsParameterList = validParameterList.sublist("Significant Digits");
+  for(unsigned int i=0 ; i<validOutputFieldSpecs.size() ; ++i)
+    setIntParameter(validOutputFieldSpecs[i].getLabel(),15,"Number of significant digits",&validSignificantDigitsParameterList,intParam);
+
   return validParameterList;
 }
 
 PeridigmNS::OutputManager_ExodusII::~OutputManager_ExodusII() {
+
+  // Write any remaining snapshots and stop the background thread
+  if(!writerThread.is_null()){
+    {
+      boost::mutex::scoped_lock lock(asyncMutex);
+      asyncShutdown = true;
+    }
+    asyncCondition.notify_all();
+    writerThread->join();
+    if(!asyncWriteError.empty())
+      std::cout << "\n**** Error in PeridigmNS::OutputManager_ExodusII, asynchronous write failed: " << asyncWriteError << std::endl;
+  }
+
+  // Close the database if it was kept open; ex_close syncs any data written since the last ex_update
+  if(fileIsOpen){
+    boost::mutex::scoped_lock exodusLock(exodusMutex());
+    int retval = ex_close(file_handle);
+    if(retval != 0)
+      std::cout << "\n**** Warning in PeridigmNS::OutputManager_ExodusII, ex_close returned " << retval << std::endl;
+    fileIsOpen = false;
+  }
 }
 
 void PeridigmNS::OutputManager_ExodusII::write(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double current_time) {
@@ -220,9 +375,13 @@ void PeridigmNS::OutputManager_ExodusII::write(Teuchos::RCP< std::vector<Peridig
     // Call compute manager; Updated any pre_computed quantities
     peridigm->computeManager->pre_compute(blocks);
 
-  // Only write if count is in between first and last dumps and frequency count match. 
+  // Only write if count is in between first and last dumps and frequency count match (or the output trigger fires).
   // The +/- 1 is to account for the initialization dumps
-  if ((count<(firstOutputStep) || count>(lastOutputStep+1)) || (frequency<=0 || (count-1)%frequency!=0)) return;
+  if (count<(firstOutputStep) || count>(lastOutputStep+1)) return;
+  if (hasOutputTrigger) {
+    if (!outputTriggerFired(blocks)) return;
+  }
+  else if (frequency<=0 || (count-1)%frequency!=0) return;
 
   // increment exodus_count index
   exodusCount = exodusCount + 1;
@@ -247,29 +406,202 @@ void PeridigmNS::OutputManager_ExodusII::write(Teuchos::RCP< std::vector<Peridig
     peridigm->getInterfaceData()->WriteExodusOutput(exodusCount,current_time,peridigm->getX(),peridigm->getY());
   }
 
-  // Open exodus database for writing
-  float version;
-  file_handle = ex_open(filename.str().c_str(), EX_WRITE, &CPU_word_size, &IO_word_size, &version);
-  if (file_handle < 0) reportExodusError(file_handle, "write", "ex_open");
+  if(!writesDatabase)
+    return;
 
-  // Write time value
-  int retval = ex_put_time(file_handle,exodusCount,&current_time);
-  if (retval!= 0) reportExodusError(retval, "write", "ex_put_time");
+  if(!asynchronousWrite){
+    packSnapshot(blocks, current_time, snapshotPool[0]);
+    writeSnapshot(snapshotPool[0]);
+    return;
+  }
+
+  // Start the background writer on the first asynchronous write
+  if(writerThread.is_null())
+    writerThread = Teuchos::rcp(new boost::thread(boost::bind(&PeridigmNS::OutputManager_ExodusII::asyncWriteLoop, this)));
+
+  // Wait for a free snapshot; this bounds the number of output steps in flight
+  int snapshotIndex;
+  {
+    boost::mutex::scoped_lock lock(asyncMutex);
+    while(freeSnapshots.empty() && asyncWriteError.empty())
+      asyncCondition.wait(lock);
+    checkAsyncWriteError();
+    snapshotIndex = freeSnapshots.front();
+    freeSnapshots.pop_front();
+  }
+
+  // The writer thread never touches a free snapshot, so it can be packed without holding the lock
+  packSnapshot(blocks, current_time, snapshotPool[snapshotIndex]);
+
+  {
+    boost::mutex::scoped_lock lock(asyncMutex);
+    pendingSnapshots.push_back(snapshotIndex);
+  }
+  asyncCondition.notify_all();
+}
+
+bool PeridigmNS::OutputManager_ExodusII::outputTriggerFired(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks) {
+
+  // The first eligible step is always written, and a frame is forced once the maximum interval has elapsed
+  int stepsSinceLastFrame = count - lastTriggeredOutputStep;
+  bool fire = (lastTriggeredOutputStep == 0 || stepsSinceLastFrame >= triggerMaximumInterval);
+  if (!fire && stepsSinceLastFrame < triggerMinimumInterval)
+    return false;
+
+  // The metrics are also evaluated for forced frames, since they are the baseline for the next trigger
+  double metrics[3];
+  computeOutputTriggerMetrics(blocks, metrics);
+  if (triggerBrokenBonds > 0.0 && metrics[0] - lastTriggerMetrics[0] >= triggerBrokenBonds)
+    fire = true;
+  if (triggerDamageIncrement > 0.0 && metrics[1] - lastTriggerMetrics[1] >= triggerDamageIncrement)
+    fire = true;
+  if (triggerKineticEnergyIncrement > 0.0 && std::abs(metrics[2] - lastTriggerMetrics[2]) >= triggerKineticEnergyIncrement)
+    fire = true;
+
+  if (fire) {
+    lastTriggeredOutputStep = count;
+    for (int i=0 ; i<3 ; ++i)
+      lastTriggerMetrics[i] = metrics[i];
+  }
+  return fire;
+}
+
+void PeridigmNS::OutputManager_ExodusII::computeOutputTriggerMetrics(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double* metrics) {
+
+  bool computeDamage = (triggerBrokenBonds > 0.0 || triggerDamageIncrement > 0.0) && damageFieldId != -1;
+  bool computeKineticEnergy = triggerKineticEnergyIncrement > 0.0 && volumeFieldId != -1 && velocityFieldId != -1;
+
+  double localMetrics[3] = {0.0, 0.0, 0.0};
+  for (std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++) {
+
+    Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = blockIt->getNeighborhoodData();
+    const int numOwnedPoints = neighborhoodData->NumOwnedPoints();
+    const int* ownedIDs = neighborhoodData->OwnedIDs();
+
+    if (computeDamage && blockIt->hasData(damageFieldId, PeridigmField::STEP_NP1)) {
+      double *damage, *numberOfCompactedBonds(0);
+      blockIt->getData(damageFieldId, PeridigmField::STEP_NP1)->ExtractView(&damage);
+      if (numberOfCompactedBondsFieldId != -1 && blockIt->hasData(numberOfCompactedBondsFieldId, PeridigmField::STEP_NONE))
+        blockIt->getData(numberOfCompactedBondsFieldId, PeridigmField::STEP_NONE)->ExtractView(&numberOfCompactedBonds);
+      const int* bondOffsets = neighborhoodData->BondOffsets();
+      for (int iID=0 ; iID<numOwnedPoints ; ++iID) {
+        int nodeId = ownedIDs[iID];
+        double numBonds = bondOffsets[iID+1] - bondOffsets[iID];
+        if (numberOfCompactedBonds != 0)
+          numBonds += numberOfCompactedBonds[nodeId];
+        localMetrics[0] += damage[nodeId]*numBonds;
+        localMetrics[1] += damage[nodeId];
+      }
+    }
+
+    if (computeKineticEnergy && blockIt->hasData(velocityFieldId, PeridigmField::STEP_NP1)) {
+      double *volume, *velocity;
+      blockIt->getData(volumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&volume);
+      blockIt->getData(velocityFieldId, PeridigmField::STEP_NP1)->ExtractView(&velocity);
+      double density = blockIt->getMaterialModel()->Density();
+      for (int iID=0 ; iID<numOwnedPoints ; ++iID) {
+        int nodeId = ownedIDs[iID];
+        double v1 = velocity[3*nodeId], v2 = velocity[3*nodeId+1], v3 = velocity[3*nodeId+2];
+        localMetrics[2] += 0.5*volume[nodeId]*density*(v1*v1 + v2*v2 + v3*v3);
+      }
+    }
+  }
+
+  peridigm->getEpetraComm()->SumAll(localMetrics, metrics, 3);
+}
+
+void PeridigmNS::OutputManager_ExodusII::flush() {
+
+  if(!writerThread.is_null()){
+    boost::mutex::scoped_lock lock(asyncMutex);
+    while(!pendingSnapshots.empty())
+      asyncCondition.wait(lock);
+    checkAsyncWriteError();
+  }
+
+  // The queue is empty, so the writer thread is idle and the open database can be synced from this thread
+  if(fileIsOpen && writesSinceUpdate > 0){
+    boost::mutex::scoped_lock exodusLock(exodusMutex());
+    int retval = ex_update(file_handle);
+    if (retval!= 0) reportExodusError(retval, "flush", "ex_update");
+    writesSinceUpdate = 0;
+  }
+}
+
+void PeridigmNS::OutputManager_ExodusII::asyncWriteLoop() {
+
+  while(true){
+
+    int snapshotIndex;
+    {
+      boost::mutex::scoped_lock lock(asyncMutex);
+      while(pendingSnapshots.empty() && !asyncShutdown)
+        asyncCondition.wait(lock);
+      if(pendingSnapshots.empty())
+        return;
+      snapshotIndex = pendingSnapshots.front();
+    }
+
+    // Exceptions cannot propagate out of the thread; record the first error and report it from the main thread
+    std::string errorMessage;
+    try{
+      writeSnapshot(snapshotPool[snapshotIndex]);
+    }
+    catch(const std::exception& e){
+      errorMessage = e.what();
+    }
+
+    {
+      boost::mutex::scoped_lock lock(asyncMutex);
+      pendingSnapshots.pop_front();
+      freeSnapshots.push_back(snapshotIndex);
+      if(!errorMessage.empty() && asyncWriteError.empty())
+        asyncWriteError = errorMessage;
+    }
+    asyncCondition.notify_all();
+  }
+}
+
+void PeridigmNS::OutputManager_ExodusII::checkAsyncWriteError() {
+  TEUCHOS_TEST_FOR_EXCEPTION(!asyncWriteError.empty(), std::runtime_error,
+                             "PeridigmNS::OutputManager_ExodusII::write() -- Asynchronous write failed:\n" << asyncWriteError);
+}
+
+namespace {
+#if defined(HAVE_MPI) && defined(PARALLEL_AWARE_EXODUS)
+  // Communicator for collective access to a shared database
+  MPI_Comm sharedFileComm(const Epetra_Comm& comm) {
+    return dynamic_cast<const Epetra_MpiComm&>(comm).Comm();
+  }
+#endif
+
+  // Reserve the next variable in a snapshot, reusing the storage allocated at previous output steps; returns its position in variables
+  unsigned int stageVariable(std::vector<PeridigmNS::ExodusOutputVariable>& variables, unsigned int& numVariables, int index, int blockId, int length) {
+    if(numVariables == variables.size())
+      variables.push_back(PeridigmNS::ExodusOutputVariable());
+    PeridigmNS::ExodusOutputVariable& variable = variables[numVariables];
+    variable.index = index;
+    variable.blockId = blockId;
+    variable.values.resize(length);
+    return numVariables++;
+  }
+}
+
+void PeridigmNS::OutputManager_ExodusII::packSnapshot(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double current_time, ExodusOutputSnapshot& snapshot) {
+
+  snapshot.exodusCount = exodusCount;
+  snapshot.time = current_time;
+  snapshot.numNodalVariables = 0;
+  snapshot.numElementVariables = 0;
 
   int num_nodes(1);
   if(!globalDataOnly)
-    num_nodes = peridigm->getOneDimensionalMap()->NumMyElements();
-
-  // Allocate temporary storage for all mothership-like data
-  std::vector<double> x_vec(num_nodes), y_vec(num_nodes), z_vec(num_nodes);
-  double *xptr = &x_vec[0];
-  double *yptr = &y_vec[0];
-  double *zptr = &z_vec[0];
+    num_nodes = numOutputNodes;
 
-  // allocate temporate storage for globals
+  // storage for globals
   int num_global_vars = global_output_field_map.size();
-  std::vector<double> globals_vec(num_global_vars);
-  double *globals = &globals_vec[0];
+  std::vector<double>& globals = snapshot.globals;
+  globals.resize(num_global_vars);
   unsigned int globalsIndex = 0;
 
   for (Teuchos::ParameterList::ConstIterator it = outputVariables->begin(); it != outputVariables->end(); ++it) {
@@ -280,34 +612,43 @@ void PeridigmNS::OutputManager_ExodusII::write(Teuchos::RCP< std::vector<Peridig
     double *block_ptr = NULL;
     if (spec.getRelation() == PeridigmField::GLOBAL) {
       // global vars are static within a block, so only need to reference first block
+      PeridigmField::Step step = PeridigmField::STEP_NP1;
+      if (spec.getTemporal() == PeridigmField::CONSTANT)
+        step = PeridigmField::STEP_NONE;
       if (spec.getLength() == PeridigmField::SCALAR) {
-        TEUCHOS_TEST_FOR_EXCEPTION(globalsIndex >= globals_vec.size(), std::invalid_argument, "PeridigmNS::OutputManager_ExodusII::write() -- error writing global variable.");
-        if (spec.getTemporal() == PeridigmField::CONSTANT)
-          globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), PeridigmField::STEP_NONE)))[0];
-        else
-          globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), PeridigmField::STEP_NP1)))[0];
+        TEUCHOS_TEST_FOR_EXCEPTION(globalsIndex >= globals.size(), std::invalid_argument, "PeridigmNS::OutputManager_ExodusII::write() -- error writing global variable.");
+        globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), step)))[0];
       }
       else if (spec.getLength() == PeridigmField::VECTOR) {
-        TEUCHOS_TEST_FOR_EXCEPTION(globalsIndex >= globals_vec.size(), std::invalid_argument, "PeridigmNS::OutputManager_ExodusII::write() -- error writing global variable.");
-        if (spec.getTemporal() == PeridigmField::CONSTANT){
-          globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), PeridigmField::STEP_NONE)))[0];
-          globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), PeridigmField::STEP_NONE)))[1];
-          globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), PeridigmField::STEP_NONE)))[2];
-        }
-        else{
-          globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), PeridigmField::STEP_NP1)))[0];
-          globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), PeridigmField::STEP_NP1)))[1];
-          globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), PeridigmField::STEP_NP1)))[2];
-        }
+        TEUCHOS_TEST_FOR_EXCEPTION(globalsIndex+2 >= globals.size(), std::invalid_argument, "PeridigmNS::OutputManager_ExodusII::write() -- error writing global variable.");
+        globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), step)))[0];
+        globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), step)))[1];
+        globals[globalsIndex++] = (*(blocks->begin()->getData(spec.getId(), step)))[2];
       }
       else {
         TEUCHOS_TEST_FOR_EXCEPTION(true, std::invalid_argument, "PeridigmNS::OutputManager_ExodusII::write() -- unsupported global type (must be scalar or vector).");
       }
-      retval = ex_put_glob_vars(file_handle, exodusCount, num_global_vars, globals);
-      if (retval!= 0) reportExodusError(retval, "write", "ex_put_glob_vars");
     }
     // Exodus ignores element blocks when writing nodal variables
     else if (spec.getRelation() == PeridigmField::NODE) {
+      // Reserve mothership-like vectors in the snapshot
+      double *xptr(NULL), *yptr(NULL), *zptr(NULL);
+      if (spec.getLength() == PeridigmField::SCALAR) {
+        unsigned int x = stageVariable(snapshot.nodalVariables, snapshot.numNodalVariables, node_output_field_map[name], 0, num_nodes);
+        if (num_nodes > 0)
+          xptr = &snapshot.nodalVariables[x].values[0];
+      }
+      else if (spec.getLength() == PeridigmField::VECTOR) {
+        // Writing all vector output as per-node data
+        unsigned int x = stageVariable(snapshot.nodalVariables, snapshot.numNodalVariables, node_output_field_map[name+"X"], 0, num_nodes);
+        unsigned int y = stageVariable(snapshot.nodalVariables, snapshot.numNodalVariables, node_output_field_map[name+"Y"], 0, num_nodes);
+        unsigned int z = stageVariable(snapshot.nodalVariables, snapshot.numNodalVariables, node_output_field_map[name+"Z"], 0, num_nodes);
+        if (num_nodes > 0) {
+          xptr = &snapshot.nodalVariables[x].values[0];
+          yptr = &snapshot.nodalVariables[y].values[0];
+          zptr = &snapshot.nodalVariables[z].values[0];
+        }
+      }
       // Loop over all blocks, copying data from each block into mothership-like vector
       std::vector<PeridigmNS::Block>::iterator blockIt;
       for(blockIt = blocks->begin(); blockIt != blocks->end() ; blockIt++) {
@@ -323,7 +664,8 @@ void PeridigmNS::OutputManager_ExodusII::write(Teuchos::RCP< std::vector<Peridig
           // loop over contents of block vector; fill mothership-like vector
           for (int j=0;j<block_num_nodes; j++) {
             int GID = blockIt->getOwnedVectorPointMap()->GID(j);
-            int msLID = peridigm->getOneDimensionalMap()->LID(GID);
+            int msLID = outputNodeIndex[peridigm->getOneDimensionalMap()->LID(GID)];
+            if (msLID == -1) continue; // point is not in the output region
             xptr[msLID] = block_ptr[j];
           }
         }
@@ -331,49 +673,42 @@ void PeridigmNS::OutputManager_ExodusII::write(Teuchos::RCP< std::vector<Peridig
           // loop over contents of block vector; fill mothership-like vector
           for (int j=0;j<block_num_nodes; j++) {
             int GID = blockIt->getOwnedVectorPointMap()->GID(j);
-            int msLID = peridigm->getThreeDimensionalMap()->LID(GID);
+            int msLID = outputNodeIndex[peridigm->getThreeDimensionalMap()->LID(GID)];
+            if (msLID == -1) continue; // point is not in the output region
             xptr[msLID] = block_ptr[3*j];
             yptr[msLID] = block_ptr[3*j+1];
             zptr[msLID] = block_ptr[3*j+2];
           }
         } // end switch on data dimension
       } // end loop over blocks
-      // Mothership-like vectors filled now; pass data to exodus database (switch again on dimension of data)
-      if (spec.getLength() == PeridigmField::SCALAR) {
-        retval = ex_put_nodal_var(file_handle, exodusCount, node_output_field_map[name], num_nodes, xptr);
-        if (retval!= 0) reportExodusError(retval, "write", "ex_put_nodal_var");
-      }
-      else if (spec.getLength() == PeridigmField::VECTOR) {
-        // Writing all vector output as per-node data
-        string tmpnameX = name+"X";
-        string tmpnameY = name+"Y";
-        string tmpnameZ = name+"Z";
-        retval = ex_put_nodal_var(file_handle, exodusCount, node_output_field_map[tmpnameX], num_nodes, xptr);
-        if (retval!= 0) reportExodusError(retval, "write", "ex_put_nodal_var");
-        retval = ex_put_nodal_var(file_handle, exodusCount, node_output_field_map[tmpnameY], num_nodes, yptr);
-        if (retval!= 0) reportExodusError(retval, "write", "ex_put_nodal_var");
-        retval = ex_put_nodal_var(file_handle, exodusCount, node_output_field_map[tmpnameZ], num_nodes, zptr);
-        if (retval!= 0) reportExodusError(retval, "write", "ex_put_nodal_var");
+      quantize(name, xptr, num_nodes);
+      if (spec.getLength() == PeridigmField::VECTOR) {
+        quantize(name, yptr, num_nodes);
+        quantize(name, zptr, num_nodes);
       }
     } // end if per-node variable
     // Exodus wants element data written individually for each element block
     else if (spec.getRelation() == PeridigmField::ELEMENT) {
-      // Loop over all blocks, passing data from each block to exodus database
+      // Loop over all blocks, copying data from each block into the snapshot
       std::vector<PeridigmNS::Block>::iterator blockIt;
       for(blockIt = blocks->begin(); blockIt != blocks->end() ; blockIt++) {
-        int block_num_nodes = (blockIt->getDataManager()->getOwnedScalarPointMap())->NumMyElements();
-        if (block_num_nodes == 0) continue; // Don't write data for empty blocks
+        int blockId = blockIt->getID();
+        // Block-local indices of the elements in the output region
+        const std::vector<int>& elements = outputBlockElements[blockId];
+        int block_num_nodes = elements.size();
+        // Don't write data for empty blocks; every processor takes part in writing a shared database, unless the block is empty on all of them
+        if (block_num_nodes == 0 && (!sharedFile || sharedElementBlockSizes[blockId] == 0)) continue;
         if (spec.getId() == elementIdFieldId) { // Handle special case of ID (int type)
+          unsigned int x = stageVariable(snapshot.elementVariables, snapshot.numElementVariables, element_output_field_map[name], blockId, block_num_nodes);
+          double *xptr = snapshot.elementVariables[x].values.size() > 0 ? &snapshot.elementVariables[x].values[0] : NULL;
           for (int j=0; j<block_num_nodes; j++)
-            xptr[j] = (double)(((blockIt->getDataManager()->getOwnedScalarPointMap())->GID(j))+1);
-          retval = ex_put_elem_var(file_handle, exodusCount, element_output_field_map[name], blockIt->getID(), block_num_nodes, xptr);
-          if (retval!= 0) reportExodusError(retval, "write", "ex_put_elem_var");
+            xptr[j] = (double)(((blockIt->getDataManager()->getOwnedScalarPointMap())->GID(elements[j]))+1);
         }
         else if (spec.getId() == procNumFieldId) { // Handle special case of Proc_Num (int type)
+          unsigned int x = stageVariable(snapshot.elementVariables, snapshot.numElementVariables, element_output_field_map[name], blockId, block_num_nodes);
+          double *xptr = snapshot.elementVariables[x].values.size() > 0 ? &snapshot.elementVariables[x].values[0] : NULL;
           for (int j=0; j<block_num_nodes; j++)
             xptr[j] = (double)myPID;
-          retval = ex_put_elem_var(file_handle, exodusCount, element_output_field_map[name], blockIt->getID(), block_num_nodes, xptr);
-          if (retval!= 0) reportExodusError(retval, "write", "ex_put_elem_var");
         }
         else {
           Teuchos::RCP<Epetra_Vector> epetra_vector;
@@ -384,34 +719,20 @@ void PeridigmNS::OutputManager_ExodusII::write(Teuchos::RCP< std::vector<Peridig
             epetra_vector = blockIt->getData(spec.getId(), step);
             epetra_vector->ExtractView(&block_ptr);
             // switch on dimension of data
+            vector<string> suffix;
             if (spec.getLength() == PeridigmField::SCALAR) {
-              retval = ex_put_elem_var(file_handle, exodusCount, element_output_field_map[name], blockIt->getID(), block_num_nodes, block_ptr);
-              if (retval!= 0) reportExodusError(retval, "write", "ex_put_elem_var");
+              suffix.push_back("");
             }
             else if (spec.getLength() == PeridigmField::VECTOR) {
-              // copy data into x, y, and z vectors (non-interleaved)
-              for (int j=0;j<block_num_nodes; j++) {
-                xptr[j] = block_ptr[3*j];
-                yptr[j] = block_ptr[3*j+1];
-                zptr[j] = block_ptr[3*j+2];
-              }
-              // write the vectors to the exodus file
-              string tmpnameX = name+"X";
-              string tmpnameY = name+"Y";
-              string tmpnameZ = name+"Z";
-              retval = ex_put_elem_var(file_handle, exodusCount, element_output_field_map[tmpnameX], blockIt->getID(), block_num_nodes, xptr);
-              if (retval!= 0) reportExodusError(retval, "write", "ex_put_elem_var");
-              retval = ex_put_elem_var(file_handle, exodusCount, element_output_field_map[tmpnameY], blockIt->getID(), block_num_nodes, yptr);
-              if (retval!= 0) reportExodusError(retval, "write", "ex_put_elem_var");
-              retval = ex_put_elem_var(file_handle, exodusCount, element_output_field_map[tmpnameZ], blockIt->getID(), block_num_nodes, zptr);
-              if (retval!= 0) reportExodusError(retval, "write", "ex_put_elem_var");
+              suffix.push_back("X");
+              suffix.push_back("Y");
+              suffix.push_back("Z");
             }
             else if (spec.getLength() == PeridigmField::SYMMETRIC_TENSOR) {
               TEUCHOS_TEST_FOR_EXCEPT_MSG(spec.getLength() == PeridigmField::SYMMETRIC_TENSOR,
                                           "\nPeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(), output for SYMMETRIC_TENSOR currently not supported!\n");
             }
             else if (spec.getLength() == PeridigmField::FULL_TENSOR) {
-              vector<string> suffix;
               suffix.push_back("XX");
               suffix.push_back("XY");
               suffix.push_back("XZ");
@@ -421,19 +742,9 @@ void PeridigmNS::OutputManager_ExodusII::write(Teuchos::RCP< std::vector<Peridig
               suffix.push_back("ZX");
               suffix.push_back("ZY");
               suffix.push_back("ZZ");
-              for(int component=0 ; component<9 ; ++component){
-                // copy data into a non-interleaved array
-                for (int j=0; j<block_num_nodes; j++)
-                  xptr[j] = block_ptr[9*j+component];
-                // write data to exodus file
-                string tmpname = name+suffix[component];
-                retval = ex_put_elem_var(file_handle, exodusCount, element_output_field_map[tmpname], blockIt->getID(), block_num_nodes, xptr);
-                if (retval!= 0) reportExodusError(retval, "write", "ex_put_elem_var");
-              }
             }
             else {
               int length = PeridigmField::variableDimension(spec.getLength());
-              vector<string> suffix;
               suffix.push_back("_1");
               suffix.push_back("_2");
               suffix.push_back("_3");
@@ -443,27 +754,92 @@ void PeridigmNS::OutputManager_ExodusII::write(Teuchos::RCP< std::vector<Peridig
               suffix.push_back("_7");
               suffix.push_back("_8");
               suffix.push_back("_9");
-              for(int component=0 ; component<length ; ++component){
-                // copy data into a non-interleaved array
-                for (int j=0; j<block_num_nodes; j++)
-                  xptr[j] = block_ptr[length*j+component];
-                // write data to exodus file
-                string tmpname = name+suffix[component];
-                retval = ex_put_elem_var(file_handle, exodusCount, element_output_field_map[tmpname], blockIt->getID(), block_num_nodes, xptr);
-                if (retval!= 0) reportExodusError(retval, "write", "ex_put_elem_var");
-              }
+              suffix.resize(length);
             }  // end switch on data dimension
+            // copy data into non-interleaved arrays, one for each component
+            int length = suffix.size();
+            for(int component=0 ; component<length ; ++component){
+              string tmpname = name+suffix[component];
+              unsigned int x = stageVariable(snapshot.elementVariables, snapshot.numElementVariables, element_output_field_map[tmpname], blockId, block_num_nodes);
+              double *xptr = snapshot.elementVariables[x].values.size() > 0 ? &snapshot.elementVariables[x].values[0] : NULL;
+              for (int j=0; j<block_num_nodes; j++)
+                xptr[j] = block_ptr[length*elements[j]+component];
+              quantize(name, xptr, block_num_nodes);
+            }
           }
         }
       } // end loop over blocks
     } // if per-element variable
   }
+}
 
-  // Flush write
-  retval = ex_update(file_handle);
-  if (retval!= 0) reportExodusError(retval, "write", "ex_update");
-  retval = ex_close(file_handle);
-  if (retval!= 0) reportExodusError(retval, "write", "ex_close");
+void PeridigmNS::OutputManager_ExodusII::writeSnapshot(ExodusOutputSnapshot& snapshot) {
+
+  boost::mutex::scoped_lock exodusLock(exodusMutex());
+
+  // Open exodus database for writing
+  if (!fileIsOpen) {
+    float version;
+#if defined(HAVE_MPI) && defined(PARALLEL_AWARE_EXODUS)
+    if (sharedFile)
+      file_handle = ex_open_par(filename.str().c_str(), EX_WRITE, &CPU_word_size, &IO_word_size, &version, sharedFileComm(*peridigm->getEpetraComm()), MPI_INFO_NULL);
+    else
+#endif
+    file_handle = ex_open(filename.str().c_str(), EX_WRITE, &CPU_word_size, &IO_word_size, &version);
+    if (file_handle < 0) reportExodusError(file_handle, "write", "ex_open");
+    fileIsOpen = keepFileOpen;
+  }
+
+  // Write time value
+  int retval = ex_put_time(file_handle,snapshot.exodusCount,&snapshot.time);
+  if (retval!= 0) reportExodusError(retval, "write", "ex_put_time");
+
+  // Write globals
+  if (snapshot.globals.size() > 0) {
+    retval = ex_put_glob_vars(file_handle, snapshot.exodusCount, snapshot.globals.size(), &snapshot.globals[0]);
+    if (retval!= 0) reportExodusError(retval, "write", "ex_put_glob_vars");
+  }
+
+  // Write nodal variables
+  for (unsigned int i=0 ; i<snapshot.numNodalVariables ; ++i) {
+    ExodusOutputVariable& variable = snapshot.nodalVariables[i];
+    double* values = variable.values.size() > 0 ? &variable.values[0] : NULL;
+    if (sharedFile) {
+      retval = ex_put_partial_var(file_handle, snapshot.exodusCount, EX_NODAL, variable.index, 1, sharedNodeOffset+1, variable.values.size(), values);
+      if (retval!= 0) reportExodusError(retval, "write", "ex_put_partial_var");
+    }
+    else {
+      retval = ex_put_nodal_var(file_handle, snapshot.exodusCount, variable.index, variable.values.size(), values);
+      if (retval!= 0) reportExodusError(retval, "write", "ex_put_nodal_var");
+    }
+  }
+
+  // Write element variables
+  for (unsigned int i=0 ; i<snapshot.numElementVariables ; ++i) {
+    ExodusOutputVariable& variable = snapshot.elementVariables[i];
+    double* values = variable.values.size() > 0 ? &variable.values[0] : NULL;
+    if (sharedFile) {
+      retval = ex_put_partial_var(file_handle, snapshot.exodusCount, EX_ELEM_BLOCK, variable.index, variable.blockId,
+                                  sharedElementBlockOffsets[variable.blockId]+1, variable.values.size(), values);
+      if (retval!= 0) reportExodusError(retval, "write", "ex_put_partial_var");
+    }
+    else {
+      retval = ex_put_elem_var(file_handle, snapshot.exodusCount, variable.index, variable.blockId, variable.values.size(), values);
+      if (retval!= 0) reportExodusError(retval, "write", "ex_put_elem_var");
+    }
+  }
+
+  // Flush write; an open database is synced only every flushInterval writes
+  writesSinceUpdate += 1;
+  if (!keepFileOpen || writesSinceUpdate >= flushInterval) {
+    retval = ex_update(file_handle);
+    if (retval!= 0) reportExodusError(retval, "write", "ex_update");
+    writesSinceUpdate = 0;
+  }
+  if (!keepFileOpen) {
+    retval = ex_close(file_handle);
+    if (retval!= 0) reportExodusError(retval, "write", "ex_close");
+  }
 }
 
 void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks) {
@@ -496,7 +872,7 @@ void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(Teuchos::RCP<
   // Construct output filename
   filename.str(std::string());
   filename.clear();
-  if (numProc > 1) {
+  if (numProc > 1 && !sharedFile) {
     filename << filenameBase.c_str();
     // determine number of zeros to use when padding filenames
     std::ostringstream tmpstr;
@@ -520,27 +896,43 @@ void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(Teuchos::RCP<
   Teuchos::RCP< std::map< std::string, std::vector<int> > > exodusNodeSets = peridigm->getExodusNodeSets();
   std::map< std::string, std::vector<int> >::iterator nsIt;
 
+  // Determine which points are written
+  computeOutputRegion(blocks);
+
   int num_dimensions = 3;
-  int num_nodes = peridigm->getOneDimensionalMap()->NumMyElements();
-  int num_elements = num_nodes;
+  int num_nodes = numOutputNodes;
   int num_element_blocks = blocks->size();
   int num_node_sets = exodusNodeSets()->size();
   int num_side_sets = 0;
 
+  // In a shared database, each processor's nodes are stored contiguously in processor order, as are each
+  // processor's elements within an element block
+  int num_nodes_in_file = num_nodes;
+  int node_index_offset = 0;
+  if (sharedFile) {
+    num_nodes_in_file = computeSharedFileLayout(blocks);
+    node_index_offset = sharedNodeOffset;
+  }
+  int num_elements = num_nodes_in_file;
+
   // For code coupling simulations, there can be a situation where there
   // are no peridynamic nodes on a processor.  This seems to cause
   // issues with Exodus, so just bail.
   bool haveData = true;
-  if(num_nodes == 0)
+  if(num_nodes_in_file == 0)
     haveData = false;
 
-  // Default to storing and writing doubles
-  int CPU_word_size, IO_word_size;
-  CPU_word_size = IO_word_size = sizeof(double);
+  // With a database per processor, a processor whose points are all outside the output region (or that owns
+  // no points) writes no database; it would have no variables defined, so every write would fail
+  if(!sharedFile && num_nodes == 0){
+    writesDatabase = false;
+    return;
+  }
 
   // Initialize exodus database; Overwrite any existing file with this name
-  file_handle = ex_create(filename.str().c_str(),EX_CLOBBER,&CPU_word_size,&IO_word_size);
-  if (file_handle < 0) reportExodusError(file_handle, "OutputManager_ExodusII", "ex_create");
+  // The lock is held until the database is closed at the end of this function
+  boost::mutex::scoped_lock exodusLock(exodusMutex());
+  createExodusDatabase();
 
   // clear the maps
   global_output_field_map.clear();
@@ -548,7 +940,7 @@ void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(Teuchos::RCP<
   node_output_field_map.clear();
 
   // Initialize exodus file with parameters
-  int retval = ex_put_init(file_handle,"Peridigm", num_dimensions, num_nodes, num_elements, num_element_blocks, num_node_sets, num_side_sets);
+  int retval = ex_put_init(file_handle,"Peridigm", num_dimensions, num_nodes_in_file, num_elements, num_element_blocks, num_node_sets, num_side_sets);
   if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_init");
   writeQARecord(file_handle);
 
@@ -569,23 +961,42 @@ void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(Teuchos::RCP<
   for(nsIt = exodusNodeSets->begin() ; nsIt != exodusNodeSets->end() ; nsIt++){
     std::vector<int>& nodeSet = nsIt->second;
     node_set_ids[nodeSetIndex] = nodeSetIndex + 1;
-    num_nodes_per_set[nodeSetIndex] = nodeSet.size();
     num_dist_per_set[nodeSetIndex] = 0;
     node_sets_node_index[nodeSetIndex] = offset;
     node_sets_dist_index[nodeSetIndex] = 0;
-    for(unsigned int i=0 ; i<nodeSet.size() ; ++i)
-      node_sets_node_list[offset++] = nodeSet[i];
+    // Node sets are restricted to the points in the output region
+    for(unsigned int i=0 ; i<nodeSet.size() ; ++i){
+      int outputIndex = outputNodeIndex[nodeSet[i]-1];
+      if(outputIndex != -1)
+        node_sets_node_list[offset++] = outputIndex + 1 + node_index_offset;
+    }
+    num_nodes_per_set[nodeSetIndex] = offset - node_sets_node_index[nodeSetIndex];
     nodeSetIndex += 1;
   }
-  if(numNodeSets > 0){
+  if(sharedFile && numNodeSets > 0){
+    // Each processor writes its portion of each node set, in processor order
+    std::vector<int> node_set_offsets(numNodeSets), num_nodes_per_set_in_file(numNodeSets);
+    peridigm->getEpetraComm()->ScanSum(&num_nodes_per_set[0], &node_set_offsets[0], numNodeSets);
+    peridigm->getEpetraComm()->SumAll(&num_nodes_per_set[0], &num_nodes_per_set_in_file[0], numNodeSets);
+    for(unsigned int i=0 ; i<numNodeSets ; ++i){
+      retval = ex_put_set_param(file_handle, EX_NODE_SET, node_set_ids[i], num_nodes_per_set_in_file[i], 0);
+      if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_set_param");
+    }
+    for(unsigned int i=0 ; i<numNodeSets ; ++i){
+      int* node_list = num_nodes_per_set[i] > 0 ? &node_sets_node_list[node_sets_node_index[i]] : NULL;
+      retval = ex_put_partial_set(file_handle, EX_NODE_SET, node_set_ids[i], node_set_offsets[i] - num_nodes_per_set[i] + 1, num_nodes_per_set[i], node_list, NULL);
+      if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_partial_set");
+    }
+  }
+  else if(numNodeSets > 0){
     retval = ex_put_concat_node_sets(file_handle,
                                      &node_set_ids[0],
                                      &num_nodes_per_set[0],
                                      &num_dist_per_set[0],
                                      &node_sets_node_index[0],
                                      &node_sets_dist_index[0],
-                                     &node_sets_node_list[0],
-                                     &node_sets_dist_fact[0]);
+                                     numNodesAcrossAllNodeSets > 0 ? &node_sets_node_list[0] : NULL,
+                                     node_sets_dist_fact);
     if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_concat_node_sets");
   }
 
@@ -604,21 +1015,30 @@ void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(Teuchos::RCP<
   // Write nodal coordinate values
   // Exodus requires pointer to x,y,z coordinates of nodes, but Peridigm stores this data using a blockmap, which interleaves the data
   // So, extract and copy the data to temporary storage that can be handed to the exodus api
+  // A processor may have no nodes in the output region, in which case NULL is passed for its (empty) portion of a shared database
   double *coord_values;
   peridigm->x->ExtractView( &coord_values );
   int numMyElements = peridigm->x->Map().NumMyElements();
-  std::vector<double> xcoord_values_vec(numMyElements), ycoord_values_vec(numMyElements), zcoord_values_vec(numMyElements);
-  double *xcoord_values = &xcoord_values_vec[0];
-  double *ycoord_values = &ycoord_values_vec[0];
-  double *zcoord_values = &zcoord_values_vec[0];
+  std::vector<double> xcoord_values_vec(num_nodes), ycoord_values_vec(num_nodes), zcoord_values_vec(num_nodes);
+  double *xcoord_values = num_nodes > 0 ? &xcoord_values_vec[0] : NULL;
+  double *ycoord_values = num_nodes > 0 ? &ycoord_values_vec[0] : NULL;
+  double *zcoord_values = num_nodes > 0 ? &zcoord_values_vec[0] : NULL;
   for( int i=0 ; i<numMyElements ; i++ ) {
+    int outputIndex = outputNodeIndex[i];
+    if( outputIndex == -1 ) continue;
     int firstPoint = peridigm->x->Map().FirstPointInElement(i);
-    xcoord_values[i] = coord_values[firstPoint];
-    ycoord_values[i] = coord_values[firstPoint+1];
-    zcoord_values[i] = coord_values[firstPoint+2];
+    xcoord_values[outputIndex] = coord_values[firstPoint];
+    ycoord_values[outputIndex] = coord_values[firstPoint+1];
+    zcoord_values[outputIndex] = coord_values[firstPoint+2];
+  }
+  if(sharedFile){
+    retval = ex_put_partial_coord(file_handle,sharedNodeOffset+1,num_nodes,xcoord_values,ycoord_values,zcoord_values);
+    if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_partial_coord");
+  }
+  else{
+    retval = ex_put_coord(file_handle,xcoord_values,ycoord_values,zcoord_values);
+    if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_coord");
   }
-  retval = ex_put_coord(file_handle,xcoord_values,ycoord_values,zcoord_values);
-  if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_coord");
 
   // Write nodal coordinate names to database
   const char *coord_names[3] = {"x", "y", "z"};
@@ -634,9 +1054,11 @@ void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(Teuchos::RCP<
   int i=0;
   for(i=0, blockIt = blocks->begin(); blockIt != blocks->end(); blockIt++, i++) {
     // Use only the number of owned elements
-    num_elem_in_block[i] = (blockIt->getDataManager()->getOwnedScalarPointMap())->NumMyElements();
+    num_elem_in_block[i] = outputBlockElements[blockIt->getID()].size();
     num_nodes_in_elem[i] = 1; // always using sphere elements
     elem_block_ID[i]     = blockIt->getID();
+    if(sharedFile)
+      num_elem_in_block[i] = sharedElementBlockSizes[elem_block_ID[i]];
     retval = ex_put_elem_block(file_handle,elem_block_ID[i],"SPHERE",num_elem_in_block[i],num_nodes_in_elem[i],0);
     if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_elem_block");
   }
@@ -654,40 +1076,67 @@ void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(Teuchos::RCP<
 
   // Write element connectivity
   for(blockIt = blocks->begin(); blockIt != blocks->end(); blockIt++) {
-    int numMyElements = blockIt->getOwnedScalarPointMap()->NumMyElements();
-    if (numMyElements == 0) continue; // don't insert connectivity info for empty blocks
+    const std::vector<int>& elements = outputBlockElements[blockIt->getID()];
+    int numMyElements = elements.size();
+    // don't insert connectivity info for empty blocks
+    if (numMyElements == 0 && (!sharedFile || sharedElementBlockSizes[blockIt->getID()] == 0)) continue;
     std::vector<int> connect_vec(numMyElements);
-    int *connect = &connect_vec[0];
+    int *connect = numMyElements > 0 ? &connect_vec[0] : NULL;
     for (int j=0;j<numMyElements;j++) {
-      int GID = blockIt->getOwnedScalarPointMap()->GID(j);
-      connect[j] = peridigm->getOneDimensionalMap()->LID(GID)+1;
+      int GID = blockIt->getOwnedScalarPointMap()->GID(elements[j]);
+      connect[j] = outputNodeIndex[peridigm->getOneDimensionalMap()->LID(GID)]+1+node_index_offset;
+    }
+    if (sharedFile) {
+      retval = ex_put_partial_conn(file_handle, EX_ELEM_BLOCK, blockIt->getID(), sharedElementBlockOffsets[blockIt->getID()]+1, numMyElements, connect, NULL, NULL);
+      if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_partial_conn");
+    }
+    else {
+      retval = ex_put_elem_conn(file_handle, blockIt->getID(), connect);
+      if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_elem_conn");
     }
-    retval = ex_put_elem_conn(file_handle, blockIt->getID(), connect);
-    if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_elem_conn");
   }
 
   // Write global node number map (global node IDs)
   std::vector<int> node_map_vec(num_nodes);
-  int *node_map = &node_map_vec[0];
-  for (i=0; i<num_nodes; i++){
-    node_map[i] = peridigm->getOneDimensionalMap()->GID(i)+1;
+  int *node_map = num_nodes > 0 ? &node_map_vec[0] : NULL;
+  for (i=0; i<numMyElements; i++){
+    if (outputNodeIndex[i] != -1)
+      node_map[outputNodeIndex[i]] = peridigm->getOneDimensionalMap()->GID(i)+1;
+  }
+  if (sharedFile) {
+    retval = ex_put_partial_id_map(file_handle, EX_NODE_MAP, sharedNodeOffset+1, num_nodes, node_map);
+    if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_partial_id_map");
+  }
+  else {
+    retval = ex_put_node_num_map(file_handle, node_map);
+    if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_node_num_map");
   }
-  retval = ex_put_node_num_map(file_handle, node_map);
-  if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_node_num_map");
 
   // Write global element number map (global element IDs)
   std::vector<int> elem_map_vec(num_nodes);
-  int *elem_map = &elem_map_vec[0];
+  int *elem_map = num_nodes > 0 ? &elem_map_vec[0] : NULL;
   int elem_map_index = 0;
+  int elem_map_block_start = 0;
   for(std::vector<PeridigmNS::Block>::iterator blockIt = blocks->begin(); blockIt != blocks->end() ; blockIt++) {
     Teuchos::RCP<const Epetra_BlockMap> map = blockIt->getOwnedScalarPointMap();
-    for(int i=0; i<map->NumMyElements() ; ++i){
+    const std::vector<int>& elements = outputBlockElements[blockIt->getID()];
+    int block_elem_map_index = elem_map_index;
+    for(unsigned int i=0; i<elements.size() ; ++i){
       TEUCHOS_TEST_FOR_EXCEPT_MSG(elem_map_index >= num_nodes, "\nPeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(), Error processing element map!\n");
-      elem_map[elem_map_index++] = map->GID(i)+1;
+      elem_map[elem_map_index++] = map->GID(elements[i])+1;
+    }
+    // In a shared database this processor's elements are not contiguous across blocks, so the map is written block by block
+    if (sharedFile && sharedElementBlockSizes[blockIt->getID()] > 0) {
+      int* block_elem_map = elements.size() > 0 ? &elem_map[block_elem_map_index] : NULL;
+      retval = ex_put_partial_id_map(file_handle, EX_ELEM_MAP, elem_map_block_start+sharedElementBlockOffsets[blockIt->getID()]+1, elements.size(), block_elem_map);
+      if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_partial_id_map");
+      elem_map_block_start += sharedElementBlockSizes[blockIt->getID()];
     }
   }
-  retval = ex_put_elem_num_map(file_handle, elem_map);
-  if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_elem_num_map");
+  if (!sharedFile) {
+    retval = ex_put_elem_num_map(file_handle, elem_map);
+    if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_elem_num_map");
+  }
 
   // Create internal mapping of requested output fields to an integer.
   // The user requests output fields via strings, but Exodus wants an integer to index the output fields
@@ -866,6 +1315,11 @@ void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(Teuchos::RCP<
         }
       }
     }
+    // The truth table is part of the database metadata, so it must be identical on all processors writing a shared database
+    if (sharedFile) {
+      std::vector<int> localTruthTableVec(truthTableVec);
+      peridigm->getEpetraComm()->MaxAll(&localTruthTableVec[0], &truthTableVec[0], truthTableVec.size());
+    }
     int *truthTable = &truthTableVec[0];
     retval = ex_put_elem_var_tab (file_handle, blocks->size(), num_element_vars, truthTable);
     if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_put_var_tab");
@@ -900,6 +1354,167 @@ void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabase(Teuchos::RCP<
   }
 }
 
+void PeridigmNS::OutputManager_ExodusII::createExodusDatabase() {
+
+  // Data is always passed to exodus as doubles; exodus converts it if the database stores floats
+  CPU_word_size = sizeof(double);
+  IO_word_size = outputSinglePrecision ? sizeof(float) : sizeof(double);
+
+  // Compression requires a netCDF-4 database
+  int mode = EX_CLOBBER;
+  if (compressionLevel > 0)
+    mode |= EX_NETCDF4;
+
+#if defined(HAVE_MPI) && defined(PARALLEL_AWARE_EXODUS)
+  if (sharedFile)
+    file_handle = ex_create_par(filename.str().c_str(),mode|EX_NETCDF4|EX_MPIIO,&CPU_word_size,&IO_word_size,sharedFileComm(*peridigm->getEpetraComm()),MPI_INFO_NULL);
+  else
+#endif
+  file_handle = ex_create(filename.str().c_str(),mode,&CPU_word_size,&IO_word_size);
+  if (file_handle < 0) reportExodusError(file_handle, "OutputManager_ExodusII", "ex_create");
+
+  // Compression settings apply to the variables defined after this point, which is all of them
+  if (compressionLevel > 0) {
+    int retval = ex_set_option(file_handle, EX_OPT_COMPRESSION_LEVEL, compressionLevel);
+    if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_set_option EX_OPT_COMPRESSION_LEVEL");
+    retval = ex_set_option(file_handle, EX_OPT_COMPRESSION_SHUFFLE, compressionShuffle ? 1 : 0);
+    if (retval!= 0) reportExodusError(retval, "initializeExodusDatabase", "ex_set_option EX_OPT_COMPRESSION_SHUFFLE");
+  }
+}
+
+void PeridigmNS::OutputManager_ExodusII::quantize(const std::string& name, double* values, int length) {
+
+  std::map<std::string, int>::const_iterator it = mantissaBits.find(name);
+  if (it == mantissaBits.end())
+    return;
+
+  // Round to nearest on the retained mantissa bits and zero the remainder, which leaves long runs of zero bits for the compressor
+  const int doubleMantissaBits = 52;
+  int discardedBits = doubleMantissaBits - it->second;
+  if (discardedBits <= 0)
+    return;
+  const uint64_t exponentMask = 0x7FF0000000000000ULL;
+  uint64_t half = uint64_t(1) << (discardedBits - 1);
+  uint64_t mask = ~((uint64_t(1) << discardedBits) - 1);
+  for (int i=0 ; i<length ; ++i) {
+    uint64_t bits;
+    memcpy(&bits, &values[i], sizeof(double));
+    if ((bits & exponentMask) == exponentMask) // leave inf and nan untouched
+      continue;
+    bits = (bits + half) & mask;
+    memcpy(&values[i], &bits, sizeof(double));
+  }
+}
+
+void PeridigmNS::OutputManager_ExodusII::computeOutputRegion(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks) {
+
+  Teuchos::RCP<const Epetra_BlockMap> oneDimensionalMap = peridigm->getOneDimensionalMap();
+  int numMyPoints = oneDimensionalMap->NumMyElements();
+
+  // Without a region every point is written
+  std::vector<bool> inRegion(numMyPoints, !hasRegion);
+
+  if (hasRegion) {
+
+    // Points in the listed blocks
+    for(std::vector<PeridigmNS::Block>::iterator blockIt = blocks->begin(); blockIt != blocks->end(); blockIt++) {
+      if (std::find(regionBlockNames.begin(), regionBlockNames.end(), blockIt->getName()) == regionBlockNames.end())
+        continue;
+      Teuchos::RCP<const Epetra_BlockMap> map = blockIt->getOwnedScalarPointMap();
+      for(int i=0 ; i<map->NumMyElements() ; ++i)
+        inRegion[oneDimensionalMap->LID(map->GID(i))] = true;
+    }
+
+    // Points in the listed node sets
+    if (regionNodeSetNames.size() > 0) {
+      Teuchos::RCP< std::map< std::string, std::vector<int> > > exodusNodeSets = peridigm->getExodusNodeSets();
+      for(unsigned int i=0 ; i<regionNodeSetNames.size() ; ++i){
+        std::map< std::string, std::vector<int> >::iterator nsIt = exodusNodeSets->find(regionNodeSetNames[i]);
+        TEUCHOS_TEST_FOR_EXCEPTION(nsIt == exodusNodeSets->end(), std::invalid_argument,
+                                   "PeridigmNS::OutputManager_ExodusII -- Output region node set " << regionNodeSetNames[i] << " not found.");
+        for(unsigned int j=0 ; j<nsIt->second.size() ; ++j)
+          inRegion[nsIt->second[j]-1] = true;
+      }
+    }
+
+    // Points at which the region function is nonzero
+    if (!regionFunction.empty()) {
+      Teuchos::RCP<PG_RuntimeCompiler::Function> rtcFunction = Teuchos::rcp(new PG_RuntimeCompiler::Function(4, "rtcOutputRegionFunction"));
+      rtcFunction->addVar("double", "x");
+      rtcFunction->addVar("double", "y");
+      rtcFunction->addVar("double", "z");
+      rtcFunction->addVar("double", "value");
+      string rtcFunctionString = regionFunction;
+      if(rtcFunctionString.find("value") == string::npos)
+        rtcFunctionString = "value = " + rtcFunctionString;
+      bool success = rtcFunction->addBody(rtcFunctionString);
+      for(int i=0 ; i<numMyPoints && success ; ++i){
+        if(inRegion[i])
+          continue;
+        success = rtcFunction->varValueFill(0, (*peridigm->x)[3*i]);
+        if(success)
+          success = rtcFunction->varValueFill(1, (*peridigm->x)[3*i+1]);
+        if(success)
+          success = rtcFunction->varValueFill(2, (*peridigm->x)[3*i+2]);
+        if(success)
+          success = rtcFunction->varValueFill(3, 0.0);
+        if(success)
+          success = rtcFunction->execute();
+        if(success && rtcFunction->getValueOfVar("value") != 0.0)
+          inRegion[i] = true;
+      }
+      if(!success){
+        string msg = "\n**** Error in OutputManager_ExodusII::computeOutputRegion().\n";
+        msg += "**** " + rtcFunction->getErrors() + "\n";
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(!success, msg);
+      }
+    }
+  }
+
+  // Number the points in the region consecutively
+  outputNodeIndex.assign(numMyPoints, -1);
+  numOutputNodes = 0;
+  for(int i=0 ; i<numMyPoints ; ++i){
+    if(inRegion[i])
+      outputNodeIndex[i] = numOutputNodes++;
+  }
+
+  // Record the elements in the region for each block
+  outputBlockElements.clear();
+  for(std::vector<PeridigmNS::Block>::iterator blockIt = blocks->begin(); blockIt != blocks->end(); blockIt++) {
+    std::vector<int>& elements = outputBlockElements[blockIt->getID()];
+    Teuchos::RCP<const Epetra_BlockMap> map = blockIt->getOwnedScalarPointMap();
+    for(int i=0 ; i<map->NumMyElements() ; ++i){
+      if(outputNodeIndex[oneDimensionalMap->LID(map->GID(i))] != -1)
+        elements.push_back(i);
+    }
+  }
+}
+
+int PeridigmNS::OutputManager_ExodusII::computeSharedFileLayout(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks) {
+
+  // Entry 0 is the number of nodes, the remaining entries are the number of elements in each block
+  int numEntries = blocks->size() + 1;
+  std::vector<int> localSizes(numEntries), scanSizes(numEntries), globalSizes(numEntries);
+  localSizes[0] = numOutputNodes;
+  int index = 1;
+  for(std::vector<PeridigmNS::Block>::iterator blockIt = blocks->begin(); blockIt != blocks->end(); blockIt++)
+    localSizes[index++] = outputBlockElements[blockIt->getID()].size();
+  peridigm->getEpetraComm()->ScanSum(&localSizes[0], &scanSizes[0], numEntries);
+  peridigm->getEpetraComm()->SumAll(&localSizes[0], &globalSizes[0], numEntries);
+
+  sharedNodeOffset = scanSizes[0] - localSizes[0];
+  sharedElementBlockOffsets.clear();
+  sharedElementBlockSizes.clear();
+  index = 1;
+  for(std::vector<PeridigmNS::Block>::iterator blockIt = blocks->begin(); blockIt != blocks->end(); blockIt++, index++){
+    sharedElementBlockOffsets[blockIt->getID()] = scanSizes[index] - localSizes[index];
+    sharedElementBlockSizes[blockIt->getID()] = globalSizes[index];
+  }
+
+  return globalSizes[0];
+}
+
 void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabaseWithOnlyGlobalData(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks) {
 
   /*
@@ -936,13 +1551,10 @@ void PeridigmNS::OutputManager_ExodusII::initializeExodusDatabaseWithOnlyGlobalD
    * Now, initialize ExodusII database
    */
 
-  // Default to storing and writing doubles
-  int CPU_word_size, IO_word_size;
-  CPU_word_size = IO_word_size = sizeof(double);
-
   // Initialize exodus database; Overwrite any existing file with this name
-  file_handle = ex_create(filename.str().c_str(),EX_CLOBBER,&CPU_word_size,&IO_word_size);
-  if (file_handle < 0) reportExodusError(file_handle, "OutputManager_ExodusII", "ex_create");
+  // The lock is held until the database is closed at the end of this function
+  boost::mutex::scoped_lock exodusLock(exodusMutex());
+  createExodusDatabase();
 
   // clear the maps
   global_output_field_map.clear();
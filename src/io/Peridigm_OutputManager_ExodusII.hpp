@@ -47,18 +47,48 @@
 #define PERIDIGM_OUTPUTMANAGER_EXODUSII_HPP
 
 #include <map>
+#include <deque>
 
 #include <Peridigm_OutputManager.hpp>
 
 #include <Teuchos_ParameterList.hpp>
 
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
 // Forward declaration
 namespace PeridigmNS {
   class Peridigm; 
 } 
 
 namespace PeridigmNS {
-  
+
+  //! Data for a single exodus nodal or element variable.
+  struct ExodusOutputVariable {
+    //! Exodus variable index (1..k)
+    int index;
+    //! Element block id, used only for element variables
+    int blockId;
+    //! Variable values
+    std::vector<double> values;
+  };
+
+  /*! \brief Copy of the data written to the exodus database at a single output step.
+   *
+   *  The variable vectors are reused from one output step to the next; only the first numNodalVariables and
+   *  numElementVariables entries are valid.
+   */
+  struct ExodusOutputSnapshot {
+    int exodusCount;
+    double time;
+    std::vector<double> globals;
+    unsigned int numNodalVariables;
+    std::vector<ExodusOutputVariable> nodalVariables;
+    unsigned int numElementVariables;
+    std::vector<ExodusOutputVariable> elementVariables;
+  };
+
   class OutputManager_ExodusII: public PeridigmNS::OutputManager {
     
   public:
@@ -74,6 +104,9 @@ namespace PeridigmNS {
     //! Write data to disk
     virtual void write(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double);
 
+    //! Block until all staged output steps have been written to disk
+    virtual void flush();
+
   private:
     
     //! Copy constructor.
@@ -88,6 +121,41 @@ namespace PeridigmNS {
     //! Initialize a new exodus database that contains only global data
     void initializeExodusDatabaseWithOnlyGlobalData(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks);
 
+    //! Create the exodus database with the requested precision and compression; sets file_handle
+    void createExodusDatabase();
+
+    //! Round the given values of a field to its requested number of significant digits; no-op for other fields
+    void quantize(const std::string& name, double* values, int length);
+
+    //! Determine the points and elements written to the database
+    void computeOutputRegion(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks);
+
+    //! Compute the location of this processor's nodes and elements in a shared database; returns the total number of nodes
+    int computeSharedFileLayout(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks);
+
+    //! Returns true if the output trigger calls for a frame at the current step; must be called on all processors
+    bool outputTriggerFired(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks);
+
+    /*! \brief Compute the quantities monitored by the output trigger.
+     *
+     *  The number of broken bonds is recovered from the damage, which damage models store as the fraction of each
+     *  point's original bonds that are broken, so no bond data are traversed.  The values are summed over all
+     *  processors with a single reduction.
+     */
+    void computeOutputTriggerMetrics(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double* metrics);
+
+    //! Copy the requested output fields into a snapshot
+    void packSnapshot(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double current_time, ExodusOutputSnapshot& snapshot);
+
+    //! Write a snapshot to the exodus database
+    void writeSnapshot(ExodusOutputSnapshot& snapshot);
+
+    //! Main loop for the background thread that writes staged snapshots
+    void asyncWriteLoop();
+
+    //! Throw if the background thread failed to write a snapshot; asyncMutex must be held by the caller
+    void checkAsyncWriteError();
+
     //! Error & Warning reporting tool for calls to ExodusII API
     void reportExodusError(int errorCode, const char *methodName, const char *exodusMethodName);
 
@@ -106,6 +174,54 @@ namespace PeridigmNS {
     //! Exodus file handle
     int file_handle;
 
+    //! Flag indicating that output is restricted to a region
+    bool hasRegion;
+
+    //! Names of the blocks in the output region
+    std::vector<std::string> regionBlockNames;
+
+    //! Names of the node sets in the output region
+    std::vector<std::string> regionNodeSetNames;
+
+    //! RTC function that is nonzero at points in the output region
+    std::string regionFunction;
+
+    //! Index of each locally-owned point in the database, or -1 if the point is not written
+    std::vector<int> outputNodeIndex;
+
+    //! Number of locally-owned points written to the database
+    int numOutputNodes;
+
+    //! Flag indicating that this processor writes a database; false for a database per processor with no points in the output
+    bool writesDatabase;
+
+    //! Block-local indices of the elements written for each block, keyed by block id
+    std::map<int, std::vector<int> > outputBlockElements;
+
+    //! Flag indicating that all processors write collectively to a single shared database
+    bool sharedFile;
+
+    //! Offset of this processor's nodes in the shared database
+    int sharedNodeOffset;
+
+    //! Offset of this processor's elements within each element block of the shared database, keyed by block id
+    std::map<int, int> sharedElementBlockOffsets;
+
+    //! Number of elements in each element block of the shared database, keyed by block id
+    std::map<int, int> sharedElementBlockSizes;
+
+    //! Flag indicating that the exodus database is kept open between writes
+    bool keepFileOpen;
+
+    //! Flag indicating that file_handle refers to an open database (used only when keepFileOpen is true)
+    bool fileIsOpen;
+
+    //! Number of writes between calls to ex_update when the database is kept open
+    int flushInterval;
+
+    //! Number of writes since the last call to ex_update
+    int writesSinceUpdate;
+
     //! Index of number of timesteps data actually written to exodus file
     int exodusCount;
 
@@ -115,12 +231,46 @@ namespace PeridigmNS {
     //! Index of last plot dump step to Exodus file
     int lastOutputStep;
 
+    //! @name Event-triggered output
+    //@{
+    //! Flag indicating that frames are written when the output trigger fires rather than at a fixed frequency
+    bool hasOutputTrigger;
+    //! Number of newly broken bonds that triggers a frame, disabled if not positive
+    double triggerBrokenBonds;
+    //! Increase in the total damage that triggers a frame, disabled if not positive
+    double triggerDamageIncrement;
+    //! Change in the kinetic energy that triggers a frame, disabled if not positive
+    double triggerKineticEnergyIncrement;
+    //! Minimum number of steps between frames
+    int triggerMinimumInterval;
+    //! Maximum number of steps between frames
+    int triggerMaximumInterval;
+    //! Value of count when the last frame was written, zero before the first frame
+    int lastTriggeredOutputStep;
+    //! Broken bonds, total damage, and kinetic energy when the last frame was written
+    double lastTriggerMetrics[3];
+    //! Field ids used by the output trigger, -1 if the field is not defined
+    int damageFieldId, numberOfCompactedBondsFieldId, volumeFieldId, velocityFieldId;
+    //@}
+
     //! Flag indicating if this is the first call to initializeExodusDatabase
     bool initializeExodusDatabaseCalled;
 
     //! Word sizes for IO and CPU
     int CPU_word_size, IO_word_size;
 
+    //! Flag indicating that real data is stored in the database as single precision
+    bool outputSinglePrecision;
+
+    //! netCDF-4 deflate level, 0 for no compression
+    int compressionLevel;
+
+    //! Flag indicating that the shuffle filter is applied before deflate
+    bool compressionShuffle;
+
+    //! Number of mantissa bits retained for fields with a requested number of significant digits, keyed by field name
+    std::map<std::string, int> mantissaBits;
+
     //! Flag indicating Exodus databases that contain only global data
     bool globalDataOnly;
 
@@ -138,6 +288,28 @@ namespace PeridigmNS {
 
     //! Field id for element id.
     int elementIdFieldId;
+
+    //! @name Asynchronous output
+    //@{
+    //! Flag indicating that snapshots are written by a background thread
+    bool asynchronousWrite;
+    //! Storage for staged snapshots; the size bounds the number of output steps in flight
+    std::vector<ExodusOutputSnapshot> snapshotPool;
+    //! Indices into snapshotPool that are available for packing
+    std::deque<int> freeSnapshots;
+    //! Indices into snapshotPool waiting to be written, in output order
+    std::deque<int> pendingSnapshots;
+    //! Background writer thread, created on the first asynchronous write
+    Teuchos::RCP<boost::thread> writerThread;
+    //! Mutex protecting freeSnapshots, pendingSnapshots, asyncShutdown, and asyncWriteError
+    boost::mutex asyncMutex;
+    //! Signaled whenever a snapshot is queued or written
+    boost::condition_variable asyncCondition;
+    //! Flag instructing the writer thread to exit once the queue is empty
+    bool asyncShutdown;
+    //! Error message from the writer thread, empty if no error occurred
+    std::string asyncWriteError;
+    //@}
   };
   
 }
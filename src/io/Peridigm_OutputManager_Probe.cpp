@@ -0,0 +1,348 @@
+/*! \file Peridigm_OutputManager_Probe.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <cfloat>
+#include <climits>
+#include <cstring>
+#include <stdint.h>
+
+#include <Epetra_Comm.h>
+#include <Teuchos_Assert.hpp>
+
+#include "Peridigm.hpp"
+#include "Peridigm_OutputManager_Probe.hpp"
+#include "Peridigm_Field.hpp"
+#include "kdtree.h"
+
+using namespace std;
+
+PeridigmNS::OutputManager_Probe::OutputManager_Probe(const Teuchos::RCP<Teuchos::ParameterList>& params,
+                                                     PeridigmNS::Peridigm *peridigm_,
+                                                     Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks)
+  : peridigm(peridigm_), probesInitialized(false), binaryOutput(false), bufferSize(1000), numColumns(0) {
+
+  // No output requested
+  iWrite = true;
+  if (params == Teuchos::null) {
+    iWrite = false;
+    return;
+  }
+
+  numProc = params->get<int>("NumProc");
+  myPID = params->get<int>("MyPID");
+  count = 0;
+  writeNeighborlist = false;
+
+  // Default to no output
+  frequency = params->get<int>("Output Frequency",-1);
+
+  // Default to CSV output
+  outputFormat = params->get<string>("Output Format","CSV");
+  TEUCHOS_TEST_FOR_EXCEPTION( outputFormat != "CSV" && outputFormat != "BINARY",  std::invalid_argument,
+                              "PeridigmNS::OutputManager_Probe::OutputManager_Probe() -- Output Format must be CSV or BINARY for probe output.");
+  binaryOutput = (outputFormat == "BINARY");
+
+  // Output filename base
+  filenameBase = params->get<string>("Output Filename","probes");
+
+  // Number of records held in memory between writes
+  bufferSize = params->get<int>("Buffer Size",1000);
+  TEUCHOS_TEST_FOR_EXCEPTION( bufferSize < 1,  std::invalid_argument, "PeridigmNS::OutputManager_Probe::OutputManager_Probe() -- Buffer Size must be at least 1.");
+
+  readProbeLocations(*params);
+
+  // User-requested fields; probes sample point data only
+  outputVariables = sublist(params, "Output Variables");
+  FieldManager& fieldManager = FieldManager::self();
+  vector<string> fieldLabels;
+  for (Teuchos::ParameterList::ConstIterator it = outputVariables->begin(); it != outputVariables->end(); ++it) {
+    PeridigmNS::FieldSpec spec = fieldManager.getFieldSpec(it->first);
+    TEUCHOS_TEST_FOR_EXCEPTION( spec.getRelation() != PeridigmField::NODE && spec.getRelation() != PeridigmField::ELEMENT,  std::invalid_argument,
+                                "PeridigmNS::OutputManager_Probe::OutputManager_Probe() -- Probe output is valid only for node and element data, " << it->first << " is neither.");
+    fieldIds.push_back(spec.getId());
+    fieldLengths.push_back(PeridigmField::variableDimension(spec.getLength()));
+    fieldLabels.push_back(spec.getLabel());
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION( fieldIds.size() == 0,  std::invalid_argument, "PeridigmNS::OutputManager_Probe::OutputManager_Probe() -- No Output Variables given.");
+
+  // Column names follow the Exodus convention for vector and tensor components
+  for (unsigned int p=0 ; p<probeNames.size() ; ++p) {
+    for (unsigned int f=0 ; f<fieldIds.size() ; ++f) {
+      for (int c=0 ; c<fieldLengths[f] ; ++c) {
+        stringstream ss;
+        ss << probeNames[p] << "_" << fieldLabels[f];
+        if (fieldLengths[f] == 3)
+          ss << "XYZ"[c];
+        else if (fieldLengths[f] > 1)
+          ss << "_" << c+1;
+        columnNames.push_back(ss.str());
+      }
+    }
+  }
+  numColumns = columnNames.size();
+}
+
+PeridigmNS::OutputManager_Probe::~OutputManager_Probe() {
+  if (file.is_open()) {
+    flush();
+    file.close();
+  }
+}
+
+void PeridigmNS::OutputManager_Probe::readProbeLocations(const Teuchos::ParameterList& params) {
+
+  // Probes given individually as sublists containing X, Y, and Z
+  if (params.isSublist("Probes")) {
+    const Teuchos::ParameterList& probes = params.sublist("Probes");
+    for (Teuchos::ParameterList::ConstIterator it = probes.begin(); it != probes.end(); ++it) {
+      const Teuchos::ParameterList& probe = probes.sublist(it->first);
+      probeNames.push_back(it->first);
+      probeLocations.push_back(probe.get<double>("X"));
+      probeLocations.push_back(probe.get<double>("Y"));
+      probeLocations.push_back(probe.get<double>("Z"));
+    }
+  }
+
+  // Probes listed in a text file, one "X Y Z" triplet per line; blank lines and lines beginning with # are skipped
+  if (params.isParameter("Probe File")) {
+    string probeFileName = params.get<string>("Probe File");
+    ifstream probeFile(probeFileName.c_str());
+    TEUCHOS_TEST_FOR_EXCEPTION( !probeFile.is_open(),  std::invalid_argument,
+                                "PeridigmNS::OutputManager_Probe::readProbeLocations() -- Unable to open probe file " << probeFileName);
+    string line;
+    int numFileProbes = 0;
+    while (getline(probeFile, line)) {
+      size_t first = line.find_first_not_of(" \t\r");
+      if (first == string::npos || line[first] == '#')
+        continue;
+      istringstream iss(line);
+      double x, y, z;
+      iss >> x >> y >> z;
+      TEUCHOS_TEST_FOR_EXCEPTION( iss.fail(),  std::invalid_argument,
+                                  "PeridigmNS::OutputManager_Probe::readProbeLocations() -- Unable to parse line \"" << line << "\" in probe file " << probeFileName);
+      stringstream name;
+      name << "Probe_" << ++numFileProbes;
+      probeNames.push_back(name.str());
+      probeLocations.push_back(x);
+      probeLocations.push_back(y);
+      probeLocations.push_back(z);
+    }
+  }
+
+  TEUCHOS_TEST_FOR_EXCEPTION( probeNames.size() == 0,  std::invalid_argument,
+                              "PeridigmNS::OutputManager_Probe::readProbeLocations() -- No probes given; provide a Probes sublist or a Probe File.");
+}
+
+void PeridigmNS::OutputManager_Probe::initializeProbes(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks) {
+
+  const Epetra_Comm& comm = *peridigm->getEpetraComm();
+  Teuchos::RCP<const Epetra_BlockMap> oneDimensionalMap = peridigm->getOneDimensionalMap();
+  Teuchos::RCP<Epetra_Vector> x = peridigm->getX();
+  int numMyPoints = oneDimensionalMap->NumMyElements();
+  int numProbes = probeNames.size();
+
+  // Find the nearest locally-owned point to each probe
+  vector<double> localDistanceSquared(numProbes, DBL_MAX), globalDistanceSquared(numProbes);
+  vector<int> localGlobalId(numProbes, INT_MAX), globalGlobalId(numProbes);
+  if (numMyPoints > 0) {
+    double* coordinates;
+    x->ExtractView(&coordinates);
+    femanica::kdtree<double,int> tree = femanica::kdtree<double,int>::get_tree(coordinates, numMyPoints);
+    vector<double> searchPoint(3);
+    vector<int> candidates;
+    for (int p=0 ; p<numProbes ; ++p) {
+      for (int i=0 ; i<3 ; ++i)
+        searchPoint[i] = probeLocations[3*p+i];
+      int localId = tree.nearest_neighbor_search(searchPoint);
+      double distanceSquared = 0.0;
+      for (int i=0 ; i<3 ; ++i)
+        distanceSquared += (coordinates[3*localId+i] - searchPoint[i])*(coordinates[3*localId+i] - searchPoint[i]);
+      localDistanceSquared[p] = distanceSquared;
+      localGlobalId[p] = oneDimensionalMap->GID(localId);
+      // The kd-tree returns any one of several equidistant points, so apply the tie rule among the local points as well
+      tree.all_neighbors_within_radius(&searchPoint[0], (1.0 + 1.0e-12)*sqrt(distanceSquared), candidates);
+      for (unsigned int n=0 ; n<candidates.size() ; ++n) {
+        int candidate = candidates[n];
+        double candidateDistanceSquared = 0.0;
+        for (int i=0 ; i<3 ; ++i)
+          candidateDistanceSquared += (coordinates[3*candidate+i] - searchPoint[i])*(coordinates[3*candidate+i] - searchPoint[i]);
+        int candidateGlobalId = oneDimensionalMap->GID(candidate);
+        if (candidateDistanceSquared < localDistanceSquared[p] ||
+            (candidateDistanceSquared == localDistanceSquared[p] && candidateGlobalId < localGlobalId[p])) {
+          localDistanceSquared[p] = candidateDistanceSquared;
+          localGlobalId[p] = candidateGlobalId;
+        }
+      }
+    }
+  }
+
+  // Select the closest point across all processors; ties go to the point with the smallest global id
+  comm.MinAll(&localDistanceSquared[0], &globalDistanceSquared[0], numProbes);
+  for (int p=0 ; p<numProbes ; ++p) {
+    if (localDistanceSquared[p] != globalDistanceSquared[p])
+      localGlobalId[p] = INT_MAX;
+  }
+  comm.MinAll(&localGlobalId[0], &globalGlobalId[0], numProbes);
+
+  // Record the block and block-local id of the locally-owned probes, along with the position of the probe points
+  vector<double> localPositions(3*numProbes, 0.0), globalPositions(3*numProbes);
+  for (int p=0 ; p<numProbes ; ++p) {
+    int localId = oneDimensionalMap->LID(globalGlobalId[p]);
+    if (localId == -1)
+      continue;
+    for (int i=0 ; i<3 ; ++i)
+      localPositions[3*p+i] = (*x)[3*localId+i];
+    for (unsigned int b=0 ; b<blocks->size() ; ++b) {
+      int blockLocalId = (*blocks)[b].getOwnedScalarPointMap()->LID(globalGlobalId[p]);
+      if (blockLocalId != -1) {
+        localProbes.push_back(p);
+        localProbeBlocks.push_back(b);
+        localProbePoints.push_back(blockLocalId);
+        break;
+      }
+    }
+  }
+  comm.SumAll(&localPositions[0], &globalPositions[0], 3*numProbes);
+
+  // Open the time-history file and write the header
+  if (myPID == 0) {
+    string filename = filenameBase + (binaryOutput ? ".bin" : ".csv");
+    if (binaryOutput) {
+      file.open(filename.c_str(), ios::out | ios::binary | ios::trunc);
+      TEUCHOS_TEST_FOR_EXCEPTION( !file.is_open(),  std::runtime_error, "PeridigmNS::OutputManager_Probe::initializeProbes() -- Unable to open " << filename);
+      file.write("PDPROBE1", 8);
+      int32_t numColumnsInFile = numColumns;
+      file.write(reinterpret_cast<const char*>(&numColumnsInFile), sizeof(int32_t));
+      for (int i=0 ; i<numColumns ; ++i) {
+        char columnName[64];
+        memset(columnName, 0, 64);
+        strncpy(columnName, columnNames[i].c_str(), 63);
+        file.write(columnName, 64);
+      }
+    }
+    else {
+      file.open(filename.c_str(), ios::out | ios::trunc);
+      TEUCHOS_TEST_FOR_EXCEPTION( !file.is_open(),  std::runtime_error, "PeridigmNS::OutputManager_Probe::initializeProbes() -- Unable to open " << filename);
+      file << setprecision(16);
+      for (int p=0 ; p<numProbes ; ++p) {
+        file << "# " << probeNames[p] << ": requested (" << probeLocations[3*p] << ", " << probeLocations[3*p+1] << ", " << probeLocations[3*p+2]
+             << "), element " << globalGlobalId[p]+1 << " at (" << globalPositions[3*p] << ", " << globalPositions[3*p+1] << ", " << globalPositions[3*p+2] << ")\n";
+      }
+      file << "Time";
+      for (int i=0 ; i<numColumns ; ++i)
+        file << "," << columnNames[i];
+      file << "\n";
+    }
+    buffer.reserve(bufferSize*(numColumns+1));
+  }
+
+  probesInitialized = true;
+}
+
+void PeridigmNS::OutputManager_Probe::write(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double current_time) {
+
+  if (!iWrite) return;
+
+  // increment index count
+  count = count + 1;
+
+  // The first call corresponds to the initial configuration
+  if (frequency<=0 || (count-1)%frequency!=0) return;
+
+  if (!probesInitialized)
+    initializeProbes(blocks);
+
+  // Sample the locally-owned probes; every other entry is zero, so the record is assembled with a sum
+  vector<double> localRecord(numColumns, 0.0), record(numColumns);
+  int columnsPerProbe = numColumns / probeNames.size();
+  for (unsigned int i=0 ; i<localProbes.size() ; ++i) {
+    PeridigmNS::Block& block = (*blocks)[localProbeBlocks[i]];
+    int point = localProbePoints[i];
+    int column = localProbes[i]*columnsPerProbe;
+    for (unsigned int f=0 ; f<fieldIds.size() ; ++f) {
+      PeridigmField::Step step = PeridigmField::STEP_NONE;
+      if (FieldManager::self().getFieldSpec(fieldIds[f]).getTemporal() == PeridigmField::TWO_STEP)
+        step = PeridigmField::STEP_NP1;
+      int length = fieldLengths[f];
+      if (block.hasData(fieldIds[f], step)) {
+        Teuchos::RCP<Epetra_Vector> data = block.getData(fieldIds[f], step);
+        for (int c=0 ; c<length ; ++c)
+          localRecord[column+c] = (*data)[length*point+c];
+      }
+      column += length;
+    }
+  }
+  peridigm->getEpetraComm()->SumAll(&localRecord[0], &record[0], numColumns);
+
+  // Buffer the record on the root processor
+  if (myPID == 0) {
+    buffer.push_back(current_time);
+    buffer.insert(buffer.end(), record.begin(), record.end());
+    if (static_cast<int>(buffer.size()) >= bufferSize*(numColumns+1))
+      flush();
+  }
+}
+
+void PeridigmNS::OutputManager_Probe::flush() {
+
+  if (!file.is_open() || buffer.size() == 0) return;
+
+  if (binaryOutput) {
+    file.write(reinterpret_cast<const char*>(&buffer[0]), buffer.size()*sizeof(double));
+  }
+  else {
+    for (unsigned int i=0 ; i<buffer.size() ; ++i) {
+      file << buffer[i];
+      file << ((i+1)%(numColumns+1) == 0 ? "\n" : ",");
+    }
+  }
+  file.flush();
+  buffer.clear();
+}
@@ -0,0 +1,158 @@
+/*! \file Peridigm_OutputManager_Probe.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef PERIDIGM_OUTPUTMANAGER_PROBE_HPP
+#define PERIDIGM_OUTPUTMANAGER_PROBE_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+#include <Peridigm_OutputManager.hpp>
+
+#include <Teuchos_ParameterList.hpp>
+
+// Forward declaration
+namespace PeridigmNS {
+  class Peridigm;
+}
+
+namespace PeridigmNS {
+
+  /*! \brief Output manager that records the time history of selected fields at a set of probe locations.
+   *
+   *  Each probe is assigned to the point nearest its location in the reference configuration, found with a kd-tree
+   *  over the locally-owned points followed by a global reduction.  At every output step the requested variables are
+   *  sampled at the probe points and gathered on the root processor, which buffers the records and appends them to a
+   *  single CSV or binary time-history file.  The probes are sampled independently of the Exodus output, typically at
+   *  a much higher frequency.
+   *
+   *  The binary format is a header ("PDPROBE1", the number of columns as a 32-bit integer, and a 64-character name for
+   *  each column) followed by one record of doubles per output step; the first column of each record is the time.
+   */
+  class OutputManager_Probe: public PeridigmNS::OutputManager {
+
+  public:
+
+    //! Basic constructor.
+    OutputManager_Probe(const Teuchos::RCP<Teuchos::ParameterList>& params,
+                        PeridigmNS::Peridigm *peridigm_,
+                        Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks);
+
+    //! Destructor.
+    virtual ~OutputManager_Probe();
+
+    //! Sample the probes and buffer the record; the buffer is written to disk when full
+    virtual void write(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks, double);
+
+    //! Write any buffered records to disk
+    virtual void flush();
+
+  private:
+
+    //! Copy constructor.
+    OutputManager_Probe( const OutputManager& OM );
+
+    //! Assignment operator.
+    OutputManager_Probe& operator=( const OutputManager& OM );
+
+    //! Read the probe locations from the parameter list and, optionally, a probe file
+    void readProbeLocations(const Teuchos::ParameterList& params);
+
+    //! Assign each probe to its nearest point and open the time-history file
+    void initializeProbes(Teuchos::RCP< std::vector<PeridigmNS::Block> > blocks);
+
+    //! Parent pointer
+    PeridigmNS::Peridigm *peridigm;
+
+    //! Flag indicating that initializeProbes() has been called
+    bool probesInitialized;
+
+    //! Flag indicating binary rather than CSV output
+    bool binaryOutput;
+
+    //! Number of records buffered before they are written to disk
+    int bufferSize;
+
+    //! Probe locations, stored as (X0, Y0, Z0, X1, Y1, Z1, ..., XN, YN, ZN)
+    std::vector<double> probeLocations;
+
+    //! Probe names, used as column prefixes
+    std::vector<std::string> probeNames;
+
+    //! Field ids of the sampled variables
+    std::vector<int> fieldIds;
+
+    //! Number of components of each sampled variable
+    std::vector<int> fieldLengths;
+
+    //! Number of columns in a record, excluding the time
+    int numColumns;
+
+    //! Column names
+    std::vector<std::string> columnNames;
+
+    //! @name Locally-owned probes
+    //@{
+    //! Index of each locally-owned probe
+    std::vector<int> localProbes;
+    //! Position of each locally-owned probe's block in the block list
+    std::vector<int> localProbeBlocks;
+    //! Block-local id of each locally-owned probe's point
+    std::vector<int> localProbePoints;
+    //@}
+
+    //! Records waiting to be written to disk, including the time (root processor only)
+    std::vector<double> buffer;
+
+    //! Time-history file (root processor only)
+    std::ofstream file;
+  };
+
+}
+
+#endif //PERIDIGM_OUTPUTMANAGER_PROBE_HPP
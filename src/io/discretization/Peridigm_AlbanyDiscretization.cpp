@@ -270,7 +270,7 @@ PeridigmNS::AlbanyDiscretization::AlbanyDiscretization(const MPI_Comm& mpiComm,
   memcpy(albanyPartialStressNeighborhoodData->OwnedIDs(), &ownedLocalIds[0], numNodeIds*sizeof(int));
   memcpy(albanyPartialStressNeighborhoodData->NeighborhoodPtr(), &neighborhoodPtr[0], numNodeIds*sizeof(int));
   albanyPartialStressNeighborhoodData->SetNeighborhoodListSize(prunedNeighborListSize);
-  memcpy(albanyPartialStressNeighborhoodData->NeighborhoodList(), prunedNeighborList.getRawPtr(), prunedNeighborListSize*sizeof(int));
+  memcpy(albanyPartialStressNeighborhoodData->InterleavedNeighborhoodList(), prunedNeighborList.getRawPtr(), prunedNeighborListSize*sizeof(int));
   albanyPartialStressNeighborhoodData = filterBonds(albanyPartialStressNeighborhoodData);
 
   // Create the three-dimensional overlap map based on the one-dimensional overlap map
@@ -292,7 +292,7 @@ PeridigmNS::AlbanyDiscretization::AlbanyDiscretization(const MPI_Comm& mpiComm,
   int* oneDimensionalMapGlobalElements = oneDimensionalMap->MyGlobalElements();
   int* myGlobalElements = new int[numMyElementsUpperBound];
   int* elementSizeList = new int[numMyElementsUpperBound];
-  int* const neighborhood = neighborhoodData->NeighborhoodList();
+  int* const neighborhood = neighborhoodData->InterleavedNeighborhoodList();
   int neighborhoodIndex = 0;
   int numPointsWithZeroNeighbors = 0;
   for(int i=0 ; i<neighborhoodData->NumOwnedPoints() ; ++i){
@@ -406,7 +406,7 @@ PeridigmNS::AlbanyDiscretization::createNeighborhoodData(int neighborListSize, i
    memcpy(neighborhoodData->OwnedIDs(), &ownedLocalIds[0], numOwnedIds*sizeof(int));
    memcpy(neighborhoodData->NeighborhoodPtr(), &neighborhoodPtr[0], numOwnedIds*sizeof(int));
    neighborhoodData->SetNeighborhoodListSize(neighborListSize);
-   memcpy(neighborhoodData->NeighborhoodList(), neighborList, neighborListSize*sizeof(int));
+   memcpy(neighborhoodData->InterleavedNeighborhoodList(), neighborList, neighborListSize*sizeof(int));
    neighborhoodData = filterBonds(neighborhoodData);
 }
 
@@ -457,7 +457,7 @@ PeridigmNS::AlbanyDiscretization::filterBonds(Teuchos::RCP<PeridigmNS::Neighborh
   int* const neighborhoodPtr = neighborhoodData->NeighborhoodPtr();
 
   int numOwnedPoints = neighborhoodData->NumOwnedPoints();
-  int* const unfilteredNeighborhoodList = unfilteredNeighborhoodData->NeighborhoodList();
+  int* const unfilteredNeighborhoodList = unfilteredNeighborhoodData->InterleavedNeighborhoodList();
   int unfilteredNeighborhoodListIndex(0);
   for(int iID=0 ; iID<numOwnedPoints ; ++iID){
     int blockID = static_cast<int>(blockIDs[iID]);
@@ -478,7 +478,7 @@ PeridigmNS::AlbanyDiscretization::filterBonds(Teuchos::RCP<PeridigmNS::Neighborh
   }
 
   neighborhoodData->SetNeighborhoodListSize(neighborhoodListVec.size());
-  memcpy(neighborhoodData->NeighborhoodList(), &neighborhoodListVec[0], neighborhoodListVec.size()*sizeof(int));
+  memcpy(neighborhoodData->InterleavedNeighborhoodList(), &neighborhoodListVec[0], neighborhoodListVec.size()*sizeof(int));
 
   return neighborhoodData;
 }
@@ -0,0 +1,250 @@
+/*! \file Peridigm_BinaryDiscretizationFile.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_BinaryDiscretizationFile.hpp"
+#include <Teuchos_Assert.hpp>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+
+  const char binaryDiscretizationMagic[8] = {'P', 'D', 'D', 'I', 'S', 'C', 'R', 'T'};
+  const int32_t binaryDiscretizationVersion = 1;
+  const int32_t binaryDiscretizationByteOrderMark = 0x01020304;
+  const int32_t hasPartitionFlag = 1;
+  const size_t nodeSetNameLength = 64;
+
+  size_t align8(size_t offset){ return (offset + 7) & ~static_cast<size_t>(7); }
+
+  // Offsets of the fixed-size sections, in bytes from the start of the file
+  struct SectionOffsets {
+    size_t coordinates;
+    size_t volumes;
+    size_t blockIds;
+    size_t partition;
+    size_t nodeSets;
+  };
+
+  SectionOffsets computeSectionOffsets(size_t numPoints, bool hasPartition){
+    SectionOffsets offsets;
+    offsets.coordinates = align8(sizeof(PeridigmNS::BinaryDiscretizationHeader));
+    offsets.volumes = offsets.coordinates + 3*numPoints*sizeof(double);
+    offsets.blockIds = offsets.volumes + numPoints*sizeof(double);
+    offsets.partition = align8(offsets.blockIds + numPoints*sizeof(int32_t));
+    offsets.nodeSets = hasPartition ? align8(offsets.partition + numPoints*sizeof(int32_t)) : offsets.partition;
+    return offsets;
+  }
+
+  void writePadding(ofstream& outFile){
+    static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    size_t position = static_cast<size_t>(outFile.tellp());
+    outFile.write(zeros, align8(position) - position);
+  }
+}
+
+PeridigmNS::BinaryDiscretizationFile::BinaryDiscretizationFile(const string& fileName_)
+  : fileName(fileName_), mappedData(MAP_FAILED), mappedSize(0), header(NULL),
+    coordinatesPtr(NULL), volumesPtr(NULL), blockIdsPtr(NULL), partitionPtr(NULL)
+{
+  int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(fileDescriptor < 0, "**** Error opening binary discretization file " + fileName + ".\n");
+  struct stat fileStatus;
+  if(fstat(fileDescriptor, &fileStatus) != 0){
+    close(fileDescriptor);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "**** Error reading the size of binary discretization file " + fileName + ".\n");
+  }
+  mappedSize = static_cast<size_t>(fileStatus.st_size);
+  if(mappedSize < sizeof(BinaryDiscretizationHeader)){
+    close(fileDescriptor);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "**** Error, " + fileName + " is too small to be a binary discretization file.\n");
+  }
+  mappedData = mmap(NULL, mappedSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+  // The mapping remains valid after the file descriptor is closed
+  close(fileDescriptor);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(mappedData == MAP_FAILED, "**** Error memory mapping binary discretization file " + fileName + ".\n");
+
+  const char* base = static_cast<const char*>(mappedData);
+  header = reinterpret_cast<const BinaryDiscretizationHeader*>(base);
+  string msg;
+  if(memcmp(header->magic, binaryDiscretizationMagic, sizeof(binaryDiscretizationMagic)) != 0)
+    msg = "**** Error, " + fileName + " is not a binary discretization file.\n";
+  else if(header->byteOrderMark != binaryDiscretizationByteOrderMark)
+    msg = "**** Error, binary discretization file " + fileName + " was written on a machine with a different byte order.\n";
+  else if(header->version != binaryDiscretizationVersion)
+    msg = "**** Error, unsupported version of binary discretization file " + fileName + ".\n";
+  else if(header->numPoints < 0 || header->numPoints > INT_MAX || header->numNodeSets < 0)
+    msg = "**** Error, invalid header in binary discretization file " + fileName + ".\n";
+  else if(static_cast<int64_t>(mappedSize) != header->fileSize)
+    msg = "**** Error, binary discretization file " + fileName + " is truncated.\n";
+  if(!msg.empty()){
+    munmap(mappedData, mappedSize);
+    mappedData = MAP_FAILED;
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(true, msg);
+  }
+
+  bool hasPartition = (header->flags & hasPartitionFlag) != 0;
+  SectionOffsets offsets = computeSectionOffsets(static_cast<size_t>(header->numPoints), hasPartition);
+  if(offsets.nodeSets > mappedSize || header->nodeSetOffset != static_cast<int64_t>(offsets.nodeSets)){
+    munmap(mappedData, mappedSize);
+    mappedData = MAP_FAILED;
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "**** Error, inconsistent section sizes in binary discretization file " + fileName + ".\n");
+  }
+  coordinatesPtr = reinterpret_cast<const double*>(base + offsets.coordinates);
+  volumesPtr = reinterpret_cast<const double*>(base + offsets.volumes);
+  blockIdsPtr = reinterpret_cast<const int32_t*>(base + offsets.blockIds);
+  if(hasPartition)
+    partitionPtr = reinterpret_cast<const int32_t*>(base + offsets.partition);
+
+  // Walk the node set records to build the directory
+  size_t offset = static_cast<size_t>(header->nodeSetOffset);
+  for(int64_t i=0 ; i<header->numNodeSets ; ++i){
+    bool valid = offset + nodeSetNameLength + 2*sizeof(int64_t) <= mappedSize;
+    int64_t id(0), size(0);
+    if(valid){
+      memcpy(&id, base + offset + nodeSetNameLength, sizeof(int64_t));
+      memcpy(&size, base + offset + nodeSetNameLength + sizeof(int64_t), sizeof(int64_t));
+      valid = size >= 0 && size <= header->numPoints &&
+        offset + nodeSetNameLength + 2*sizeof(int64_t) + size*sizeof(int32_t) <= mappedSize;
+    }
+    if(!valid){
+      munmap(mappedData, mappedSize);
+      mappedData = MAP_FAILED;
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "**** Error, invalid node set record in binary discretization file " + fileName + ".\n");
+    }
+    const char* name = base + offset;
+    nodeSetNames.push_back(string(name, strnlen(name, nodeSetNameLength)));
+    nodeSetIdList.push_back(static_cast<int>(id));
+    nodeSetSizes.push_back(static_cast<int>(size));
+    nodeSetPtrs.push_back(reinterpret_cast<const int32_t*>(base + offset + nodeSetNameLength + 2*sizeof(int64_t)));
+    offset = align8(offset + nodeSetNameLength + 2*sizeof(int64_t) + size*sizeof(int32_t));
+  }
+}
+
+PeridigmNS::BinaryDiscretizationFile::~BinaryDiscretizationFile()
+{
+  if(mappedData != MAP_FAILED)
+    munmap(mappedData, mappedSize);
+}
+
+void PeridigmNS::writeBinaryDiscretizationFile(const string& fileName,
+                                               const vector<double>& coordinates,
+                                               const vector<double>& volumes,
+                                               const vector<int>& blockIds,
+                                               const vector<int>& partition,
+                                               int numPartitions,
+                                               const map< string, vector<int> >& nodeSets,
+                                               const map< string, int >& nodeSetIds)
+{
+  size_t numPoints = volumes.size();
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(coordinates.size() != 3*numPoints || blockIds.size() != numPoints,
+                              "**** Error in writeBinaryDiscretizationFile(), inconsistent array lengths.\n");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(!partition.empty() && (partition.size() != numPoints || numPartitions < 1),
+                              "**** Error in writeBinaryDiscretizationFile(), invalid partition.\n");
+  bool hasPartition = !partition.empty();
+  SectionOffsets offsets = computeSectionOffsets(numPoints, hasPartition);
+
+  BinaryDiscretizationHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, binaryDiscretizationMagic, sizeof(binaryDiscretizationMagic));
+  header.version = binaryDiscretizationVersion;
+  header.byteOrderMark = binaryDiscretizationByteOrderMark;
+  header.numPoints = numPoints;
+  header.numPartitions = hasPartition ? numPartitions : 0;
+  header.flags = hasPartition ? hasPartitionFlag : 0;
+  header.numNodeSets = nodeSets.size();
+  header.nodeSetOffset = offsets.nodeSets;
+  size_t fileSize = offsets.nodeSets;
+  for(map< string, vector<int> >::const_iterator it = nodeSets.begin() ; it != nodeSets.end() ; ++it)
+    fileSize = align8(fileSize + nodeSetNameLength + 2*sizeof(int64_t) + it->second.size()*sizeof(int32_t));
+  header.fileSize = fileSize;
+
+  ofstream outFile(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(!outFile.is_open(), "**** Error opening binary discretization file " + fileName + " for writing.\n");
+  outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  writePadding(outFile);
+  if(numPoints > 0){
+    outFile.write(reinterpret_cast<const char*>(&coordinates[0]), 3*numPoints*sizeof(double));
+    outFile.write(reinterpret_cast<const char*>(&volumes[0]), numPoints*sizeof(double));
+    vector<int32_t> buffer(blockIds.begin(), blockIds.end());
+    outFile.write(reinterpret_cast<const char*>(&buffer[0]), numPoints*sizeof(int32_t));
+    writePadding(outFile);
+    if(hasPartition){
+      buffer.assign(partition.begin(), partition.end());
+      outFile.write(reinterpret_cast<const char*>(&buffer[0]), numPoints*sizeof(int32_t));
+      writePadding(outFile);
+    }
+  }
+  int nextNodeSetId = 1;
+  for(map< string, vector<int> >::const_iterator it = nodeSets.begin() ; it != nodeSets.end() ; ++it, ++nextNodeSetId){
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(it->first.size() >= nodeSetNameLength,
+                                "**** Error in writeBinaryDiscretizationFile(), node set name too long: " + it->first + "\n");
+    char name[nodeSetNameLength];
+    memset(name, 0, nodeSetNameLength);
+    memcpy(name, it->first.c_str(), it->first.size());
+    map<string, int>::const_iterator idIt = nodeSetIds.find(it->first);
+    int64_t id = idIt != nodeSetIds.end() ? idIt->second : nextNodeSetId;
+    int64_t size = it->second.size();
+    outFile.write(name, nodeSetNameLength);
+    outFile.write(reinterpret_cast<const char*>(&id), sizeof(int64_t));
+    outFile.write(reinterpret_cast<const char*>(&size), sizeof(int64_t));
+    if(size > 0){
+      vector<int32_t> buffer(it->second.begin(), it->second.end());
+      outFile.write(reinterpret_cast<const char*>(&buffer[0]), size*sizeof(int32_t));
+    }
+    writePadding(outFile);
+  }
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(!outFile.good(), "**** Error writing binary discretization file " + fileName + ".\n");
+  outFile.close();
+}
@@ -0,0 +1,167 @@
+/*! \file Peridigm_BinaryDiscretizationFile.hpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef PERIDIGM_BINARYDISCRETIZATIONFILE_HPP
+#define PERIDIGM_BINARYDISCRETIZATIONFILE_HPP
+
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace PeridigmNS {
+
+  /*! \brief Header of a native binary discretization file.
+   *
+   *  The header is followed by 8-byte aligned sections holding the coordinates (3*numPoints doubles),
+   *  the cell volumes (numPoints doubles), the block ids (numPoints int32s), the optional partition
+   *  (numPoints int32s), and the node sets.  Each node set is stored as a 64-character name, an int64 id,
+   *  an int64 length, and the 0-based global ids of its points.  The global id of a point is its index in
+   *  the file.  Data are stored in the byte order of the machine that wrote the file.
+   */
+  struct BinaryDiscretizationHeader {
+    char magic[8];
+    int32_t version;
+    int32_t byteOrderMark;
+    int64_t numPoints;
+    int32_t numPartitions;
+    int32_t flags;
+    int64_t numNodeSets;
+    int64_t nodeSetOffset;
+    int64_t fileSize;
+  };
+
+  //! Read-only view of a native binary discretization file; the file is memory mapped for the lifetime of the object.
+  class BinaryDiscretizationFile {
+
+  public:
+
+    //! Constructor, maps the file and validates the header.
+    explicit BinaryDiscretizationFile(const std::string& fileName);
+
+    //! Destructor, unmaps the file.
+    ~BinaryDiscretizationFile();
+
+    //! Total number of points in the file.
+    int numPoints() const { return static_cast<int>(header->numPoints); }
+
+    //! Coordinates of all the points, stored as x0 y0 z0 x1 y1 z1 ...
+    const double* coordinates() const { return coordinatesPtr; }
+
+    //! Cell volume of each point.
+    const double* volumes() const { return volumesPtr; }
+
+    //! Block id of each point.
+    const int32_t* blockIds() const { return blockIdsPtr; }
+
+    //! Number of partitions stored in the file; zero if the file does not contain a partition.
+    int numPartitions() const { return header->numPartitions; }
+
+    //! Partition of each point, or NULL if the file does not contain a partition.
+    const int32_t* partition() const { return partitionPtr; }
+
+    //! Number of node sets.
+    int numNodeSets() const { return static_cast<int>(nodeSetNames.size()); }
+
+    //! Name of the i-th node set.
+    const std::string& nodeSetName(int i) const { return nodeSetNames[i]; }
+
+    //! Id of the i-th node set.
+    int nodeSetId(int i) const { return nodeSetIdList[i]; }
+
+    //! Number of points in the i-th node set.
+    int nodeSetSize(int i) const { return nodeSetSizes[i]; }
+
+    //! Global ids of the points in the i-th node set.
+    const int32_t* nodeSet(int i) const { return nodeSetPtrs[i]; }
+
+  private:
+
+    //! Private to prohibit copying
+    BinaryDiscretizationFile(const BinaryDiscretizationFile&);
+
+    //! Private to prohibit copying
+    BinaryDiscretizationFile& operator=(const BinaryDiscretizationFile&);
+
+    //! Name of the file, used in error messages.
+    std::string fileName;
+
+    //! Start and length of the mapped region.
+    void* mappedData;
+    size_t mappedSize;
+
+    //! Pointers into the mapped region.
+    const BinaryDiscretizationHeader* header;
+    const double* coordinatesPtr;
+    const double* volumesPtr;
+    const int32_t* blockIdsPtr;
+    const int32_t* partitionPtr;
+
+    //! Node set directory.
+    std::vector<std::string> nodeSetNames;
+    std::vector<int> nodeSetIdList;
+    std::vector<int> nodeSetSizes;
+    std::vector<const int32_t*> nodeSetPtrs;
+  };
+
+  /*! \brief Write a native binary discretization file.
+   *
+   *  The partition may be empty, in which case numPartitions is ignored.  Node set ids are taken from nodeSetIds
+   *  when present and are otherwise assigned in order, starting with one.
+   */
+  void writeBinaryDiscretizationFile(const std::string& fileName,
+                                     const std::vector<double>& coordinates,
+                                     const std::vector<double>& volumes,
+                                     const std::vector<int>& blockIds,
+                                     const std::vector<int>& partition,
+                                     int numPartitions,
+                                     const std::map< std::string, std::vector<int> >& nodeSets,
+                                     const std::map< std::string, int >& nodeSetIds);
+}
+
+#endif // PERIDIGM_BINARYDISCRETIZATIONFILE_HPP
@@ -59,6 +59,11 @@
 
 namespace PeridigmNS {
 
+  /*! \brief Base class for discretizations.
+   *
+   *  Point global IDs, and hence the maps, are 32-bit ints, so a discretization is limited to INT_MAX points.
+   *  The number of bonds is not limited by the global IDs; bonds are indexed locally on each processor.
+   */
   class Discretization {
   public:
 
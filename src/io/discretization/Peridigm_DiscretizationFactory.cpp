@@ -75,7 +75,7 @@ PeridigmNS::DiscretizationFactory::create(const Teuchos::RCP<const Epetra_Comm>&
   if(type == "Exodus"){
 	discretization = Teuchos::rcp(new PeridigmNS::ExodusDiscretization(epetra_comm, discParams));
   }
-  else if(type == "Text File"){
+  else if(type == "Text File" || type == "Binary File"){
 	discretization = Teuchos::rcp(new PeridigmNS::TextFileDiscretization(epetra_comm, discParams));
   }
   else if(type == "PdQuickGrid"){
@@ -83,7 +83,7 @@ PeridigmNS::DiscretizationFactory::create(const Teuchos::RCP<const Epetra_Comm>&
   }
   else{
     TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter, 
-		       "**** Invalid discretization type.  Valid types are \"Exodus\", \"Text File\", and \"PdQuickGrid\".\n");
+		       "**** Invalid discretization type.  Valid types are \"Exodus\", \"Text File\", \"Binary File\", and \"PdQuickGrid\".\n");
   }
  
   return discretization;
@@ -49,9 +49,13 @@
 #include "Peridigm_ProximitySearch.hpp"
 #include "Peridigm_HorizonManager.hpp"
 #include "Peridigm_GeometryUtils.hpp"
+#include "Peridigm_ExodusMutex.hpp"
+#include "PdZoltan.h"
 #include <Epetra_Map.h>
 #include <Epetra_Vector.h>
 #include <Epetra_Import.h>
+#include <Epetra_Export.h>
+#include <Epetra_MultiVector.h>
 #include <Epetra_MpiComm.h>
 #include <Teuchos_CommHelpers.hpp>
 #include <Teuchos_DefaultComm.hpp>
@@ -59,7 +63,6 @@
 #include <Teuchos_RCP.hpp>
 #include <Ionit_Initializer.h>
 #include <sstream>
-#include <boost/math/constants/constants.hpp>
 #include <boost/algorithm/string.hpp>
 #include <exodusII.h>
 
@@ -72,10 +75,12 @@ PeridigmNS::ExodusDiscretization::ExodusDiscretization(const Teuchos::RCP<const
   verbose(false),
   minElementRadius(1.0e50),
   maxElementRadius(0.0),
+  decomposeSerialMesh(false),
   storeExodusMesh(false),
   constructInterfaces(false),
   computeIntersections(false),
   maxElementDimension(0.0),
+  maxElementBoundingRadius(0.0),
   numBonds(0),
   maxNumBondsPerElem(0),
   myPID(epetra_comm->MyPID()),
@@ -93,6 +98,11 @@ PeridigmNS::ExodusDiscretization::ExodusDiscretization(const Teuchos::RCP<const
     verbose = params->get<bool>("Verbose");
   }
 
+  // Read a single serial file on all processors and partition it in memory
+  if(params->isParameter("Decompose Serial Mesh")){
+    decomposeSerialMesh = params->get<bool>("Decompose Serial Mesh");
+  }
+
   // Store exodus mesh for intersection calculations, or if it was specifically requested (e.g., unit tests)
   if(params->isParameter("Store Exodus Mesh")){
     storeExodusMesh = params->get<bool>("Store Exodus Mesh");
@@ -111,10 +121,13 @@ PeridigmNS::ExodusDiscretization::ExodusDiscretization(const Teuchos::RCP<const
   createBondFilters(params);
 
   // Load data from mesh file
-  loadData(meshFileName);
+  if(decomposeSerialMesh && numPID > 1)
+    loadDataInParallel(meshFileName);
+  else
+    loadData(meshFileName);
   
   if(computeIntersections)
-    maxElementDimension = computeMaxElementDimension();
+    maxElementBoundingRadius = computeMaxElementBoundingRadius();
 
   // Assign the correct horizon to each node
   PeridigmNS::HorizonManager& horizonManager = PeridigmNS::HorizonManager::self();
@@ -147,9 +160,10 @@ PeridigmNS::ExodusDiscretization::ExodusDiscretization(const Teuchos::RCP<const
   int* neighborList;
 
   // Execute the neighbor search
-  // When computing element-horizon intersections, the search is expanded by the maximum element dimension
+  // When computing element-horizon intersections, the search is expanded by the largest distance from a sphere
+  // position to a node of its element, which is enough to find every element that can intersect the horizon
   if(computeIntersections)
-    ProximitySearch::GlobalProximitySearch(initialX, horizonForEachPoint, oneDimensionalOverlapMap, neighborListSize, neighborList, bondFilters, maxElementDimension);
+    ProximitySearch::GlobalProximitySearch(initialX, horizonForEachPoint, oneDimensionalOverlapMap, neighborListSize, neighborList, bondFilters, maxElementBoundingRadius);
   else
     ProximitySearch::GlobalProximitySearch(initialX, horizonForEachPoint, oneDimensionalOverlapMap, neighborListSize, neighborList, bondFilters);
 
@@ -187,7 +201,7 @@ PeridigmNS::ExodusDiscretization::ExodusDiscretization(const Teuchos::RCP<const
   int* oneDimensionalMapGlobalElements = oneDimensionalMap->MyGlobalElements();
   int* myGlobalElements = new int[numMyElementsUpperBound];
   int* elementSizeList = new int[numMyElementsUpperBound];
-  int* const neighborhood = neighborhoodData->NeighborhoodList();
+  int* const neighborhood = neighborhoodData->InterleavedNeighborhoodList();
   int neighborhoodIndex = 0;
   int numPointsWithZeroNeighbors = 0;
   for(int i=0 ; i<neighborhoodData->NumOwnedPoints() ; ++i){
@@ -262,6 +276,7 @@ void PeridigmNS::ExodusDiscretization::loadData(const string& meshFileName)
   int compWordSize = sizeof(double);
   int ioWordSize = 0;
   float exodusVersion;
+  boost::mutex::scoped_lock exodusLock(exodusMutex());
   int exodusFileId = ex_open(fileName.c_str(), EX_READ, &compWordSize, &ioWordSize, &exodusVersion);
   if(exodusFileId < 0){
     cout << "\n****Error on processor " << myPID << ": unable to open file " << fileName.c_str() << "\n" << endl;
@@ -614,10 +629,380 @@ void PeridigmNS::ExodusDiscretization::loadData(const string& meshFileName)
   if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadData()", "ex_close");
 }
 
+void PeridigmNS::ExodusDiscretization::loadDataInParallel(const string& meshFileName)
+{
+  // Every processor opens the same serial genesis file and reads only its share of the large arrays
+  int compWordSize = sizeof(double);
+  int ioWordSize = 0;
+  float exodusVersion;
+  boost::mutex::scoped_lock exodusLock(exodusMutex());
+  int exodusFileId = ex_open(meshFileName.c_str(), EX_READ, &compWordSize, &ioWordSize, &exodusVersion);
+  if(exodusFileId < 0){
+    cout << "\n****Error on processor " << myPID << ": unable to open file " << meshFileName.c_str() << "\n" << endl;
+    reportExodusError(exodusFileId, "ExodusDiscretization::loadDataInParallel()", "ex_open");
+  }
+
+  // Read the initialization parameters
+  int numDim, numNodes, numElem, numElemBlocks, numNodeSets, numSideSets;
+  char title[MAX_LINE_LENGTH];
+  int retval = ex_get_init(exodusFileId, title, &numDim, &numNodes, &numElem, &numElemBlocks, &numNodeSets, &numSideSets);
+  if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_init");
+
+  // Each processor reads a contiguous range of the elements and a contiguous range of the nodes, in file order
+  long long pid = myPID, numProc = numPID;
+  int firstElem = static_cast<int>((numElem*pid)/numProc);
+  int numMyElem = static_cast<int>((numElem*(pid + 1))/numProc) - firstElem;
+  int firstNode = static_cast<int>((numNodes*pid)/numProc);
+  int numMyNodes = static_cast<int>((numNodes*(pid + 1))/numProc) - firstNode;
+
+  // Node coordinates for this processor's node range
+  // The 0-based position of a node in the file is used as its global id
+  vector<double> sliceNodeCoordX(numMyNodes), sliceNodeCoordY(numMyNodes), sliceNodeCoordZ(numMyNodes);
+  if(numMyNodes > 0){
+    retval = ex_get_partial_coord(exodusFileId, firstNode + 1, numMyNodes, &sliceNodeCoordX[0], &sliceNodeCoordY[0], &sliceNodeCoordZ[0]);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_partial_coord");
+  }
+  vector<int> sliceNodeIds(numMyNodes);
+  for(int i=0 ; i<numMyNodes ; ++i)
+    sliceNodeIds[i] = firstNode + i;
+  Epetra_BlockMap sliceNodeMap(numNodes, numMyNodes, numMyNodes > 0 ? &sliceNodeIds[0] : NULL, 3, 0, *comm);
+  Epetra_Vector sliceNodePositions(sliceNodeMap);
+  for(int i=0 ; i<numMyNodes ; ++i){
+    sliceNodePositions[3*i]   = sliceNodeCoordX[i];
+    sliceNodePositions[3*i+1] = sliceNodeCoordY[i];
+    sliceNodePositions[3*i+2] = sliceNodeCoordZ[i];
+  }
+
+  // Global element numbering for this processor's element range
+  vector<int> elemIdMap(numMyElem);
+  if(numMyElem > 0){
+    retval = ex_get_partial_id_map(exodusFileId, EX_ELEM_MAP, firstElem + 1, numMyElem, &elemIdMap[0]);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_partial_id_map");
+  }
+  int numNodeMaps, numElemMaps;
+  retval = ex_get_map_param(exodusFileId, &numNodeMaps, &numElemMaps);
+  if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_map_param");
+  if(numElemMaps > 0){
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(numElemMaps > 1,
+                                "**** Error in ExodusDiscretization::loadDataInParallel(), genesis file contains invalid number of auxiliary element maps (>1).\n");
+    char mapName[MAX_STR_LENGTH];
+    retval = ex_get_name(exodusFileId, EX_ELEM_MAP, 1, mapName);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_name");
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(string(mapName) != string("original_global_id_map"),
+                                "**** Error in ExodusDiscretization::loadDataInParallel(), unknown exodus EX_ELEM_MAP: " + string(mapName) + ".\n");
+    if(numMyElem > 0){
+      retval = ex_get_partial_num_map(exodusFileId, EX_ELEM_MAP, 1, firstElem + 1, numMyElem, &elemIdMap[0]);
+      if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_partial_num_map");
+    }
+  }
+  for(int i=0 ; i<numMyElem ; ++i)
+    elemIdMap[i] -= 1; // Note the switch from 1-based indexing to 0-based indexing
+
+  // Process the element blocks
+  // The block parameters are read on every processor so that all processors are aware of the full block list
+  vector<int> elemBlockIds(numElemBlocks);
+  if(numElemBlocks > 0){
+    retval = ex_get_elem_blk_ids(exodusFileId, &elemBlockIds[0]);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_elem_blk_ids");
+  }
+
+  // Print a warning if the input mesh has side nodes (they will be ignored)
+  bool tenNodedTetWarningGiven(false), twentyNodedHexWarningGiven(false);
+
+  map<int, string> elemBlockNames;
+  vector<int> myElemBlockIds(numMyElem);
+  vector<ExodusElementType> myElemTypes(numMyElem, UNKNOWN_ELEMENT);
+  vector<double> mySphereVolumes(numMyElem, 0.0);
+  vector<int> myConnOffsets(1, 0);
+  vector<int> myConn;
+  int blockFirstElem(0);
+  for(int iElemBlock=0 ; iElemBlock<numElemBlocks ; iElemBlock++){
+
+    int elemBlockId = elemBlockIds[iElemBlock];
+
+    // Get the block name, if there is one
+    char exodusElemBlockName[MAX_STR_LENGTH];
+    retval = ex_get_name(exodusFileId, EX_ELEM_BLOCK, elemBlockId, exodusElemBlockName);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_name");
+    // If the block name came back blank, create one that looks like "block_1", "block_2", etc.
+    string elemBlockName(exodusElemBlockName);
+    if(elemBlockName.size() == 0){
+      stringstream ss;
+      ss << "block_" << elemBlockId;
+      elemBlockName = ss.str();
+    }
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(elementBlocks->find(elemBlockName) != elementBlocks->end(), "**** Duplicate block found: " + elemBlockName + "\n");
+    (*elementBlocks)[elemBlockName] = vector<int>();
+    elemBlockNames[elemBlockId] = elemBlockName;
+
+    // Get the block parameters
+    char elemType[MAX_STR_LENGTH];
+    int numElemThisBlock, numNodesPerElem, numAttributes;
+    retval = ex_get_elem_block(exodusFileId, elemBlockId, elemType, &numElemThisBlock, &numNodesPerElem, &numAttributes);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_elem_block");
+
+    // The part of the block that falls in this processor's element range
+    int start = max(firstElem, blockFirstElem);
+    int stop = min(firstElem + numMyElem, blockFirstElem + numElemThisBlock);
+    int numElemToRead = stop - start;
+    if(numElemToRead > 0){
+      ExodusElementType exodusElementType(UNKNOWN_ELEMENT);
+      string elemTypeString(elemType);
+      boost::to_upper(elemTypeString);
+      if(elemTypeString == string("SPHERE"))
+        exodusElementType = SPHERE_ELEMENT;
+      else if(elemTypeString == string("TET") || elemTypeString == string("TETRA") || elemTypeString == string("TET4") || elemTypeString == string("TET10"))
+        exodusElementType = TET_ELEMENT;
+      else if(elemTypeString == string("HEX") || elemTypeString == string("HEX8") || elemTypeString == string("HEX20"))
+        exodusElementType = HEX_ELEMENT;
+      else{
+        string msg = "\n**** Error in loadDataInParallel(), unknown element type " + elemTypeString + ".\n";
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(true, msg);
+      }
+      if(exodusElementType == TET_ELEMENT && numNodesPerElem == 10 && !tenNodedTetWarningGiven){
+        cout << "**** Warning on processor " << myPID
+             << ", side nodes being discarded for 10-node tetrahedron element, will be treated as 4-node tetrahedron element." << endl;
+        tenNodedTetWarningGiven = true;
+      }
+      if(exodusElementType == HEX_ELEMENT && numNodesPerElem == 20 && !twentyNodedHexWarningGiven){
+        cout << "**** Warning on processor " << myPID
+             << ", side nodes being discarded for 20-node hexahedron element, will be treated as 8-node hexahedron element." << endl;
+        twentyNodedHexWarningGiven = true;
+      }
+
+      vector<int> conn(numElemToRead*numNodesPerElem);
+      retval = ex_get_partial_conn(exodusFileId, EX_ELEM_BLOCK, elemBlockId, start - blockFirstElem + 1, numElemToRead, &conn[0], NULL, NULL);
+      if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_partial_conn");
+      vector<double> attributes;
+      if(exodusElementType == SPHERE_ELEMENT){
+        attributes.resize(numElemToRead*numAttributes);
+        retval = ex_get_partial_attr(exodusFileId, EX_ELEM_BLOCK, elemBlockId, start - blockFirstElem + 1, numElemToRead, &attributes[0]);
+        if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_partial_attr");
+      }
+
+      for(int iElem=0 ; iElem<numElemToRead ; ++iElem){
+        int localElemId = start - firstElem + iElem;
+        myElemBlockIds[localElemId] = elemBlockId;
+        myElemTypes[localElemId] = exodusElementType;
+        // The second attribute of a sphere element is its volume
+        if(exodusElementType == SPHERE_ELEMENT)
+          mySphereVolumes[localElemId] = attributes[iElem*numAttributes + 1];
+        for(int i=0 ; i<numNodesPerElem ; ++i)
+          myConn.push_back(conn[iElem*numNodesPerElem + i] - 1); // Note the switch from 1-based indexing to 0-based indexing
+        myConnOffsets.push_back(static_cast<int>(myConn.size()));
+      }
+    }
+    blockFirstElem += numElemThisBlock;
+  }
+
+  // Fetch the coordinates of the nodes used by this processor's elements from the processors that read them
+  set<int> myNodeSet(myConn.begin(), myConn.end());
+  vector<int> myNodes(myNodeSet.begin(), myNodeSet.end());
+  int numMyReferencedNodes = static_cast<int>(myNodes.size());
+  int* myNodesPtr = numMyReferencedNodes > 0 ? &myNodes[0] : NULL;
+  Epetra_BlockMap myNodeMap(-1, numMyReferencedNodes, myNodesPtr, 3, 0, *comm);
+  Epetra_Vector myNodePositions(myNodeMap);
+  Epetra_Import nodePositionImporter(myNodeMap, sliceNodeMap);
+  myNodePositions.Import(sliceNodePositions, nodePositionImporter, Insert);
+
+  // Convert elements to spheres
+  vector<double> myX(3*numMyElem);
+  vector<double> myVolumes(numMyElem);
+  vector<double> nodeCoordinates;
+  for(int iElem=0 ; iElem<numMyElem ; ++iElem){
+    int numNodesPerElem = myConnOffsets[iElem+1] - myConnOffsets[iElem];
+    nodeCoordinates.resize(3*numNodesPerElem);
+    for(int i=0 ; i<numNodesPerElem ; ++i){
+      int nodeLocalId = myNodeMap.LID(myConn[myConnOffsets[iElem] + i]);
+      nodeCoordinates[3*i]   = myNodePositions[3*nodeLocalId];
+      nodeCoordinates[3*i+1] = myNodePositions[3*nodeLocalId+1];
+      nodeCoordinates[3*i+2] = myNodePositions[3*nodeLocalId+2];
+    }
+    double volume(0.0);
+    if(myElemTypes[iElem] == SPHERE_ELEMENT){
+      myX[3*iElem]   = nodeCoordinates[0];
+      myX[3*iElem+1] = nodeCoordinates[1];
+      myX[3*iElem+2] = nodeCoordinates[2];
+      volume = mySphereVolumes[iElem];
+    }
+    else if(myElemTypes[iElem] == TET_ELEMENT){
+      tetCentroidAndVolume(&nodeCoordinates[0], &myX[3*iElem], &volume);
+    }
+    else if(myElemTypes[iElem] == HEX_ELEMENT){
+      hexCentroidAndVolume(&nodeCoordinates[0], &myX[3*iElem], &volume);
+    }
+    myVolumes[iElem] = volume;
+  }
+
+  // Resolve node-set membership on the file-order distribution
+  // Each processor reads a range of each node set and flags those nodes on the processors that read them,
+  // then every element that contains a flagged node is included in the node set
+  int* elemIdMapPtr = numMyElem > 0 ? &elemIdMap[0] : NULL;
+  Epetra_BlockMap fileOrderElemMap(numElem, numMyElem, elemIdMapPtr, 1, 0, *comm);
+  Epetra_MultiVector fileOrderNodeSetFlags(fileOrderElemMap, max(numNodeSets, 1));
+  nodeSets = Teuchos::rcp< map<string, vector<int> > >(new map<string, vector<int> >() );
+  nodeSetIds = Teuchos::rcp< map<string, int> >(new map<string, int>() );
+  vector<string> nodeSetNames(numNodeSets);
+  if(numNodeSets > 0){
+    vector<int> exodusNodeSetIds(numNodeSets);
+    retval = ex_get_node_set_ids(exodusFileId, &exodusNodeSetIds[0]);
+    if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_node_set_ids");
+    Epetra_BlockMap sliceNodeScalarMap(numNodes, numMyNodes, numMyNodes > 0 ? &sliceNodeIds[0] : NULL, 1, 0, *comm);
+    Epetra_BlockMap myNodeScalarMap(-1, numMyReferencedNodes, myNodesPtr, 1, 0, *comm);
+    Epetra_Import nodeFlagImporter(myNodeScalarMap, sliceNodeScalarMap);
+    for(int iNodeSet=0 ; iNodeSet<numNodeSets ; ++iNodeSet){
+      int nodeSetId = exodusNodeSetIds[iNodeSet];
+      char exodusNodeSetName[MAX_STR_LENGTH];
+      retval = ex_get_name(exodusFileId, EX_NODE_SET, nodeSetId, exodusNodeSetName);
+      if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_name");
+      // If the node set name came back blank, create one that looks like "nodelist_1", "nodelist_2", etc.
+      string nodeSetName(exodusNodeSetName);
+      if(nodeSetName.size() == 0){
+        stringstream ss;
+        ss << "nodelist_" << nodeSetId;
+        nodeSetName = ss.str();
+      }
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(nodeSets->find(nodeSetName) != nodeSets->end(), "**** Duplicate node set found: " + nodeSetName + "\n");
+      (*nodeSets)[nodeSetName] = vector<int>();
+      (*nodeSetIds)[nodeSetName] = nodeSetId;
+      nodeSetNames[iNodeSet] = nodeSetName;
+
+      int numNodesInSet, numDistributionFactorsInSet;
+      retval = ex_get_node_set_param(exodusFileId, nodeSetId, &numNodesInSet, &numDistributionFactorsInSet);
+      if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_node_set_param");
+      int firstEntry = static_cast<int>((numNodesInSet*pid)/numProc);
+      int numMyEntries = static_cast<int>((numNodesInSet*(pid + 1))/numProc) - firstEntry;
+      set<int> myNodeSetNodes;
+      if(numMyEntries > 0){
+        vector<int> entries(numMyEntries);
+        retval = ex_get_partial_set(exodusFileId, EX_NODE_SET, nodeSetId, firstEntry + 1, numMyEntries, &entries[0], NULL);
+        if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_get_partial_set");
+        for(int i=0 ; i<numMyEntries ; ++i)
+          myNodeSetNodes.insert(entries[i] - 1); // Note the switch from 1-based indexing to 0-based indexing
+      }
+      vector<int> entryNodes(myNodeSetNodes.begin(), myNodeSetNodes.end());
+      Epetra_BlockMap entryMap(-1, static_cast<int>(entryNodes.size()), entryNodes.size() > 0 ? &entryNodes[0] : NULL, 1, 0, *comm);
+      Epetra_Vector entryFlags(entryMap);
+      entryFlags.PutScalar(1.0);
+      Epetra_Vector sliceNodeFlags(sliceNodeScalarMap);
+      Epetra_Export entryExporter(entryMap, sliceNodeScalarMap);
+      sliceNodeFlags.Export(entryFlags, entryExporter, Add);
+      Epetra_Vector myNodeFlags(myNodeScalarMap);
+      myNodeFlags.Import(sliceNodeFlags, nodeFlagImporter, Insert);
+      for(int iElem=0 ; iElem<numMyElem ; ++iElem){
+        for(int i=myConnOffsets[iElem] ; i<myConnOffsets[iElem+1] ; ++i){
+          if(myNodeFlags[myNodeScalarMap.LID(myConn[i])] > 0.0){
+            fileOrderNodeSetFlags[iNodeSet][iElem] = 1.0;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  // Partition the spheres with Zoltan
+  QUICKGRID::Data decomp = QUICKGRID::allocatePdGridData(numMyElem, 3);
+  decomp.globalNumPoints = numElem;
+  if(numMyElem > 0){
+    memcpy(decomp.myGlobalIDs.get(), &elemIdMap[0], numMyElem*sizeof(int));
+    memcpy(decomp.cellVolume.get(), &myVolumes[0], numMyElem*sizeof(double));
+    memcpy(decomp.myX.get(), &myX[0], 3*numMyElem*sizeof(double));
+  }
+  decomp = PDNEIGH::getLoadBalancedDiscretization(decomp);
+
+  // Create the owned maps
+  int numBalancedElem = static_cast<int>(decomp.numPoints);
+  oneDimensionalMap = Teuchos::rcp(new Epetra_BlockMap(numElem, numBalancedElem, decomp.myGlobalIDs.get(), 1, 0, *comm));
+  threeDimensionalMap = Teuchos::rcp(new Epetra_BlockMap(numElem, numBalancedElem, decomp.myGlobalIDs.get(), 3, 0, *comm));
+
+  // Create Epetra_Vectors for the initial positions, volumes, and block_ids
+  initialX = Teuchos::rcp(new Epetra_Vector(Copy, *threeDimensionalMap, decomp.myX.get()));
+  cellVolume = Teuchos::rcp(new Epetra_Vector(Copy, *oneDimensionalMap, decomp.cellVolume.get()));
+  Epetra_Vector fileOrderBlockID(fileOrderElemMap);
+  for(int iElem=0 ; iElem<numMyElem ; ++iElem)
+    fileOrderBlockID[iElem] = myElemBlockIds[iElem];
+  blockID = Teuchos::rcp(new Epetra_Vector(*oneDimensionalMap));
+  Epetra_Import balanceImporter(*oneDimensionalMap, fileOrderElemMap);
+  blockID->Import(fileOrderBlockID, balanceImporter, Insert);
+
+  // Create the element list for each block
+  for(int i=0 ; i<blockID->MyLength() ; ++i){
+    int elemBlockId = static_cast<int>((*blockID)[i]);
+    (*elementBlocks)[elemBlockNames[elemBlockId]].push_back(oneDimensionalMap->GID(i));
+  }
+
+  // Node sets contain the owned elements flagged above
+  if(numNodeSets > 0){
+    Epetra_MultiVector nodeSetFlags(*oneDimensionalMap, numNodeSets);
+    nodeSetFlags.Import(fileOrderNodeSetFlags, balanceImporter, Insert);
+    for(int iNodeSet=0 ; iNodeSet<numNodeSets ; ++iNodeSet){
+      vector<int>& nodeSet = (*nodeSets)[nodeSetNames[iNodeSet]];
+      for(int i=0 ; i<nodeSetFlags.MyLength() ; ++i){
+        if(nodeSetFlags[iNodeSet][i] > 0.0)
+          nodeSet.push_back(oneDimensionalMap->GID(i));
+      }
+    }
+  }
+
+  // Store the original exodus-mesh node positions and the connectivity of the owned elements
+  // This is for calculation of element-horizon intersetions
+  if(storeExodusMesh){
+    vector<int> fileOrderElementSizes(numMyElem);
+    Epetra_Vector fileOrderElementSize(fileOrderElemMap);
+    for(int iElem=0 ; iElem<numMyElem ; ++iElem){
+      fileOrderElementSizes[iElem] = myConnOffsets[iElem+1] - myConnOffsets[iElem];
+      fileOrderElementSize[iElem] = fileOrderElementSizes[iElem];
+    }
+    Epetra_Vector elementSize(*oneDimensionalMap);
+    elementSize.Import(fileOrderElementSize, balanceImporter, Insert);
+    vector<int> elementSizeList(numBalancedElem);
+    for(int i=0 ; i<numBalancedElem ; ++i)
+      elementSizeList[i] = static_cast<int>(elementSize[i]);
+    Epetra_BlockMap fileOrderConnectivityMap(-1, numMyElem, elemIdMapPtr, numMyElem > 0 ? &fileOrderElementSizes[0] : NULL, 0, *comm);
+    Epetra_Vector fileOrderConnectivity(fileOrderConnectivityMap);
+    for(unsigned int i=0 ; i<myConn.size() ; ++i)
+      fileOrderConnectivity[i] = myConn[i];
+    Epetra_BlockMap exodusMeshElementConnectivityMap(-1, numBalancedElem, oneDimensionalMap->MyGlobalElements(),
+                                                     numBalancedElem > 0 ? &elementSizeList[0] : NULL, 0, *comm);
+    exodusMeshElementConnectivity = Teuchos::rcp(new Epetra_Vector(exodusMeshElementConnectivityMap));
+    exodusMeshElementConnectivity->PutScalar(-1.0);
+    Epetra_Import connectivityImporter(exodusMeshElementConnectivityMap, fileOrderConnectivityMap);
+    exodusMeshElementConnectivity->Import(fileOrderConnectivity, connectivityImporter, Insert);
+
+    // The stored node positions are those of the nodes of the owned elements after load balancing
+    set<int> balancedNodeSet;
+    for(int i=0 ; i<exodusMeshElementConnectivity->MyLength() ; ++i)
+      balancedNodeSet.insert(static_cast<int>((*exodusMeshElementConnectivity)[i]));
+    vector<int> balancedNodes(balancedNodeSet.begin(), balancedNodeSet.end());
+    int numBalancedNodes = static_cast<int>(balancedNodes.size());
+    Epetra_BlockMap exodusMeshNodePositionsMap(-1, numBalancedNodes, numBalancedNodes > 0 ? &balancedNodes[0] : NULL, 3, 0, *comm);
+    exodusMeshNodePositions = Teuchos::rcp(new Epetra_Vector(exodusMeshNodePositionsMap));
+    Epetra_Import balancedNodePositionImporter(exodusMeshNodePositionsMap, sliceNodeMap);
+    exodusMeshNodePositions->Import(sliceNodePositions, balancedNodePositionImporter, Insert);
+  }
+
+  if(verbose && myPID == 0){
+    stringstream ss;
+    ss << "\nGenesis file " << meshFileName << " (decomposed in memory)" << endl;
+    ss << "  title " << title << endl;
+    ss << "  number of dimensions " << numDim << endl;
+    ss << "  number of nodes " << numNodes << endl;
+    ss << "  number of elements " << numElem << endl;
+    ss << "  number of blocks " << numElemBlocks << endl;
+    ss << "  number of node sets " << numNodeSets << endl;
+    ss << "  number of side sets (ignored) " << numSideSets << endl;
+    cout << ss.str() << endl;
+  }
+
+  // Close the genesis file
+  retval = ex_close(exodusFileId);
+  if (retval != 0) reportExodusError(retval, "ExodusDiscretization::loadDataInParallel()", "ex_close");
+}
+
 void
 PeridigmNS::ExodusDiscretization::constructInterfaceData()
 {
-  int* const neighPtr = neighborhoodData->NeighborhoodList();
+  int* const neighPtr = neighborhoodData->InterleavedNeighborhoodList();
   const int listSize = neighborhoodData->NeighborhoodListSize();
 
   // faces of a cube as stored by exodus ordering:
@@ -727,7 +1112,7 @@ PeridigmNS::ExodusDiscretization::createNeighborhoodData(int neighborListSize, i
    memcpy(neighborhoodData->OwnedIDs(), &ownedLocalIds[0], numOwnedIds*sizeof(int));
    memcpy(neighborhoodData->NeighborhoodPtr(), &neighborhoodPtr[0], numOwnedIds*sizeof(int));
    neighborhoodData->SetNeighborhoodListSize(neighborListSize);
-   memcpy(neighborhoodData->NeighborhoodList(), neighborList, neighborListSize*sizeof(int));
+   memcpy(neighborhoodData->InterleavedNeighborhoodList(), neighborList, neighborListSize*sizeof(int));
    neighborhoodData = filterBonds(neighborhoodData);
 }
 
@@ -778,7 +1163,7 @@ PeridigmNS::ExodusDiscretization::filterBonds(Teuchos::RCP<PeridigmNS::Neighborh
   int* const neighborhoodPtr = neighborhoodData->NeighborhoodPtr();
 
   int numOwnedPoints = neighborhoodData->NumOwnedPoints();
-  int* const unfilteredNeighborhoodList = unfilteredNeighborhoodData->NeighborhoodList();
+  int* const unfilteredNeighborhoodList = unfilteredNeighborhoodData->InterleavedNeighborhoodList();
   int unfilteredNeighborhoodListIndex(0);
   for(int iID=0 ; iID<numOwnedPoints ; ++iID){
     int blockID = static_cast<int>(blockIDs[iID]);
@@ -799,7 +1184,7 @@ PeridigmNS::ExodusDiscretization::filterBonds(Teuchos::RCP<PeridigmNS::Neighborh
   }
 
   neighborhoodData->SetNeighborhoodListSize(neighborhoodListVec.size());
-  memcpy(neighborhoodData->NeighborhoodList(), &neighborhoodListVec[0], neighborhoodListVec.size()*sizeof(int));
+  memcpy(neighborhoodData->InterleavedNeighborhoodList(), &neighborhoodListVec[0], neighborhoodListVec.size()*sizeof(int));
 
   return neighborhoodData;
 }
@@ -911,60 +1296,26 @@ void PeridigmNS::ExodusDiscretization::getExodusMeshNodePositions(int globalNode
   return;
 }
 
-double PeridigmNS::ExodusDiscretization::computeMaxElementDimension()
+double PeridigmNS::ExodusDiscretization::computeMaxElementBoundingRadius()
 {
-  TEUCHOS_TEST_FOR_EXCEPT_MSG(!storeExodusMesh, "**** Error:  computeMaxElementDimension() called, but exodus information not stored.\n");
-  double length, volume, localMaxElementDimension(0.0);
-  double x, y, z;
-  int globalId, numNodes, numNodesInElement;
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(!storeExodusMesh, "**** Error:  computeMaxElementBoundingRadius() called, but exodus information not stored.\n");
+  double localMaxRadiusSquared(0.0);
   vector<double> nodeCoordinates;
-  const double pi = boost::math::constants::pi<double>();
-
   for(int iElem=0 ; iElem<oneDimensionalMap->NumMyElements() ; ++iElem){
-    globalId = oneDimensionalMap->GID(iElem);
-    getExodusMeshNodePositions(globalId, nodeCoordinates);
-    numNodes = nodeCoordinates.size()/3;
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(numNodes != 8 &&
-                                numNodes != 4 &&
-                                numNodes != 1 &&
-                                numNodes != 10 &&
-                                numNodes != 20,
-                                "**** Invalid element topology.\n");
-    if(numNodes == 1){
-      // Sphere element
-      volume = (*cellVolume)[iElem];
-      length = pow( (3.0*volume)/(4.0*pi), 1.0/3.0 );
-    }
-    else{
-
-      // Consider 4- and 10-noded tets (treat either as 4-noded)
-      // Consider 10- and 20-noded hexes (treat either as 10-noded)
-      numNodesInElement = 4;
-      if(numNodes == 8 || numNodes == 20)
-        numNodesInElement = 8;
-
-      for(int i=0 ; i<numNodesInElement ; ++i){
-        for(int j=i ; j<numNodesInElement ; ++j){
-          if(i != j){
-            x = nodeCoordinates[i*3]   - nodeCoordinates[j*3];
-            y = nodeCoordinates[i*3+1] - nodeCoordinates[j*3+1];
-            z = nodeCoordinates[i*3+2] - nodeCoordinates[j*3+2];
-            length = x*x + y*y + z*z;
-            if(length > localMaxElementDimension)
-              localMaxElementDimension = length;
-          }
-        }
-      }
+    getExodusMeshNodePositions(oneDimensionalMap->GID(iElem), nodeCoordinates);
+    for(unsigned int i=0 ; i<nodeCoordinates.size()/3 ; ++i){
+      double x = nodeCoordinates[3*i]   - (*initialX)[3*iElem];
+      double y = nodeCoordinates[3*i+1] - (*initialX)[3*iElem+1];
+      double z = nodeCoordinates[3*i+2] - (*initialX)[3*iElem+2];
+      double radiusSquared = x*x + y*y + z*z;
+      if(radiusSquared > localMaxRadiusSquared)
+        localMaxRadiusSquared = radiusSquared;
     }
   }
-
-  localMaxElementDimension = sqrt(localMaxElementDimension);
-
-  // Parallel communication to determine overall maximum element dimension
-  double globalMaxElementDimension;
-  comm->MaxAll(&localMaxElementDimension, &globalMaxElementDimension, 1);
-
-  return globalMaxElementDimension;
+  double localMaxRadius = sqrt(localMaxRadiusSquared);
+  double globalMaxRadius;
+  comm->MaxAll(&localMaxRadius, &globalMaxRadius, 1);
+  return globalMaxRadius;
 }
 
 void PeridigmNS::ExodusDiscretization::removeNonintersectingNeighborsFromNeighborList(Teuchos::RCP<Epetra_Vector> x,
@@ -974,71 +1325,121 @@ void PeridigmNS::ExodusDiscretization::removeNonintersectingNeighborsFromNeighbo
                                                                                       int& neighborListSize,
                                                                                       int*& neighborList)
 {
-  int refinedNumNeighbors, numNeighbors, neighborLocalId, neighborGlobalId;
-  unsigned int refinedNumNeighborsIndex;
-  double horizon;
-  SphereIntersection sphereIntersection;
-  vector<double> exodusNodePositions;
-  vector<double> sphereCenter(3);
+  int numNeighbors, neighborLocalId, neighborGlobalId;
   vector<int> refinedNeighborGlobalIdList;
   set<int> refinedGlobalIds;
   refinedNeighborGlobalIdList.reserve(neighborListSize);
 
+  // Cache the node positions and a bounding sphere for each owned and ghosted element
+  // The bounding sphere is centered at the average of the nodes and passes through the farthest node
+  int numOverlapElements = overlapMap->NumMyElements();
+  vector<double> elementNodePositions(24*numOverlapElements);
+  vector<double> boundingSphereCenters(3*numOverlapElements, 0.0);
+  vector<double> boundingSphereRadii(numOverlapElements, 0.0);
+  vector<double> exodusNodePositions;
+  for(int iElem=0 ; iElem<numOverlapElements ; ++iElem){
+    getExodusMeshNodePositions(overlapMap->GID(iElem), exodusNodePositions);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(exodusNodePositions.size()/3 != 8,
+                                "\n**** Error:  Element-horizon intersection calculations currently enabled only for hexahedron elements.\n");
+    double* nodes = &elementNodePositions[24*iElem];
+    double* center = &boundingSphereCenters[3*iElem];
+    for(int i=0 ; i<24 ; ++i)
+      nodes[i] = exodusNodePositions[i];
+    for(int i=0 ; i<8 ; ++i){
+      center[0] += nodes[3*i]/8.0;
+      center[1] += nodes[3*i+1]/8.0;
+      center[2] += nodes[3*i+2]/8.0;
+    }
+    double radiusSquared(0.0);
+    for(int i=0 ; i<8 ; ++i){
+      double distanceSquared = (nodes[3*i]   - center[0])*(nodes[3*i]   - center[0])
+        + (nodes[3*i+1] - center[1])*(nodes[3*i+1] - center[1])
+        + (nodes[3*i+2] - center[2])*(nodes[3*i+2] - center[2]);
+      if(distanceSquared > radiusSquared)
+        radiusSquared = distanceSquared;
+    }
+    boundingSphereRadii[iElem] = sqrt(radiusSquared);
+  }
+
+  // Locate the start of each owned element's entry in the neighbor list
+  int numOwnedElements = ownedMap->NumMyElements();
+  vector<int> neighborListOffsets(numOwnedElements);
   int index = 0;
-  int elemLocalId = 0;
-  while(index < neighborListSize){
-    numNeighbors = neighborList[index++];
-    refinedNumNeighborsIndex = refinedNeighborGlobalIdList.size();
-    refinedNumNeighbors = 0;
-    refinedNeighborGlobalIdList.push_back(refinedNumNeighbors);
-    for(int iNeighbor=0 ; iNeighbor<numNeighbors ; ++iNeighbor){
-      neighborLocalId = neighborList[index++];
-      neighborGlobalId = overlapMap->GID(neighborLocalId);
+  for(int elemLocalId=0 ; elemLocalId<numOwnedElements ; ++elemLocalId){
+    neighborListOffsets[elemLocalId] = index;
+    index += 1 + neighborList[index];
+  }
 
-      // Determine if the element intersects the sphere
+  // Determine which bonds to keep; elements are processed independently so the loop is threaded
+  // The bounding spheres settle most pairs, the exact test is needed only for elements that straddle the horizon
+  const double tolerance = 1.0e-12;
+  vector<char> keepBond(neighborListSize, 0);
+  // Exceptions may not propagate out of the threaded loop, so the first error caught is rethrown afterwards
+  string errorMessage;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+  for(int elemLocalId=0 ; elemLocalId<numOwnedElements ; ++elemLocalId){
+    try{
+      vector<double> sphereCenter(3);
       sphereCenter[0] = (*x)[3*elemLocalId];
       sphereCenter[1] = (*x)[3*elemLocalId+1];
       sphereCenter[2] = (*x)[3*elemLocalId+2];
-      getExodusMeshNodePositions(neighborGlobalId, exodusNodePositions);
-      horizon = (*searchRadii)[elemLocalId];
-   
-      TEUCHOS_TEST_FOR_EXCEPT_MSG(exodusNodePositions.size()/3 != 8,
-                                  "\n**** Error:  Element-horizon intersection calculations currently enabled only for hexahedron elements.\n");
-
+      double horizon = (*searchRadii)[elemLocalId];
+      int offset = neighborListOffsets[elemLocalId];
+      int numElemNeighbors = neighborList[offset];
+      for(int iNeighbor=0 ; iNeighbor<numElemNeighbors ; ++iNeighbor){
+        int neighborId = neighborList[offset + 1 + iNeighbor];
+        const double* center = &boundingSphereCenters[3*neighborId];
+        double distance = sqrt( (sphereCenter[0] - center[0])*(sphereCenter[0] - center[0])
+                                + (sphereCenter[1] - center[1])*(sphereCenter[1] - center[1])
+                                + (sphereCenter[2] - center[2])*(sphereCenter[2] - center[2]) );
+        SphereIntersection sphereIntersection;
 #ifdef DEBUGGING_BACKWARDS_COMPATIBILITY_NEIGHBORHOOD_LIST
-      double centroid[3];
-      centroid[0] = 0.0;
-      centroid[1] = 0.0;
-      centroid[2] = 0.0;
-      for(int i=0 ; i<8 ; ++i){
-        centroid[0] += exodusNodePositions[3*i];
-        centroid[1] += exodusNodePositions[3*i+1];
-        centroid[2] += exodusNodePositions[3*i+2];
-      }
-      centroid[0] /= 8.0;
-      centroid[1] /= 8.0;
-      centroid[2] /= 8.0;
-
-      double distanceSquared = (sphereCenter[0] - centroid[0])*(sphereCenter[0] - centroid[0])
-        + (sphereCenter[1] - centroid[1])*(sphereCenter[1] - centroid[1])
-        + (sphereCenter[2] - centroid[2])*(sphereCenter[2] - centroid[2]);
-
-      if(distanceSquared > horizon*horizon)
-        sphereIntersection = OUTSIDE_SPHERE;
-      else
-        sphereIntersection = INSIDE_SPHERE;
+        if(distance*distance > horizon*horizon)
+          sphereIntersection = OUTSIDE_SPHERE;
+        else
+          sphereIntersection = INSIDE_SPHERE;
 #else
-      sphereIntersection = hexahedronSphereIntersection(&exodusNodePositions[0], sphereCenter, horizon);
+        double radius = boundingSphereRadii[neighborId];
+        if(distance > (horizon + radius)*(1.0 + tolerance))
+          sphereIntersection = OUTSIDE_SPHERE;
+        else if(distance + radius < horizon*(1.0 - tolerance))
+          sphereIntersection = INSIDE_SPHERE;
+        else
+          sphereIntersection = hexahedronSphereIntersection(&elementNodePositions[24*neighborId], sphereCenter, horizon);
+#endif
+        if(sphereIntersection != OUTSIDE_SPHERE)
+          keepBond[offset + 1 + iNeighbor] = 1;
+      }
+    }
+    catch(const std::exception& e){
+#ifdef _OPENMP
+#pragma omp critical(removeNonintersectingNeighborsError)
 #endif
+      {
+        if(errorMessage.empty())
+          errorMessage = e.what();
+      }
+    }
+  }
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(!errorMessage.empty(), errorMessage);
 
-      if(sphereIntersection != OUTSIDE_SPHERE){
+  index = 0;
+  while(index < neighborListSize){
+    numNeighbors = neighborList[index++];
+    unsigned int refinedNumNeighborsIndex = refinedNeighborGlobalIdList.size();
+    int refinedNumNeighbors = 0;
+    refinedNeighborGlobalIdList.push_back(refinedNumNeighbors);
+    for(int iNeighbor=0 ; iNeighbor<numNeighbors ; ++iNeighbor, ++index){
+      if(keepBond[index]){
+        neighborGlobalId = overlapMap->GID(neighborList[index]);
         refinedNeighborGlobalIdList.push_back(neighborGlobalId);
         refinedGlobalIds.insert(neighborGlobalId);
         refinedNumNeighbors += 1;
       }
     }
     refinedNeighborGlobalIdList[refinedNumNeighborsIndex] = refinedNumNeighbors;
-    elemLocalId += 1;
   }
 
   // Create new overlap map and neighborlist based on refinedNeighborGlobalIdList
@@ -124,8 +124,8 @@ namespace PeridigmNS {
 
   private:
 
-    //! Compute the maximum element dimension.
-    double computeMaxElementDimension();
+    //! Compute the maximum distance from an element's sphere position to any of its nodes.
+    double computeMaxElementBoundingRadius();
 
     //! Private to prohibit copying
     ExodusDiscretization(const ExodusDiscretization&);
@@ -136,6 +136,14 @@ namespace PeridigmNS {
     //! Loads mesh data into Epetra_Vectors (initial positions, volumes, block ids) and stores original Exodus node locations and connectivity.
     void loadData(const std::string& meshFileName);
 
+    /*! \brief Loads a single serial Exodus file on any number of processors.
+     *
+     *  Each processor reads a contiguous range of the elements, nodes, and node-set entries, the node coordinates
+     *  needed by its elements are exchanged in memory, and the resulting spheres are load balanced with Zoltan.
+     *  This replaces the pre-split mesh.g.N.i files that loadData() requires when running in parallel.
+     */
+    void loadDataInParallel(const std::string& meshFileName);
+
   protected:
 
     template<class T>
@@ -197,6 +205,9 @@ namespace PeridigmNS {
     //! Vector containing the block ID of each element
     Teuchos::RCP<Epetra_Vector> blockID;
 
+    //! Boolean flag for decomposing a serial exodus file in memory instead of reading pre-split files
+    bool decomposeSerialMesh;
+
     //! Boolean flag for storing exodus mesh
     bool storeExodusMesh;
 
@@ -209,6 +220,9 @@ namespace PeridigmNS {
     //! Maximum element dimension of the original exodus mesh
     double maxElementDimension;
 
+    //! Maximum distance from a sphere position to a node of its original exodus element
+    double maxElementBoundingRadius;
+
     //! Vector containing node positions in the initial hex/tet mesh
     Teuchos::RCP<Epetra_Vector> exodusMeshNodePositions;
 
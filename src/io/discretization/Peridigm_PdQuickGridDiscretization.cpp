@@ -51,6 +51,7 @@
 #include "PdZoltan.h"
 #include <vector>
 #include <sstream>
+#include <climits>
 
 using namespace std;
 using std::tr1::shared_ptr;
@@ -230,6 +231,8 @@ QUICKGRID::Data PeridigmNS::PdQuickGridDiscretization::getDiscretization(const T
 
     // Create abstract decomposition iterator
     QUICKGRID::TensorProduct3DMeshGenerator cellPerProcIter(numPID,horizon,xSpec,ySpec,zSpec,neighborhoodType);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(cellPerProcIter.getNumGlobalCells() > static_cast<size_t>(INT_MAX),
+                                "**** Error:  TensorProduct3DMeshGenerator creates more points than can be indexed by 32-bit global IDs.\n");
     decomp =  QUICKGRID::getDiscretization(myPID, cellPerProcIter);
     // Load balance and write new decomposition
 #ifdef HAVE_MPI
@@ -271,6 +274,8 @@ QUICKGRID::Data PeridigmNS::PdQuickGridDiscretization::getDiscretization(const T
 
     // Create abstract decomposition iterator
     QUICKGRID::TensorProductCylinderMeshGenerator cellPerProcIter(numPID, horizon,ring2dSpec, axisSpec,neighborhoodType);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(cellPerProcIter.getNumGlobalCells() > static_cast<size_t>(INT_MAX),
+                                "**** Error:  TensorProductCylinderMeshGenerator creates more points than can be indexed by 32-bit global IDs.\n");
     decomp =  QUICKGRID::getDiscretization(myPID, cellPerProcIter);
     // Load balance and write new decomposition
 #ifdef HAVE_MPI
@@ -327,7 +332,7 @@ PeridigmNS::PdQuickGridDiscretization::createNeighborhoodData(const QUICKGRID::D
  		  decomp.neighborhoodPtr.get(),
  		  decomp.numPoints*sizeof(int));
    neighborhoodData->SetNeighborhoodListSize(decomp.sizeNeighborhoodList);
-   memcpy(neighborhoodData->NeighborhoodList(),
+   memcpy(neighborhoodData->InterleavedNeighborhoodList(),
 		  Discretization::getLocalNeighborList(decomp, *oneDimensionalOverlapMap).get(),
  		  decomp.sizeNeighborhoodList*sizeof(int));
 }
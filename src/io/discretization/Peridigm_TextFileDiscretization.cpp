@@ -46,6 +46,7 @@
 //@HEADER
 
 #include "Peridigm_TextFileDiscretization.hpp"
+#include "Peridigm_BinaryDiscretizationFile.hpp"
 #include "Peridigm_HorizonManager.hpp"
 #include "NeighborhoodList.h"
 #include "PdZoltan.h"
@@ -61,8 +62,14 @@
 
 #include <sstream>
 #include <fstream>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 
-#include <boost/algorithm/string/trim.hpp>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace std;
 
@@ -78,7 +85,8 @@ PeridigmNS::TextFileDiscretization::TextFileDiscretization(const Teuchos::RCP<co
   bondFilterCommand("None"),
   comm(epetra_comm)
 {
-  TEUCHOS_TEST_FOR_EXCEPT_MSG(params->get<string>("Type") != "Text File", "Invalid Type in TextFileDiscretization");
+  string type = params->get<string>("Type");
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(type != "Text File" && type != "Binary File", "Invalid Type in TextFileDiscretization");
 
   string meshFileName = params->get<string>("Input Mesh File");
   if(params->isParameter("Omit Bonds Between Blocks"))
@@ -104,7 +112,7 @@ PeridigmNS::TextFileDiscretization::TextFileDiscretization(const Teuchos::RCP<co
   int* oneDimensionalMapGlobalElements = oneDimensionalMap->MyGlobalElements();
   int* myGlobalElements = new int[numMyElementsUpperBound];
   int* elementSizeList = new int[numMyElementsUpperBound];
-  int* const neighborhood = neighborhoodData->NeighborhoodList();
+  int* const neighborhood = neighborhoodData->InterleavedNeighborhoodList();
   int neighborhoodIndex = 0;
   int numPointsWithZeroNeighbors = 0;
   for(int i=0 ; i<neighborhoodData->NumOwnedPoints() ; ++i){
@@ -164,78 +172,118 @@ QUICKGRID::Data PeridigmNS::TextFileDiscretization::getDecomp(const string& text
   vector<double> coordinates;
   vector<double> volumes;
   vector<int> blockIds;
+  vector<int> globalIds;
+  set<int> uniqueBlockIds;
+  int numElements(0);
+  int dimension = 3;
+  QUICKGRID::Data decomp;
+  Teuchos::RCP<BinaryDiscretizationFile> binaryFile;
+
+  if(params->get<string>("Type") == "Binary File"){
+
+    // Every processor maps the file and copies its share of the points directly into the decomp arrays
+    binaryFile = Teuchos::rcp(new BinaryDiscretizationFile(textFileName));
+    int numFilePoints = binaryFile->numPoints();
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(numFilePoints < 1, "**** Error reading binary discretization file, no data found.\n");
+
+    // Use the stored partition if it was created for this number of processors, otherwise take a contiguous slice
+    int firstPoint(0);
+    const int32_t* partition = binaryFile->partition();
+    if(partition != NULL && binaryFile->numPartitions() == numPID){
+      for(int i=0 ; i<numFilePoints ; ++i){
+        if(partition[i] == myPID)
+          globalIds.push_back(i);
+      }
+      numElements = static_cast<int>(globalIds.size());
+    }
+    else{
+      firstPoint = static_cast<int>((static_cast<long long>(numFilePoints)*myPID)/numPID);
+      numElements = static_cast<int>((static_cast<long long>(numFilePoints)*(myPID + 1))/numPID) - firstPoint;
+      globalIds.resize(numElements);
+      for(int i=0 ; i<numElements ; ++i)
+        globalIds[i] = firstPoint + i;
+    }
 
-  // Read the text file on the root processor
-  if(myPID == 0){
-    ifstream inFile(textFileName.c_str());
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(!inFile.is_open(), "**** Error opening discretization text file.\n");
-    while(inFile.good()){
-      string str;
-      getline(inFile, str);
-      boost::trim(str);
-      // Ignore comment lines, otherwise parse
-      if( !(str[0] == '#' || str[0] == '/' || str[0] == '*' || str.size() == 0) ){
-        istringstream iss(str);
-        vector<double> data;
-        copy(istream_iterator<double>(iss),
-             istream_iterator<double>(),
-             back_inserter<vector<double> >(data));
-        // Check for obvious problems with the data
-        if(data.size() != 5){
-          string msg = "\n**** Error parsing text file, invalid line: " + str + "\n";
-          TEUCHOS_TEST_FOR_EXCEPT_MSG(data.size() != 5, msg);
-        }
-        // Store the coordinates, block id, and volumes
-        coordinates.push_back(data[0]);
-        coordinates.push_back(data[1]);
-        coordinates.push_back(data[2]);
-        blockIds.push_back(static_cast<int>(data[3]));
-        volumes.push_back(data[4]);
+    decomp = QUICKGRID::allocatePdGridData(numElements, dimension);
+    blockIds.resize(numElements);
+    const double* fileX = binaryFile->coordinates();
+    const double* fileVolume = binaryFile->volumes();
+    const int32_t* fileBlockIds = binaryFile->blockIds();
+    if(partition != NULL && binaryFile->numPartitions() == numPID){
+      double* x = decomp.myX.get();
+      double* volume = decomp.cellVolume.get();
+      for(int i=0 ; i<numElements ; ++i){
+        int fileIndex = globalIds[i];
+        x[3*i]     = fileX[3*fileIndex];
+        x[3*i + 1] = fileX[3*fileIndex + 1];
+        x[3*i + 2] = fileX[3*fileIndex + 2];
+        volume[i] = fileVolume[fileIndex];
+        blockIds[i] = fileBlockIds[fileIndex];
       }
     }
-    inFile.close();
+    else if(numElements > 0){
+      memcpy(decomp.myX.get(), fileX + 3*firstPoint, 3*numElements*sizeof(double));
+      memcpy(decomp.cellVolume.get(), fileVolume + firstPoint, numElements*sizeof(double));
+      for(int i=0 ; i<numElements ; ++i)
+        blockIds[i] = fileBlockIds[firstPoint + i];
+    }
+    if(numElements > 0)
+      memcpy(decomp.myGlobalIDs.get(), &globalIds[0], numElements*sizeof(int));
+
+    for(int i=0 ; i<numElements ; ++i)
+      uniqueBlockIds.insert(blockIds[i]);
   }
+  else{
 
-  int numElements = static_cast<int>(blockIds.size());
-  TEUCHOS_TEST_FOR_EXCEPT_MSG(myPID == 0 && numElements < 1, "**** Error reading discretization text file, no data found.\n");
+    // Each processor parses its own byte range of the text file
+    readTextFile(textFileName, coordinates, volumes, blockIds);
+
+    numElements = static_cast<int>(blockIds.size());
+    int numGlobalTextElements;
+    comm->SumAll(&numElements, &numGlobalTextElements, 1);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(numGlobalTextElements < 1, "**** Error reading discretization text file, no data found.\n");
 
-  // Record the block ids on the root processor
-  set<int> uniqueBlockIds;
-  if(myPID == 0){
     for(unsigned int i=0 ; i<blockIds.size() ; ++i)
       uniqueBlockIds.insert(blockIds[i]);
+
+    // Create list of global ids, numbering the points in the order in which they appear in the file
+    int lastGlobalId;
+    comm->ScanSum(&numElements, &lastGlobalId, 1);
+    globalIds.resize(numElements);
+    for(unsigned int i=0 ; i<globalIds.size() ; ++i)
+      globalIds[i] = lastGlobalId - numElements + i;
+
+    // Copy data into a decomp object
+    decomp = QUICKGRID::allocatePdGridData(numElements, dimension);
+    if(numElements > 0){
+      memcpy(decomp.myGlobalIDs.get(), &globalIds[0], numElements*sizeof(int));
+      memcpy(decomp.cellVolume.get(), &volumes[0], numElements*sizeof(double));
+      memcpy(decomp.myX.get(), &coordinates[0], 3*numElements*sizeof(double));
+    }
   }
 
   // Broadcast necessary data from root processor
   Teuchos::RCP<const Teuchos::Comm<int> > teuchosComm = Teuchos::createMpiComm<int>(Teuchos::opaqueWrapper<MPI_Comm>(MPI_COMM_WORLD));
   int numGlobalElements;
   reduceAll(*teuchosComm, Teuchos::REDUCE_SUM, 1, &numElements, &numGlobalElements);
+  decomp.globalNumPoints = numGlobalElements;
 
   // Broadcast the unique block ids so that all processors are aware of the full block list
   // This is necessary because if a processor does not have any elements for a given block, it will be unaware the
   // given block exists, which causes problems downstream
   int numLocalUniqueBlockIds = static_cast<int>( uniqueBlockIds.size() );
-  int numGlobalUniqueBlockIds;
-  reduceAll(*teuchosComm, Teuchos::REDUCE_SUM, 1, &numLocalUniqueBlockIds, &numGlobalUniqueBlockIds);
-  vector<int> uniqueLocalBlockIds(numGlobalUniqueBlockIds, 0);
-  int index = 0;
+  int numGatheredBlockIds, lastGatheredBlockIdIndex;
+  reduceAll(*teuchosComm, Teuchos::REDUCE_SUM, 1, &numLocalUniqueBlockIds, &numGatheredBlockIds);
+  comm->ScanSum(&numLocalUniqueBlockIds, &lastGatheredBlockIdIndex, 1);
+  vector<int> localGatheredBlockIds(numGatheredBlockIds, 0);
+  int index = lastGatheredBlockIdIndex - numLocalUniqueBlockIds;
   for(set<int>::const_iterator it = uniqueBlockIds.begin() ; it != uniqueBlockIds.end() ; it++)
-    uniqueLocalBlockIds[index++] = *it;
-  vector<int> uniqueGlobalBlockIds(numGlobalUniqueBlockIds);  
-  reduceAll(*teuchosComm, Teuchos::REDUCE_SUM, numGlobalUniqueBlockIds, &uniqueLocalBlockIds[0], &uniqueGlobalBlockIds[0]);
-
-  // Create list of global ids
-  vector<int> globalIds(numElements);
-  for(unsigned int i=0 ; i<globalIds.size() ; ++i)
-    globalIds[i] = i;
-
-  // Copy data into a decomp object
-  int dimension = 3;
-  QUICKGRID::Data decomp = QUICKGRID::allocatePdGridData(numElements, dimension);
-  decomp.globalNumPoints = numGlobalElements;
-  memcpy(decomp.myGlobalIDs.get(), &globalIds[0], numElements*sizeof(int)); 
-  memcpy(decomp.cellVolume.get(), &volumes[0], numElements*sizeof(double)); 
-  memcpy(decomp.myX.get(), &coordinates[0], 3*numElements*sizeof(double));
+    localGatheredBlockIds[index++] = *it;
+  vector<int> gatheredBlockIds(numGatheredBlockIds);
+  if(numGatheredBlockIds > 0)
+    reduceAll(*teuchosComm, Teuchos::REDUCE_SUM, numGatheredBlockIds, &localGatheredBlockIds[0], &gatheredBlockIds[0]);
+  set<int> gatheredBlockIdSet(gatheredBlockIds.begin(), gatheredBlockIds.end());
+  vector<int> uniqueGlobalBlockIds(gatheredBlockIdSet.begin(), gatheredBlockIdSet.end());
 
   // Create a blockID vector in the current configuration
   // That is, the configuration prior to load balancing
@@ -334,9 +382,122 @@ QUICKGRID::Data PeridigmNS::TextFileDiscretization::getDecomp(const string& text
   Epetra_Import horizonImporter(horizonForEachPoint->Map(), rebalancedHorizonForEachPoint->Map());
   horizonForEachPoint->Import(*rebalancedHorizonForEachPoint, horizonImporter, Insert);
 
+  // Node sets stored in a binary discretization file, restricted to the points owned after load balancing
+  if(!binaryFile.is_null()){
+    nodeSetIds = Teuchos::rcp< map<string, int> >(new map<string, int>() );
+    for(int i=0 ; i<binaryFile->numNodeSets() ; ++i){
+      const string& nodeSetName = binaryFile->nodeSetName(i);
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(nodeSets->find(nodeSetName) != nodeSets->end(), "**** Duplicate node set found: " + nodeSetName + "\n");
+      vector<int>& nodeSet = (*nodeSets)[nodeSetName];
+      (*nodeSetIds)[nodeSetName] = binaryFile->nodeSetId(i);
+      const int32_t* nodeSetGlobalIds = binaryFile->nodeSet(i);
+      for(int j=0 ; j<binaryFile->nodeSetSize(i) ; ++j){
+        if(oneDimensionalMap->MyGID(nodeSetGlobalIds[j]))
+          nodeSet.push_back(nodeSetGlobalIds[j]);
+      }
+    }
+  }
+
   return decomp;
 }
 
+void PeridigmNS::TextFileDiscretization::readTextFile(const string& textFileName,
+                                                      vector<double>& coordinates,
+                                                      vector<double>& volumes,
+                                                      vector<int>& blockIds)
+{
+  // Every processor maps the file; only the pages in this processor's byte range are touched
+  int fileDescriptor = open(textFileName.c_str(), O_RDONLY);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(fileDescriptor < 0, "**** Error opening discretization text file.\n");
+  struct stat fileStatus;
+  int statReturnCode = fstat(fileDescriptor, &fileStatus);
+  size_t fileSize = statReturnCode == 0 ? static_cast<size_t>(fileStatus.st_size) : 0;
+  if(fileSize == 0){
+    close(fileDescriptor);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(statReturnCode != 0, "**** Error reading the size of discretization text file.\n");
+    return;
+  }
+  void* mappedData = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+  close(fileDescriptor);
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(mappedData == MAP_FAILED, "**** Error memory mapping discretization text file.\n");
+  const char* text = static_cast<const char*>(mappedData);
+
+  // Split the file into equal byte ranges, then move the boundaries forward to the start of the next line so
+  // that each line is parsed by exactly one processor
+  size_t rangeBegin = static_cast<size_t>((static_cast<unsigned long long>(fileSize)*myPID)/numPID);
+  size_t rangeEnd = static_cast<size_t>((static_cast<unsigned long long>(fileSize)*(myPID + 1))/numPID);
+  size_t begin = rangeBegin;
+  if(begin > 0){
+    const char* newline = static_cast<const char*>(memchr(text + begin - 1, '\n', fileSize - begin + 1));
+    begin = newline == NULL ? fileSize : static_cast<size_t>(newline - text) + 1;
+  }
+  size_t end = rangeEnd;
+  if(end > 0 && end < fileSize){
+    const char* newline = static_cast<const char*>(memchr(text + end - 1, '\n', fileSize - end + 1));
+    end = newline == NULL ? fileSize : static_cast<size_t>(newline - text) + 1;
+  }
+
+  // Rough reservation assuming lines of about 60 characters
+  size_t estimatedNumPoints = (end > begin ? end - begin : 0)/60 + 1;
+  coordinates.reserve(3*estimatedNumPoints);
+  volumes.reserve(estimatedNumPoints);
+  blockIds.reserve(estimatedNumPoints);
+
+  string lastLine;
+  size_t lineBegin = begin;
+  while(lineBegin < end){
+    const char* newline = static_cast<const char*>(memchr(text + lineBegin, '\n', end - lineBegin));
+    size_t lineEnd = newline == NULL ? end : static_cast<size_t>(newline - text);
+    const char* line = text + lineBegin;
+    const char* lineStop = text + lineEnd;
+    // strtod() requires a terminator, which the mapped file does not provide if the last line has no newline
+    if(newline == NULL){
+      lastLine.assign(line, lineStop);
+      line = lastLine.c_str();
+      lineStop = line + lastLine.size();
+    }
+    lineBegin = lineEnd + 1;
+
+    while(line < lineStop && isspace(static_cast<unsigned char>(*line)))
+      ++line;
+    // Ignore comment lines, otherwise parse
+    if(line == lineStop || *line == '#' || *line == '/' || *line == '*')
+      continue;
+    double data[5];
+    int numValues = 0;
+    const char* position = line;
+    while(numValues < 6){
+      // Skip the whitespace here so that strtod() never reads past the end of the line
+      while(position < lineStop && isspace(static_cast<unsigned char>(*position)))
+        ++position;
+      if(position == lineStop)
+        break;
+      char* parseEnd;
+      double value = strtod(position, &parseEnd);
+      if(parseEnd == position)
+        break;
+      if(numValues < 5)
+        data[numValues] = value;
+      numValues++;
+      position = parseEnd;
+    }
+    // Check for obvious problems with the data
+    if(numValues != 5){
+      string msg = "\n**** Error parsing text file, invalid line: " + string(line, lineStop) + "\n";
+      munmap(mappedData, fileSize);
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(numValues != 5, msg);
+    }
+    // Store the coordinates, block id, and volumes
+    coordinates.push_back(data[0]);
+    coordinates.push_back(data[1]);
+    coordinates.push_back(data[2]);
+    blockIds.push_back(static_cast<int>(data[3]));
+    volumes.push_back(data[4]);
+  }
+
+  munmap(mappedData, fileSize);
+}
+
 void
 PeridigmNS::TextFileDiscretization::createMaps(const QUICKGRID::Data& decomp)
 {
@@ -375,7 +536,7 @@ PeridigmNS::TextFileDiscretization::createNeighborhoodData(const QUICKGRID::Data
  		 decomp.neighborhoodPtr.get(),
  		 decomp.numPoints*sizeof(int));
    neighborhoodData->SetNeighborhoodListSize(decomp.sizeNeighborhoodList);
-   memcpy(neighborhoodData->NeighborhoodList(),
+   memcpy(neighborhoodData->InterleavedNeighborhoodList(),
  		 Discretization::getLocalNeighborList(decomp, *oneDimensionalOverlapMap).get(),
  		 decomp.sizeNeighborhoodList*sizeof(int));
    neighborhoodData = filterBonds(neighborhoodData);
@@ -428,7 +589,7 @@ PeridigmNS::TextFileDiscretization::filterBonds(Teuchos::RCP<PeridigmNS::Neighbo
   int* const neighborhoodPtr = neighborhoodData->NeighborhoodPtr();
 
   int numOwnedPoints = neighborhoodData->NumOwnedPoints();
-  int* const unfilteredNeighborhoodList = unfilteredNeighborhoodData->NeighborhoodList();
+  int* const unfilteredNeighborhoodList = unfilteredNeighborhoodData->InterleavedNeighborhoodList();
   int unfilteredNeighborhoodListIndex(0);
   for(int iID=0 ; iID<numOwnedPoints ; ++iID){
     int blockID = static_cast<int>(blockIDs[iID]);
@@ -449,7 +610,7 @@ PeridigmNS::TextFileDiscretization::filterBonds(Teuchos::RCP<PeridigmNS::Neighbo
   }
 
   neighborhoodData->SetNeighborhoodListSize(neighborhoodListVec.size());
-  memcpy(neighborhoodData->NeighborhoodList(), &neighborhoodListVec[0], neighborhoodListVec.size()*sizeof(int));
+  memcpy(neighborhoodData->InterleavedNeighborhoodList(), &neighborhoodListVec[0], neighborhoodListVec.size()*sizeof(int));
 
   return neighborhoodData;
 }
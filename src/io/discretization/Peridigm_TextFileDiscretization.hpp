@@ -55,7 +55,11 @@
 
 namespace PeridigmNS {
 
-  //! Discretization class that creates discretization from a text file containing node locations, volumes, and block ids.
+  /*! \brief Discretization class that creates discretization from a text file containing node locations, volumes, and block ids.
+   *
+   *  The same data may instead be supplied as a native binary file (Type "Binary File"), which every processor memory maps
+   *  and reads its share of directly.  Binary files may also carry node sets and an initial partition of the points.
+   */
   class TextFileDiscretization : public PeridigmNS::Discretization {
 
   public:
@@ -123,10 +127,20 @@ namespace PeridigmNS {
     //! Private to prohibit copying
     TextFileDiscretization& operator=(const TextFileDiscretization&);
 
-    //! Creates a discretization object based on data read from a text file.
+    //! Creates a discretization object based on data read from a text file or a native binary file.
     QUICKGRID::Data getDecomp(const std::string& textFileName,
                               const Teuchos::RCP<Teuchos::ParameterList>& params);
 
+    /*! \brief Reads this processor's share of a text discretization file.
+     *
+     *  The file is split into equal byte ranges that are aligned to line boundaries, so each processor parses
+     *  a contiguous run of lines.  The points are returned in file order.
+     */
+    void readTextFile(const std::string& textFileName,
+                      std::vector<double>& coordinates,
+                      std::vector<double>& volumes,
+                      std::vector<int>& blockIds);
+
   protected:
 
     template<class T>
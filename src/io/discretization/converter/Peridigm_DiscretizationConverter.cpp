@@ -0,0 +1,385 @@
+/*! \file Peridigm_DiscretizationConverter.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+//! Converts a text file or a serial Exodus mesh into a native binary discretization file (Type "Binary File").
+
+#include "Peridigm_BinaryDiscretizationFile.hpp"
+#include "Peridigm_GeometryUtils.hpp"
+#include <Teuchos_Assert.hpp>
+#include <boost/algorithm/string.hpp>
+#include <exodusII.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <set>
+
+using namespace std;
+
+namespace {
+
+  void printUsage(){
+    cout << "\nUsage: PeridigmDiscretizationConverter <input mesh> <output file> [options]\n\n"
+         << "  The input mesh is either a Peridigm text discretization (x y z block_id volume on each line) or a\n"
+         << "  serial Exodus II mesh (.g, .e, .exo, .gen) containing sphere, tet, or hex elements.\n\n"
+         << "  Options:\n"
+         << "    --partitions <n>          store a recursive coordinate bisection partition for n processors\n"
+         << "    --node-set <name> <file>  add a node set read from a text file of 1-based node numbers\n" << endl;
+  }
+
+  bool isComment(const string& str){
+    return str.size() == 0 || str[0] == '#' || str[0] == '/' || str[0] == '*';
+  }
+
+  void readTextFile(const string& fileName, vector<double>& coordinates, vector<double>& volumes, vector<int>& blockIds){
+    ifstream inFile(fileName.c_str());
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(!inFile.is_open(), "**** Error opening discretization text file " + fileName + "\n");
+    while(inFile.good()){
+      string str;
+      getline(inFile, str);
+      boost::trim(str);
+      if(!isComment(str)){
+        istringstream iss(str);
+        vector<double> data;
+        copy(istream_iterator<double>(iss), istream_iterator<double>(), back_inserter<vector<double> >(data));
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(data.size() != 5, "\n**** Error parsing text file, invalid line: " + str + "\n");
+        coordinates.push_back(data[0]);
+        coordinates.push_back(data[1]);
+        coordinates.push_back(data[2]);
+        blockIds.push_back(static_cast<int>(data[3]));
+        volumes.push_back(data[4]);
+      }
+    }
+  }
+
+  void readNodeSetFile(const string& fileName, int numPoints, vector<int>& nodeSet){
+    ifstream inFile(fileName.c_str());
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(!inFile.is_open(), "**** Error opening node set text file: " + fileName + "\n");
+    while(inFile.good()){
+      string str;
+      getline(inFile, str);
+      boost::trim(str);
+      if(!isComment(str)){
+        istringstream iss(str);
+        int nodeNumber;
+        while(iss >> nodeNumber){
+          TEUCHOS_TEST_FOR_EXCEPT_MSG(nodeNumber < 1 || nodeNumber > numPoints,
+                                      "**** Error:  Invalid node number in node set file " + fileName + "; node numbering must begin with 1.\n");
+          nodeSet.push_back(nodeNumber - 1);
+        }
+      }
+    }
+  }
+
+  void checkExodus(int retval, const string& function){
+    stringstream ss;
+    ss << "**** Error in PeridigmDiscretizationConverter, " << function << " returned error code " << retval << ".\n";
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(retval != 0, ss.str());
+  }
+
+  //! Converts the elements of a serial Exodus mesh to spheres in the same way as ExodusDiscretization.
+  void readExodusFile(const string& fileName,
+                      vector<double>& coordinates,
+                      vector<double>& volumes,
+                      vector<int>& blockIds,
+                      map< string, vector<int> >& nodeSets,
+                      map< string, int >& nodeSetIds){
+
+    int compWordSize = sizeof(double);
+    int ioWordSize = 0;
+    float exodusVersion;
+    int exodusFileId = ex_open(fileName.c_str(), EX_READ, &compWordSize, &ioWordSize, &exodusVersion);
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(exodusFileId < 0, "**** Error, unable to open Exodus file " + fileName + "\n");
+
+    int numDim, numNodes, numElem, numElemBlocks, numNodeSets, numSideSets;
+    char title[MAX_LINE_LENGTH];
+    checkExodus(ex_get_init(exodusFileId, title, &numDim, &numNodes, &numElem, &numElemBlocks, &numNodeSets, &numSideSets), "ex_get_init");
+
+    vector<double> nodeX(numNodes), nodeY(numNodes), nodeZ(numNodes);
+    checkExodus(ex_get_coord(exodusFileId, &nodeX[0], &nodeY[0], &nodeZ[0]), "ex_get_coord");
+
+    // The element ids become the point ids, so they must number the elements 1 through numElem
+    vector<int> elemIdMap(numElem);
+    checkExodus(ex_get_id_map(exodusFileId, EX_ELEM_MAP, &elemIdMap[0]), "ex_get_id_map");
+    vector<char> seen(numElem, 0);
+    for(int i=0 ; i<numElem ; ++i){
+      elemIdMap[i] -= 1; // Note the switch from 1-based indexing to 0-based indexing
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(elemIdMap[i] < 0 || elemIdMap[i] >= numElem || seen[elemIdMap[i]],
+                                  "**** Error, the element ids in " + fileName + " are not a permutation of 1 through the number of elements.\n");
+      seen[elemIdMap[i]] = 1;
+    }
+
+    coordinates.assign(3*numElem, 0.0);
+    volumes.assign(numElem, 0.0);
+    blockIds.assign(numElem, 0);
+
+    vector<int> elemBlockIds(numElemBlocks);
+    if(numElemBlocks > 0)
+      checkExodus(ex_get_elem_blk_ids(exodusFileId, &elemBlockIds[0]), "ex_get_elem_blk_ids");
+
+    vector< vector<int> > elementsThatNodeBelongsTo(numNodes);
+    int localElemId(0);
+    for(int iElemBlock=0 ; iElemBlock<numElemBlocks ; iElemBlock++){
+      int elemBlockId = elemBlockIds[iElemBlock];
+
+      // Block names are not stored in the binary file, Peridigm will refer to the block as block_<id>
+      char exodusElemBlockName[MAX_STR_LENGTH];
+      checkExodus(ex_get_name(exodusFileId, EX_ELEM_BLOCK, elemBlockId, exodusElemBlockName), "ex_get_name");
+      stringstream defaultName;
+      defaultName << "block_" << elemBlockId;
+      if(string(exodusElemBlockName).size() != 0 && string(exodusElemBlockName) != defaultName.str())
+        cout << "**** Warning, element block " << exodusElemBlockName << " will be named " << defaultName.str() << " in the binary file." << endl;
+
+      char elemType[MAX_STR_LENGTH];
+      int numElemThisBlock, numNodesPerElem, numAttributes;
+      checkExodus(ex_get_elem_block(exodusFileId, elemBlockId, elemType, &numElemThisBlock, &numNodesPerElem, &numAttributes), "ex_get_elem_block");
+      if(numElemThisBlock == 0)
+        continue;
+
+      string elemTypeString(elemType);
+      boost::to_upper(elemTypeString);
+      bool isSphere = elemTypeString == "SPHERE";
+      bool isTet = elemTypeString == "TET" || elemTypeString == "TETRA" || elemTypeString == "TET4" || elemTypeString == "TET10";
+      bool isHex = elemTypeString == "HEX" || elemTypeString == "HEX8" || elemTypeString == "HEX20";
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(!isSphere && !isTet && !isHex, "\n**** Error, unknown element type " + elemTypeString + ".\n");
+
+      vector<int> conn(numElemThisBlock*numNodesPerElem);
+      checkExodus(ex_get_elem_conn(exodusFileId, elemBlockId, &conn[0]), "ex_get_elem_conn");
+      vector<double> attributes;
+      if(isSphere){
+        attributes.resize(numElemThisBlock*numAttributes);
+        checkExodus(ex_get_elem_attr(exodusFileId, elemBlockId, &attributes[0]), "ex_get_elem_attr");
+      }
+
+      vector<double> nodeCoordinates(3*numNodesPerElem);
+      for(int iElem=0 ; iElem<numElemThisBlock ; iElem++, localElemId++){
+        for(int i=0 ; i<numNodesPerElem ; ++i){
+          int nodeId = conn[iElem*numNodesPerElem + i] - 1;
+          nodeCoordinates[3*i] = nodeX[nodeId];
+          nodeCoordinates[3*i+1] = nodeY[nodeId];
+          nodeCoordinates[3*i+2] = nodeZ[nodeId];
+          elementsThatNodeBelongsTo[nodeId].push_back(elemIdMap[localElemId]);
+        }
+        int pointId = elemIdMap[localElemId];
+        double volume(0.0);
+        double* coord = &coordinates[3*pointId];
+        if(isSphere){
+          coord[0] = nodeCoordinates[0];
+          coord[1] = nodeCoordinates[1];
+          coord[2] = nodeCoordinates[2];
+          volume = attributes[iElem*numAttributes + 1];
+        }
+        else if(isTet){
+          PeridigmNS::tetCentroidAndVolume(&nodeCoordinates[0], coord, &volume);
+        }
+        else{
+          PeridigmNS::hexCentroidAndVolume(&nodeCoordinates[0], coord, &volume);
+        }
+        volumes[pointId] = volume;
+        blockIds[pointId] = elemBlockId;
+      }
+    }
+
+    // Node sets are converted to the sphere mesh in the same way as ExodusDiscretization
+    if(numNodeSets > 0){
+      vector<int> exodusNodeSetIds(numNodeSets);
+      checkExodus(ex_get_node_set_ids(exodusFileId, &exodusNodeSetIds[0]), "ex_get_node_set_ids");
+      for(int i=0 ; i<numNodeSets ; ++i){
+        int nodeSetId = exodusNodeSetIds[i];
+        char exodusNodeSetName[MAX_STR_LENGTH];
+        checkExodus(ex_get_name(exodusFileId, EX_NODE_SET, nodeSetId, exodusNodeSetName), "ex_get_name");
+        string nodeSetName(exodusNodeSetName);
+        if(nodeSetName.size() == 0){
+          stringstream ss;
+          ss << "nodelist_" << nodeSetId;
+          nodeSetName = ss.str();
+        }
+        TEUCHOS_TEST_FOR_EXCEPT_MSG(nodeSets.find(nodeSetName) != nodeSets.end(), "**** Duplicate node set found: " + nodeSetName + "\n");
+        nodeSetIds[nodeSetName] = nodeSetId;
+        int numNodesInSet, numDistributionFactorsInSet;
+        checkExodus(ex_get_node_set_param(exodusFileId, nodeSetId, &numNodesInSet, &numDistributionFactorsInSet), "ex_get_node_set_param");
+        set<int> points;
+        if(numNodesInSet > 0){
+          vector<int> nodeSetNodeList(numNodesInSet);
+          checkExodus(ex_get_node_set(exodusFileId, nodeSetId, &nodeSetNodeList[0]), "ex_get_node_set");
+          for(int j=0 ; j<numNodesInSet ; ++j){
+            const vector<int>& elements = elementsThatNodeBelongsTo[nodeSetNodeList[j] - 1];
+            points.insert(elements.begin(), elements.end());
+          }
+        }
+        nodeSets[nodeSetName] = vector<int>(points.begin(), points.end());
+      }
+    }
+
+    checkExodus(ex_close(exodusFileId), "ex_close");
+  }
+
+  //! Assigns the points in [begin, end) to partitions firstPart through firstPart+numParts-1 by recursive coordinate bisection.
+  void recursiveCoordinateBisection(const vector<double>& coordinates,
+                                    vector<int>::iterator begin,
+                                    vector<int>::iterator end,
+                                    int firstPart,
+                                    int numParts,
+                                    vector<int>& partition){
+    if(numParts == 1){
+      for(vector<int>::iterator it = begin ; it != end ; ++it)
+        partition[*it] = firstPart;
+      return;
+    }
+    if(begin == end)
+      return;
+
+    // Cut along the longest side of the bounding box
+    double minX[3] = { coordinates[3*(*begin)], coordinates[3*(*begin)+1], coordinates[3*(*begin)+2] };
+    double maxX[3] = { minX[0], minX[1], minX[2] };
+    for(vector<int>::iterator it = begin ; it != end ; ++it){
+      for(int d=0 ; d<3 ; ++d){
+        minX[d] = min(minX[d], coordinates[3*(*it)+d]);
+        maxX[d] = max(maxX[d], coordinates[3*(*it)+d]);
+      }
+    }
+    int cutDimension = 0;
+    for(int d=1 ; d<3 ; ++d){
+      if(maxX[d] - minX[d] > maxX[cutDimension] - minX[cutDimension])
+        cutDimension = d;
+    }
+
+    int numLeftParts = numParts/2;
+    long long numPoints = end - begin;
+    vector<int>::iterator middle = begin + static_cast<long long>((numPoints*numLeftParts)/numParts);
+    vector< pair<double,int> > keys;
+    keys.reserve(numPoints);
+    for(vector<int>::iterator it = begin ; it != end ; ++it)
+      keys.push_back(make_pair(coordinates[3*(*it)+cutDimension], *it));
+    nth_element(keys.begin(), keys.begin() + (middle - begin), keys.end());
+    for(long long i=0 ; i<numPoints ; ++i)
+      *(begin + i) = keys[i].second;
+
+    recursiveCoordinateBisection(coordinates, begin, middle, firstPart, numLeftParts, partition);
+    recursiveCoordinateBisection(coordinates, middle, end, firstPart + numLeftParts, numParts - numLeftParts, partition);
+  }
+}
+
+int main(int argc, char* argv[]){
+
+  if(argc < 3){
+    printUsage();
+    return 1;
+  }
+
+  string inputFileName(argv[1]);
+  string outputFileName(argv[2]);
+  int numPartitions(0);
+  vector< pair<string,string> > nodeSetFiles;
+  for(int i=3 ; i<argc ; ++i){
+    string option(argv[i]);
+    if(option == "--partitions" && i+1 < argc){
+      numPartitions = atoi(argv[++i]);
+    }
+    else if(option == "--node-set" && i+2 < argc){
+      string name(argv[++i]);
+      string file(argv[++i]);
+      nodeSetFiles.push_back(make_pair(name, file));
+    }
+    else{
+      printUsage();
+      return 1;
+    }
+  }
+  if(numPartitions < 0){
+    printUsage();
+    return 1;
+  }
+
+  try{
+    vector<double> coordinates;
+    vector<double> volumes;
+    vector<int> blockIds;
+    map< string, vector<int> > nodeSets;
+    map< string, int > nodeSetIds;
+
+    string extension = inputFileName.substr(inputFileName.find_last_of('.') + 1);
+    boost::to_lower(extension);
+    if(extension == "g" || extension == "e" || extension == "exo" || extension == "gen")
+      readExodusFile(inputFileName, coordinates, volumes, blockIds, nodeSets, nodeSetIds);
+    else
+      readTextFile(inputFileName, coordinates, volumes, blockIds);
+    int numPoints = static_cast<int>(volumes.size());
+    TEUCHOS_TEST_FOR_EXCEPT_MSG(numPoints < 1, "**** Error, no points found in " + inputFileName + "\n");
+
+    for(unsigned int i=0 ; i<nodeSetFiles.size() ; ++i){
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(nodeSets.find(nodeSetFiles[i].first) != nodeSets.end(), "**** Duplicate node set found: " + nodeSetFiles[i].first + "\n");
+      readNodeSetFile(nodeSetFiles[i].second, numPoints, nodeSets[nodeSetFiles[i].first]);
+    }
+
+    vector<int> partition;
+    if(numPartitions > 0){
+      partition.resize(numPoints);
+      vector<int> points(numPoints);
+      for(int i=0 ; i<numPoints ; ++i)
+        points[i] = i;
+      recursiveCoordinateBisection(coordinates, points.begin(), points.end(), 0, numPartitions, partition);
+    }
+
+    PeridigmNS::writeBinaryDiscretizationFile(outputFileName, coordinates, volumes, blockIds, partition, numPartitions, nodeSets, nodeSetIds);
+
+    cout << "Wrote " << numPoints << " points";
+    if(!nodeSets.empty())
+      cout << " and " << nodeSets.size() << " node sets";
+    if(numPartitions > 0)
+      cout << " partitioned for " << numPartitions << " processors";
+    cout << " to " << outputFileName << endl;
+  }
+  catch(const std::exception& e){
+    cerr << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,170 @@
+/*! \file utPeridigm_BinaryDiscretizationFile.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include "Peridigm_BinaryDiscretizationFile.hpp"
+#include <Teuchos_UnitTestHarness.hpp>
+#include <Teuchos_UnitTestRepository.hpp>
+#include <Teuchos_GlobalMPISession.hpp>
+#include <cstdio>
+#include <fstream>
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+using namespace std;
+
+//! Write a small discretization with a partition and node sets and read it back through the memory-mapped reader.
+TEUCHOS_UNIT_TEST(BinaryDiscretizationFile, RoundTrip) {
+
+  string fileName("utPeridigm_BinaryDiscretizationFile_RoundTrip.pdbin");
+  int numPoints = 5;
+  vector<double> coordinates(3*numPoints), volumes(numPoints);
+  vector<int> blockIds(numPoints), partition(numPoints);
+  for(int i=0 ; i<numPoints ; ++i){
+    coordinates[3*i] = 0.5*i;
+    coordinates[3*i+1] = -1.0*i;
+    coordinates[3*i+2] = 2.0 + i;
+    volumes[i] = 0.125*(i+1);
+    blockIds[i] = 1 + i%2;
+    partition[i] = i < 3 ? 0 : 1;
+  }
+  map< string, vector<int> > nodeSets;
+  nodeSets["min_x"].push_back(0);
+  nodeSets["max_x"].push_back(3);
+  nodeSets["max_x"].push_back(4);
+  nodeSets["empty"] = vector<int>();
+  map< string, int > nodeSetIds;
+  nodeSetIds["max_x"] = 7;
+
+  writeBinaryDiscretizationFile(fileName, coordinates, volumes, blockIds, partition, 2, nodeSets, nodeSetIds);
+
+  {
+    BinaryDiscretizationFile file(fileName);
+    TEST_EQUALITY(file.numPoints(), numPoints);
+    for(int i=0 ; i<numPoints ; ++i){
+      TEST_EQUALITY(file.coordinates()[3*i], coordinates[3*i]);
+      TEST_EQUALITY(file.coordinates()[3*i+1], coordinates[3*i+1]);
+      TEST_EQUALITY(file.coordinates()[3*i+2], coordinates[3*i+2]);
+      TEST_EQUALITY(file.volumes()[i], volumes[i]);
+      TEST_EQUALITY(file.blockIds()[i], blockIds[i]);
+    }
+    TEST_EQUALITY(file.numPartitions(), 2);
+    TEST_ASSERT(file.partition() != NULL);
+    for(int i=0 ; i<numPoints ; ++i)
+      TEST_EQUALITY(file.partition()[i], partition[i]);
+
+    // Node sets are stored in name order
+    TEST_EQUALITY(file.numNodeSets(), 3);
+    TEST_EQUALITY(file.nodeSetName(0), "empty");
+    TEST_EQUALITY(file.nodeSetSize(0), 0);
+    TEST_EQUALITY(file.nodeSetName(1), "max_x");
+    TEST_EQUALITY(file.nodeSetId(1), 7);
+    TEST_EQUALITY(file.nodeSetSize(1), 2);
+    TEST_EQUALITY(file.nodeSet(1)[0], 3);
+    TEST_EQUALITY(file.nodeSet(1)[1], 4);
+    TEST_EQUALITY(file.nodeSetName(2), "min_x");
+    TEST_EQUALITY(file.nodeSetId(2), 3);
+    TEST_EQUALITY(file.nodeSetSize(2), 1);
+    TEST_EQUALITY(file.nodeSet(2)[0], 0);
+  }
+
+  // Without a partition
+  vector<int> noPartition;
+  writeBinaryDiscretizationFile(fileName, coordinates, volumes, blockIds, noPartition, 0, map< string, vector<int> >(), map< string, int >());
+  {
+    BinaryDiscretizationFile file(fileName);
+    TEST_EQUALITY(file.numPoints(), numPoints);
+    TEST_EQUALITY(file.numPartitions(), 0);
+    TEST_ASSERT(file.partition() == NULL);
+    TEST_EQUALITY(file.numNodeSets(), 0);
+    TEST_EQUALITY(file.volumes()[numPoints-1], volumes[numPoints-1]);
+  }
+
+  remove(fileName.c_str());
+}
+
+//! Files that are not binary discretizations, or that have been truncated, must be rejected.
+TEUCHOS_UNIT_TEST(BinaryDiscretizationFile, InvalidFile) {
+
+  string fileName("utPeridigm_BinaryDiscretizationFile_InvalidFile.pdbin");
+  {
+    ofstream outFile(fileName.c_str());
+    outFile << "# x y z block_id volume\n";
+    outFile << "0.0 0.0 0.0 1 1.0\n";
+    outFile << "1.0 0.0 0.0 1 1.0\n";
+  }
+  TEST_THROW(BinaryDiscretizationFile file(fileName), std::exception);
+
+  vector<double> coordinates(6, 1.0), volumes(2, 1.0);
+  vector<int> blockIds(2, 1), partition;
+  writeBinaryDiscretizationFile(fileName, coordinates, volumes, blockIds, partition, 0, map< string, vector<int> >(), map< string, int >());
+  ifstream inFile(fileName.c_str(), ios::binary);
+  vector<char> contents((istreambuf_iterator<char>(inFile)), istreambuf_iterator<char>());
+  inFile.close();
+  ofstream truncatedFile(fileName.c_str(), ios::binary | ios::trunc);
+  truncatedFile.write(&contents[0], contents.size() - 8);
+  truncatedFile.close();
+  TEST_THROW(BinaryDiscretizationFile file(fileName), std::exception);
+
+  remove(fileName.c_str());
+}
+
+int main( int argc, char* argv[] ) {
+
+    int numProcs = 1;
+    int returnCode = -1;
+   
+    Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+   
+    if(numProcs == 1){
+       returnCode = Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+    }
+    else{
+       std::cerr << "Unit test runtime ERROR: utPeridigm_BinaryDiscretizationFile only makes sense on 1 processor." << std::endl;
+    }
+
+    return returnCode;
+}
@@ -49,6 +49,8 @@
 #include <Teuchos_UnitTestHarness.hpp>
 #include "Teuchos_GlobalMPISession.hpp"
 #include <vector>
+#include <set>
+#include <cmath>
 
 #include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
 #ifdef HAVE_MPI
@@ -56,8 +58,13 @@
 #else
   #include <Epetra_SerialComm.h>
 #endif
+#include <Epetra_Import.h>
 #include "Peridigm_ExodusDiscretization.hpp"
 #include "Peridigm_HorizonManager.hpp"
+#include "Peridigm_GeometryUtils.hpp"
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
 
 using namespace Teuchos;
 using namespace PeridigmNS;
@@ -213,7 +220,7 @@ TEUCHOS_UNIT_TEST(ExodusDiscretization, Exodus2x2x2Test) {
   for(int i=0 ; i<neighborhoodData->NumOwnedPoints() ; ++i)
     TEST_ASSERT(ownedIds[i] == i);
   TEST_ASSERT(neighborhoodData->NeighborhoodListSize() == numMyElementsTruth*4);
-  int* neighborhood = neighborhoodData->NeighborhoodList();
+  int* neighborhood = neighborhoodData->InterleavedNeighborhoodList();
   int* neighborhoodPtr = neighborhoodData->NeighborhoodPtr();
 
   if(numProc == 1){
@@ -603,6 +610,177 @@ TEUCHOS_UNIT_TEST(ExodusDiscretization, Exodus2x2x2Test) {
   TEST_FLOATING_EQUALITY(exodusNodePositions[23], 0.5, 1.0e-16);    
 }
 
+TEUCHOS_UNIT_TEST(ExodusDiscretization, DecomposeSerialMesh2x2x2Test) {
+
+  Teuchos::RCP<const Epetra_Comm> comm;
+  #ifdef HAVE_MPI
+    comm = rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  #else
+    comm = rcp(new Epetra_SerialComm);
+  #endif
+
+  // This test is set up for either 1 or 2 processors
+  int numProc = comm->NumProc();
+  TEST_ASSERT(numProc == 1 || numProc == 2);
+
+  ParameterList blockParameterList;
+  ParameterList& blockParams = blockParameterList.sublist("My Block");
+  blockParams.set("Block Names", "block_1");
+  blockParams.set("Horizon", 0.501);
+  PeridigmNS::HorizonManager::self().loadHorizonInformationFromBlockParameters(blockParameterList);
+
+  // Reference discretization, read from the pre-split files when running in parallel
+  RCP<ParameterList> discParams = rcp(new ParameterList);
+  discParams->set("Type", "Exodus");
+  discParams->set("Input Mesh File", "utPeridigm_ExodusDiscretization_2x2x2.g");
+  RCP<ExodusDiscretization> reference = rcp(new ExodusDiscretization(comm, discParams));
+
+  // The same mesh, read from the serial file and partitioned in memory
+  discParams->set("Decompose Serial Mesh", true);
+  discParams->set("Store Exodus Mesh", true);
+  RCP<ExodusDiscretization> discretization = rcp(new ExodusDiscretization(comm, discParams));
+
+  // Partition-independent checks
+  Teuchos::RCP<const Epetra_BlockMap> map = discretization->getGlobalOwnedMap(1);
+  TEST_ASSERT(map->NumGlobalElements() == 8);
+  TEST_ASSERT(map->UniqueGIDs() == true);
+
+  Teuchos::RCP<Epetra_Vector> volume = discretization->getCellVolume();
+  TEST_ASSERT(volume->GlobalLength() == 8);
+  for(int i=0 ; i<volume->MyLength() ; ++i)
+    TEST_FLOATING_EQUALITY((*volume)[i], 0.125, 1.0e-15);
+
+  // Each sphere must have the same position as in the reference discretization
+  Teuchos::RCP<Epetra_Vector> initialX = discretization->getInitialX();
+  Teuchos::RCP<Epetra_Vector> referenceX = reference->getInitialX();
+  Epetra_Vector referenceXOnNewMap(initialX->Map());
+  Epetra_Import importer(initialX->Map(), referenceX->Map());
+  referenceXOnNewMap.Import(*referenceX, importer, Insert);
+  for(int i=0 ; i<initialX->MyLength() ; ++i)
+    TEST_FLOATING_EQUALITY((*initialX)[i], referenceXOnNewMap[i], 1.0e-15);
+
+  // The horizon was chosen such that each point should have three neighbors
+  TEST_ASSERT(static_cast<int>(discretization->getNumBonds()) == map->NumMyElements()*3);
+
+  // Every element is in block_1
+  TEST_ASSERT(discretization->getNumBlocks() == 1);
+  TEST_ASSERT(static_cast<int>((*discretization->getElementBlocks())["block_1"].size()) == map->NumMyElements());
+
+  // Node sets must contain the same elements globally
+  Teuchos::RCP< std::map< std::string, std::vector<int> > > nodeSets = discretization->getNodeSets();
+  Teuchos::RCP< std::map< std::string, std::vector<int> > > referenceNodeSets = reference->getNodeSets();
+  TEST_ASSERT(nodeSets->size() == referenceNodeSets->size());
+  for(std::map< std::string, std::vector<int> >::iterator it = referenceNodeSets->begin() ; it != referenceNodeSets->end() ; ++it){
+    TEST_ASSERT(nodeSets->find(it->first) != nodeSets->end());
+    std::vector<int>& nodeSet = (*nodeSets)[it->first];
+    int numOwned(0), numReferenceOwned(0), numGlobal(0), numReferenceGlobal(0);
+    for(unsigned int i=0 ; i<nodeSet.size() ; ++i)
+      TEST_ASSERT(map->MyGID(nodeSet[i]));
+    numOwned = static_cast<int>(nodeSet.size());
+    for(unsigned int i=0 ; i<it->second.size() ; ++i){
+      if(reference->getGlobalOwnedMap(1)->MyGID(it->second[i]))
+        numReferenceOwned++;
+    }
+    comm->SumAll(&numOwned, &numGlobal, 1);
+    comm->SumAll(&numReferenceOwned, &numReferenceGlobal, 1);
+    TEST_EQUALITY(numGlobal, numReferenceGlobal);
+  }
+
+  // The stored Exodus mesh must describe the owned elements after load balancing:  each element is a hex
+  // with edge length 0.5, whose eight distinct corners lie at offsets of +/-0.25 from the sphere position
+  std::vector<double> nodePositions;
+  for(int iElem=0 ; iElem<map->NumMyElements() ; ++iElem){
+    discretization->getExodusMeshNodePositions(map->GID(iElem), nodePositions);
+    TEST_EQUALITY(static_cast<int>(nodePositions.size()), 24);
+    std::set<int> corners;
+    for(unsigned int iNode=0 ; iNode<nodePositions.size()/3 ; ++iNode){
+      int corner = 0;
+      for(int dof=0 ; dof<3 ; ++dof){
+        double offset = nodePositions[3*iNode+dof] - (*initialX)[3*iElem+dof];
+        TEST_FLOATING_EQUALITY(std::fabs(offset), 0.25, 1.0e-14);
+        if(offset > 0.0)
+          corner += 1 << dof;
+      }
+      corners.insert(corner);
+    }
+    TEST_EQUALITY(static_cast<int>(corners.size()), 8);
+  }
+
+  // The element-horizon intersections use the stored mesh; every element intersects the horizon of every other element
+  discParams->set("Compute Element-Horizon Intersections", true);
+  RCP<ExodusDiscretization> intersectionDiscretization = rcp(new ExodusDiscretization(comm, discParams));
+  TEST_EQUALITY(static_cast<int>(intersectionDiscretization->getNumBonds()), map->NumMyElements()*7);
+}
+
+TEUCHOS_UNIT_TEST(ExodusDiscretization, ElementHorizonIntersection2x2x2Test) {
+
+  Teuchos::RCP<const Epetra_Comm> comm;
+  #ifdef HAVE_MPI
+    comm = rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  #else
+    comm = rcp(new Epetra_SerialComm);
+  #endif
+
+  // A horizon of 0.3 intersects the elements sharing a face with the element at the sphere position,
+  // the elements sharing only an edge are found by the expanded neighbor search and must be removed
+  const double horizon = 0.3;
+  ParameterList blockParameterList;
+  ParameterList& blockParams = blockParameterList.sublist("My Block");
+  blockParams.set("Block Names", "block_1");
+  blockParams.set("Horizon", horizon);
+  PeridigmNS::HorizonManager::self().loadHorizonInformationFromBlockParameters(blockParameterList);
+
+  RCP<ParameterList> discParams = rcp(new ParameterList);
+  discParams->set("Type", "Exodus");
+  discParams->set("Input Mesh File", "utPeridigm_ExodusDiscretization_2x2x2.g");
+  discParams->set("Store Exodus Mesh", true);
+  discParams->set("Compute Element-Horizon Intersections", true);
+  RCP<ExodusDiscretization> discretization = rcp(new ExodusDiscretization(comm, discParams));
+
+  Teuchos::RCP<const Epetra_BlockMap> overlapMap = discretization->getGlobalOverlapMap(1);
+  Teuchos::RCP<Epetra_Vector> initialX = discretization->getInitialX();
+  Teuchos::RCP<PeridigmNS::NeighborhoodData> neighborhoodData = discretization->getNeighborhoodData();
+  int numOwnedPoints = neighborhoodData->NumOwnedPoints();
+  int* neighborhood = neighborhoodData->InterleavedNeighborhoodList();
+  TEST_EQUALITY(neighborhoodData->NeighborhoodListSize(), numOwnedPoints*4);
+
+  // Each remaining neighbor must intersect the horizon
+  std::vector<double> sphereCenter(3), nodePositions;
+  int index = 0;
+  for(int i=0 ; i<numOwnedPoints ; ++i){
+    for(int dof=0 ; dof<3 ; ++dof)
+      sphereCenter[dof] = (*initialX)[3*i+dof];
+    int numNeighbors = neighborhood[index++];
+    TEST_EQUALITY(numNeighbors, 3);
+    for(int j=0 ; j<numNeighbors ; ++j){
+      discretization->getExodusMeshNodePositions(overlapMap->GID(neighborhood[index++]), nodePositions);
+      TEST_ASSERT(PeridigmNS::hexahedronSphereIntersection(&nodePositions[0], sphereCenter, horizon) != PeridigmNS::OUTSIDE_SPHERE);
+    }
+  }
+
+#ifdef _OPENMP
+  // The threaded pruning must match the result obtained with a single thread
+  int numThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  RCP<ExodusDiscretization> serialDiscretization = rcp(new ExodusDiscretization(comm, discParams));
+  omp_set_num_threads(numThreads);
+  Teuchos::RCP<const Epetra_BlockMap> serialOverlapMap = serialDiscretization->getGlobalOverlapMap(1);
+  Teuchos::RCP<PeridigmNS::NeighborhoodData> serialNeighborhoodData = serialDiscretization->getNeighborhoodData();
+  TEST_EQUALITY(serialNeighborhoodData->NeighborhoodListSize(), neighborhoodData->NeighborhoodListSize());
+  if(serialNeighborhoodData->NeighborhoodListSize() == neighborhoodData->NeighborhoodListSize()){
+    int* serialNeighborhood = serialNeighborhoodData->InterleavedNeighborhoodList();
+    index = 0;
+    for(int i=0 ; i<numOwnedPoints ; ++i){
+      int numNeighbors = neighborhood[index];
+      TEST_EQUALITY(serialNeighborhood[index], numNeighbors);
+      index += 1;
+      for(int j=0 ; j<numNeighbors ; ++j, ++index)
+        TEST_EQUALITY(serialOverlapMap->GID(serialNeighborhood[index]), overlapMap->GID(neighborhood[index]));
+    }
+  }
+#endif
+}
+
 int main
 (int argc, char* argv[])
 {
@@ -207,7 +207,7 @@ TEUCHOS_UNIT_TEST(PdQuickGridDiscretization, SimpleTensorProductMeshTest) {
   for(int i=0 ; i<neighborhoodData->NumOwnedPoints() ; ++i)
     TEST_ASSERT(ownedIds[i] == i);
   TEST_ASSERT(neighborhoodData->NeighborhoodListSize() == 32);
-  int* neighborhood = neighborhoodData->NeighborhoodList();
+  int* neighborhood = neighborhoodData->InterleavedNeighborhoodList();
   int* neighborhoodPtr = neighborhoodData->NeighborhoodPtr();
 
   TEST_ASSERT(neighborhoodPtr[0] == 0);
@@ -286,7 +286,7 @@ TEUCHOS_UNIT_TEST(PdQuickGridDiscretization_MPI_np2, SimpleTensorProductMeshTest
   TEST_ASSERT(ownedIds[2] == 2);
   TEST_ASSERT(ownedIds[3] == 3);
   TEST_ASSERT(neighborhoodData->NeighborhoodListSize() == 16);
-  int* neighborhood = neighborhoodData->NeighborhoodList();
+  int* neighborhood = neighborhoodData->InterleavedNeighborhoodList();
   int* neighborhoodPtr = neighborhoodData->NeighborhoodPtr();
   // remember, these are local IDs on each processor, 
   // which includes both owned and ghost nodes (confusing!)
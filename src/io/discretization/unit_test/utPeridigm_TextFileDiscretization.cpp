@@ -0,0 +1,147 @@
+/*! \file utPeridigm_TextFileDiscretization.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include <Epetra_MpiComm.h>
+#include "Peridigm_TextFileDiscretization.hpp"
+#include "Peridigm_HorizonManager.hpp"
+#include <fstream>
+#include <string>
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+using namespace std;
+
+/*! \brief Text discretization file with twelve points at x = 0 through 11, in file order.
+ *
+ *  Points 0 through 5 are in block 1 and points 6 through 11 in block 2, and point i has volume 0.5*(i+1).  The
+ *  file mixes LF and CRLF line endings, comment and blank lines, and tab and leading whitespace, and the last
+ *  line has no trailing newline.  The long first line spans the range boundaries so that, on four processors,
+ *  the first processor parses no points and the second processor's range is empty.  On two and three processors
+ *  the range boundaries fall inside the first line and inside the first line of data.
+ */
+string textFileContents() {
+  string contents = "# " + string(420, '=') + "\n";
+  contents += "0 0 0 1 0.5\r\n";
+  contents += "# x y z block_id volume\r\n";
+  contents += "  1 0 0 1 1\n";
+  contents += "\n";
+  contents += "2 0 0 1 1.5\r\n";
+  contents += "// comment between points\n";
+  contents += "3\t0\t0\t1\t2\n";
+  contents += "4 0 0 1 2.5\r\n";
+  contents += "* another comment\r\n";
+  contents += "5.0 0.0 0.0 1 3.0\n";
+  contents += "6 0 0 2 3.5\n";
+  contents += "   \r\n";
+  contents += "7 0 0 2 4\r\n";
+  contents += "8.000 0 0 2 4.5\n";
+  contents += "9 0 0 2 5\n";
+  contents += "10 0 0 2 5.5\r\n";
+  contents += "11 0 0 2 6";
+  return contents;
+}
+
+TEUCHOS_UNIT_TEST(TextFileDiscretization, ReadTextFile) {
+
+  Teuchos::RCP<Epetra_Comm> comm;
+  comm = rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+
+  const string fileName = "utPeridigm_TextFileDiscretization.txt";
+  if(comm->MyPID() == 0){
+    ofstream file(fileName.c_str(), ios::binary);
+    file << textFileContents();
+  }
+  comm->Barrier();
+
+  // initialize the horizon manager and set the horizon so that each point is bonded to its neighbors along x
+  ParameterList blockParameterList;
+  ParameterList& blockParams = blockParameterList.sublist("My Blocks");
+  blockParams.set("Block Names", "block_1 block_2");
+  blockParams.set("Horizon", 1.01);
+  PeridigmNS::HorizonManager::self().loadHorizonInformationFromBlockParameters(blockParameterList);
+
+  RCP<ParameterList> discParams = rcp(new ParameterList);
+  discParams->set("Type", "Text File");
+  discParams->set("Input Mesh File", fileName);
+  RCP<TextFileDiscretization> discretization = rcp(new TextFileDiscretization(comm, discParams));
+
+  // every point is read exactly once, regardless of the number of processors
+  Teuchos::RCP<const Epetra_BlockMap> map = discretization->getGlobalOwnedMap(1);
+  TEST_EQUALITY(map->NumGlobalElements(), 12);
+  TEST_ASSERT(map->UniqueGIDs());
+  TEST_EQUALITY(discretization->getNumBlocks(), 2);
+
+  // the global ids follow the order of the points in the file
+  Epetra_Vector& x = *discretization->getInitialX();
+  Epetra_Vector& volume = *discretization->getCellVolume();
+  Epetra_Vector& blockId = *discretization->getBlockID();
+  for(int i=0 ; i<map->NumMyElements() ; ++i){
+    int globalId = map->GID(i);
+    TEST_EQUALITY(x[3*i], static_cast<double>(globalId));
+    TEST_EQUALITY(x[3*i+1], 0.0);
+    TEST_EQUALITY(x[3*i+2], 0.0);
+    TEST_EQUALITY(volume[i], 0.5*(globalId + 1));
+    TEST_EQUALITY(blockId[i], globalId < 6 ? 1.0 : 2.0);
+  }
+
+  // the points at the ends of the chain have one bond, the others two
+  int numBonds = static_cast<int>(discretization->getNumBonds());
+  int numGlobalBonds;
+  comm->SumAll(&numBonds, &numGlobalBonds, 1);
+  TEST_EQUALITY(numGlobalBonds, 22);
+}
+
+int main
+(int argc, char* argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
@@ -0,0 +1,226 @@
+/*! \file utPeridigm_OutputManager_Probe.cpp */
+
+//@HEADER
+// ************************************************************************
+//
+//                             Peridigm
+//                 Copyright (2011) Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions?
+// David J. Littlewood   djlittl@sandia.gov
+// John A. Mitchell      jamitch@sandia.gov
+// Michael L. Parks      mlparks@sandia.gov
+// Stewart A. Silling    sasilli@sandia.gov
+//
+// ************************************************************************
+//@HEADER
+
+#include <Peridigm_Discretization.hpp>
+#include <Teuchos_ParameterList.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+#include "Teuchos_GlobalMPISession.hpp"
+#include <Epetra_ConfigDefs.h> // used to define HAVE_MPI
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <stdint.h>
+#include "Peridigm.hpp"
+#include "Peridigm_Field.hpp"
+#include "Peridigm_OutputManager_Probe.hpp"
+
+using namespace Teuchos;
+using namespace PeridigmNS;
+
+//! Four points at x = 0.75, 2.25, 3.75, 5.25, with global ids 0 through 3.
+Teuchos::RCP<Peridigm> createFourPointModel() {
+
+  Teuchos::RCP<Teuchos::ParameterList> peridigmParams = rcp(new Teuchos::ParameterList());
+
+  // material parameters
+  Teuchos::ParameterList& materialParams = peridigmParams->sublist("Materials");
+  Teuchos::ParameterList& linearElasticMaterialParams = materialParams.sublist("My Elastic Material");
+  linearElasticMaterialParams.set("Material Model", "Elastic");
+  linearElasticMaterialParams.set("Density", 7800.0);
+  linearElasticMaterialParams.set("Bulk Modulus", 130.0e9);
+  linearElasticMaterialParams.set("Shear Modulus", 78.0e9);
+
+  // blocks
+  Teuchos::ParameterList& blockParams = peridigmParams->sublist("Blocks");
+  Teuchos::ParameterList& blockOneParams = blockParams.sublist("My Group of Blocks");
+  blockOneParams.set("Block Names", "block_1");
+  blockOneParams.set("Material", "My Elastic Material");
+  blockOneParams.set("Horizon", 5.0);
+
+  // Set up discretization parameterlist
+  Teuchos::ParameterList& discretizationParams = peridigmParams->sublist("Discretization");
+  discretizationParams.set("Type", "PdQuickGrid");
+
+  // pdQuickGrid tensor product mesh generator parameters
+  Teuchos::ParameterList& pdQuickGridParams = discretizationParams.sublist("TensorProduct3DMeshGenerator");
+  pdQuickGridParams.set("Type", "PdQuickGrid");
+  pdQuickGridParams.set("X Origin",  0.0);
+  pdQuickGridParams.set("Y Origin",  0.0);
+  pdQuickGridParams.set("Z Origin",  0.0);
+  pdQuickGridParams.set("X Length",  6.0);
+  pdQuickGridParams.set("Y Length",  1.0);
+  pdQuickGridParams.set("Z Length",  1.0);
+  pdQuickGridParams.set("Number Points X", 4);
+  pdQuickGridParams.set("Number Points Y", 1);
+  pdQuickGridParams.set("Number Points Z", 1);
+
+  Teuchos::RCP<Discretization> nullDiscretization;
+  Teuchos::RCP<Peridigm> peridigm = Teuchos::rcp(new Peridigm(MPI_COMM_WORLD, peridigmParams, nullDiscretization));
+
+  return peridigm;
+}
+
+//! Sets the velocity of each point to (3*GID + offset, 3*GID + 1 + offset, 3*GID + 2 + offset).
+void setVelocity(Teuchos::RCP< std::vector<Block> > blocks, double offset) {
+  FieldManager& fieldManager = FieldManager::self();
+  for(std::vector<Block>::iterator blockIt = blocks->begin() ; blockIt != blocks->end() ; blockIt++){
+    Teuchos::RCP<Epetra_Vector> velocity = blockIt->getData(fieldManager.getFieldId("Velocity"), PeridigmField::STEP_NP1);
+    double* velocityValues = velocity->Values();
+    int* myGIDs = velocity->Map().MyGlobalElements();
+    for(int i=0 ; i<velocity->Map().NumMyElements() ; ++i){
+      for(int c=0 ; c<3 ; ++c)
+        velocityValues[3*i+c] = 3.0*myGIDs[i] + c + offset;
+    }
+  }
+}
+
+TEUCHOS_UNIT_TEST(OutputManager_Probe, NearestPointTest)
+{
+  Teuchos::RCP<Epetra_Comm> comm;
+  #ifdef HAVE_MPI
+    comm = Teuchos::rcp(new Epetra_MpiComm(MPI_COMM_WORLD));
+  #else
+    comm = Teuchos::rcp(new Epetra_SerialComm);
+  #endif
+
+  int numProcs = comm->NumProc();
+
+  TEST_COMPARE(numProcs, <=, 4);
+  if(numProcs > 4){
+    std::cerr << "Unit test runtime ERROR: utPeridigm_OutputManager_Probe only makes sense on 1 to 4 processors." << std::endl;
+    return;
+  }
+
+  Teuchos::RCP<Peridigm> peridigm = createFourPointModel();
+  Teuchos::RCP< std::vector<Block> > blocks = peridigm->getBlocks();
+
+  // Probe output parameters, with the processor data normally added by Peridigm
+  std::string filenameBase("utPeridigm_OutputManager_Probe");
+  Teuchos::RCP<Teuchos::ParameterList> outputParams = rcp(new Teuchos::ParameterList());
+  outputParams->set("NumProc", comm->NumProc());
+  outputParams->set("MyPID", comm->MyPID());
+  outputParams->set("Output File Type", "Probe");
+  outputParams->set("Output Format", "BINARY");
+  outputParams->set("Output Filename", filenameBase);
+  outputParams->set("Output Frequency", 1);
+  Teuchos::ParameterList& probeParams = outputParams->sublist("Probes");
+  // Nearest to the point at x = 2.25
+  Teuchos::ParameterList& probeA = probeParams.sublist("Probe_A");
+  probeA.set("X", 2.0);
+  probeA.set("Y", 0.5);
+  probeA.set("Z", 0.5);
+  // Equidistant from the points at x = 2.25 and x = 3.75, the tie goes to the smaller global id
+  Teuchos::ParameterList& probeB = probeParams.sublist("Probe_B");
+  probeB.set("X", 3.0);
+  probeB.set("Y", 0.5);
+  probeB.set("Z", 0.5);
+  // Outside the domain, nearest to the point at x = 5.25
+  Teuchos::ParameterList& probeC = probeParams.sublist("Probe_C");
+  probeC.set("X", 100.0);
+  probeC.set("Y", -3.0);
+  probeC.set("Z", 2.0);
+  Teuchos::ParameterList& outputVariables = outputParams->sublist("Output Variables");
+  outputVariables.set("Velocity", true);
+  outputVariables.set("Volume", true);
+
+  // Write two steps; the destructor flushes the buffered records
+  Teuchos::RCP<OutputManager_Probe> probeOutput = rcp(new OutputManager_Probe(outputParams, peridigm.get(), blocks));
+  setVelocity(blocks, 0.0);
+  probeOutput->write(blocks, 0.0);
+  setVelocity(blocks, 100.0);
+  probeOutput->write(blocks, 0.5);
+  probeOutput = Teuchos::null;
+
+  if(comm->MyPID() != 0)
+    return;
+
+  std::ifstream file((filenameBase + ".bin").c_str(), std::ios::in | std::ios::binary);
+  TEST_ASSERT(file.is_open());
+
+  char magic[8];
+  file.read(magic, 8);
+  TEST_ASSERT(std::strncmp(magic, "PDPROBE1", 8) == 0);
+  int32_t numColumns;
+  file.read(reinterpret_cast<char*>(&numColumns), sizeof(int32_t));
+  TEST_EQUALITY(numColumns, 12);
+  std::vector<std::string> columnNames;
+  for(int i=0 ; i<numColumns ; ++i){
+    char columnName[64];
+    file.read(columnName, 64);
+    columnNames.push_back(std::string(columnName));
+  }
+  TEST_EQUALITY(columnNames[0], "Probe_A_VelocityX");
+  TEST_EQUALITY(columnNames[2], "Probe_A_VelocityZ");
+  TEST_EQUALITY(columnNames[3], "Probe_A_Volume");
+  TEST_EQUALITY(columnNames[11], "Probe_C_Volume");
+
+  // Global id of the point sampled by each probe
+  int expectedGlobalIds[3] = {1, 1, 3};
+  double offsets[2] = {0.0, 100.0};
+  double times[2] = {0.0, 0.5};
+  for(int step=0 ; step<2 ; ++step){
+    std::vector<double> record(numColumns + 1);
+    file.read(reinterpret_cast<char*>(&record[0]), (numColumns + 1)*sizeof(double));
+    TEST_ASSERT(file.good());
+    TEST_EQUALITY(record[0], times[step]);
+    for(int p=0 ; p<3 ; ++p){
+      for(int c=0 ; c<3 ; ++c)
+        TEST_FLOATING_EQUALITY(record[1 + 4*p + c], 3.0*expectedGlobalIds[p] + c + offsets[step], 1.0e-15);
+      TEST_FLOATING_EQUALITY(record[1 + 4*p + 3], 1.5, 1.0e-15);
+    }
+  }
+
+  // No further records
+  file.peek();
+  TEST_ASSERT(file.eof());
+}
+
+int main (int argc, char* argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc, &argv);
+  return Teuchos::UnitTestRepository::runUnitTestsFromMain(argc, argv);
+}
@@ -50,6 +50,7 @@
 #include "elastic.h"
 #include "correspondence.h"
 #include <Teuchos_Assert.hpp>
+#include <algorithm>
 
 using namespace std;
 
@@ -192,6 +193,20 @@ PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
                                                  const int* neighborhoodList,
                                                  PeridigmNS::DataManager& dataManager) const
 {
+  // View of the interleaved list; the neighbors are gathered one block of points at a time, without copying the list
+  NeighborhoodData neighborhoodData(numOwnedPoints, ownedIDs, neighborhoodList);
+  computeForce(dt, neighborhoodData, dataManager);
+}
+
+void
+PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
+                                                 const PeridigmNS::NeighborhoodData& neighborhoodData,
+                                                 PeridigmNS::DataManager& dataManager) const
+{
+  const int numOwnedPoints = neighborhoodData.NumOwnedPoints();
+  const int* bondOffsets = neighborhoodData.BondOffsets();
+  std::vector<int> neighborIndicesBuffer;
+
   // Zero out the forces and partial stress
   dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1)->PutScalar(0.0);
   dataManager.getData(m_partialStressFieldId, PeridigmField::STEP_NP1)->PutScalar(0.0);
@@ -209,21 +224,12 @@ PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
   // The approximate deformation gradient will be used by the derived class (specific correspondence material model)
   // to compute the Cauchy stress.
   // The inverse of the shape tensor is stored for later use after the Cauchy stress calculation
-  int shapeTensorReturnCode = 
-    CORRESPONDENCE::computeShapeTensorInverseAndApproximateDeformationGradient(volume,
-                                                                               horizon,
-                                                                               modelCoordinates,
-                                                                               coordinates,
-                                                                               shapeTensorInverse,
-                                                                               deformationGradient,
-                                                                               neighborhoodList,
-                                                                               numOwnedPoints);
-  string shapeTensorErrorMessage =
-    "**** Error:  CorrespondenceMaterial::computeForce() failed to compute shape tensor.\n";
-  shapeTensorErrorMessage +=
-    "****         Note that all nodes must have a minimum of three neighbors.  Is the horizon too small?\n";
-  TEUCHOS_TEST_FOR_EXCEPT_MSG(shapeTensorReturnCode != 0, shapeTensorErrorMessage);
-
+  //
+  // Compute left stretch tensor, rotation tensor, and unrotated rate-of-deformation.
+  // Performs a polar decomposition via Flanagan & Taylor (1987) algorithm.
+  //
+  // Both are evaluated point by point, so the points are processed in blocks so that
+  // compressed neighbor lists are decoded one block at a time.
   double *leftStretchTensorN, *leftStretchTensorNP1, *rotationTensorN, *rotationTensorNP1, *unrotatedRateOfDeformation;
   dataManager.getData(m_leftStretchTensorFieldId, PeridigmField::STEP_N)->ExtractView(&leftStretchTensorN);
   dataManager.getData(m_leftStretchTensorFieldId, PeridigmField::STEP_NP1)->ExtractView(&leftStretchTensorNP1);
@@ -231,22 +237,49 @@ PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
   dataManager.getData(m_rotationTensorFieldId, PeridigmField::STEP_NP1)->ExtractView(&rotationTensorNP1);
   dataManager.getData(m_unrotatedRateOfDeformationFieldId, PeridigmField::STEP_NONE)->ExtractView(&unrotatedRateOfDeformation);
 
-  // Compute left stretch tensor, rotation tensor, and unrotated rate-of-deformation.
-  // Performs a polar decomposition via Flanagan & Taylor (1987) algorithm.
-  int rotationTensorReturnCode = CORRESPONDENCE::computeUnrotatedRateOfDeformationAndRotationTensor(volume,
-                                                                                                    horizon,
-                                                                                                    modelCoordinates, 
-                                                                                                    velocities, 
-                                                                                                    deformationGradient,
-                                                                                                    shapeTensorInverse,
-                                                                                                    leftStretchTensorN,
-                                                                                                    rotationTensorN,
-                                                                                                    leftStretchTensorNP1,
-                                                                                                    rotationTensorNP1,
-                                                                                                    unrotatedRateOfDeformation,
-                                                                                                    neighborhoodList, 
-                                                                                                    numOwnedPoints, 
-                                                                                                    dt);
+  int shapeTensorReturnCode(0), rotationTensorReturnCode(0);
+  for(int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()){
+    int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+    const int* neighborIndices = neighborhoodData.NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+    shapeTensorReturnCode =
+      CORRESPONDENCE::computeShapeTensorInverseAndApproximateDeformationGradientCSR(volume,
+                                                                                    horizon,
+                                                                                    modelCoordinates,
+                                                                                    coordinates,
+                                                                                    shapeTensorInverse,
+                                                                                    deformationGradient,
+                                                                                    firstPoint,
+                                                                                    lastPoint,
+                                                                                    bondOffsets,
+                                                                                    neighborIndices);
+    if(shapeTensorReturnCode != 0)
+      break;
+    rotationTensorReturnCode =
+      CORRESPONDENCE::computeUnrotatedRateOfDeformationAndRotationTensorCSR(volume,
+                                                                            horizon,
+                                                                            modelCoordinates,
+                                                                            velocities,
+                                                                            deformationGradient,
+                                                                            shapeTensorInverse,
+                                                                            leftStretchTensorN,
+                                                                            rotationTensorN,
+                                                                            leftStretchTensorNP1,
+                                                                            rotationTensorNP1,
+                                                                            unrotatedRateOfDeformation,
+                                                                            firstPoint,
+                                                                            lastPoint,
+                                                                            bondOffsets,
+                                                                            neighborIndices,
+                                                                            dt);
+    if(rotationTensorReturnCode != 0)
+      break;
+  }
+  string shapeTensorErrorMessage =
+    "**** Error:  CorrespondenceMaterial::computeForce() failed to compute shape tensor.\n";
+  shapeTensorErrorMessage +=
+    "****         Note that all nodes must have a minimum of three neighbors.  Is the horizon too small?\n";
+  TEUCHOS_TEST_FOR_EXCEPT_MSG(shapeTensorReturnCode != 0, shapeTensorErrorMessage);
+
   string rotationTensorErrorMessage =
     "**** Error:  CorrespondenceMaterial::computeForce() failed to compute rotation tensor.\n";
   rotationTensorErrorMessage +=
@@ -306,67 +339,70 @@ PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
   double* temp = &tempVector[0];
 
   // Loop over the material points and convert the Cauchy stress into pairwise peridynamic force densities
-  const int *neighborListPtr = neighborhoodList;
-  for(int iID=0 ; iID<numOwnedPoints ; ++iID, 
-          ++delta, defGrad+=9, stress+=9, shapeTensorInv+=9){
-
-    // first Piola-Kirchhoff stress = J * cauchyStress * defGrad^-T
-
-    // Invert the deformation gradient and store the determinant
-    int matrixInversionReturnCode =
-      CORRESPONDENCE::Invert3by3Matrix(defGrad, jacobianDeterminant, defGradInv);
-    TEUCHOS_TEST_FOR_EXCEPT_MSG(matrixInversionReturnCode != 0, matrixInversionErrorMessage);
+  for(int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()){
+    int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+    const int *neighborListPtr = neighborhoodData.NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+    for(int iID=firstPoint ; iID<lastPoint ; ++iID, 
+            ++delta, defGrad+=9, stress+=9, shapeTensorInv+=9){
+
+      // first Piola-Kirchhoff stress = J * cauchyStress * defGrad^-T
+
+      // Invert the deformation gradient and store the determinant
+      int matrixInversionReturnCode =
+        CORRESPONDENCE::Invert3by3Matrix(defGrad, jacobianDeterminant, defGradInv);
+      TEUCHOS_TEST_FOR_EXCEPT_MSG(matrixInversionReturnCode != 0, matrixInversionErrorMessage);
     
-    //P = J * \sigma * F^(-T)
-    CORRESPONDENCE::MatrixMultiply(false, true, jacobianDeterminant, stress, defGradInv, piolaStress);
-
-    // Inner product of Piola stress and the inverse of the shape tensor
-    CORRESPONDENCE::MatrixMultiply(false, false, 1.0, piolaStress, shapeTensorInv, temp);
-
-    // Loop over the neighbors and compute contribution to force densities
-    modelCoordinatesPtr = modelCoordinates + 3*iID;
-    numNeighbors = *neighborListPtr; neighborListPtr++;
-
-    for(int n=0; n<numNeighbors; n++, neighborListPtr++){
-
-      neighborIndex = *neighborListPtr;
-      neighborModelCoordinatesPtr = modelCoordinates + 3*neighborIndex;
-
-      undeformedBondX = *(neighborModelCoordinatesPtr)   - *(modelCoordinatesPtr);
-      undeformedBondY = *(neighborModelCoordinatesPtr+1) - *(modelCoordinatesPtr+1);
-      undeformedBondZ = *(neighborModelCoordinatesPtr+2) - *(modelCoordinatesPtr+2);
-      undeformedBondLength = sqrt(undeformedBondX*undeformedBondX +
-                                  undeformedBondY*undeformedBondY +
-                                  undeformedBondZ*undeformedBondZ);
-
-      omega = m_OMEGA(undeformedBondLength, *delta);
-      TX = omega * ( *(temp)   * undeformedBondX + *(temp+1) * undeformedBondY + *(temp+2) * undeformedBondZ );
-      TY = omega * ( *(temp+3) * undeformedBondX + *(temp+4) * undeformedBondY + *(temp+5) * undeformedBondZ );
-      TZ = omega * ( *(temp+6) * undeformedBondX + *(temp+7) * undeformedBondY + *(temp+8) * undeformedBondZ );
-
-      vol = volume[iID];
-      neighborVol = volume[neighborIndex];
-
-      forceDensityPtr = forceDensity + 3*iID;
-      neighborForceDensityPtr = forceDensity + 3*neighborIndex;
-
-      *(forceDensityPtr)   += TX * neighborVol;
-      *(forceDensityPtr+1) += TY * neighborVol;
-      *(forceDensityPtr+2) += TZ * neighborVol;
-      *(neighborForceDensityPtr)   -= TX * vol;
-      *(neighborForceDensityPtr+1) -= TY * vol;
-      *(neighborForceDensityPtr+2) -= TZ * vol;
-
-      partialStressPtr = partialStress + 9*iID;
-      *(partialStressPtr)   += TX*undeformedBondX*neighborVol;
-      *(partialStressPtr+1) += TX*undeformedBondY*neighborVol;
-      *(partialStressPtr+2) += TX*undeformedBondZ*neighborVol;
-      *(partialStressPtr+3) += TY*undeformedBondX*neighborVol;
-      *(partialStressPtr+4) += TY*undeformedBondY*neighborVol;
-      *(partialStressPtr+5) += TY*undeformedBondZ*neighborVol;
-      *(partialStressPtr+6) += TZ*undeformedBondX*neighborVol;
-      *(partialStressPtr+7) += TZ*undeformedBondY*neighborVol;
-      *(partialStressPtr+8) += TZ*undeformedBondZ*neighborVol;
+      //P = J * \sigma * F^(-T)
+      CORRESPONDENCE::MatrixMultiply(false, true, jacobianDeterminant, stress, defGradInv, piolaStress);
+
+      // Inner product of Piola stress and the inverse of the shape tensor
+      CORRESPONDENCE::MatrixMultiply(false, false, 1.0, piolaStress, shapeTensorInv, temp);
+
+      // Loop over the neighbors and compute contribution to force densities
+      modelCoordinatesPtr = modelCoordinates + 3*iID;
+      numNeighbors = bondOffsets[iID+1] - bondOffsets[iID];
+
+      for(int n=0; n<numNeighbors; n++, neighborListPtr++){
+
+        neighborIndex = *neighborListPtr;
+        neighborModelCoordinatesPtr = modelCoordinates + 3*neighborIndex;
+
+        undeformedBondX = *(neighborModelCoordinatesPtr)   - *(modelCoordinatesPtr);
+        undeformedBondY = *(neighborModelCoordinatesPtr+1) - *(modelCoordinatesPtr+1);
+        undeformedBondZ = *(neighborModelCoordinatesPtr+2) - *(modelCoordinatesPtr+2);
+        undeformedBondLength = sqrt(undeformedBondX*undeformedBondX +
+                                    undeformedBondY*undeformedBondY +
+                                    undeformedBondZ*undeformedBondZ);
+
+        omega = m_OMEGA(undeformedBondLength, *delta);
+        TX = omega * ( *(temp)   * undeformedBondX + *(temp+1) * undeformedBondY + *(temp+2) * undeformedBondZ );
+        TY = omega * ( *(temp+3) * undeformedBondX + *(temp+4) * undeformedBondY + *(temp+5) * undeformedBondZ );
+        TZ = omega * ( *(temp+6) * undeformedBondX + *(temp+7) * undeformedBondY + *(temp+8) * undeformedBondZ );
+
+        vol = volume[iID];
+        neighborVol = volume[neighborIndex];
+
+        forceDensityPtr = forceDensity + 3*iID;
+        neighborForceDensityPtr = forceDensity + 3*neighborIndex;
+
+        *(forceDensityPtr)   += TX * neighborVol;
+        *(forceDensityPtr+1) += TY * neighborVol;
+        *(forceDensityPtr+2) += TZ * neighborVol;
+        *(neighborForceDensityPtr)   -= TX * vol;
+        *(neighborForceDensityPtr+1) -= TY * vol;
+        *(neighborForceDensityPtr+2) -= TZ * vol;
+
+        partialStressPtr = partialStress + 9*iID;
+        *(partialStressPtr)   += TX*undeformedBondX*neighborVol;
+        *(partialStressPtr+1) += TX*undeformedBondY*neighborVol;
+        *(partialStressPtr+2) += TX*undeformedBondZ*neighborVol;
+        *(partialStressPtr+3) += TY*undeformedBondX*neighborVol;
+        *(partialStressPtr+4) += TY*undeformedBondY*neighborVol;
+        *(partialStressPtr+5) += TY*undeformedBondZ*neighborVol;
+        *(partialStressPtr+6) += TZ*undeformedBondX*neighborVol;
+        *(partialStressPtr+7) += TZ*undeformedBondY*neighborVol;
+        *(partialStressPtr+8) += TZ*undeformedBondZ*neighborVol;
+      }
     }
   }
 
@@ -380,16 +416,22 @@ PeridigmNS::CorrespondenceMaterial::computeForce(const double dt,
   //       They are summed into the force vector below, and the force vector is assembled across processors,
   //       so the calculation runs correctly, but the hourglass output is off.
 
-  CORRESPONDENCE::computeHourglassForce(volume,
-                                        horizon,
-                                        modelCoordinates,
-                                        coordinates,
-                                        deformationGradient,
-                                        hourglassForceDensity,
-                                        neighborhoodList,
-                                        numOwnedPoints,
-                                        m_bulkModulus,
-                                        m_hourglassCoefficient);
+  for(int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()){
+    int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+    const int* neighborIndices = neighborhoodData.NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+    CORRESPONDENCE::computeHourglassForceCSR(volume,
+                                             horizon,
+                                             modelCoordinates,
+                                             coordinates,
+                                             deformationGradient,
+                                             hourglassForceDensity,
+                                             firstPoint,
+                                             lastPoint,
+                                             bondOffsets,
+                                             neighborIndices,
+                                             m_bulkModulus,
+                                             m_hourglassCoefficient);
+  }
 
   // Sum the hourglass force densities into the force densities
   Teuchos::RCP<Epetra_Vector> forceDensityVector = dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1);
@@ -96,6 +96,13 @@ namespace PeridigmNS {
                               const int* neighborhoodList,
                               PeridigmNS::DataManager& dataManager) const;
 
+    using Material::computeForce;
+
+    //! Evaluate the internal force using the CSR form of the neighborhood data.
+    virtual void computeForce(const double dt,
+                              const PeridigmNS::NeighborhoodData& neighborhoodData,
+                              PeridigmNS::DataManager& dataManager) const;
+
   protected:
 
     // material parameters
@@ -49,6 +49,8 @@
 #include "Peridigm_Field.hpp"
 #include "elastic_bond_based.h"
 #include <Teuchos_Assert.hpp>
+#include <algorithm>
+#include <vector>
 
 PeridigmNS::ElasticBondBasedMaterial::ElasticBondBasedMaterial(const Teuchos::ParameterList& params)
   : Material(params),
@@ -99,6 +101,19 @@ PeridigmNS::ElasticBondBasedMaterial::computeForce(const double dt,
                                           const int* neighborhoodList,
                                           PeridigmNS::DataManager& dataManager) const
 {
+  // View of the interleaved list; the neighbors are gathered one block of points at a time, without copying the list
+  NeighborhoodData neighborhoodData(numOwnedPoints, ownedIDs, neighborhoodList);
+  computeForce(dt, neighborhoodData, dataManager);
+}
+
+void
+PeridigmNS::ElasticBondBasedMaterial::computeForce(const double dt,
+                                                   const PeridigmNS::NeighborhoodData& neighborhoodData,
+                                                   PeridigmNS::DataManager& dataManager) const
+{
+  const int numOwnedPoints = neighborhoodData.NumOwnedPoints();
+  const int* bondOffsets = neighborhoodData.BondOffsets();
+
   // Zero out the forces
   dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1)->PutScalar(0.0);
 
@@ -111,5 +126,11 @@ PeridigmNS::ElasticBondBasedMaterial::computeForce(const double dt,
   dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_NP1)->ExtractView(&bondDamage);
   dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1)->ExtractView(&force);
 
-  MATERIAL_EVALUATION::computeInternalForceElasticBondBased(x,y,cellVolume,bondDamage,force,neighborhoodList,numOwnedPoints,m_bulkModulus,m_horizon);
+  // Process the points in blocks so that compressed neighbor lists are decoded one block at a time
+  std::vector<int> neighborIndicesBuffer;
+  for(int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()){
+    int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+    const int* neighborIndices = neighborhoodData.NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+    MATERIAL_EVALUATION::computeInternalForceElasticBondBasedCSR(x,y,cellVolume,bondDamage,force,firstPoint,lastPoint,bondOffsets,neighborIndices,m_bulkModulus,m_horizon);
+  }
 }
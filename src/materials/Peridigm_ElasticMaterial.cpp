@@ -56,6 +56,8 @@
 #include <Epetra_SerialComm.h>
 #include <Sacado.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <algorithm>
+#include <vector>
 
 using namespace std;
 
@@ -142,6 +144,44 @@ PeridigmNS::ElasticMaterial::computeForce(const double dt,
                                           const int* neighborhoodList,
                                           PeridigmNS::DataManager& dataManager) const
 {
+#ifdef PERIDIGM_KOKKOS
+  // Zero out the forces
+  dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1)->PutScalar(0.0);
+  if(m_computePartialStress)
+    dataManager.getData(m_partialStressFieldId, PeridigmField::STEP_NP1)->PutScalar(0.0);
+
+  // Extract pointers to the underlying data
+  double *x, *y, *cellVolume, *weightedVolume, *dilatation, *bondDamage, *force, *deltaTemperature;
+
+  dataManager.getData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&x);
+  dataManager.getData(m_coordinatesFieldId, PeridigmField::STEP_NP1)->ExtractView(&y);
+  dataManager.getData(m_volumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&cellVolume);
+  dataManager.getData(m_weightedVolumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&weightedVolume);
+  dataManager.getData(m_dilatationFieldId, PeridigmField::STEP_NP1)->ExtractView(&dilatation);
+  dataManager.getData(m_bondDamageFieldId, PeridigmField::STEP_NP1)->ExtractView(&bondDamage);
+  dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1)->ExtractView(&force);
+  deltaTemperature = NULL;
+  if(m_applyThermalStrains)
+    dataManager.getData(m_deltaTemperatureFieldId, PeridigmField::STEP_NP1)->ExtractView(&deltaTemperature);
+
+  MATERIAL_EVALUATION::computeDilatation(x,y,weightedVolume,cellVolume,bondDamage,dilatation,neighborhoodList,numOwnedPoints,m_horizon,m_OMEGA,m_alpha,deltaTemperature);
+  MATERIAL_EVALUATION::computeInternalForceLinearElasticKokkos(x,y,weightedVolume,cellVolume,dilatation,bondDamage,scf,force,neighborhoodList,numOwnedPoints,m_bulkModulus,m_shearModulus,m_horizon,m_alpha,deltaTemperature);
+#else
+  // View of the interleaved list; the neighbors are gathered one block of points at a time, without copying the list
+  NeighborhoodData neighborhoodData(numOwnedPoints, ownedIDs, neighborhoodList);
+  computeForce(dt, neighborhoodData, dataManager);
+#endif
+}
+
+void
+PeridigmNS::ElasticMaterial::computeForce(const double dt,
+                                          const PeridigmNS::NeighborhoodData& neighborhoodData,
+                                          PeridigmNS::DataManager& dataManager) const
+{
+#ifdef PERIDIGM_KOKKOS
+  std::vector<int> neighborhoodListBuffer;
+  computeForce(dt, neighborhoodData.NumOwnedPoints(), neighborhoodData.OwnedIDs(), neighborhoodData.NeighborhoodList(neighborhoodListBuffer), dataManager);
+#else
   // Zero out the forces
   dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1)->PutScalar(0.0);
   if(m_computePartialStress)
@@ -164,11 +204,11 @@ PeridigmNS::ElasticMaterial::computeForce(const double dt,
   if(m_computePartialStress)
     dataManager.getData(m_partialStressFieldId, PeridigmField::STEP_NP1)->ExtractView(&partialStress);
 
-  MATERIAL_EVALUATION::computeDilatation(x,y,weightedVolume,cellVolume,bondDamage,dilatation,neighborhoodList,numOwnedPoints,m_horizon,m_OMEGA,m_alpha,deltaTemperature);
-#ifdef PERIDIGM_KOKKOS
-  MATERIAL_EVALUATION::computeInternalForceLinearElasticKokkos(x,y,weightedVolume,cellVolume,dilatation,bondDamage,scf,force,neighborhoodList,numOwnedPoints,m_bulkModulus,m_shearModulus,m_horizon,m_alpha,deltaTemperature);
-#else
-  MATERIAL_EVALUATION::computeInternalForceLinearElastic(x,y,weightedVolume,cellVolume,dilatation,bondDamage,force,partialStress,neighborhoodList,numOwnedPoints,m_bulkModulus,m_shearModulus,m_horizon,m_alpha,deltaTemperature);
+  int numOverlapPoints = dataManager.getData(m_coordinatesFieldId, PeridigmField::STEP_NP1)->MyLength()/3;
+
+  // The dilatation of every point must be known before any forces are computed
+  MATERIAL_EVALUATION::computeDilatationCSR(x,y,weightedVolume,cellVolume,bondDamage,dilatation,neighborhoodData,m_horizon,m_OMEGA,m_alpha,deltaTemperature);
+  MATERIAL_EVALUATION::computeInternalForceLinearElasticCSR(x,y,weightedVolume,cellVolume,dilatation,bondDamage,force,partialStress,neighborhoodData,numOverlapPoints,m_bulkModulus,m_shearModulus,m_horizon,m_alpha,deltaTemperature);
 #endif
 }
 
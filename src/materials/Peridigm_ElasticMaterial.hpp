@@ -137,6 +137,14 @@ namespace PeridigmNS {
 		 const int* neighborhoodList,
                  PeridigmNS::DataManager& dataManager) const;
 
+    using Material::computeForce;
+
+    //! Evaluate the internal force using the CSR form of the neighborhood data.
+    virtual void
+    computeForce(const double dt,
+                 const PeridigmNS::NeighborhoodData& neighborhoodData,
+                 PeridigmNS::DataManager& dataManager) const;
+
     //! Compute stored elastic density energy.
     virtual void
     computeStoredElasticEnergyDensity(const double dt,
@@ -53,6 +53,7 @@
 #include <Epetra_SerialComm.h>
 #include <Epetra_Vector.h>
 #include <Sacado.hpp>
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -138,6 +139,19 @@ PeridigmNS::ElasticPlasticMaterial::computeForce(const double dt,
                                                  const int* neighborhoodList,
                                                  PeridigmNS::DataManager& dataManager) const
 {
+  // View of the interleaved list; the neighbors are gathered one block of points at a time, without copying the list
+  NeighborhoodData neighborhoodData(numOwnedPoints, ownedIDs, neighborhoodList);
+  computeForce(dt, neighborhoodData, dataManager);
+}
+
+void
+PeridigmNS::ElasticPlasticMaterial::computeForce(const double dt,
+                                                 const PeridigmNS::NeighborhoodData& neighborhoodData,
+                                                 PeridigmNS::DataManager& dataManager) const
+{
+  const int numOwnedPoints = neighborhoodData.NumOwnedPoints();
+  const int* bondOffsets = neighborhoodData.BondOffsets();
+
   double *x, *y, *volume, *dilatation, *weightedVolume, *bondDamage, *edpN, *edpNP1, *lambdaN, *lambdaNP1, *force;
   dataManager.getData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&x);
   dataManager.getData(m_coordinatesFieldId, PeridigmField::STEP_NP1)->ExtractView(&y);
@@ -154,29 +168,39 @@ PeridigmNS::ElasticPlasticMaterial::computeForce(const double dt,
   // Zero out the force
   dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1)->PutScalar(0.0);
 
-  MATERIAL_EVALUATION::computeDilatation(x,y,weightedVolume,volume,bondDamage,dilatation,neighborhoodList,numOwnedPoints,m_horizon);
-  MATERIAL_EVALUATION::computeInternalForceIsotropicElasticPlastic
-     (
-       x,
-       y,
-       weightedVolume,
-       volume,
-       dilatation,
-       bondDamage,
-       edpN,
-       edpNP1,
-       lambdaN,
-       lambdaNP1,
-       force,
-       neighborhoodList,
-       numOwnedPoints,
-       m_bulkModulus,
-       m_shearModulus,
-       m_horizon,
-       m_yieldStress,
-       m_isPlanarProblem,
-       m_thickness
-    );
+  // The dilatation of every point must be known before any forces are computed
+  MATERIAL_EVALUATION::computeDilatationCSR(x,y,weightedVolume,volume,bondDamage,dilatation,neighborhoodData,m_horizon);
+
+  // Process the points in blocks so that compressed neighbor lists are decoded one block at a time
+  std::vector<int> neighborIndicesBuffer;
+  for(int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()){
+    int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+    const int* neighborIndices = neighborhoodData.NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+    MATERIAL_EVALUATION::computeInternalForceIsotropicElasticPlasticCSR
+       (
+         x,
+         y,
+         weightedVolume,
+         volume,
+         dilatation,
+         bondDamage,
+         edpN,
+         edpNP1,
+         lambdaN,
+         lambdaNP1,
+         force,
+         firstPoint,
+         lastPoint,
+         bondOffsets,
+         neighborIndices,
+         m_bulkModulus,
+         m_shearModulus,
+         m_horizon,
+         m_yieldStress,
+         m_isPlanarProblem,
+         m_thickness
+      );
+  }
 }
 
 void
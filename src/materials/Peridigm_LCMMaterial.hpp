@@ -96,6 +96,8 @@ namespace PeridigmNS {
 		 const int* neighborhoodList,
                  PeridigmNS::DataManager& dataManager) const;
 
+    using Material::computeForce;
+
   protected:
 
     // material parameters
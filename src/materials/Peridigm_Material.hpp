@@ -56,6 +56,7 @@
 #include <string>
 #include <float.h>
 #include "Peridigm_DataManager.hpp"
+#include "Peridigm_NeighborhoodData.hpp"
 #include "Peridigm_SerialMatrix.hpp"
 #include "Peridigm_ScratchMatrix.hpp"
 
@@ -116,6 +117,21 @@ namespace PeridigmNS {
                  const int* neighborhoodList,
                  PeridigmNS::DataManager& dataManager) const = 0;
 
+    /*! \brief Evaluate the internal force given the block's neighborhood data, which is in CSR form.
+     *
+     *  Material models with kernels that operate on the compressed sparse row form of the neighborhood
+     *  data (NeighborhoodData::BondOffsets() and NeighborhoodData::NeighborIndices(int, int, std::vector<int>&))
+     *  override this function.  The default implementation rebuilds the interleaved neighborhood list
+     *  and calls computeForce() with it.
+     */
+    virtual void
+    computeForce(const double dt,
+                 const PeridigmNS::NeighborhoodData& neighborhoodData,
+                 PeridigmNS::DataManager& dataManager) const {
+      std::vector<int> neighborhoodListBuffer;
+      computeForce(dt, neighborhoodData.NumOwnedPoints(), neighborhoodData.OwnedIDs(), neighborhoodData.NeighborhoodList(neighborhoodListBuffer), dataManager);
+    }
+
     /// \enum JacobianType
     /// \brief Whether to compute the full tangent stiffness matrix or just its block diagonal entries
     ///
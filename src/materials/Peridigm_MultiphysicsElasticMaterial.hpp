@@ -143,6 +143,8 @@ namespace PeridigmNS {
 		 const int* neighborhoodList,
                  PeridigmNS::DataManager& dataManager) const;
 
+    using Material::computeForce;
+
     //! Compute stored elastic density energy.
     virtual void
     computeStoredElasticEnergyDensity(const double dt,
@@ -58,6 +58,8 @@ public:
 		 const int* neighborhoodList,
 				PeridigmNS::DataManager& dataManager) const;
 
+	using Material::computeForce;
+
     //! Compute stored elastic density energy.
     virtual void
     computeStoredElasticEnergyDensity(const double dt,
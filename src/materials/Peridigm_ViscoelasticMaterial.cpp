@@ -52,7 +52,9 @@
 #include <Teuchos_Assert.hpp>
 #include <Epetra_Vector.h>
 #include <Epetra_MultiVector.h>
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 PeridigmNS::ViscoelasticMaterial::ViscoelasticMaterial(const Teuchos::ParameterList & params)
  : Material(params),
@@ -119,6 +121,19 @@ PeridigmNS::ViscoelasticMaterial::computeForce(const double dt,
                                                           const int* neighborhoodList,
                                                           PeridigmNS::DataManager& dataManager) const
 {
+  // View of the interleaved list; the neighbors are gathered one block of points at a time, without copying the list
+  NeighborhoodData neighborhoodData(numOwnedPoints, ownedIDs, neighborhoodList);
+  computeForce(dt, neighborhoodData, dataManager);
+}
+
+void
+PeridigmNS::ViscoelasticMaterial::computeForce(const double dt,
+                                               const PeridigmNS::NeighborhoodData& neighborhoodData,
+                                               PeridigmNS::DataManager& dataManager) const
+{
+  const int numOwnedPoints = neighborhoodData.NumOwnedPoints();
+  const int* bondOffsets = neighborhoodData.BondOffsets();
+
   double *x, *yN, *yNP1, *volume, *dilatationN, *dilatationNp1, *weightedVolume, *bondDamage, *edbN, *edbNP1,  *force;
   dataManager.getData(m_modelCoordinatesFieldId, PeridigmField::STEP_NONE)->ExtractView(&x);
   dataManager.getData(m_volumeFieldId, PeridigmField::STEP_NONE)->ExtractView(&volume);
@@ -134,24 +149,33 @@ PeridigmNS::ViscoelasticMaterial::computeForce(const double dt,
 
   dataManager.getData(m_forceDensityFieldId, PeridigmField::STEP_NP1)->PutScalar(0.0);
 
-  MATERIAL_EVALUATION::computeDilatation(x,yNP1,weightedVolume,volume,bondDamage,dilatationNp1,neighborhoodList,numOwnedPoints,m_horizon);
-  MATERIAL_EVALUATION::computeInternalForceViscoelasticStandardLinearSolid(dt,
-                                                                           x,
-                                                                           yN,
-                                                                           yNP1,
-                                                                           weightedVolume,
-                                                                           volume,
-                                                                           dilatationN,
-                                                                           dilatationNp1,
-                                                                           bondDamage,
-                                                                           edbN,
-                                                                           edbNP1,
-                                                                           force,
-                                                                           neighborhoodList,
-                                                                           numOwnedPoints,
-                                                                           m_bulkModulus,
-                                                                           m_shearModulus,
-                                                                           m_lambda_i,
-                                                                           m_tau_b);
-}
+  // The dilatation of every point must be known before any forces are computed
+  MATERIAL_EVALUATION::computeDilatationCSR(x,yNP1,weightedVolume,volume,bondDamage,dilatationNp1,neighborhoodData,m_horizon);
 
+  // Process the points in blocks so that compressed neighbor lists are decoded one block at a time
+  std::vector<int> neighborIndicesBuffer;
+  for(int firstPoint=0 ; firstPoint<numOwnedPoints ; firstPoint+=NeighborhoodData::PointBlockSize()){
+    int lastPoint = std::min(firstPoint + NeighborhoodData::PointBlockSize(), numOwnedPoints);
+    const int* neighborIndices = neighborhoodData.NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+    MATERIAL_EVALUATION::computeInternalForceViscoelasticStandardLinearSolidCSR(dt,
+                                                                                x,
+                                                                                yN,
+                                                                                yNP1,
+                                                                                weightedVolume,
+                                                                                volume,
+                                                                                dilatationN,
+                                                                                dilatationNp1,
+                                                                                bondDamage,
+                                                                                edbN,
+                                                                                edbNP1,
+                                                                                force,
+                                                                                firstPoint,
+                                                                                lastPoint,
+                                                                                bondOffsets,
+                                                                                neighborIndices,
+                                                                                m_bulkModulus,
+                                                                                m_shearModulus,
+                                                                                m_lambda_i,
+                                                                                m_tau_b);
+  }
+}
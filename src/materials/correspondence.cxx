@@ -53,6 +53,7 @@
 #include <functional>
 #include <boost/math/constants/constants.hpp>
 #include <vector>
+#include <algorithm>
 
 namespace CORRESPONDENCE {
 
@@ -225,16 +226,45 @@ ScalarT* deformationGradient,
 const int* neighborhoodList,
 int numPoints
 )
+{
+  std::vector<int> bondOffsets, neighborIndicesBuffer;
+  MATERIAL_EVALUATION::computeBondOffsets(neighborhoodList, numPoints, bondOffsets);
+  int returnCode = 0;
+  const int blockSize = PeridigmNS::NeighborhoodData::PointBlockSize();
+  for(int firstPoint=0; firstPoint<numPoints; firstPoint+=blockSize){
+    int lastPoint = std::min(firstPoint + blockSize, numPoints);
+    const int* neighborIndices = MATERIAL_EVALUATION::gatherNeighborIndices(neighborhoodList, &bondOffsets[0], firstPoint, lastPoint, neighborIndicesBuffer);
+    int blockReturnCode = computeShapeTensorInverseAndApproximateDeformationGradientCSR(volume, horizon, modelCoordinates, coordinates, shapeTensorInverse, deformationGradient, firstPoint, lastPoint, &bondOffsets[0], neighborIndices);
+    if(blockReturnCode != 0)
+      returnCode = blockReturnCode;
+  }
+  return returnCode;
+}
+
+template<typename ScalarT>
+int computeShapeTensorInverseAndApproximateDeformationGradientCSR
+(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const ScalarT* coordinates,
+ScalarT* shapeTensorInverse,
+ScalarT* deformationGradient,
+int firstPoint,
+int lastPoint,
+const int* bondOffsets,
+const int* neighborIndices
+)
 {
   int returnCode = 0;
 
-  const double* delta = horizon;
-  const double* modelCoord = modelCoordinates;
+  const double* delta = horizon + firstPoint;
+  const double* modelCoord = modelCoordinates + 3*firstPoint;
   const double* neighborModelCoord;
-  const ScalarT* coord = coordinates;
+  const ScalarT* coord = coordinates + 3*firstPoint;
   const ScalarT* neighborCoord;
-  ScalarT* shapeTensorInv = shapeTensorInverse;
-  ScalarT* defGrad = deformationGradient;
+  ScalarT* shapeTensorInv = shapeTensorInverse + 9*firstPoint;
+  ScalarT* defGrad = deformationGradient + 9*firstPoint;
 
   double undeformedBondX, undeformedBondY, undeformedBondZ, undeformedBondLength;
   ScalarT deformedBondX, deformedBondY, deformedBondZ;
@@ -253,8 +283,8 @@ int numPoints
   int inversionReturnCode(0);
 
   int neighborIndex, numNeighbors;
-  const int *neighborListPtr = neighborhoodList;
-  for(int iID=0 ; iID<numPoints ; ++iID, delta++, modelCoord+=3, coord+=3,
+  const int *neighborListPtr = neighborIndices;
+  for(int iID=firstPoint ; iID<lastPoint ; ++iID, delta++, modelCoord+=3, coord+=3,
         shapeTensorInv+=9, defGrad+=9){
 
     // Zero out data
@@ -265,7 +295,7 @@ int numPoints
     *(defGradFirstTerm+3) = 0.0 ; *(defGradFirstTerm+4) = 0.0 ; *(defGradFirstTerm+5) = 0.0 ;
     *(defGradFirstTerm+6) = 0.0 ; *(defGradFirstTerm+7) = 0.0 ; *(defGradFirstTerm+8) = 0.0 ;
 
-    numNeighbors = *neighborListPtr; neighborListPtr++;
+    numNeighbors = bondOffsets[iID+1] - bondOffsets[iID];
     for(int n=0; n<numNeighbors; n++, neighborListPtr++){
 
       neighborIndex = *neighborListPtr;
@@ -341,21 +371,55 @@ int numPoints,
 double dt
 )
 {
+  std::vector<int> bondOffsets, neighborIndicesBuffer;
+  MATERIAL_EVALUATION::computeBondOffsets(neighborhoodList, numPoints, bondOffsets);
   int returnCode = 0;
+  const int blockSize = PeridigmNS::NeighborhoodData::PointBlockSize();
+  for(int firstPoint=0; firstPoint<numPoints; firstPoint+=blockSize){
+    int lastPoint = std::min(firstPoint + blockSize, numPoints);
+    const int* neighborIndices = MATERIAL_EVALUATION::gatherNeighborIndices(neighborhoodList, &bondOffsets[0], firstPoint, lastPoint, neighborIndicesBuffer);
+    int blockReturnCode = computeUnrotatedRateOfDeformationAndRotationTensorCSR(volume, horizon, modelCoordinates, velocities, deformationGradient, shapeTensorInverse, leftStretchTensorN, rotationTensorN, leftStretchTensorNP1, rotationTensorNP1, unrotatedRateOfDeformation, firstPoint, lastPoint, &bondOffsets[0], neighborIndices, dt);
+    if(blockReturnCode != 0)
+      returnCode = blockReturnCode;
+  }
+  return returnCode;
+}
 
-  const double* delta = horizon;
-  const double* modelCoord = modelCoordinates;
+template<typename ScalarT>
+int computeUnrotatedRateOfDeformationAndRotationTensorCSR(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const ScalarT* velocities,
+const ScalarT* deformationGradient,
+const ScalarT* shapeTensorInverse,
+const ScalarT* leftStretchTensorN,
+const ScalarT* rotationTensorN,
+ScalarT* leftStretchTensorNP1,
+ScalarT* rotationTensorNP1,
+ScalarT* unrotatedRateOfDeformation,
+int firstPoint,
+int lastPoint,
+const int* bondOffsets,
+const int* neighborIndices,
+double dt
+)
+{
+  int returnCode = 0;
+
+  const double* delta = horizon + firstPoint;
+  const double* modelCoord = modelCoordinates + 3*firstPoint;
   const double* neighborModelCoord;
-  const ScalarT* vel = velocities;
+  const ScalarT* vel = velocities + 3*firstPoint;
   const ScalarT* neighborVel;
-  const ScalarT* defGrad = deformationGradient;
-  const ScalarT* shapeTensorInv = shapeTensorInverse;
-  const ScalarT* leftStretchN = leftStretchTensorN;
-  const ScalarT* rotTensorN = rotationTensorN;
+  const ScalarT* defGrad = deformationGradient + 9*firstPoint;
+  const ScalarT* shapeTensorInv = shapeTensorInverse + 9*firstPoint;
+  const ScalarT* leftStretchN = leftStretchTensorN + 9*firstPoint;
+  const ScalarT* rotTensorN = rotationTensorN + 9*firstPoint;
 
-  ScalarT* leftStretchNP1 = leftStretchTensorNP1;
-  ScalarT* rotTensorNP1 = rotationTensorNP1;
-  ScalarT* unrotRateOfDef = unrotatedRateOfDeformation;
+  ScalarT* leftStretchNP1 = leftStretchTensorNP1 + 9*firstPoint;
+  ScalarT* rotTensorNP1 = rotationTensorNP1 + 9*firstPoint;
+  ScalarT* unrotRateOfDef = unrotatedRateOfDeformation + 9*firstPoint;
 
   std::vector<ScalarT> FdotFirstTermVector(9) ; ScalarT* FdotFirstTerm = &FdotFirstTermVector[0];
   std::vector<ScalarT> FdotVector(9) ; ScalarT* Fdot = &FdotVector[0];
@@ -386,8 +450,8 @@ double dt
   double bondDamage = 0.0;
 
   int neighborIndex, numNeighbors;
-  const int *neighborListPtr = neighborhoodList;
-  for(int iID=0 ; iID<numPoints ; ++iID, delta++, modelCoord+=3, vel+=3,
+  const int *neighborListPtr = neighborIndices;
+  for(int iID=firstPoint ; iID<lastPoint ; ++iID, delta++, modelCoord+=3, vel+=3,
         shapeTensorInv+=9, rotTensorN+=9, rotTensorNP1+=9, leftStretchNP1+=9, leftStretchN+=9,
         unrotRateOfDef+=9, defGrad+=9){
 
@@ -397,7 +461,7 @@ double dt
     *(FdotFirstTerm+6) = 0.0 ; *(FdotFirstTerm+7) = 0.0 ;  *(FdotFirstTerm+8) = 0.0;
     
     //Compute Fdot
-    numNeighbors = *neighborListPtr; neighborListPtr++;
+    numNeighbors = bondOffsets[iID+1] - bondOffsets[iID];
     for(int n=0; n<numNeighbors; n++, neighborListPtr++){
 
       neighborIndex = *neighborListPtr;
@@ -668,6 +732,33 @@ int numPoints,
 double bulkModulus,
 double hourglassCoefficient
 )
+{
+  std::vector<int> bondOffsets, neighborIndicesBuffer;
+  MATERIAL_EVALUATION::computeBondOffsets(neighborhoodList, numPoints, bondOffsets);
+  const int blockSize = PeridigmNS::NeighborhoodData::PointBlockSize();
+  for(int firstPoint=0; firstPoint<numPoints; firstPoint+=blockSize){
+    int lastPoint = std::min(firstPoint + blockSize, numPoints);
+    const int* neighborIndices = MATERIAL_EVALUATION::gatherNeighborIndices(neighborhoodList, &bondOffsets[0], firstPoint, lastPoint, neighborIndicesBuffer);
+    computeHourglassForceCSR(volume, horizon, modelCoordinates, coordinates, deformationGradient, hourglassForceDensity, firstPoint, lastPoint, &bondOffsets[0], neighborIndices, bulkModulus, hourglassCoefficient);
+  }
+}
+
+template<typename ScalarT>
+void computeHourglassForceCSR
+(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const ScalarT* coordinates,
+const ScalarT* deformationGradient,
+ScalarT* hourglassForceDensity,
+int firstPoint,
+int lastPoint,
+const int* bondOffsets,
+const int* neighborIndices,
+double bulkModulus,
+double hourglassCoefficient
+)
 {
   double vol, neighborVol;
   double undeformedBondX, undeformedBondY, undeformedBondZ, undeformedBondLength;
@@ -677,14 +768,14 @@ double hourglassCoefficient
   ScalarT dot, magnitude;
   int neighborIndex, numNeighbors;
 
-  const ScalarT* defGrad = deformationGradient;
+  const ScalarT* defGrad = deformationGradient + 9*firstPoint;
 
-  const double* delta = horizon;
-  const double* modelCoord = modelCoordinates;
+  const double* delta = horizon + firstPoint;
+  const double* modelCoord = modelCoordinates + 3*firstPoint;
   const double* neighborModelCoord;
-  const ScalarT* coord = coordinates;
+  const ScalarT* coord = coordinates + 3*firstPoint;
   const ScalarT* neighborCoord;
-  ScalarT* hourglassForceDensityPtr = hourglassForceDensity;
+  ScalarT* hourglassForceDensityPtr = hourglassForceDensity + 3*firstPoint;
   ScalarT* neighborHourglassForceDensityPtr;
 
   // placeholder for inclusion of bond damage
@@ -694,13 +785,13 @@ double hourglassCoefficient
   double firstPartOfConstant = 18.0*hourglassCoefficient*bulkModulus/pi;
   double constant;
 
-  const int *neighborListPtr = neighborhoodList;
-  for(int iID=0 ; iID<numPoints ; ++iID, delta++, modelCoord+=3, coord+=3,
+  const int *neighborListPtr = neighborIndices;
+  for(int iID=firstPoint ; iID<lastPoint ; ++iID, delta++, modelCoord+=3, coord+=3,
         defGrad+=9, hourglassForceDensityPtr+=3){
 
     constant = firstPartOfConstant/( (*delta)*(*delta)*(*delta)*(*delta) );
 
-    numNeighbors = *neighborListPtr; neighborListPtr++;
+    numNeighbors = bondOffsets[iID+1] - bondOffsets[iID];
     for(int n=0; n<numNeighbors; n++, neighborListPtr++){
       neighborIndex = *neighborListPtr;
       neighborModelCoord = modelCoordinates + 3*neighborIndex;
@@ -826,6 +917,20 @@ const int* neighborhoodList,
 int numPoints
 );
 
+template int computeShapeTensorInverseAndApproximateDeformationGradientCSR<double>
+(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const double* coordinates,
+double* shapeTensorInverse,
+double* deformationGradient,
+int firstPoint,
+int lastPoint,
+const int* bondOffsets,
+const int* neighborIndices
+);
+
 template int computeUnrotatedRateOfDeformationAndRotationTensor<double>
 (
 const double* volume,
@@ -844,6 +949,26 @@ int numPoints,
 double dt
 );
 
+template int computeUnrotatedRateOfDeformationAndRotationTensorCSR<double>
+(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const double* velocities,
+const double* deformationGradient,
+const double* shapeTensorInverse,
+const double* leftStretchTensorN,
+const double* rotationTensorN,
+double* leftStretchTensorNP1,
+double* rotationTensorNP1,
+double* unrotatedRateOfDeformation,
+int firstPoint,
+int lastPoint,
+const int* bondOffsets,
+const int* neighborIndices,
+double dt
+);
+
 template void computeGreenLagrangeStrain<double>
 (
   const double* deformationGradientXX,
@@ -881,6 +1006,22 @@ double bulkModulus,
 double hourglassCoefficient
 );
 
+template void computeHourglassForceCSR<double>
+(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const double* coordinates,
+const double* deformationGradient,
+double* hourglassForceDensity,
+int firstPoint,
+int lastPoint,
+const int* bondOffsets,
+const int* neighborIndices,
+double bulkModulus,
+double hourglassCoefficient
+);
+
 template void setOnesOnDiagonalFullTensor<double>
 (
  double* tensor,
@@ -101,6 +101,22 @@ const int* neighborhoodList,
 int numPoints
 );
 
+//! As computeShapeTensorInverseAndApproximateDeformationGradient(), but evaluates owned points firstPoint through lastPoint-1 using the CSR form of the neighbor list.
+template<typename ScalarT>
+int computeShapeTensorInverseAndApproximateDeformationGradientCSR
+(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const ScalarT* coordinates,
+ScalarT* shapeTensorInverse,
+ScalarT* deformationGradient,
+int firstPoint,
+int lastPoint,
+const int* bondOffsets,
+const int* neighborIndices
+);
+
 // Calculation of stretch rates following Flanagan & Taylor
 template<typename ScalarT>
 int computeUnrotatedRateOfDeformationAndRotationTensor(
@@ -120,6 +136,27 @@ int numPoints,
 double dt
 );
 
+//! As computeUnrotatedRateOfDeformationAndRotationTensor(), but evaluates owned points firstPoint through lastPoint-1 using the CSR form of the neighbor list.
+template<typename ScalarT>
+int computeUnrotatedRateOfDeformationAndRotationTensorCSR(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const ScalarT* velocities,
+const ScalarT* deformationGradient,
+const ScalarT* shapeTensorInverse,
+const ScalarT* leftStretchTensorN,
+const ScalarT* rotationTensorN,
+ScalarT* leftStretchTensorNP1,
+ScalarT* rotationTensorNP1,
+ScalarT* unrotatedRateOfDeformation,
+int firstPoint,
+int lastPoint,
+const int* bondOffsets,
+const int* neighborIndices,
+double dt
+);
+
 //! Green-Lagrange Strain E = 0.5*(F^T F - I).
 template<typename ScalarT>
 void computeGreenLagrangeStrain
@@ -160,6 +197,24 @@ double bulkModulus,
 double hourglassCoefficient
 );
 
+//! As computeHourglassForce(), but evaluates owned points firstPoint through lastPoint-1 using the CSR form of the neighbor list.
+template<typename ScalarT>
+void computeHourglassForceCSR
+(
+const double* volume,
+const double* horizon,
+const double* modelCoordinates,
+const ScalarT* coordinates,
+const ScalarT* deformationGradient,
+ScalarT* hourglassForceDensity,
+int firstPoint,
+int lastPoint,
+const int* bondOffsets,
+const int* neighborIndices,
+double bulkModulus,
+double hourglassCoefficient
+);
+
 template<typename ScalarT>
 void setOnesOnDiagonalFullTensor(ScalarT* tensor, int numPoints);
 
@@ -46,7 +46,12 @@
 //@HEADER
 
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include <Sacado.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "elastic.h"
 #include "material_utilities.h"
 
@@ -72,35 +77,100 @@ void computeInternalForceLinearElastic
         const double* deltaTemperature
 )
 {
+	std::vector<int> bondOffsets, neighborIndicesBuffer;
+	computeBondOffsets(localNeighborList, numOwnedPoints, bondOffsets);
+	const int blockSize = PeridigmNS::NeighborhoodData::PointBlockSize();
+	for(int firstPoint=0; firstPoint<numOwnedPoints; firstPoint+=blockSize){
+		int lastPoint = std::min(firstPoint + blockSize, numOwnedPoints);
+		const int* neighborIndices = gatherNeighborIndices(localNeighborList, &bondOffsets[0], firstPoint, lastPoint, neighborIndicesBuffer);
+		computeInternalForceLinearElasticCSR(xOverlap,yOverlap,mOwned,volumeOverlap,dilatationOwned,bondDamage,fInternalOverlap,partialStressOverlap,firstPoint,lastPoint,&bondOffsets[0],neighborIndices,BULK_MODULUS,SHEAR_MODULUS,horizon,thermalExpansionCoefficient,deltaTemperature);
+	}
+}
+
+/** Explicit template instantiation for double. */
+template void computeInternalForceLinearElastic<double>
+(
+		const double* xOverlap,
+		const double* yOverlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const double* dilatationOwned,
+		const double* bondDamage,
+		double* fInternalOverlap,
+		double* partialStressOverlap,
+		const int*  localNeighborList,
+		int numOwnedPoints,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+        double horizon,
+        double thermalExpansionCoefficient,
+        const double* deltaTemperature
+ );
 
+/** Explicit template instantiation for Sacado::Fad::DFad<double>. */
+template void computeInternalForceLinearElastic<Sacado::Fad::DFad<double> >
+(
+		const double* xOverlap,
+		const Sacado::Fad::DFad<double>* yOverlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const Sacado::Fad::DFad<double>* dilatationOwned,
+		const double* bondDamage,
+		Sacado::Fad::DFad<double>* fInternalOverlap,
+		Sacado::Fad::DFad<double>* partialStressOverlap,
+		const int*  localNeighborList,
+		int numOwnedPoints,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+        double horizon,
+        double thermalExpansionCoefficient,
+        const double* deltaTemperature
+);
+
+template<typename ScalarT>
+void computeInternalForceLinearElasticCSR
+(
+		const double* xOverlap,
+		const ScalarT* yOverlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const ScalarT* dilatationOwned,
+		const double* bondDamage,
+		ScalarT* fInternalOverlap,
+		ScalarT* partialStressOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+        double horizon,
+        double thermalExpansionCoefficient,
+        const double* deltaTemperature
+)
+{
 	/*
 	 * Compute processor local contribution to internal force
 	 */
 	double K = BULK_MODULUS;
 	double MU = SHEAR_MODULUS;
 
-	const double *xOwned = xOverlap;
-	const ScalarT *yOwned = yOverlap;
-    const double *deltaT = deltaTemperature;
-	const double *m = mOwned;
-	const double *v = volumeOverlap;
-	const ScalarT *theta = dilatationOwned;
-	ScalarT *fOwned = fInternalOverlap;
-	ScalarT *psOwned = partialStressOverlap;
-
-	const int *neighPtr = localNeighborList;
-	double cellVolume, alpha, X_dx, X_dy, X_dz, zeta, omega;
+	double cellVolume, alpha, X_dx, X_dy, X_dz, zeta, omega, damage;
 	ScalarT Y_dx, Y_dy, Y_dz, dY, t, fx, fy, fz, e, c1;
-	for(int p=0;p<numOwnedPoints;p++, xOwned +=3, yOwned +=3, fOwned+=3, psOwned+=9, deltaT++, m++, theta++){
-
-		int numNeigh = *neighPtr; neighPtr++;
-		const double *X = xOwned;
-		const ScalarT *Y = yOwned;
-		alpha = 15.0*MU/(*m);
-		double selfCellVolume = v[p];
-		for(int n=0;n<numNeigh;n++,neighPtr++,bondDamage++){
-			int localId = *neighPtr;
-			cellVolume = v[localId];
+	const int firstBond = bondOffsets[firstPoint];
+	for(int p=firstPoint;p<lastPoint;p++){
+
+		const double *X = &xOverlap[3*p];
+		const ScalarT *Y = &yOverlap[3*p];
+		ScalarT *fOwned = &fInternalOverlap[3*p];
+		const double m = mOwned[p];
+		const ScalarT theta = dilatationOwned[p];
+		alpha = 15.0*MU/m;
+		double selfCellVolume = volumeOverlap[p];
+		for(int bondIndex=bondOffsets[p];bondIndex<bondOffsets[p+1];bondIndex++){
+			int localId = neighborIndices[bondIndex-firstBond];
+			damage = bondDamage[bondIndex];
+			cellVolume = volumeOverlap[localId];
 			const double *XP = &xOverlap[3*localId];
 			const ScalarT *YP = &yOverlap[3*localId];
 			X_dx = XP[0]-X[0];
@@ -111,42 +181,42 @@ void computeInternalForceLinearElastic
 			Y_dy = YP[1]-Y[1];
 			Y_dz = YP[2]-Y[2];
 			dY = sqrt(Y_dx*Y_dx+Y_dy*Y_dy+Y_dz*Y_dz);
-            e = dY - zeta;
-            if(deltaTemperature)
-              e -= thermalExpansionCoefficient*(*deltaT)*zeta;
+			e = dY - zeta;
+			if(deltaTemperature)
+			  e -= thermalExpansionCoefficient*deltaTemperature[p]*zeta;
 			omega = scalarInfluenceFunction(zeta,horizon);
-			// c1 = omega*(*theta)*(9.0*K-15.0*MU)/(3.0*(*m));
-			c1 = omega*(*theta)*(3.0*K/(*m)-alpha/3.0);
-			t = (1.0-*bondDamage)*(c1 * zeta + (1.0-*bondDamage) * omega * alpha * e);
+			// c1 = omega*theta*(9.0*K-15.0*MU)/(3.0*m);
+			c1 = omega*theta*(3.0*K/m-alpha/3.0);
+			t = (1.0-damage)*(c1 * zeta + (1.0-damage) * omega * alpha * e);
 			fx = t * Y_dx / dY;
 			fy = t * Y_dy / dY;
 			fz = t * Y_dz / dY;
 
-			*(fOwned+0) += fx*cellVolume;
-			*(fOwned+1) += fy*cellVolume;
-			*(fOwned+2) += fz*cellVolume;
+			fOwned[0] += fx*cellVolume;
+			fOwned[1] += fy*cellVolume;
+			fOwned[2] += fz*cellVolume;
 			fInternalOverlap[3*localId+0] -= fx*selfCellVolume;
 			fInternalOverlap[3*localId+1] -= fy*selfCellVolume;
 			fInternalOverlap[3*localId+2] -= fz*selfCellVolume;
 
 			if(partialStressOverlap != 0){
-			  *(psOwned+0) += fx*X_dx*cellVolume;
-			  *(psOwned+1) += fx*X_dy*cellVolume;
-			  *(psOwned+2) += fx*X_dz*cellVolume;
-			  *(psOwned+3) += fy*X_dx*cellVolume;
-			  *(psOwned+4) += fy*X_dy*cellVolume;
-			  *(psOwned+5) += fy*X_dz*cellVolume;
-			  *(psOwned+6) += fz*X_dx*cellVolume;
-			  *(psOwned+7) += fz*X_dy*cellVolume;
-			  *(psOwned+8) += fz*X_dz*cellVolume;
+			  ScalarT *psOwned = &partialStressOverlap[9*p];
+			  psOwned[0] += fx*X_dx*cellVolume;
+			  psOwned[1] += fx*X_dy*cellVolume;
+			  psOwned[2] += fx*X_dz*cellVolume;
+			  psOwned[3] += fy*X_dx*cellVolume;
+			  psOwned[4] += fy*X_dy*cellVolume;
+			  psOwned[5] += fy*X_dz*cellVolume;
+			  psOwned[6] += fz*X_dx*cellVolume;
+			  psOwned[7] += fz*X_dy*cellVolume;
+			  psOwned[8] += fz*X_dz*cellVolume;
 			}
 		}
-
 	}
 }
 
 /** Explicit template instantiation for double. */
-template void computeInternalForceLinearElastic<double>
+template void computeInternalForceLinearElasticCSR<double>
 (
 		const double* xOverlap,
 		const double* yOverlap,
@@ -156,17 +226,19 @@ template void computeInternalForceLinearElastic<double>
 		const double* bondDamage,
 		double* fInternalOverlap,
 		double* partialStressOverlap,
-		const int*  localNeighborList,
-		int numOwnedPoints,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
 		double BULK_MODULUS,
 		double SHEAR_MODULUS,
         double horizon,
         double thermalExpansionCoefficient,
         const double* deltaTemperature
- );
+);
 
 /** Explicit template instantiation for Sacado::Fad::DFad<double>. */
-template void computeInternalForceLinearElastic<Sacado::Fad::DFad<double> >
+template void computeInternalForceLinearElasticCSR<Sacado::Fad::DFad<double> >
 (
 		const double* xOverlap,
 		const Sacado::Fad::DFad<double>* yOverlap,
@@ -176,8 +248,10 @@ template void computeInternalForceLinearElastic<Sacado::Fad::DFad<double> >
 		const double* bondDamage,
 		Sacado::Fad::DFad<double>* fInternalOverlap,
 		Sacado::Fad::DFad<double>* partialStressOverlap,
-		const int*  localNeighborList,
-		int numOwnedPoints,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
 		double BULK_MODULUS,
 		double SHEAR_MODULUS,
         double horizon,
@@ -185,4 +259,70 @@ template void computeInternalForceLinearElastic<Sacado::Fad::DFad<double> >
         const double* deltaTemperature
 );
 
+void computeInternalForceLinearElasticCSR
+(
+		const double* xOverlap,
+		const double* yOverlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const double* dilatationOwned,
+		const double* bondDamage,
+		double* fInternalOverlap,
+		double* partialStressOverlap,
+		const PeridigmNS::NeighborhoodData& neighborhoodData,
+		int numOverlapPoints,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+        double horizon,
+        double thermalExpansionCoefficient,
+        const double* deltaTemperature
+)
+{
+	const int numOwnedPoints = neighborhoodData.NumOwnedPoints();
+	const int* bondOffsets = neighborhoodData.BondOffsets();
+	const int blockSize = PeridigmNS::NeighborhoodData::PointBlockSize();
+	const int numPointBlocks = (numOwnedPoints + blockSize - 1)/blockSize;
+
+	int numThreads(1);
+#ifdef _OPENMP
+	numThreads = std::min(omp_get_max_threads(), std::max(numPointBlocks, 1));
+#endif
+	// Thread 0 accumulates directly into fInternalOverlap, the other threads into their own arrays;
+	// the partial stress is written only for owned points, so the threads never share an entry
+	const int length = 3*numOverlapPoints;
+	std::vector<double> threadForce(numThreads > 1 ? static_cast<size_t>(numThreads-1)*length : 0, 0.0);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(numThreads)
+#endif
+	{
+		int thread(0);
+#ifdef _OPENMP
+		thread = omp_get_thread_num();
+#endif
+		double* force = (thread == 0) ? fInternalOverlap : &threadForce[static_cast<size_t>(thread-1)*length];
+		std::vector<int> neighborIndicesBuffer;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+		for(int pointBlock=0; pointBlock<numPointBlocks; pointBlock++){
+			int firstPoint = pointBlock*blockSize;
+			int lastPoint = std::min(firstPoint + blockSize, numOwnedPoints);
+			const int* neighborIndices = neighborhoodData.NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+			computeInternalForceLinearElasticCSR(xOverlap,yOverlap,mOwned,volumeOverlap,dilatationOwned,bondDamage,force,partialStressOverlap,firstPoint,lastPoint,bondOffsets,neighborIndices,BULK_MODULUS,SHEAR_MODULUS,horizon,thermalExpansionCoefficient,deltaTemperature);
+		}
+	}
+
+	// Sum the per-thread contributions
+	if(numThreads > 1){
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(numThreads)
+#endif
+		for(int i=0; i<length; i++){
+			for(int thread=1; thread<numThreads; thread++)
+				fInternalOverlap[i] += threadForce[static_cast<size_t>(thread-1)*length + i];
+		}
+	}
+}
+
 }
@@ -47,9 +47,11 @@
 #ifndef ELASTIC_H
 #define ELASTIC_H
 
+#include "Peridigm_NeighborhoodData.hpp"
+
 namespace MATERIAL_EVALUATION {
 
-//! Computes contributions to the internal force resulting from owned points.
+//! Computes contributions to the internal force resulting from owned points, using an interleaved neighbor list; see computeInternalForceLinearElasticCSR().
 template<typename ScalarT>
 void computeInternalForceLinearElastic
 (
@@ -71,6 +73,61 @@ void computeInternalForceLinearElastic
 
 );
 
+/** \brief Computes contributions to the internal force resulting from owned points, using the
+ *  compressed sparse row (CSR) view of the neighborhood data.
+ *
+ *  Owned points firstPoint through lastPoint-1 are evaluated.  The bonds of owned point p are bondOffsets[p] through
+ *  bondOffsets[p+1]-1, and the neighbor of bond bondIndex is neighborIndices[bondIndex - bondOffsets[firstPoint]].
+ */
+template<typename ScalarT>
+void computeInternalForceLinearElasticCSR
+(
+		const double* xOverlapPtr,
+		const ScalarT* yOverlapPtr,
+		const double* mOwned,
+		const double* volumeOverlapPtr,
+		const ScalarT* dilatationOwned,
+		const double* bondDamage,
+		ScalarT* fInternalOverlapPtr,
+		ScalarT* partialStressOverlapPtr,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+        double horizon,
+        double thermalExpansionCoefficient = 0,
+        const double* deltaTemperature = 0
+);
+
+
+/** \brief Computes contributions to the internal force resulting from all the owned points of the given
+ *  neighborhood data, which must be in CSR form.
+ *
+ *  The points are evaluated with computeInternalForceLinearElasticCSR() in blocks of NeighborhoodData::PointBlockSize().
+ *  If OpenMP is enabled the blocks are distributed over the threads, each of which accumulates the forces on neighbors
+ *  into its own array of length 3*numOverlapPoints; these are summed into fInternalOverlapPtr at the end.
+ */
+void computeInternalForceLinearElasticCSR
+(
+		const double* xOverlapPtr,
+		const double* yOverlapPtr,
+		const double* mOwned,
+		const double* volumeOverlapPtr,
+		const double* dilatationOwned,
+		const double* bondDamage,
+		double* fInternalOverlapPtr,
+		double* partialStressOverlapPtr,
+		const PeridigmNS::NeighborhoodData& neighborhoodData,
+		int numOverlapPoints,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+        double horizon,
+        double thermalExpansionCoefficient = 0,
+        const double* deltaTemperature = 0
+);
+
 }
 
 #endif // ELASTIC_H
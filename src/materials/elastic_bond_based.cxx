@@ -46,6 +46,8 @@
 //@HEADER
 
 #include <cmath>
+#include <vector>
+#include <algorithm>
 #include <Sacado.hpp>
 #include <boost/math/constants/constants.hpp>
 #include "elastic_bond_based.h"
@@ -66,15 +68,42 @@ void computeInternalForceElasticBondBased
 		double BULK_MODULUS,
         double horizon
 )
+{
+  std::vector<int> bondOffsets, neighborIndicesBuffer;
+  computeBondOffsets(localNeighborList, numOwnedPoints, bondOffsets);
+  const int blockSize = PeridigmNS::NeighborhoodData::PointBlockSize();
+  for(int firstPoint=0; firstPoint<numOwnedPoints; firstPoint+=blockSize){
+    int lastPoint = std::min(firstPoint + blockSize, numOwnedPoints);
+    const int* neighborIndices = gatherNeighborIndices(localNeighborList, &bondOffsets[0], firstPoint, lastPoint, neighborIndicesBuffer);
+    computeInternalForceElasticBondBasedCSR(xOverlap,yOverlap,volumeOverlap,bondDamage,fInternalOverlap,firstPoint,lastPoint,&bondOffsets[0],neighborIndices,BULK_MODULUS,horizon);
+  }
+}
+
+template<typename ScalarT>
+void computeInternalForceElasticBondBasedCSR
+(
+		const double* xOverlap,
+		const ScalarT* yOverlap,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		ScalarT* fInternalOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+        double horizon
+)
 {
   double volume, neighborVolume, X[3], neighborX[3], initialBondLength, damageOnBond;
   ScalarT Y[3], neighborY[3], currentBondLength, stretch, t, fx, fy, fz;
-  int neighborhoodIndex(0), bondDamageIndex(0), neighborId;
+  int neighborId;
 
   const double pi = boost::math::constants::pi<double>();
   double constant = 18.0*BULK_MODULUS/(pi*horizon*horizon*horizon*horizon);
 
-  for(int p=0 ; p<numOwnedPoints ; p++){
+  const int firstBond = bondOffsets[firstPoint];
+  for(int p=firstPoint ; p<lastPoint ; p++){
 
     X[0] = xOverlap[p*3];
     X[1] = xOverlap[p*3+1];
@@ -84,10 +113,9 @@ void computeInternalForceElasticBondBased
     Y[2] = yOverlap[p*3+2];
     volume = volumeOverlap[p];
 
-    int numNeighbors = localNeighborList[neighborhoodIndex++];
-	for(int n=0; n<numNeighbors; n++){
+	for(int bondIndex=bondOffsets[p]; bondIndex<bondOffsets[p+1]; bondIndex++){
 
-      neighborId = localNeighborList[neighborhoodIndex++];
+      neighborId = neighborIndices[bondIndex-firstBond];
       neighborX[0] = xOverlap[neighborId*3];
       neighborX[1] = xOverlap[neighborId*3+1];
       neighborX[2] = xOverlap[neighborId*3+2];
@@ -100,7 +128,7 @@ void computeInternalForceElasticBondBased
       currentBondLength = std::sqrt( (neighborY[0]-Y[0])*(neighborY[0]-Y[0]) + (neighborY[1]-Y[1])*(neighborY[1]-Y[1]) + (neighborY[2]-Y[2])*(neighborY[2]-Y[2]) );
       stretch = (currentBondLength - initialBondLength)/initialBondLength;
 
-      damageOnBond = bondDamage[bondDamageIndex++];
+      damageOnBond = bondDamage[bondIndex];
 
       t = 0.5*(1.0 - damageOnBond)*stretch*constant;
 
@@ -146,4 +174,37 @@ template void computeInternalForceElasticBondBased<Sacado::Fad::DFad<double> >
         double horizon
 );
 
+
+/** Explicit template instantiation for double. */
+template void computeInternalForceElasticBondBasedCSR<double>
+(
+		const double* xOverlap,
+		const double* yOverlap,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		double* fInternalOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+        double horizon
+ );
+
+/** Explicit template instantiation for Sacado::Fad::DFad<double>. */
+template void computeInternalForceElasticBondBasedCSR<Sacado::Fad::DFad<double> >
+(
+		const double* xOverlap,
+		const Sacado::Fad::DFad<double>* yOverlap,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		Sacado::Fad::DFad<double>* fInternalOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+        double horizon
+);
+
 }
@@ -49,7 +49,7 @@
 
 namespace MATERIAL_EVALUATION {
 
-//! Computes contributions to the internal force resulting from owned points.
+//! Computes contributions to the internal force resulting from owned points, using an interleaved neighbor list; see computeInternalForceElasticBondBasedCSR().
 template<typename ScalarT>
 void computeInternalForceElasticBondBased
 (
@@ -64,6 +64,28 @@ void computeInternalForceElasticBondBased
         double horizon
 );
 
+/** \brief Computes contributions to the internal force resulting from owned points, using the
+ *  compressed sparse row (CSR) view of the neighborhood data.
+ *
+ *  Owned points firstPoint through lastPoint-1 are evaluated.  The bonds of owned point p are bondOffsets[p] through
+ *  bondOffsets[p+1]-1, and the neighbor of bond bondIndex is neighborIndices[bondIndex - bondOffsets[firstPoint]].
+ */
+template<typename ScalarT>
+void computeInternalForceElasticBondBasedCSR
+(
+		const double* xOverlapPtr,
+		const ScalarT* yOverlapPtr,
+		const double* volumeOverlapPtr,
+		const double* bondDamage,
+		ScalarT* fInternalOverlapPtr,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+        double horizon
+);
+
 }
 
 #endif // ELASTIC_BOND_BASED_H
@@ -45,8 +45,11 @@
 // ************************************************************************
 //@HEADER
 #include <cmath>
+#include <vector>
+#include <algorithm>
 #include <Sacado.hpp>
 #include "elastic_plastic.h"
+#include "material_utilities.h"
 
 namespace MATERIAL_EVALUATION {
 
@@ -135,6 +138,42 @@ void computeInternalForceIsotropicElasticPlastic
 		bool isPlanarProblem,
 		double thickness
 )
+{
+	std::vector<int> bondOffsets, neighborIndicesBuffer;
+	computeBondOffsets(localNeighborList, numOwnedPoints, bondOffsets);
+	const int blockSize = PeridigmNS::NeighborhoodData::PointBlockSize();
+	for(int firstPoint=0; firstPoint<numOwnedPoints; firstPoint+=blockSize){
+		int lastPoint = std::min(firstPoint + blockSize, numOwnedPoints);
+		const int* neighborIndices = gatherNeighborIndices(localNeighborList, &bondOffsets[0], firstPoint, lastPoint, neighborIndicesBuffer);
+		computeInternalForceIsotropicElasticPlasticCSR(xOverlap,yNP1Overlap,mOwned,volumeOverlap,dilatationOwned,bondDamage,deviatoricPlasticExtensionStateN,deviatoricPlasticExtensionStateNp1,lambdaN,lambdaNP1,fInternalOverlap,firstPoint,lastPoint,&bondOffsets[0],neighborIndices,BULK_MODULUS,SHEAR_MODULUS,HORIZON,yieldStress,isPlanarProblem,thickness);
+	}
+}
+
+template<typename ScalarT>
+void computeInternalForceIsotropicElasticPlasticCSR
+(
+		const double* xOverlap,
+		const ScalarT* yNP1Overlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const ScalarT* dilatationOwned,
+		const double* bondDamage,
+		const double* deviatoricPlasticExtensionStateN,
+		ScalarT* deviatoricPlasticExtensionStateNp1,
+		const double* lambdaN,
+		ScalarT* lambdaNP1,
+		ScalarT* fInternalOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+		double HORIZON,
+		double yieldStress,
+		bool isPlanarProblem,
+		double thickness
+)
 {
 	/*
 	 * Compute processor local contribution to internal force
@@ -151,32 +190,30 @@ void computeInternalForceIsotropicElasticPlastic
 	if(isPlanarProblem)
     	yieldValue = 225.0 / 3. * yieldStress * yieldStress / 8 / M_PI / THICKNESS / pow(DELTA,4);
 
-	const double *xOwned = xOverlap;
-	const ScalarT *yOwned = yNP1Overlap;
-	const double *m = mOwned;
 	const double *v = volumeOverlap;
-	const ScalarT *theta = dilatationOwned;
-	ScalarT *fOwned = fInternalOverlap;
+	const int firstBond = bondOffsets[firstPoint];
 
-	const int *neighPtr = localNeighborList;
 	double cellVolume, alpha, dx_X, dy_X, dz_X, zeta, edpN;
     ScalarT dx_Y, dy_Y, dz_Y, dY, ed, tdTrial, t, ti, td;
-	for(int p=0;p<numOwnedPoints;p++, xOwned +=3, yOwned +=3, fOwned+=3, m++, theta++, lambdaN++, lambdaNP1++){
-
-		int numNeigh = *neighPtr; neighPtr++;
-		const double *X = xOwned;
-		const ScalarT *Y = yOwned;
-		double weightedVol = *m;
+	for(int p=firstPoint;p<lastPoint;p++){
+
+		int numNeigh = bondOffsets[p+1] - bondOffsets[p];
+		const int *neighPtr = &neighborIndices[bondOffsets[p]-firstBond];
+		const double *X = &xOverlap[3*p];
+		const ScalarT *Y = &yNP1Overlap[3*p];
+		ScalarT *fOwned = &fInternalOverlap[3*p];
+		const ScalarT theta = dilatationOwned[p];
+		double weightedVol = mOwned[p];
 		alpha = 15.0*MU/weightedVol;
 		double selfCellVolume = v[p];
-		ScalarT c = 3 * K * (*theta) * OMEGA / weightedVol;
+		ScalarT c = 3 * K * theta * OMEGA / weightedVol;
 		ScalarT deltaLambda=0.0;
 
 		/*
 		 * Compute norm of trial stress
 		 */
 		ScalarT tdNorm = 0.0;
-		tdNorm = computeDeviatoricForceStateNorm(numNeigh,*theta,neighPtr,bondDamage,deviatoricPlasticExtensionStateN,X,Y,xOverlap,yNP1Overlap,v,alpha,OMEGA);
+		tdNorm = computeDeviatoricForceStateNorm(numNeigh,theta,neighPtr,&bondDamage[bondOffsets[p]],&deviatoricPlasticExtensionStateN[bondOffsets[p]],X,Y,xOverlap,yNP1Overlap,v,alpha,OMEGA);
 
 		/*
 		 * Evaluate yield function
@@ -189,15 +226,14 @@ void computeInternalForceIsotropicElasticPlastic
 			/*
 			 * This step is incrementally plastic
 			 */
-			//			std::cout << "\t PLASTIC" << std::endl;
 			elastic = false;
 			deltaLambda=( tdNorm / sqrt(2.0*pointWiseYieldValue) - 1.0 ) / alpha;
-			*lambdaNP1 = *lambdaN + deltaLambda;
+			lambdaNP1[p] = lambdaN[p] + deltaLambda;
 		} else {
-			*lambdaNP1 = *lambdaN;
+			lambdaNP1[p] = lambdaN[p];
 		}
 
-		for(int n=0;n<numNeigh;n++,neighPtr++,bondDamage++, deviatoricPlasticExtensionStateN++, deviatoricPlasticExtensionStateNp1++){
+		for(int bondIndex=bondOffsets[p];bondIndex<bondOffsets[p+1];bondIndex++,neighPtr++){
 			int localId = *neighPtr;
 			cellVolume = v[localId];
 			const double *XP = &xOverlap[3*localId];
@@ -213,12 +249,12 @@ void computeInternalForceIsotropicElasticPlastic
 			/*
 			 * Deviatoric extension state
 			 */
-			ed = dY-zeta-*theta*zeta/3;
+			ed = dY-zeta-theta*zeta/3;
 
 			/*
 			 * Deviatoric plastic extension state from last step
 			 */
-			edpN = *deviatoricPlasticExtensionStateN;
+			edpN = deviatoricPlasticExtensionStateN[bondIndex];
 
 			/*
 			 * Compute trial stress
@@ -237,7 +273,7 @@ void computeInternalForceIsotropicElasticPlastic
 				/*
 				 * Therefore edpNp1 = edpN
 				 */
-				*deviatoricPlasticExtensionStateNp1 = *deviatoricPlasticExtensionStateN;
+				deviatoricPlasticExtensionStateNp1[bondIndex] = edpN;
 
 			} else {
 				/*
@@ -248,7 +284,7 @@ void computeInternalForceIsotropicElasticPlastic
 				/*
 				 * Update deviatoric plastic deformation state
 				 */
-				*deviatoricPlasticExtensionStateNp1 = edpN + td * deltaLambda;
+				deviatoricPlasticExtensionStateNp1[bondIndex] = edpN + td * deltaLambda;
 			}
 			/*
 			 * Compute isotropic part of force state
@@ -258,7 +294,7 @@ void computeInternalForceIsotropicElasticPlastic
 			/*
 			 * Force state (with damage)
 			 */
-			double d=(1.0-*bondDamage);
+			double d=(1.0-bondDamage[bondIndex]);
 			t = d*(ti + d*td);
 
 			/*
@@ -360,5 +396,58 @@ template void computeInternalForceIsotropicElasticPlastic<Sacado::Fad::DFad<doub
 		double thickness
 );
 
+
+/** Explicit template instantiation for double. */
+template void computeInternalForceIsotropicElasticPlasticCSR<double>
+(
+		const double* xOverlap,
+		const double* yNP1Overlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const double* dilatationOwned,
+		const double* bondDamage,
+		const double* deviatoricPlasticExtensionStateN,
+		double* deviatoricPlasticExtensionStateNp1,
+		const double* lambdaN,
+		double* lambdaNP1,
+		double* fInternalOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+		double HORIZON,
+		double yieldStress,
+		bool isPlanarProblem,
+		double thickness
+);
+
+/** Explicit template instantiation for Sacado::Fad::DFad<double>. */
+template void computeInternalForceIsotropicElasticPlasticCSR<Sacado::Fad::DFad<double> >
+(
+		const double* xOverlap,
+		const Sacado::Fad::DFad<double>* yNP1Overlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const Sacado::Fad::DFad<double>* dilatationOwned,
+		const double* bondDamage,
+		const double* deviatoricPlasticExtensionStateN,
+		Sacado::Fad::DFad<double>* deviatoricPlasticExtensionStateNp1,
+		const double* lambdaN,
+		Sacado::Fad::DFad<double>* lambdaNP1,
+		Sacado::Fad::DFad<double>* fInternalOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+		double HORIZON,
+		double yieldStress,
+		bool isPlanarProblem,
+		double thickness
+);
+
 }
 
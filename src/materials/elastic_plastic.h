@@ -81,6 +81,7 @@ ScalarT computeDeviatoricForceStateNorm
 		double OMEGA
 );
 
+//! Computes the internal force and plastic state of owned points, using an interleaved neighbor list; see computeInternalForceIsotropicElasticPlasticCSR().
 template<typename ScalarT>
 void computeInternalForceIsotropicElasticPlastic
 (
@@ -105,6 +106,38 @@ void computeInternalForceIsotropicElasticPlastic
 		double thickness
 );
 
+/** \brief Computes the internal force and plastic state of owned points, using the compressed sparse row (CSR)
+ *  view of the neighborhood data.
+ *
+ *  Owned points firstPoint through lastPoint-1 are evaluated.  The bonds of owned point p are bondOffsets[p] through
+ *  bondOffsets[p+1]-1, and the neighbor of bond bondIndex is neighborIndices[bondIndex - bondOffsets[firstPoint]].
+ */
+template<typename ScalarT>
+void computeInternalForceIsotropicElasticPlasticCSR
+(
+		const double* xOverlap,
+		const ScalarT* yNP1Overlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const ScalarT* dilatationOwned,
+		const double* bondDamage,
+		const double* deviatoricPlasticExtensionStateN,
+		ScalarT* deviatoricPlasticExtensionStateNp1,
+		const double* lambdaN,
+		ScalarT* lambdaNP1,
+		ScalarT* fInternalOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+		double HORIZON,
+		double yieldStress,
+		bool isPlanarProblem,
+		double thickness
+);
+
 }
 
 #endif // ELASTIC_PLASTIC_H
@@ -49,7 +49,10 @@
 #include <float.h>
 #include "elastic_plastic.h"
 #include "elastic_plastic_hardening.h"
+#include "material_utilities.h"
 #include <complex>
+#include <vector>
+#include <algorithm>
 
 namespace MATERIAL_EVALUATION {
 
@@ -81,6 +84,42 @@ void computeInternalForceIsotropicHardeningPlastic
 		double yieldStress,
 		double HARD_MODULUS
 )
+{
+	std::vector<int> bondOffsets, neighborIndicesBuffer;
+	computeBondOffsets(localNeighborList, numOwnedPoints, bondOffsets);
+	const int blockSize = PeridigmNS::NeighborhoodData::PointBlockSize();
+	for(int firstPoint=0; firstPoint<numOwnedPoints; firstPoint+=blockSize){
+		int lastPoint = std::min(firstPoint + blockSize, numOwnedPoints);
+		const int* neighborIndices = gatherNeighborIndices(localNeighborList, &bondOffsets[0], firstPoint, lastPoint, neighborIndicesBuffer);
+		computeInternalForceIsotropicHardeningPlasticCSR(xOverlap,yNP1Overlap,mOwned,volumeOverlap,dilatationOwned,bondDamage,scfOwned,deviatoricPlasticExtensionStateN,deviatoricPlasticExtensionStateNp1,lambdaN,lambdaNP1,fInternalOverlap,firstPoint,lastPoint,&bondOffsets[0],neighborIndices,BULK_MODULUS,SHEAR_MODULUS,HORIZON,yieldStress,HARD_MODULUS);
+	}
+}
+
+template<typename ScalarT>
+void computeInternalForceIsotropicHardeningPlasticCSR
+(
+		const double* xOverlap,
+		const ScalarT* yNP1Overlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const ScalarT* dilatationOwned,
+		const double* bondDamage,
+		const double* scfOwned,
+		const double* deviatoricPlasticExtensionStateN,
+		ScalarT* deviatoricPlasticExtensionStateNp1,
+		const double* lambdaN,
+		ScalarT* lambdaNP1,
+		ScalarT* fInternalOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+		double HORIZON,
+		double yieldStress,
+		double HARD_MODULUS
+)
 {
 
 	/*
@@ -95,51 +134,42 @@ void computeInternalForceIsotropicHardeningPlastic
 	 * 3d variety of yield value 
 	 */
 	double yieldValue = 25.0 * yieldStress * yieldStress / 8 / M_PI / pow(DELTA,5);
-	/*
-	 * Planar variety of yield value
-	 */
-//		double THICKNESS=1.0;
-//		double yieldValue = 225.0 * yieldStress * yieldStress / 8 / M_PI / THICKNESS / pow(DELTA,4);
-//		double yieldValue = 0.5 * pow(15*yieldStress/weightedVol,2) * M_PI * THICKNESS * pow(DELTA,4) / 16.0;
 
-
-	const double *xOwned = xOverlap;
-	const ScalarT *yOwned = yNP1Overlap;
-	const double *m = mOwned;
 	const double *v = volumeOverlap;
-	const ScalarT *theta = dilatationOwned;
-	ScalarT *fOwned = fInternalOverlap;
+	const int firstBond = bondOffsets[firstPoint];
 
-	const int *neighPtr = localNeighborList;
 	double cellVolume, alpha, dx_X, dy_X, dz_X, zeta, edpN;
     ScalarT dx_Y, dy_Y, dz_Y, dY, ed, tdTrial, t, ti, td;
-	for(int p=0;p<numOwnedPoints;p++, xOwned +=3, yOwned +=3, fOwned+=3, m++, theta++, lambdaN++, lambdaNP1++, scfOwned++){
-
-		int numNeigh = *neighPtr; neighPtr++;
-		const double *X = xOwned;
-		const ScalarT *Y = yOwned;
-		double weightedVol = *m;
-		alpha = *scfOwned * 15.0*MU/weightedVol;
+	for(int p=firstPoint;p<lastPoint;p++){
+
+		int numNeigh = bondOffsets[p+1] - bondOffsets[p];
+		const int *neighPtr = &neighborIndices[bondOffsets[p]-firstBond];
+		const double *X = &xOverlap[3*p];
+		const ScalarT *Y = &yNP1Overlap[3*p];
+		ScalarT *fOwned = &fInternalOverlap[3*p];
+		const ScalarT theta = dilatationOwned[p];
+		double weightedVol = mOwned[p];
+		alpha = scfOwned[p] * 15.0*MU/weightedVol;
 		double selfCellVolume = v[p];
-		ScalarT c = 3 * K * (*theta) * OMEGA / weightedVol;
+		ScalarT c = 3 * K * theta * OMEGA / weightedVol;
 		ScalarT deltaLambda=0.0;
 
 		/*
 		 * Compute norm of trial stress
 		 */
 		ScalarT tdNorm = 0.0;
-		tdNorm = computeDeviatoricForceStateNorm(numNeigh,*theta,neighPtr,bondDamage,deviatoricPlasticExtensionStateN,X,Y,xOverlap,yNP1Overlap,v,alpha,OMEGA);
+		tdNorm = computeDeviatoricForceStateNorm(numNeigh,theta,neighPtr,&bondDamage[bondOffsets[p]],&deviatoricPlasticExtensionStateN[bondOffsets[p]],X,Y,xOverlap,yNP1Overlap,v,alpha,OMEGA);
 
 		/*
 		 * Evaluate yield function
 		 */
-		double pointWiseYieldValue = *scfOwned * (*scfOwned) * yieldValue;
+		double pointWiseYieldValue = scfOwned[p] * scfOwned[p] * yieldValue;
 
         /*
          * Compute lambdaNP1 using a backward Euler implicit scheme
         */
         if (tdNorm * tdNorm / 2 - pointWiseYieldValue > 0){
-            deltaLambda = updateDeltaLambda(tdNorm, *lambdaN, pointWiseYieldValue, alpha, H);
+            deltaLambda = updateDeltaLambda(tdNorm, lambdaN[p], pointWiseYieldValue, alpha, H);
             if (deltaLambda < 0.0 ){
                 deltaLambda = 0.0;
             }
@@ -147,29 +177,18 @@ void computeInternalForceIsotropicHardeningPlastic
             deltaLambda = 0.0;
         }
 
-
-        //ScalarT f = tdNorm * tdNorm / 2 - pointWiseYieldValue - HARD_MODULUS*(deltaLambda + (*lambdaN));
-		//ScalarT f = tdNorm * tdNorm / 2 - pointWiseYieldValue;
 		bool elastic = true;
-
-//		std::cout << "Point id = " << p << std::endl;
-//		std::cout << "\tyieldStress/m^(4/5) = " << yieldStress/pow(weightedVol,4/5) << std::endl;
-//		std::cout << "\tYield Value = " << yieldValue << "; tdNorm * tdNorm / 2 = " << tdNorm * tdNorm / 2 << std::endl;
 		if(deltaLambda>0){
 			/*
 			 * This step is incrementally plastic
 			 */
-			//			std::cout << "\t PLASTIC" << std::endl;
 			elastic = false;
-            //deltaLambda= (*lambdaNP1 - *lambdaN);
-			//deltaLambda=( tdNorm / sqrt(2.0*pointWiseYieldValue) - 1.0 ) / alpha;
-			*lambdaNP1 = *lambdaN + deltaLambda;
+			lambdaNP1[p] = lambdaN[p] + deltaLambda;
 		} else {
-// 			std::cout << "\t ELASTIC" << std::endl;
-			*lambdaNP1 = *lambdaN;
+			lambdaNP1[p] = lambdaN[p];
 		}
 
-		for(int n=0;n<numNeigh;n++,neighPtr++,bondDamage++, deviatoricPlasticExtensionStateN++, deviatoricPlasticExtensionStateNp1++){
+		for(int bondIndex=bondOffsets[p];bondIndex<bondOffsets[p+1];bondIndex++,neighPtr++){
 			int localId = *neighPtr;
 			cellVolume = v[localId];
 			const double *XP = &xOverlap[3*localId];
@@ -185,12 +204,12 @@ void computeInternalForceIsotropicHardeningPlastic
 			/*
 			 * Deviatoric extension state
 			 */
-			ed = dY-zeta-*theta*zeta/3;
+			ed = dY-zeta-theta*zeta/3;
 
 			/*
 			 * Deviatoric plastic extension state from last step
 			 */
-			edpN = *deviatoricPlasticExtensionStateN;
+			edpN = deviatoricPlasticExtensionStateN[bondIndex];
 
 			/*
 			 * Compute trial stress
@@ -209,23 +228,19 @@ void computeInternalForceIsotropicHardeningPlastic
 				/*
 				 * Therefore edpNp1 = edpN
 				 */
-				*deviatoricPlasticExtensionStateNp1 = *deviatoricPlasticExtensionStateN;
+				deviatoricPlasticExtensionStateNp1[bondIndex] = edpN;
 
 			} else {
 				/*
 				 * Compute deviatoric force state
 				 */
-				//td = sqrt(2.0*pointWiseYieldValue) * tdTrial / tdNorm;
                 td = tdTrial / (1+alpha*deltaLambda);
 
 				/*
 				 * Update deviatoric plastic deformation state
 				 */
-				*deviatoricPlasticExtensionStateNp1 = edpN + td * deltaLambda;
-
-//				std::cout << "Neighbor Id = " << localId << "; Updating deviatoricPlasticExtensionState = " << *deviatoricPlasticExtensionState << std::endl;
+				deviatoricPlasticExtensionStateNp1[bondIndex] = edpN + td * deltaLambda;
 			}
-//			std::cout << "\tNeighbor Id = " << localId << "\n\ttd = " << td;
 			/*
 			 * Compute isotropic part of force state
 			 */
@@ -234,7 +249,7 @@ void computeInternalForceIsotropicHardeningPlastic
 			/*
 			 * Force state (with damage)
 			 */
-			double d=(1.0-*bondDamage);
+			double d=(1.0-bondDamage[bondIndex]);
 			t = d*(ti + d*td);
 
 			/*
@@ -405,4 +420,57 @@ template Sacado::Fad::DFad<double> updateDeltaLambda<Sacado::Fad::DFad<double> >
         double HARD_MODULUS
 );
 
+
+/** Explicit template instantiation for double. */
+template void computeInternalForceIsotropicHardeningPlasticCSR<double>
+(
+		const double* xOverlap,
+		const double* yNP1Overlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const double* dilatationOwned,
+		const double* bondDamage,
+		const double* scfOwned,
+		const double* deviatoricPlasticExtensionStateN,
+		double* deviatoricPlasticExtensionStateNp1,
+		const double* lambdaN,
+		double* lambdaNP1,
+		double* fInternalOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+		double HORIZON,
+		double yieldStress,
+		double HARD_MODULUS
+);
+
+/** Explicit template instantiation for Sacado::Fad::DFad<double>. */
+template void computeInternalForceIsotropicHardeningPlasticCSR<Sacado::Fad::DFad<double> >
+(
+		const double* xOverlap,
+		const Sacado::Fad::DFad<double>* yNP1Overlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const Sacado::Fad::DFad<double>* dilatationOwned,
+		const double* bondDamage,
+		const double* scfOwned,
+		const double* deviatoricPlasticExtensionStateN,
+		Sacado::Fad::DFad<double>* deviatoricPlasticExtensionStateNp1,
+		const double* lambdaN,
+		Sacado::Fad::DFad<double>* lambdaNP1,
+		Sacado::Fad::DFad<double>* fInternalOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+		double HORIZON,
+		double yieldStress,
+		double HARD_MODULUS
+);
+
 }
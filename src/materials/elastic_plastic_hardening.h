@@ -67,6 +67,7 @@ ScalarT updateDeltaLambda
         double HARD_MODULUS
 );
 
+//! Computes the internal force and plastic state of owned points, using an interleaved neighbor list; see computeInternalForceIsotropicHardeningPlasticCSR().
 template<typename ScalarT>
 void computeInternalForceIsotropicHardeningPlastic
 (
@@ -91,6 +92,38 @@ void computeInternalForceIsotropicHardeningPlastic
 		double HARD_MODULUS
 );
 
+/** \brief Computes the internal force and plastic state of owned points, using the compressed sparse row (CSR)
+ *  view of the neighborhood data.
+ *
+ *  Owned points firstPoint through lastPoint-1 are evaluated.  The bonds of owned point p are bondOffsets[p] through
+ *  bondOffsets[p+1]-1, and the neighbor of bond bondIndex is neighborIndices[bondIndex - bondOffsets[firstPoint]].
+ */
+template<typename ScalarT>
+void computeInternalForceIsotropicHardeningPlasticCSR
+(
+		const double* xOverlap,
+		const ScalarT* yNP1Overlap,
+		const double* mOwned,
+		const double* volumeOverlap,
+		const ScalarT* dilatationOwned,
+		const double* bondDamage,
+		const double* scfOwned,
+		const double* deviatoricPlasticExtensionStateN,
+		ScalarT* deviatoricPlasticExtensionStateNp1,
+		const double* lambdaN,
+		ScalarT* lambdaNP1,
+		ScalarT* fInternalOverlap,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+		double BULK_MODULUS,
+		double SHEAR_MODULUS,
+		double HORIZON,
+		double yieldStress,
+		double HARD_MODULUS
+);
+
 }
 
 #endif // ELASTIC_PLASTIC_HARDENING_H
@@ -49,6 +49,10 @@
 #include <cmath>
 #include <vector>
 #include <Sacado.hpp>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace MATERIAL_EVALUATION {
 
@@ -232,6 +236,45 @@ void computeDeviatoricDilatation
 	}
 }
 
+void computeBondOffsets
+(
+		const int* localNeighborList,
+		int numOwnedPoints,
+		std::vector<int>& bondOffsets
+)
+{
+	bondOffsets.resize(numOwnedPoints+1);
+	int numBonds = 0;
+	const int *neighPtr = localNeighborList;
+	for(int p=0; p<numOwnedPoints; p++){
+		int numNeigh = *neighPtr;
+		bondOffsets[p] = numBonds;
+		numBonds += numNeigh;
+		neighPtr += numNeigh + 1;
+	}
+	bondOffsets[numOwnedPoints] = numBonds;
+}
+
+const int* gatherNeighborIndices
+(
+		const int* localNeighborList,
+		const int* bondOffsets,
+		int firstPoint,
+		int lastPoint,
+		std::vector<int>& buffer
+)
+{
+	if(lastPoint == firstPoint + 1)
+		return &localNeighborList[bondOffsets[firstPoint]+firstPoint+1];
+	buffer.resize(bondOffsets[lastPoint] - bondOffsets[firstPoint] + 1);
+	int* target = &buffer[0];
+	for(int p=firstPoint; p<lastPoint; p++){
+		const int *neighPtr = &localNeighborList[bondOffsets[p]+p+1];
+		target = std::copy(neighPtr, neighPtr + (bondOffsets[p+1] - bondOffsets[p]), target);
+	}
+	return &buffer[0];
+}
+
 template<typename ScalarT>
 void computeDilatation
 (
@@ -249,22 +292,42 @@ void computeDilatation
         const double* deltaTemperature
 )
 {
-	const double *xOwned = xOverlap;
-	const ScalarT *yOwned = yOverlap;
-	const double *deltaT = deltaTemperature;
-	const double *m = mOwned;
-	const double *v = volumeOverlap;
-	ScalarT *theta = dilatationOwned;
-	double cellVolume;
-	const int *neighPtr = localNeighborList;
-	for(int p=0; p<numOwnedPoints;p++, xOwned+=3, yOwned+=3, deltaT++, m++, theta++){
-		int numNeigh = *neighPtr; neighPtr++;
-		const double *X = xOwned;
-		const ScalarT *Y = yOwned;
-		*theta = ScalarT(0.0);
-		for(int n=0;n<numNeigh;n++,neighPtr++,bondDamage++){
-			int localId = *neighPtr;
-			cellVolume = v[localId];
+	std::vector<int> bondOffsets, neighborIndicesBuffer;
+	computeBondOffsets(localNeighborList, numOwnedPoints, bondOffsets);
+	const int blockSize = PeridigmNS::NeighborhoodData::PointBlockSize();
+	for(int firstPoint=0; firstPoint<numOwnedPoints; firstPoint+=blockSize){
+		int lastPoint = std::min(firstPoint + blockSize, numOwnedPoints);
+		const int* neighborIndices = gatherNeighborIndices(localNeighborList, &bondOffsets[0], firstPoint, lastPoint, neighborIndicesBuffer);
+		computeDilatationCSR(xOverlap,yOverlap,mOwned,volumeOverlap,bondDamage,dilatationOwned,firstPoint,lastPoint,&bondOffsets[0],neighborIndices,horizon,OMEGA,thermalExpansionCoefficient,deltaTemperature);
+	}
+}
+
+template<typename ScalarT>
+void computeDilatationCSR
+(
+		const double* xOverlap,
+		const ScalarT* yOverlap,
+		const double *mOwned,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		ScalarT* dilatationOwned,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+        double horizon,
+		const FunctionPointer OMEGA,
+        double thermalExpansionCoefficient,
+        const double* deltaTemperature
+)
+{
+	const int firstBond = bondOffsets[firstPoint];
+	for(int p=firstPoint; p<lastPoint;p++){
+		const double *X = &xOverlap[3*p];
+		const ScalarT *Y = &yOverlap[3*p];
+		ScalarT theta(0.0);
+		for(int bondIndex=bondOffsets[p];bondIndex<bondOffsets[p+1];bondIndex++){
+			int localId = neighborIndices[bondIndex-firstBond];
 			const double *XP = &xOverlap[3*localId];
 			const ScalarT *YP = &yOverlap[3*localId];
 			double X_dx = XP[0]-X[0];
@@ -279,11 +342,11 @@ void computeDilatation
 			ScalarT e = sqrt(dY);
 			e -= d;
 			if(deltaTemperature)
-			  e -= thermalExpansionCoefficient*(*deltaT)*d;
+			  e -= thermalExpansionCoefficient*deltaTemperature[p]*d;
 			double omega = OMEGA(d,horizon);
-			*theta += 3.0*omega*(1.0-*bondDamage)*d*e*cellVolume/(*m);
+			theta += 3.0*omega*(1.0-bondDamage[bondIndex])*d*e*volumeOverlap[localId]/mOwned[p];
 		}
-
+		dilatationOwned[p] = theta;
 	}
 }
 
@@ -305,7 +368,6 @@ void computeDilatation<double>
         const double* deltaTemperature
  );
 
-
 /** Explicit template instantiation for Sacado::Fad::DFad<double>. */
 template
 void computeDilatation<Sacado::Fad::DFad<double> >
@@ -324,6 +386,84 @@ void computeDilatation<Sacado::Fad::DFad<double> >
         const double* deltaTemperature
  );
 
+/** Explicit template instantiation for double. */
+template
+void computeDilatationCSR<double>
+(
+		const double* xOverlap,
+		const double* yOverlap,
+		const double *mOwned,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		double* dilatationOwned,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+        double horizon,
+		const FunctionPointer OMEGA,
+        double thermalExpansionCoefficient,
+        const double* deltaTemperature
+ );
+
+/** Explicit template instantiation for Sacado::Fad::DFad<double>. */
+template
+void computeDilatationCSR<Sacado::Fad::DFad<double> >
+(
+		const double* xOverlap,
+		const Sacado::Fad::DFad<double>* yOverlap,
+		const double *mOwned,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		Sacado::Fad::DFad<double>* dilatationOwned,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+        double horizon,
+		const FunctionPointer OMEGA,
+        double thermalExpansionCoefficient,
+        const double* deltaTemperature
+ );
+
+void computeDilatationCSR
+(
+		const double* xOverlap,
+		const double* yOverlap,
+		const double *mOwned,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		double* dilatationOwned,
+		const PeridigmNS::NeighborhoodData& neighborhoodData,
+        double horizon,
+		const FunctionPointer OMEGA,
+        double thermalExpansionCoefficient,
+        const double* deltaTemperature
+)
+{
+	const int numOwnedPoints = neighborhoodData.NumOwnedPoints();
+	const int* bondOffsets = neighborhoodData.BondOffsets();
+	const int blockSize = PeridigmNS::NeighborhoodData::PointBlockSize();
+	const int numPointBlocks = (numOwnedPoints + blockSize - 1)/blockSize;
+
+	// Each point reads only its own bonds, so the blocks of points are independent
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+	{
+		std::vector<int> neighborIndicesBuffer;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+		for(int pointBlock=0; pointBlock<numPointBlocks; pointBlock++){
+			int firstPoint = pointBlock*blockSize;
+			int lastPoint = std::min(firstPoint + blockSize, numOwnedPoints);
+			const int* neighborIndices = neighborhoodData.NeighborIndices(firstPoint, lastPoint, neighborIndicesBuffer);
+			computeDilatationCSR(xOverlap,yOverlap,mOwned,volumeOverlap,bondDamage,dilatationOwned,firstPoint,lastPoint,bondOffsets,neighborIndices,horizon,OMEGA,thermalExpansionCoefficient,deltaTemperature);
+		}
+	}
+}
+
 /**
  * Call this function on a single point 'X'
  * NOTE: neighPtr to should point to 'numNeigh' for 'X'
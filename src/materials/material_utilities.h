@@ -49,8 +49,10 @@
 #define MATERIAL_UTILITIES_H
 
 #include <cstdlib>
+#include <vector>
 
 #include "Peridigm_InfluenceFunction.hpp"
+#include "Peridigm_NeighborhoodData.hpp"
 
 class Bond_Volume_Calculator;
 
@@ -192,6 +194,36 @@ void computeDeviatoricDilatation
         const FunctionPointer OMEGA=PeridigmNS::InfluenceFunction::self().getInfluenceFunction()
 );
 
+/**
+ * Computes the compressed sparse row (CSR) bond offsets of an interleaved neighbor list [n0, ids..., n1, ids..., ...].
+ * On return bondOffsets has length numOwnedPoints+1, and owned point p has neighbors bondOffsets[p] through
+ * bondOffsets[p+1]-1, which are stored at localNeighborList[bondOffsets[p]+p+1] onward.
+ */
+void computeBondOffsets
+(
+		const int* localNeighborList,
+		int numOwnedPoints,
+		std::vector<int>& bondOffsets
+);
+
+/**
+ * Returns the neighbors of the points [firstPoint, lastPoint) of an interleaved neighbor list in the layout
+ * expected by the CSR kernels, with the neighbor of bond bondIndex at entry bondIndex - bondOffsets[firstPoint].
+ * The neighbors of a single point are returned in place, otherwise they are gathered into the given buffer.
+ */
+const int* gatherNeighborIndices
+(
+		const int* localNeighborList,
+		const int* bondOffsets,
+		int firstPoint,
+		int lastPoint,
+		std::vector<int>& buffer
+);
+
+/**
+ * Computes the dilatation using an interleaved neighbor list; the points are evaluated with
+ * computeDilatationCSR() in blocks of NeighborhoodData::PointBlockSize() using gatherNeighborIndices().
+ */
 template<typename ScalarT>
 void computeDilatation
 (
@@ -209,6 +241,51 @@ void computeDilatation
         const double* deltaTemperature = 0
  );
 
+/**
+ * Computes the dilatation using the compressed sparse row (CSR) view of the neighborhood data;
+ * the dilatation of each owned point depends only on its own bonds, so any range of points
+ * [firstPoint, lastPoint) may be evaluated independently.  The neighbor of bond bondIndex is
+ * neighborIndices[bondIndex - bondOffsets[firstPoint]].
+ */
+template<typename ScalarT>
+void computeDilatationCSR
+(
+		const double* xOverlap,
+		const ScalarT* yOverlap,
+		const double *mOwned,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		ScalarT* dilatationOwned,
+		int firstPoint,
+		int lastPoint,
+		const int* bondOffsets,
+		const int* neighborIndices,
+        double horizon,
+        const FunctionPointer OMEGA=PeridigmNS::InfluenceFunction::self().getInfluenceFunction(),
+        double thermalExpansionCoefficient = 0,
+        const double* deltaTemperature = 0
+ );
+
+/**
+ * Computes the dilatation of all the owned points of the given neighborhood data, which must be in CSR form.
+ * The points are evaluated with computeDilatationCSR() in blocks of NeighborhoodData::PointBlockSize(),
+ * and the blocks are distributed over the threads if OpenMP is enabled.
+ */
+void computeDilatationCSR
+(
+		const double* xOverlap,
+		const double* yOverlap,
+		const double *mOwned,
+		const double* volumeOverlap,
+		const double* bondDamage,
+		double* dilatationOwned,
+		const PeridigmNS::NeighborhoodData& neighborhoodData,
+        double horizon,
+        const FunctionPointer OMEGA=PeridigmNS::InfluenceFunction::self().getInfluenceFunction(),
+        double thermalExpansionCoefficient = 0,
+        const double* deltaTemperature = 0
+ );
+
 namespace WITH_BOND_VOLUME {
 
 /**
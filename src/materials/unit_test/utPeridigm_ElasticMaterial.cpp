@@ -51,8 +51,12 @@
 #include "Peridigm_ElasticMaterial.hpp"
 #include "Peridigm_SerialMatrix.hpp"
 #include "Peridigm_Field.hpp"
+#include "elastic.h"
+#include "material_utilities.h"
 #include <Epetra_SerialComm.h>
 #include <iostream>
+#include <vector>
+#include <cmath>
 
 
 using namespace std;
@@ -841,6 +845,81 @@ TEUCHOS_UNIT_TEST(ElasticMaterial, twoPointTangentStiffnessMatrixJAM) {
 //   jacobian.print(cout);
 }
 
+//! Tests that the blocked, threaded, and compressed CSR traversal reproduces the interleaved traversal.
+TEUCHOS_UNIT_TEST(ElasticMaterial, testCSRMatchesInterleaved) {
+
+  // cubic lattice with more points than a single block of NeighborhoodData::PointBlockSize()
+  const int n = 12;
+  const int numPoints = n*n*n;
+  const double spacing = 1.0;
+  const double horizon = 1.75*spacing;
+  const double bulkModulus = 130.0e9;
+  const double shearModulus = 78.0e9;
+
+  vector<double> x(3*numPoints), y(3*numPoints), volume(numPoints, spacing*spacing*spacing);
+  for(int i=0 ; i<n ; ++i){
+    for(int j=0 ; j<n ; ++j){
+      for(int k=0 ; k<n ; ++k){
+        int id = i*n*n + j*n + k;
+        x[3*id]   = i*spacing;
+        x[3*id+1] = j*spacing;
+        x[3*id+2] = k*spacing;
+        // nonuniform deformation so that every bond carries a different force
+        y[3*id]   = x[3*id]   + 0.01*std::sin(0.7*id);
+        y[3*id+1] = x[3*id+1] + 0.01*std::cos(1.3*id);
+        y[3*id+2] = 1.02*x[3*id+2];
+      }
+    }
+  }
+
+  // interleaved neighborhood list, with every seventh bond partially damaged
+  vector<int> ownedIDs(numPoints), neighborhoodList;
+  vector<double> bondDamage;
+  for(int iID=0 ; iID<numPoints ; ++iID){
+    ownedIDs[iID] = iID;
+    int numNeighborsIndex = neighborhoodList.size();
+    neighborhoodList.push_back(0);
+    for(int jID=0 ; jID<numPoints ; ++jID){
+      double dx = x[3*jID] - x[3*iID], dy = x[3*jID+1] - x[3*iID+1], dz = x[3*jID+2] - x[3*iID+2];
+      if(jID != iID && dx*dx + dy*dy + dz*dz < horizon*horizon){
+        neighborhoodList.push_back(jID);
+        neighborhoodList[numNeighborsIndex] += 1;
+        bondDamage.push_back(bondDamage.size()%7 == 0 ? 0.5 : 0.0);
+      }
+    }
+  }
+
+  vector<double> weightedVolume(numPoints);
+  MATERIAL_EVALUATION::computeWeightedVolume(&x[0], &volume[0], &weightedVolume[0], numPoints, &neighborhoodList[0], horizon);
+
+  // interleaved traversal
+  vector<double> dilatation(numPoints), force(3*numPoints, 0.0), partialStress(9*numPoints, 0.0);
+  MATERIAL_EVALUATION::computeDilatation(&x[0], &y[0], &weightedVolume[0], &volume[0], &bondDamage[0], &dilatation[0],
+                                         &neighborhoodList[0], numPoints, horizon);
+  MATERIAL_EVALUATION::computeInternalForceLinearElastic(&x[0], &y[0], &weightedVolume[0], &volume[0], &dilatation[0], &bondDamage[0],
+                                                         &force[0], &partialStress[0], &neighborhoodList[0], numPoints,
+                                                         bulkModulus, shearModulus, horizon);
+
+  // CSR traversal, both as stored and compressed
+  for(int compress=0 ; compress<2 ; ++compress){
+    NeighborhoodData neighborhoodData(numPoints, &ownedIDs[0], &neighborhoodList[0]);
+    if(compress)
+      neighborhoodData.Compress();
+    vector<double> csrDilatation(numPoints), csrForce(3*numPoints, 0.0), csrPartialStress(9*numPoints, 0.0);
+    MATERIAL_EVALUATION::computeDilatationCSR(&x[0], &y[0], &weightedVolume[0], &volume[0], &bondDamage[0], &csrDilatation[0],
+                                              neighborhoodData, horizon);
+    MATERIAL_EVALUATION::computeInternalForceLinearElasticCSR(&x[0], &y[0], &weightedVolume[0], &volume[0], &csrDilatation[0], &bondDamage[0],
+                                                              &csrForce[0], &csrPartialStress[0], neighborhoodData, numPoints,
+                                                              bulkModulus, shearModulus, horizon);
+    for(int i=0 ; i<numPoints ; ++i)
+      TEST_FLOATING_EQUALITY(csrDilatation[i], dilatation[i], 1.0e-12);
+    for(int i=0 ; i<3*numPoints ; ++i)
+      TEST_FLOATING_EQUALITY(csrForce[i], force[i], 1.0e-10);
+    for(int i=0 ; i<9*numPoints ; ++i)
+      TEST_FLOATING_EQUALITY(csrPartialStress[i], partialStress[i], 1.0e-10);
+  }
+}
+
 int main
 (int argc, char* argv[])
 {
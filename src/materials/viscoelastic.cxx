@@ -47,7 +47,10 @@
 
 #include <cmath>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 #include "viscoelastic.h"
+#include "material_utilities.h"
 using std::cout;
 using std::endl;
 namespace MATERIAL_EVALUATION {
@@ -73,6 +76,40 @@ void computeInternalForceViscoelasticStandardLinearSolid
    double m_lambda_i,
    double m_tau_b_i
 )
+{
+	std::vector<int> bondOffsets, neighborIndicesBuffer;
+	computeBondOffsets(localNeighborList, numOwnedPoints, bondOffsets);
+	const int blockSize = PeridigmNS::NeighborhoodData::PointBlockSize();
+	for(int firstPoint=0; firstPoint<numOwnedPoints; firstPoint+=blockSize){
+		int lastPoint = std::min(firstPoint + blockSize, numOwnedPoints);
+		const int* neighborIndices = gatherNeighborIndices(localNeighborList, &bondOffsets[0], firstPoint, lastPoint, neighborIndicesBuffer);
+		computeInternalForceViscoelasticStandardLinearSolidCSR(delta_t,xOverlap,yNOverlap,yNP1Overlap,mOwned,volumeOverlap,dilatationOwnedN,dilatationOwnedNp1,bondDamage,edbN,edbNP1,fInternalOverlap,firstPoint,lastPoint,&bondOffsets[0],neighborIndices,BULK_MODULUS,SHEAR_MODULUS,m_lambda_i,m_tau_b_i);
+	}
+}
+
+void computeInternalForceViscoelasticStandardLinearSolidCSR
+  (
+   double delta_t,
+   const double *xOverlap,
+   const double *yNOverlap,
+   const double *yNP1Overlap,
+   const double *mOwned,
+   const double* volumeOverlap,
+   const double* dilatationOwnedN,
+   const double* dilatationOwnedNp1,
+   const double* bondDamage,
+   const double *edbN,
+   double *edbNP1,
+   double *fInternalOverlap,
+   int firstPoint,
+   int lastPoint,
+   const int* bondOffsets,
+   const int* neighborIndices,
+   double BULK_MODULUS,
+   double SHEAR_MODULUS,
+   double m_lambda_i,
+   double m_tau_b_i
+)
 {
 
 	double c1 = m_tau_b_i / delta_t;
@@ -86,31 +123,24 @@ void computeInternalForceViscoelasticStandardLinearSolid
 	double MU = SHEAR_MODULUS;
 	double OMEGA=1.0;
 
-	const double *xOwned = xOverlap;
-	const double *yNOwned = yNOverlap;
-	const double *yNP1Owned = yNP1Overlap;
-	const double *m = mOwned;
 	const double *v = volumeOverlap;
-	const double *thetaN = dilatationOwnedN;
-	const double *thetaNp1 = dilatationOwnedNp1;
-	double *fOwned = fInternalOverlap;
+	const int firstBond = bondOffsets[firstPoint];
 
-	const int *neighPtr = localNeighborList;
 	double cellVolume, dx, dy, dz, zeta, dYN, dYNp1, t, ti, td, edN, edNp1, delta_ed;
-	for(int p=0;p<numOwnedPoints;p++, xOwned +=3, yNOwned +=3, yNP1Owned +=3, fOwned+=3, m++, thetaN++, thetaNp1++){
-
-		int numNeigh = *neighPtr; neighPtr++;
-		const double *X = xOwned;
-		const double *YN = yNOwned;
-		const double *YNP1 = yNP1Owned;
-		double weightedVolume = *m;
-		double dilatationN   = *thetaN;
-		double dilatationNp1 = *thetaNp1;
+	for(int p=firstPoint;p<lastPoint;p++){
+
+		const double *X = &xOverlap[3*p];
+		const double *YN = &yNOverlap[3*p];
+		const double *YNP1 = &yNP1Overlap[3*p];
+		double *fOwned = &fInternalOverlap[3*p];
+		double weightedVolume = mOwned[p];
+		double dilatationN   = dilatationOwnedN[p];
+		double dilatationNp1 = dilatationOwnedNp1[p];
 		double alpha = 15.0*MU/weightedVolume;
 		double selfCellVolume = v[p];
 		double c = 3.0 * K * dilatationNp1 / weightedVolume;
-		for(int n=0;n<numNeigh;n++,neighPtr++,bondDamage++,edbN++,edbNP1++){
-			int localId = *neighPtr;
+		for(int bondIndex=bondOffsets[p];bondIndex<bondOffsets[p+1];bondIndex++){
+			int localId = neighborIndices[bondIndex-firstBond];
 			cellVolume = v[localId];
 			const double *XP    = &xOverlap[3*localId];
 			const double *YPN   = &yNOverlap[3*localId];
@@ -133,8 +163,8 @@ void computeInternalForceViscoelasticStandardLinearSolid
 			 * damage on step N is the same as step NP1;
 			 * ERROR: this needs to be fixed.
 			 */
-			double damageN = (1.0-*bondDamage);
-			double damageNp1 = (1.0-*bondDamage);
+			double damageN = (1.0-bondDamage[bondIndex]);
+			double damageNp1 = (1.0-bondDamage[bondIndex]);
 
 			/*
 			 * volumetric scalar state
@@ -169,12 +199,12 @@ void computeInternalForceViscoelasticStandardLinearSolid
 			/*
 			 * Integrate back extension state forward in time
 			 */
-			*edbNP1 = edN * (1-decay) + (*edbN)*decay  + beta_i * delta_ed;
+			edbNP1[bondIndex] = edN * (1-decay) + edbN[bondIndex]*decay  + beta_i * delta_ed;
 
 			/*
 			 * Compute deviatoric force state
 			 */
-			td = (1.0-m_lambda_i) * alpha * OMEGA * edNp1 + m_lambda_i * alpha * OMEGA * ( edNp1 - *edbNP1 );
+			td = (1.0-m_lambda_i) * alpha * OMEGA * edNp1 + m_lambda_i * alpha * OMEGA * ( edNp1 - edbNP1[bondIndex] );
 
 			/*
 			 * Compute volumetric force state
@@ -56,6 +56,8 @@ namespace MATERIAL_EVALUATION {
  * Output:
  *   * force
  *   * edbNP1 -- deviatoric back strain at end of step
+ * The points of the interleaved neighbor list are evaluated in blocks with
+ * computeInternalForceViscoelasticStandardLinearSolidCSR().
  */
 void computeInternalForceViscoelasticStandardLinearSolid
   (double delta_t,
@@ -78,6 +80,35 @@ void computeInternalForceViscoelasticStandardLinearSolid
    double m_tau_b_i
    );
 
+/**
+ * Internal force calculator for viscoelastic standard linear solid, using the compressed
+ * sparse row (CSR) view of the neighborhood data.  Owned points firstPoint through lastPoint-1
+ * are evaluated.  The bonds of owned point p are bondOffsets[p] through bondOffsets[p+1]-1, and
+ * the neighbor of bond bondIndex is neighborIndices[bondIndex - bondOffsets[firstPoint]].
+ */
+void computeInternalForceViscoelasticStandardLinearSolidCSR
+  (double delta_t,
+   const double *xOverlap,
+   const double *yNOverlap,
+   const double *yNP1Overlap,
+   const double *mOwned,
+   const double* volumeOverlap,
+   const double* dilatationOwnedN,
+   const double* dilatationOwnedNp1,
+   const double* bondDamage,
+   const double *edbN,
+   double *edbNP1,
+   double *fInternalOverlap,
+   int firstPoint,
+   int lastPoint,
+   const int* bondOffsets,
+   const int* neighborIndices,
+   double m_bulkModulus,
+   double m_shearModulus,
+   double m_lambda_i,
+   double m_tau_b_i
+   );
+
 }
 
 #endif // VISCOELASTIC_H
@@ -0,0 +1,124 @@
+#! /usr/bin/env python
+
+# Check the bond family output of the BondFamilyOutput test case
+# Usage:  CheckBondFamilyOutput.py <output filename base> <number of processors>
+
+import sys
+import struct
+
+# Grid of points and horizon in BondFamilyOutput.xml
+num_points = (3, 2, 2)
+spacing = 1.0
+horizon = 1.5
+tolerance = 1.0e-12
+
+def expected_bonds():
+    """Return the bond family of each point, keyed by one-based global id; ids are assigned in x, y, z order"""
+    points = []
+    for k in range(num_points[2]):
+        for j in range(num_points[1]):
+            for i in range(num_points[0]):
+                points.append((spacing*i, spacing*j, spacing*k))
+    families = {}
+    for a in range(len(points)):
+        families[a+1] = set()
+        for b in range(len(points)):
+            distance_squared = sum([(points[a][d] - points[b][d])**2 for d in range(3)])
+            if a != b and distance_squared < horizon*horizon:
+                families[a+1].add(b+1)
+    return families
+
+def read_file(file_name):
+    """Return the column names and a list of (time, bond id pairs, columns) records"""
+    data = open(file_name, 'rb').read()
+    if data[0:8] != b"PDBONDS1":
+        raise ValueError(file_name + ": invalid header")
+    offset = 8
+    num_columns = struct.unpack_from("<i", data, offset)[0]
+    offset += 4
+    names = []
+    for c in range(num_columns):
+        names.append(data[offset:offset+64].split(b"\0")[0].decode())
+        offset += 64
+    records = []
+    while offset < len(data):
+        time, num_bonds = struct.unpack_from("<dq", data, offset)
+        offset += 16
+        ids = struct.unpack_from("<%di" % (2*num_bonds), data, offset)
+        offset += 8*num_bonds
+        pairs = [(ids[2*b], ids[2*b+1]) for b in range(num_bonds)]
+        columns = []
+        for c in range(num_columns):
+            columns.append(struct.unpack_from("<%dd" % num_bonds, data, offset))
+            offset += 8*num_bonds
+        records.append((time, pairs, columns))
+    return names, records
+
+def file_names(base_name, num_procs):
+    if num_procs == 1:
+        return [base_name + ".bonds"]
+    width = len(str(num_procs))
+    return [base_name + ".bonds." + str(num_procs).zfill(width) + "." + str(rank).zfill(width) for rank in range(num_procs)]
+
+def check(base_name, num_procs):
+    errors = []
+    families = expected_bonds()
+    expected_pairs = set([(i, j) for i in families for j in families[i]])
+
+    results = [read_file(name) for name in file_names(base_name, num_procs)]
+    num_steps = len(results[0][1])
+    if num_steps < 2:
+        errors.append("expected the initial and later steps, found %d steps" % num_steps)
+    for names, records in results:
+        if names != ["Bond_Damage", "Bond_Stretch"]:
+            errors.append("unexpected columns " + str(names))
+        if len(records) != num_steps:
+            errors.append("processors wrote different numbers of steps")
+    if errors:
+        return errors
+
+    max_stretch = 0.0
+    for step in range(num_steps):
+        times = [records[step][0] for names, records in results]
+        if max(times) - min(times) > tolerance:
+            errors.append("step %d: processors wrote different times %s" % (step, str(times)))
+
+        # Each bond must be written exactly once, by the owner of its family
+        stretch = {}
+        for names, records in results:
+            time, pairs, columns = records[step]
+            for b in range(len(pairs)):
+                if pairs[b] in stretch:
+                    errors.append("step %d: bond %s written more than once" % (step, str(pairs[b])))
+                stretch[pairs[b]] = columns[1][b]
+                if columns[0][b] != 0.0:
+                    errors.append("step %d: bond %s has nonzero damage" % (step, str(pairs[b])))
+        if set(stretch.keys()) != expected_pairs:
+            errors.append("step %d: bond families do not match the grid" % step)
+            continue
+
+        # A bond and its reverse may be written by different processors, but they must agree
+        for (i, j) in stretch:
+            if abs(stretch[(i, j)] - stretch[(j, i)]) > tolerance:
+                errors.append("step %d: stretch of bond %s differs from its reverse" % (step, str((i, j))))
+            max_stretch = max(max_stretch, abs(stretch[(i, j)]))
+
+    # The initial velocity stretches the bonds with an x component
+    if max_stretch == 0.0:
+        errors.append("all bond stretches are zero")
+
+    return errors
+
+if __name__ == "__main__":
+
+    if len(sys.argv) != 3:
+        print("\nUsage:  CheckBondFamilyOutput.py <output filename base> <number of processors>\n")
+        sys.exit(1)
+
+    errors = check(sys.argv[1], int(sys.argv[2]))
+    for error in errors:
+        print("**** Error:  " + error)
+    if errors:
+        sys.exit(1)
+    print("Bond family output check passed.")
+    sys.exit(0)
@@ -0,0 +1,61 @@
+#! /usr/bin/env python
+
+import sys
+import os
+import re
+from subprocess import Popen
+
+test_dir = "BondFamilyOutput/np2"
+base_name = "BondFamilyOutput"
+
+if __name__ == "__main__":
+
+    result = 0
+
+    # log file will be dumped if verbose option is given
+    verbose = False
+    if "-verbose" in sys.argv:
+        verbose = True
+
+    # change to the specified test directory
+    os.chdir(test_dir)
+
+    # open log file
+    log_file_name = base_name + ".log"
+    if os.path.exists(log_file_name):
+        os.remove(log_file_name)
+    logfile = open(log_file_name, 'w')
+
+    # remove old output files, if any
+    files_to_remove = [base_name + ".bonds.2.0", base_name + ".bonds.2.1", base_name + ".e.2.0", base_name + ".e.2.1"]
+    for file in os.listdir(os.getcwd()):
+      if file in files_to_remove:
+        os.remove(file)
+
+    # run Peridigm
+    command = ["mpiexec", "-np", "2", "../../../../src/Peridigm", "../"+base_name+".xml"]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    if return_code != 0:
+      result = return_code
+
+    # the Bond Family flag of the ExodusII output list must be ignored with a warning
+    logfile.close()
+    if re.search("\"Bond Family\" is ignored", open(log_file_name).read()) == None:
+      result = 1
+    logfile = open(log_file_name, 'a')
+
+    # check the bond family output of each processor
+    command = ["python", "../CheckBondFamilyOutput.py", base_name, "2"]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    if return_code != 0:
+      result = return_code
+
+    logfile.close()
+
+    # dump the output if the user requested verbose
+    if verbose == True:
+        os.system("cat " + log_file_name)
+
+    sys.exit(result)
@@ -0,0 +1,64 @@
+#! /usr/bin/env python
+
+import sys
+import os
+import re
+from subprocess import Popen
+
+test_dir = "ReducedPrecisionOutput/np2"
+base_name = "ReducedPrecisionOutput"
+
+if __name__ == "__main__":
+
+    result = 0
+
+    # log file will be dumped if verbose option is given
+    verbose = False
+    if "-verbose" in sys.argv:
+        verbose = True
+
+    # change to the specified test directory
+    os.chdir(test_dir)
+
+    # open log file
+    log_file_name = base_name + ".log"
+    if os.path.exists(log_file_name):
+        os.remove(log_file_name)
+    logfile = open(log_file_name, 'w')
+
+    # remove old output files, if any
+    variants = ["_Double", "_Single", "_Quantized"]
+    suffixes = [".e.2.0", ".e.2.1"]
+    files_to_remove = [base_name + variant + suffix for variant in variants for suffix in suffixes]
+    for file in os.listdir(os.getcwd()):
+      if file in files_to_remove:
+        os.remove(file)
+
+    # run Peridigm
+    command = ["mpiexec", "-np", "2", "../../../../src/Peridigm", "../"+base_name+".xml"]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    if return_code != 0:
+      result = return_code
+
+    # the reduced precision files must be within the requested digits of the double precision ones
+    for variant in ["_Single", "_Quantized"]:
+      for suffix in suffixes:
+        command = ["../../../../scripts/exodiff", \
+                   "-stat", \
+                   "-f", \
+                   "../"+base_name+variant+".comp", \
+                   base_name+variant+suffix, \
+                   base_name+"_Double"+suffix]
+        p = Popen(command, stdout=logfile, stderr=logfile)
+        return_code = p.wait()
+        if return_code != 0:
+          result = return_code
+
+    logfile.close()
+
+    # dump the output if the user requested verbose
+    if verbose == True:
+        os.system("cat " + log_file_name)
+
+    sys.exit(result)
@@ -0,0 +1,57 @@
+#! /usr/bin/env python
+
+import sys
+import os
+import re
+from subprocess import Popen
+
+test_dir = "RegionOutput/np2"
+base_name = "RegionOutput"
+
+if __name__ == "__main__":
+
+    result = 0
+
+    # log file will be dumped if verbose option is given
+    verbose = False
+    if "-verbose" in sys.argv:
+        verbose = True
+
+    # change to the specified test directory
+    os.chdir(test_dir)
+
+    # open log file
+    log_file_name = base_name + ".log"
+    if os.path.exists(log_file_name):
+        os.remove(log_file_name)
+    logfile = open(log_file_name, 'w')
+
+    # remove old output files, if any
+    files_to_remove = [base_name + ".e.2.0", base_name + ".e.2.1"]
+    for file in os.listdir(os.getcwd()):
+      if file in files_to_remove:
+        os.remove(file)
+
+    # run Peridigm
+    command = ["mpiexec", "-np", "2", "../../../../src/Peridigm", "../"+base_name+".xml"]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    if return_code != 0:
+      result = return_code
+
+    # only the processor that owns the point in the region writes a database
+    databases = [file for file in files_to_remove if os.path.exists(file)]
+    if len(databases) != 1:
+      logfile.write("**** Error:  expected one database, found " + str(databases) + "\n")
+      result = 1
+
+    # no exodus call may fail or warn
+    logfile.close()
+    if re.search("OutputManager_ExodusII::.*(Warning|Error) code", open(log_file_name).read()) != None:
+      result = 1
+
+    # dump the output if the user requested verbose
+    if verbose == True:
+        os.system("cat " + log_file_name)
+
+    sys.exit(result)
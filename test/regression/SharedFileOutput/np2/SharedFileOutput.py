@@ -0,0 +1,77 @@
+#! /usr/bin/env python
+
+import sys
+import os
+import re
+from subprocess import Popen
+
+test_dir = "SharedFileOutput/np2"
+base_name = "SharedFileOutput"
+
+if __name__ == "__main__":
+
+    result = 0
+
+    # log file will be dumped if verbose option is given
+    verbose = False
+    if "-verbose" in sys.argv:
+        verbose = True
+
+    # change to the specified test directory
+    os.chdir(test_dir)
+
+    # open log file
+    log_file_name = base_name + ".log"
+    if os.path.exists(log_file_name):
+        os.remove(log_file_name)
+    logfile = open(log_file_name, 'w')
+
+    # remove old output files, if any
+    files_to_remove = [base_name + ".e", base_name + "_PerRank" + ".e", base_name + "_PerRank" + ".e.2.0", base_name + "_PerRank" + ".e.2.1"]
+    for file in os.listdir(os.getcwd()):
+      if file in files_to_remove:
+        os.remove(file)
+
+    # run Peridigm
+    command = ["mpiexec", "-np", "2", "../../../../src/Peridigm", "../"+base_name+".xml"]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    if return_code != 0:
+      result = return_code
+
+    # the test is skipped (return code 77) if exodus cannot write a shared database
+    logfile.flush()
+    if re.search("Shared File requires", open(log_file_name).read()) != None:
+      logfile.write("\nShared File output is not supported by this build, skipping test.\n")
+      logfile.close()
+      if verbose == True:
+        os.system("cat " + log_file_name)
+      sys.exit(77)
+
+    # join the per-processor databases
+    command = ["../../../../scripts/epu", "-p", "2", base_name+"_PerRank"]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    if return_code != 0:
+      result = return_code
+
+    # the shared database must match the per-processor output
+    command = ["../../../../scripts/exodiff", \
+               "-stat", \
+               "-map", \
+               "-f", \
+               "../"+base_name+".comp", \
+               base_name+".e", \
+               base_name+"_PerRank"+".e"]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    if return_code != 0:
+      result = return_code
+
+    logfile.close()
+
+    # dump the output if the user requested verbose
+    if verbose == True:
+        os.system("cat " + log_file_name)
+
+    sys.exit(result)